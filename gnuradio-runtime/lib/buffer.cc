@@ -31,6 +31,7 @@
 #include <iostream>
 #include <assert.h>
 #include <algorithm>
+#include <limits>
 #include <boost/math/common_factor_rt.hpp>
 
 namespace gr {
@@ -124,7 +125,7 @@ namespace gr {
     // If we rounded-up a whole bunch, give the user a heads up.
     // This only happens if sizeof_item is not a power of two.
 
-    if(nitems > 2 * orig_nitems && nitems * (int) sizeof_item > granularity){
+    if(nitems > 2 * orig_nitems && (size_t)nitems * sizeof_item > (size_t)granularity){
       std::cerr << "gr::buffer::allocate_buffer: warning: tried to allocate\n"
                 << "   " << orig_nitems << " items of size "
                 << sizeof_item << ". Due to alignment requirements\n"
@@ -133,6 +134,15 @@ namespace gr {
                 << "   On this platform, our allocation granularity is " << granularity << " bytes.\n";
     }
 
+    // The circular buffer size is an int. Vector items of 2^24
+    // complex samples are 128 MB each, so a few of them reach it.
+    if((size_t)nitems * sizeof_item > (size_t)std::numeric_limits<int>::max()){
+      std::cerr << "gr::buffer::allocate_buffer: " << nitems << " items of size "
+                << sizeof_item << " exceed the largest buffer of "
+                << std::numeric_limits<int>::max() / (1024*1024) << " MB\n";
+      return false;
+    }
+
     d_bufsize = nitems;
     d_vmcircbuf = gr::vmcircbuf_sysconfig::make(d_bufsize * d_sizeof_item);
     if(d_vmcircbuf == 0){
@@ -30,6 +30,7 @@
 #include "scheduler_tpb.h"
 #include <gnuradio/top_block.h>
 #include <gnuradio/prefs.h>
+#include <volk/volk.h>
 
 #include <stdexcept>
 #include <iostream>
@@ -115,6 +116,10 @@ namespace gr {
     if(p->get_bool("ControlPort", "on", false) && p->get_bool("PerfCounters", "export", false))
       d_ffg->enable_pc_rpc();
 
+    // Resolve all VOLK kernels before the block threads start so
+    // their first work() calls do not pay for it.
+    volk_init();
+
     d_scheduler = make_scheduler(d_ffg, d_max_noutput_items);
     d_state = RUNNING;
   }
@@ -176,6 +181,10 @@ namespace gr {
     new_ffg->merge_connections(d_ffg);   // reuse buffers, etc
     d_ffg = new_ffg;
 
+    // Resolve all VOLK kernels before the block threads start so
+    // their first work() calls do not pay for it.
+    volk_init();
+
     // Create a new scheduler to execute it
     d_scheduler = make_scheduler(d_ffg, d_max_noutput_items);
     d_state = RUNNING;
@@ -48,11 +48,16 @@ namespace gr {
        * \param gain Gain setting to adjust the output amplitude. Set
        *             based on converting the phase difference between
        *             samples to a nominal output value.
+       * \param fast If true, use a lower-accuracy atan2 (error below
+       *             1.2e-5 rad) that is cheaper per sample.
        */
-      static sptr make(float gain);
+      static sptr make(float gain, bool fast=false);
 
       virtual void set_gain(float gain) = 0;
       virtual float gain() const = 0;
+
+      virtual void set_fast(bool fast) = 0;
+      virtual bool fast() const = 0;
     };
 
   } /* namespace analog */
@@ -86,18 +86,18 @@ namespace gr {
       else
 	f_r = ctcss_tones[i+1];
 
-      d_goertzel_l = new fft::goertzel(rate, d_len, f_l);
-      d_goertzel_c = new fft::goertzel(rate, d_len, freq);
-      d_goertzel_r = new fft::goertzel(rate, d_len, f_r);
+      std::vector<float> freqs(3);
+      freqs[0] = f_l;
+      freqs[1] = freq;
+      freqs[2] = f_r;
+      d_goertzel = new fft::goertzel_bank(rate, d_len, freqs);
 
       d_mute = true;
     }
 
     ctcss_squelch_ff_impl::~ctcss_squelch_ff_impl()
     {
-      delete d_goertzel_l;
-      delete d_goertzel_c;
-      delete d_goertzel_r;
+      delete d_goertzel;
     }
 
     std::vector<float>
@@ -114,16 +114,16 @@ namespace gr {
     void
     ctcss_squelch_ff_impl::update_state(const float &in)
     {
-      d_goertzel_l->input(in);
-      d_goertzel_c->input(in);
-      d_goertzel_r->input(in);
+      d_goertzel->input(in);
 
       float rounder = 100000;
       float d_out_l, d_out_c, d_out_r;
-      if(d_goertzel_c->ready()) {
-	d_out_l = floor(rounder*abs(d_goertzel_l->output()))/rounder;
-	d_out_c = floor(rounder*abs(d_goertzel_c->output()))/rounder;
-	d_out_r = floor(rounder*abs(d_goertzel_r->output()))/rounder;
+      if(d_goertzel->ready()) {
+	gr_complex out[3];
+	d_goertzel->output(out);
+	d_out_l = floor(rounder*abs(out[0]))/rounder;
+	d_out_c = floor(rounder*abs(out[1]))/rounder;
+	d_out_r = floor(rounder*abs(out[2]))/rounder;
 
 	//printf("d_out_l=%f d_out_c=%f d_out_r=%f\n", d_out_l, d_out_c, d_out_r);
 	d_mute = (d_out_c < d_level || d_out_c < d_out_l || d_out_c < d_out_r);
@@ -25,7 +25,7 @@
 
 #include "squelch_base_ff_impl.h"
 #include <gnuradio/analog/ctcss_squelch_ff.h>
-#include <gnuradio/fft/goertzel.h>
+#include <gnuradio/fft/goertzel_bank.h>
 
 namespace gr {
   namespace analog {
@@ -38,9 +38,7 @@ namespace gr {
       int   d_len;
       bool  d_mute;
 
-      fft::goertzel *d_goertzel_l;
-      fft::goertzel *d_goertzel_c;
-      fft::goertzel *d_goertzel_r;
+      fft::goertzel_bank *d_goertzel;   // lower guard, tone, upper guard
 
       int find_tone(float freq);
 
@@ -26,13 +26,17 @@
 
 #include "frequency_modulator_fc_impl.h"
 #include <gnuradio/io_signature.h>
-#include <gnuradio/fxpt.h>
+#include <volk/volk.h>
 #include <math.h>
-#include <boost/math/special_functions/trunc.hpp>
+#include <algorithm>
 
 namespace gr {
   namespace analog {
 
+    // Phases are converted to phasors this many at a time; a multiple
+    // of any VOLK alignment so every chunk of out stays aligned.
+    static const int PHASE_CHUNK = 4096;
+
     frequency_modulator_fc::sptr
     frequency_modulator_fc::make(double sensitivity)
     {
@@ -46,10 +50,17 @@ namespace gr {
 		      io_signature::make(1, 1, sizeof(gr_complex))),
 	d_sensitivity(sensitivity), d_phase(0)
     {
+      const int alignment_multiple =
+	volk_get_alignment() / sizeof(gr_complex);
+      set_alignment(std::max(1, alignment_multiple));
+
+      d_phase_buf = (float*)volk_malloc(PHASE_CHUNK * sizeof(float),
+                                        volk_get_alignment());
     }
 
     frequency_modulator_fc_impl::~frequency_modulator_fc_impl()
     {
+      volk_free(d_phase_buf);
     }
 
     int
@@ -60,19 +71,23 @@ namespace gr {
       const float *in = (const float*)input_items[0];
       gr_complex *out = (gr_complex*)output_items[0];
 
-      for(int i = 0; i < noutput_items; i++) {
-	d_phase = d_phase + d_sensitivity * in[i];
+      // The phase accumulation is a running sum, so it stays scalar;
+      // the phase to phasor conversion is done in vector calls.
+      for(int j = 0; j < noutput_items; j += PHASE_CHUNK) {
+	const int n = std::min(PHASE_CHUNK, noutput_items - j);
+
+	for(int i = 0; i < n; i++) {
+	  d_phase = d_phase + d_sensitivity * in[j+i];
 
-	while(d_phase > (float)(M_PI))
-	  d_phase -= (float)(2.0 * M_PI);
-	while(d_phase < (float)(-M_PI))
-	  d_phase += (float)(2.0 * M_PI);
+	  while(d_phase > (float)(M_PI))
+	    d_phase -= (float)(2.0 * M_PI);
+	  while(d_phase < (float)(-M_PI))
+	    d_phase += (float)(2.0 * M_PI);
 
-	float oi, oq;
+	  d_phase_buf[i] = d_phase;
+	}
 
-	gr_int32 angle = gr::fxpt::float_to_fixed (d_phase);
-	gr::fxpt::sincos(angle, &oq, &oi);
-	out[i] = gr_complex(oi, oq);
+	volk_32f_sincos_32fc(&out[j], d_phase_buf, n);
       }
 
       return noutput_items;
@@ -33,6 +33,7 @@ namespace gr {
     private:
       float d_sensitivity;
       float d_phase;
+      float *d_phase_buf;	// aligned, PHASE_CHUNK phases
 
     public:
       frequency_modulator_fc_impl(double sensitivity);
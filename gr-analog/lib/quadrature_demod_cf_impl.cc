@@ -26,24 +26,23 @@
 
 #include "quadrature_demod_cf_impl.h"
 #include <gnuradio/io_signature.h>
-#include <gnuradio/math.h>
 #include <volk/volk.h>
 
 namespace gr {
   namespace analog {
 
     quadrature_demod_cf::sptr
-    quadrature_demod_cf::make(float gain)
+    quadrature_demod_cf::make(float gain, bool fast)
     {
       return gnuradio::get_initial_sptr
-	(new quadrature_demod_cf_impl(gain));
+	(new quadrature_demod_cf_impl(gain, fast));
     }
 
-    quadrature_demod_cf_impl::quadrature_demod_cf_impl(float gain)
+    quadrature_demod_cf_impl::quadrature_demod_cf_impl(float gain, bool fast)
       : sync_block("quadrature_demod_cf",
 		      io_signature::make(1, 1, sizeof(gr_complex)),
 		      io_signature::make(1, 1, sizeof(float))),
-	d_gain(gain)
+	d_gain(gain), d_fast(fast)
     {
       const int alignment_multiple =
 	volk_get_alignment() / sizeof(gr_complex);
@@ -66,9 +65,10 @@ namespace gr {
 
       std::vector<gr_complex> tmp(noutput_items);
       volk_32fc_x2_multiply_conjugate_32fc(&tmp[0], &in[1], &in[0], noutput_items);
-      for(int i = 0; i < noutput_items; i++) {
-        out[i] = d_gain * gr::fast_atan2f(imag(tmp[i]), real(tmp[i]));
-      }
+      if(d_fast)
+        volk_32fc_s32f_fast_atan2_32f(out, &tmp[0], 1.0f / d_gain, noutput_items);
+      else
+        volk_32fc_s32f_atan2_32f(out, &tmp[0], 1.0f / d_gain, noutput_items);
 
       return noutput_items;
     }
@@ -32,14 +32,18 @@ namespace gr {
     {
     private:
       float d_gain;
+      bool d_fast;
 
     public:
-      quadrature_demod_cf_impl(float gain);
+      quadrature_demod_cf_impl(float gain, bool fast);
       ~quadrature_demod_cf_impl();
 
       void set_gain(float gain) { d_gain = gain; }
       float gain() const { return d_gain; }
 
+      void set_fast(bool fast) { d_fast = fast; }
+      bool fast() const { return d_fast; }
+
       int work(int noutput_items,
 	       gr_vector_const_void_star &input_items,
 	       gr_vector_void_star &output_items);
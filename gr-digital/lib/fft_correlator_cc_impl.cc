@@ -0,0 +1,342 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "fft_correlator_cc_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
+#include <gnuradio/filter/filter_engine.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+namespace gr {
+  namespace digital {
+
+    fft_correlator_cc::sptr
+    fft_correlator_cc::make(const std::vector<std::vector<gr_complex> > &references,
+                            float threshold, int nthreads)
+    {
+      return gnuradio::get_initial_sptr
+        (new fft_correlator_cc_impl(references, threshold, nthreads));
+    }
+
+    static void
+    check_references(const std::vector<std::vector<gr_complex> > &references)
+    {
+      if(references.empty())
+        throw std::invalid_argument("fft_correlator_cc: at least one reference is required");
+      for(unsigned int k = 0; k < references.size(); k++) {
+        if(references[k].empty())
+          throw std::invalid_argument("fft_correlator_cc: references cannot be empty");
+      }
+    }
+
+    fft_correlator_cc_impl::fft_correlator_cc_impl(const std::vector<std::vector<gr_complex> > &references,
+                                                   float threshold, int nthreads)
+      : sync_block("fft_correlator_cc",
+                   io_signature::make(1, 1, sizeof(gr_complex)),
+                   io_signature::make(1, -1, sizeof(gr_complex))),
+        d_threshold(threshold), d_nthreads(nthreads), d_updated(false),
+        d_fftsize(0), d_nsamples(0), d_fwdfft(NULL), d_invfft(NULL),
+        d_processed(0), d_max_window(0)
+    {
+      check_references(references);
+      d_references = references;
+      build();
+    }
+
+    fft_correlator_cc_impl::~fft_correlator_cc_impl()
+    {
+      for(unsigned int k = 0; k < d_xformed.size(); k++)
+        volk_free(d_xformed[k]);
+      delete d_fwdfft;
+      delete d_invfft;
+    }
+
+    void
+    fft_correlator_cc_impl::build()
+    {
+      d_maxlen = 0;
+      for(unsigned int k = 0; k < d_references.size(); k++)
+        d_maxlen = std::max(d_maxlen, (int)d_references[k].size());
+
+      // Same FFT size as kernel::fft_filter_ccc would use for a
+      // filter as long as the longest reference.
+      int old_fftsize = d_fftsize;
+      d_fftsize = (int)(2 * pow(2.0, ceil(log(double(d_maxlen)) / log(2.0))));
+      if(d_maxlen >= (int)filter::kernel::filter_cost_model::MIN_FFT_TAPS)
+        d_fftsize = filter::kernel::filter_cost_model::instance().best_fftsize
+          (filter::kernel::filter_cost_model::FFT_COMPLEX, d_maxlen, 1, NULL, 4*d_fftsize);
+      d_nsamples = d_fftsize - d_maxlen + 1;
+
+      if(d_fftsize != old_fftsize) {
+        delete d_fwdfft;
+        delete d_invfft;
+        int batch = std::max(1, BATCH_ITEMS / d_fftsize);
+        d_fwdfft = new fft::fft_complex(d_fftsize, true, d_nthreads, batch);
+        d_invfft = new fft::fft_complex(d_fftsize, false, d_nthreads, batch);
+      }
+
+      for(unsigned int k = 0; k < d_xformed.size(); k++)
+        volk_free(d_xformed[k]);
+      d_xformed.resize(d_references.size());
+      d_ref_energy.resize(d_references.size());
+
+      // Correlating with r is filtering with the time reversed
+      // conj(r), whose transform is conj(FFT(r)). The 1/fftsize
+      // scaling of the inverse FFT is folded in here.
+      gr_complex *in = d_fwdfft->get_inbuf();
+      for(unsigned int k = 0; k < d_references.size(); k++) {
+        const std::vector<gr_complex> &r = d_references[k];
+        memset(in, 0, d_fftsize * sizeof(gr_complex));
+        std::copy(r.begin(), r.end(), in);
+        d_fwdfft->execute(1);
+
+        d_xformed[k] = (gr_complex*)volk_malloc(d_fftsize * sizeof(gr_complex),
+                                                volk_get_alignment());
+        const gr_complex *out = d_fwdfft->get_outbuf();
+        for(int i = 0; i < d_fftsize; i++)
+          d_xformed[k][i] = conj(out[i]) / (float)d_fftsize;
+
+        double energy = 0;
+        for(unsigned int j = 0; j < r.size(); j++)
+          energy += norm(r[j]);
+        d_ref_energy[k] = energy;
+      }
+
+      peak idle;
+      idle.in_run = false;
+      idle.tagged = false;
+      d_peaks.assign(d_references.size(), idle);
+
+      // The passthrough output is the oldest sample of the history,
+      // so every reference fits in the samples after it.
+      set_history(d_maxlen);
+      set_output_multiple(d_nsamples);
+    }
+
+    std::vector<std::vector<gr_complex> >
+    fft_correlator_cc_impl::references() const
+    {
+      return d_references;
+    }
+
+    void
+    fft_correlator_cc_impl::set_references(const std::vector<std::vector<gr_complex> > &references)
+    {
+      check_references(references);
+
+      gr::thread::scoped_lock lock(d_setlock);
+      d_references = references;
+      d_updated = true;
+    }
+
+    void
+    fft_correlator_cc_impl::set_threshold(float threshold)
+    {
+      gr::thread::scoped_lock lock(d_setlock);
+      d_threshold = threshold;
+    }
+
+    void
+    fft_correlator_cc_impl::set_nthreads(int n)
+    {
+      gr::thread::scoped_lock lock(d_setlock);
+      d_nthreads = n;
+      d_fwdfft->set_nthreads(n);
+      d_invfft->set_nthreads(n);
+    }
+
+    void
+    fft_correlator_cc_impl::correlate(const gr_complex *in,
+                                      std::vector<gr_complex*> &corrs,
+                                      int noutput_items)
+    {
+      const int nblocks = noutput_items / d_nsamples;
+      const int batch = d_fwdfft->batch();
+
+      // Each batch of input blocks is transformed once and then
+      // correlated with every reference.
+      for(int first = 0; first < nblocks; first += batch) {
+        int n = std::min(batch, nblocks - first);
+        for(int i = 0; i < n; i++) {
+          memcpy(d_fwdfft->get_inbuf() + i * d_fftsize,
+                 in + (first + i) * d_nsamples,
+                 d_fftsize * sizeof(gr_complex));
+        }
+        d_fwdfft->execute(n);
+
+        for(unsigned int k = 0; k < corrs.size(); k++) {
+          for(int i = 0; i < n; i++) {
+            volk_32fc_x2_multiply_32fc(d_invfft->get_inbuf() + i * d_fftsize,
+                                       d_fwdfft->get_outbuf() + i * d_fftsize,
+                                       d_xformed[k], d_fftsize);
+          }
+          d_invfft->execute(n);
+
+          // The first d_nsamples outputs of each block are free of
+          // circular wrap-around.
+          for(int i = 0; i < n; i++) {
+            memcpy(corrs[k] + (first + i) * d_nsamples,
+                   d_invfft->get_outbuf() + i * d_fftsize,
+                   d_nsamples * sizeof(gr_complex));
+          }
+        }
+      }
+    }
+
+    void
+    fft_correlator_cc_impl::tag(unsigned int ref, const peak &p)
+    {
+      add_item_tag(0, p.offset, pmt::intern("corr_est"),
+                   pmt::from_double(p.metric), pmt::intern(alias()));
+      add_item_tag(0, p.offset, pmt::intern("phase_est"),
+                   pmt::from_double(arg(p.corr)), pmt::intern(alias()));
+      add_item_tag(0, p.offset, pmt::intern("corr_id"),
+                   pmt::from_long(ref), pmt::intern(alias()));
+    }
+
+    void
+    fft_correlator_cc_impl::detect(unsigned int ref, const gr_complex *corr,
+                                   int noutput_items, uint64_t nwritten)
+    {
+      const int len = d_references[ref].size();
+      const double ref_energy = d_ref_energy[ref];
+      peak &p = d_peaks[ref];
+
+      // Items held back by the previous call have been seen already
+      int start = 0;
+      if(d_processed > nwritten)
+        start = std::min((uint64_t)noutput_items, d_processed - nwritten);
+
+      volk_32fc_magnitude_squared_32f(&d_mag[0], corr, noutput_items);
+
+      for(int i = start; i < noutput_items; i++) {
+        double energy = ref_energy * (d_energy[i+len] - d_energy[i]);
+        float m = (energy > 0) ? d_mag[i] / energy : 0;
+
+        if(m > d_threshold) {
+          if(!p.in_run) {
+            p.in_run = true;
+            p.tagged = false;
+            p.metric = -1;
+          }
+          if(!p.tagged && m > p.metric) {
+            p.metric = m;
+            p.corr = corr[i];
+            p.offset = nwritten + i;
+          }
+        }
+        else if(p.in_run) {
+          if(!p.tagged)
+            tag(ref, p);
+          p.in_run = false;
+        }
+      }
+    }
+
+    int
+    fft_correlator_cc_impl::work(int noutput_items,
+                                 gr_vector_const_void_star &input_items,
+                                 gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock lock(d_setlock);
+
+      if(d_updated) {
+        build();
+        d_updated = false;
+        return 0;                  // history and output multiple may have changed
+      }
+
+      const gr_complex *in = (const gr_complex *)input_items[0];
+      gr_complex *out = (gr_complex *)output_items[0];
+      const unsigned int nrefs = d_references.size();
+
+      memcpy(out, in, sizeof(gr_complex)*noutput_items);
+
+      // Correlations go to their output port if it is connected
+      std::vector<gr_complex*> corrs(nrefs);
+      d_corr.resize(nrefs * noutput_items);
+      for(unsigned int k = 0; k < nrefs; k++) {
+        if(k+1 < output_items.size())
+          corrs[k] = (gr_complex *)output_items[k+1];
+        else
+          corrs[k] = &d_corr[k * noutput_items];
+      }
+      for(unsigned int k = nrefs+1; k < output_items.size(); k++)
+        memset(output_items[k], 0, sizeof(gr_complex)*noutput_items);
+
+      correlate(in, corrs, noutput_items);
+
+      // d_energy[i] is the energy of in[0..i-1]
+      const int nin = noutput_items + d_maxlen - 1;
+      d_energy.resize(nin + 1);
+      d_energy[0] = 0;
+      for(int i = 0; i < nin; i++)
+        d_energy[i+1] = d_energy[i] + norm(in[i]);
+
+      const uint64_t nwritten = nitems_written(0);
+      d_mag.resize(noutput_items);
+      for(unsigned int k = 0; k < nrefs; k++)
+        detect(k, corrs[k], noutput_items, nwritten);
+      d_processed = std::max(d_processed, nwritten + noutput_items);
+
+      // A run that has not ended yet is tagged when it does, so hold
+      // back the items from its peak on; the peak and its metric stay
+      // in d_peaks and the next call goes on tracking the run. With
+      // the peak on the first item nothing is produced, which waits
+      // for a longer window, unless none can come: this window is as
+      // long as any the scheduler has given, or the input has ended.
+      // The run is then tagged at its peak so far.
+      const bool can_wait = noutput_items < d_max_window &&
+        !detail()->input(0)->done();
+      d_max_window = std::max(d_max_window, noutput_items);
+
+      int nproduced = noutput_items;
+      for(unsigned int k = 0; k < nrefs; k++) {
+        peak &p = d_peaks[k];
+        if(!p.in_run || p.tagged)
+          continue;
+        if(p.offset > nwritten) {
+          nproduced = std::min(nproduced, (int)(p.offset - nwritten));
+        }
+        else if(can_wait) {
+          nproduced = 0;
+        }
+        else {
+          tag(k, p);
+          p.tagged = true;
+        }
+      }
+
+      return nproduced;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
@@ -0,0 +1,96 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_FFT_CORRELATOR_CC_IMPL_H
+#define INCLUDED_DIGITAL_FFT_CORRELATOR_CC_IMPL_H
+
+#include <gnuradio/digital/fft_correlator_cc.h>
+#include <gnuradio/fft/fft.h>
+
+namespace gr {
+  namespace digital {
+
+    class fft_correlator_cc_impl : public fft_correlator_cc
+    {
+    private:
+      // Samples transformed per FFT execute; blocks are batched up to this.
+      static const int BATCH_ITEMS = 16384;
+
+      // The largest sample of a run above the threshold
+      struct peak {
+        bool       in_run;
+        bool       tagged;      // tagged before the run ended
+        float      metric;
+        gr_complex corr;
+        uint64_t   offset;
+      };
+
+      std::vector<std::vector<gr_complex> > d_references;
+      std::vector<float>         d_ref_energy;
+      float                      d_threshold;
+      int                        d_nthreads;
+      bool                       d_updated;
+
+      int                        d_maxlen;     // longest reference
+      int                        d_fftsize;
+      int                        d_nsamples;   // outputs per FFT
+      fft::fft_complex          *d_fwdfft;
+      fft::fft_complex          *d_invfft;
+      std::vector<gr_complex*>   d_xformed;    // conj(FFT(reference))/fftsize
+
+      std::vector<gr_complex>    d_corr;       // for references without a port
+      std::vector<float>         d_mag;
+      std::vector<double>        d_energy;     // running sum of |x|^2
+      std::vector<peak>          d_peaks;
+      uint64_t                   d_processed;  // items seen by the detector
+      int                        d_max_window; // largest noutput_items so far
+
+      void build();
+      void correlate(const gr_complex *in, std::vector<gr_complex*> &corrs,
+                     int noutput_items);
+      void detect(unsigned int ref, const gr_complex *corr,
+                  int noutput_items, uint64_t nwritten);
+      void tag(unsigned int ref, const peak &p);
+
+    public:
+      fft_correlator_cc_impl(const std::vector<std::vector<gr_complex> > &references,
+                             float threshold, int nthreads);
+      ~fft_correlator_cc_impl();
+
+      std::vector<std::vector<gr_complex> > references() const;
+      void set_references(const std::vector<std::vector<gr_complex> > &references);
+
+      float threshold() const { return d_threshold; }
+      void set_threshold(float threshold);
+
+      void set_nthreads(int n);
+      int nthreads() const { return d_nthreads; }
+
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_FFT_CORRELATOR_CC_IMPL_H */
@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+
+import cmath, math, random
+
+import pmt
+from gnuradio import gr, gr_unittest, digital, blocks
+
+class test_fft_correlator(gr_unittest.TestCase):
+
+    def setUp(self):
+        random.seed(0)
+        self.refs = [[complex(random.choice((-1, 1)), random.choice((-1, 1)))
+                      for i in xrange(n)] for n in (200, 63)]
+        self.maxlen = 200
+        self.data = [0.3*complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                     for i in xrange(12000)]
+        # (position, reference, amplitude, phase) of each copy
+        self.events = [(1000, 0, 1.0, 0.3), (4321, 1, 2.0, -2.0),
+                       (4700, 0, 0.5, 1.0), (9000, 1, 1.0, 2.5)]
+        for pos, ref, amp, phase in self.events:
+            rot = amp*cmath.exp(1j*phase)
+            for i, r in enumerate(self.refs[ref]):
+                self.data[pos+i] += rot*r
+
+    def run_correlator(self, corr):
+        src = blocks.vector_source_c(self.data)
+        out = blocks.vector_sink_c()
+        sinks = [blocks.vector_sink_c() for r in self.refs]
+        tb = gr.top_block()
+        tb.connect(src, corr, out)
+        for i, snk in enumerate(sinks):
+            tb.connect((corr, i+1), snk)
+        tb.run()
+        return out, [snk.data() for snk in sinks]
+
+    def test_001_detect(self):
+        corr = digital.fft_correlator_cc(self.refs, 0.5)
+        out, corrs = self.run_correlator(corr)
+
+        # The passthrough output is delayed by the longest reference
+        delay = self.maxlen - 1
+        data = out.data()
+        self.assertComplexTuplesAlmostEqual(delay*(0,) + tuple(self.data[:len(data)-delay]),
+                                            data, 6)
+
+        tags = {}
+        for tag in out.tags():
+            key = pmt.symbol_to_string(tag.key)
+            tags.setdefault(tag.offset, {})[key] = tag.value
+        self.assertEqual(sorted(tags.keys()),
+                         [pos + delay for pos, ref, amp, phase in self.events])
+        for pos, ref, amp, phase in self.events:
+            tag = tags[pos + delay]
+            self.assertEqual(ref, pmt.to_long(tag["corr_id"]))
+            self.assertTrue(pmt.to_double(tag["corr_est"]) > 0.9)
+            self.assertAlmostEqual(phase, pmt.to_double(tag["phase_est"]), 1)
+
+        # Correlation outputs, aligned with the passthrough output
+        x = delay*[0,] + self.data
+        for ref, c in zip(self.refs, corrs):
+            for n in xrange(0, len(c) - len(ref), 97):
+                expected = sum(x[n+j]*r.conjugate() for j, r in enumerate(ref))
+                self.assertComplexAlmostEqual2(expected, c[n], 1e-3, 1e-4)
+
+    def test_002_threshold(self):
+        corr = digital.fft_correlator_cc(self.refs, 0.5)
+        corr.set_threshold(1.5)
+        self.assertAlmostEqual(1.5, corr.threshold())
+        out, corrs = self.run_correlator(corr)
+        self.assertEqual(0, len(out.tags()))
+
+    def test_003_run_across_calls(self):
+        # With the reference [1, 1] and |x| = 1 the metric is
+        # cos^2(d/2), d the phase step between two samples. A run of
+        # 14 samples above the threshold, largest 12 samples in,
+        # crosses the boundary between two calls of 30 items.
+        metrics = [0.6, 0.7, 0.65]*4 + [0.95, 0.7]
+        steps = 100*[math.pi,]
+        for i, m in enumerate(metrics):
+            steps[25+i] = 2*math.acos(math.sqrt(m))
+        phase, data = 0, []
+        for d in steps:
+            data.append(cmath.exp(1j*phase))
+            phase += d
+
+        corr = digital.fft_correlator_cc([[1, 1]], 0.5)
+        corr.set_max_noutput_items(30)
+        src = blocks.vector_source_c(data)
+        out = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(src, corr, out)
+        tb.run()
+
+        # One set of tags, at the largest metric of the run; the
+        # passthrough output is delayed by one sample
+        tags = [t for t in out.tags() if pmt.symbol_to_string(t.key) == "corr_est"]
+        self.assertEqual(1, len(tags))
+        self.assertEqual(25 + 12 + 1, tags[0].offset)
+        self.assertAlmostEqual(0.95, pmt.to_double(tags[0].value), 4)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_fft_correlator, "test_fft_correlator.xml")
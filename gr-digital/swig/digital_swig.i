@@ -66,6 +66,7 @@
 #include "gnuradio/digital/diff_decoder_bb.h"
 #include "gnuradio/digital/diff_encoder_bb.h"
 #include "gnuradio/digital/diff_phasor_cc.h"
+#include "gnuradio/digital/fft_correlator_cc.h"
 #include "gnuradio/digital/fll_band_edge_cc.h"
 #include "gnuradio/digital/framer_sink_1.h"
 #include "gnuradio/digital/glfsr_source_b.h"
@@ -142,6 +143,7 @@
 %include "gnuradio/digital/diff_decoder_bb.h"
 %include "gnuradio/digital/diff_encoder_bb.h"
 %include "gnuradio/digital/diff_phasor_cc.h"
+%include "gnuradio/digital/fft_correlator_cc.h"
 %include "gnuradio/digital/fll_band_edge_cc.h"
 %include "gnuradio/digital/framer_sink_1.h"
 %include "gnuradio/digital/glfsr_source_b.h"
@@ -212,6 +214,7 @@ GR_SWIG_BLOCK_MAGIC2(digital, descrambler_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, diff_decoder_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, diff_encoder_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, diff_phasor_cc);
+GR_SWIG_BLOCK_MAGIC2(digital, fft_correlator_cc);
 GR_SWIG_BLOCK_MAGIC2(digital, fll_band_edge_cc);
 GR_SWIG_BLOCK_MAGIC2(digital, framer_sink_1);
 GR_SWIG_BLOCK_MAGIC2(digital, glfsr_source_b);
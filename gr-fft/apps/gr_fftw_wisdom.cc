@@ -0,0 +1,247 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Plan FFTs of the given sizes ahead of time so the wisdom file used
+ * by gr::fft (~/.gr_fftw_wisdom) already covers them; GNU Radio
+ * flowgraphs then start without planning. Planning with --rigor
+ * patient or exhaustive takes longer but finds faster plans, and the
+ * wisdom is reused by the MEASURE plans made at run time.
+ *
+ * With --benchmark N, each planned size is also timed over N
+ * transforms: fft_vcc's per-item work for large sizes (copy in,
+ * in-place transform) and for small sizes (copy in, out-of-place
+ * transform, copy out), and the bare out-of-place complex and real
+ * transforms. Compare thread counts by running it with each -t.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/fft/fft.h>
+#include <boost/program_options.hpp>
+#include <boost/format.hpp>
+#include <boost/foreach.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace po = boost::program_options;
+using boost::format;
+
+// Seconds per call of f.execute() over \p reps calls.
+template<class FFT>
+static double
+time_execute(FFT &f, int reps)
+{
+  f.execute();
+  boost::posix_time::ptime t0 = boost::posix_time::microsec_clock::universal_time();
+  for(int i = 0; i < reps; i++)
+    f.execute();
+  boost::posix_time::ptime t1 = boost::posix_time::microsec_clock::universal_time();
+  return (t1 - t0).total_microseconds() * 1e-6 / reps;
+}
+
+// Adapts fft_complex_inplace to time_execute() the way fft_vcc uses
+// it for large sizes: copy an item into the output buffer, then
+// transform it there.
+struct inplace_runner
+{
+  gr::fft::fft_complex_inplace &fft;
+  const gr_complex *in;
+  gr_complex *buf;
+  int size;
+  inplace_runner(gr::fft::fft_complex_inplace &f, const gr_complex *i,
+                 gr_complex *b, int n) : fft(f), in(i), buf(b), size(n) {}
+  void execute()
+  {
+    memcpy(buf, in, size*sizeof(gr_complex));
+    fft.execute(buf);
+  }
+};
+
+// Adapts fft_complex to time_execute() the way fft_vcc uses it for
+// small sizes: copy an item into the input buffer, transform it, copy
+// the result out.
+struct copy_runner
+{
+  gr::fft::fft_complex &fft;
+  const gr_complex *in;
+  gr_complex *out;
+  int size;
+  copy_runner(gr::fft::fft_complex &f, const gr_complex *i,
+              gr_complex *o, int n) : fft(f), in(i), out(o), size(n) {}
+  void execute()
+  {
+    memcpy(fft.get_inbuf(), in, size*sizeof(gr_complex));
+    fft.execute();
+    memcpy(out, fft.get_outbuf(), size*sizeof(gr_complex));
+  }
+};
+
+// The usual FFT figure of merit: 5 N log2(N) flops per complex
+// transform, half that per real one.
+static void
+report(const char *name, int size, double t, double flops = 5.0)
+{
+  double mflops = flops * size * std::log((double)size) / std::log(2.0) / t * 1e-6;
+  std::cout << format("  %-16s %12.1f us %10.1f MFLOPS") % name % (t*1e6) % mflops
+            << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  po::options_description desc((format("Program options: %1% [options] size...") % argv[0]).str());
+  po::positional_options_description pos;
+  po::variables_map vm;
+
+  desc.add_options()
+    ("help,h", "print help message")
+    ("size,s", po::value<std::vector<int> >(), "FFT size to plan (repeatable, or positional)")
+    ("pow2", po::value<std::string>(), "plan all powers of 2 from 2^a to 2^b, given as a:b")
+    ("kind,k", po::value<std::string>()->default_value("all"),
+     "transforms to plan: complex, real or all")
+    ("batch,b", po::value<std::vector<int> >(),
+     "also plan complex transforms of this many vectors (repeatable)")
+    ("threads,t", po::value<int>()->default_value(1), "number of FFTW threads")
+    ("rigor,r", po::value<std::string>()->default_value("patient"),
+     "planning rigor: measure, patient or exhaustive")
+    ("benchmark", po::value<int>(), "time this many transforms of each size")
+    ;
+  pos.add("size", -1);
+
+  try {
+    po::store(po::command_line_parser(argc, argv).options(desc).positional(pos).run(), vm);
+    po::notify(vm);
+  }
+  catch (po::error& error){
+    std::cerr << "Error: " << error.what() << std::endl << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  std::vector<int> sizes;
+  if(vm.count("size"))
+    sizes = vm["size"].as<std::vector<int> >();
+  if(vm.count("pow2")) {
+    int a, b;
+    if(sscanf(vm["pow2"].as<std::string>().c_str(), "%d:%d", &a, &b) != 2 ||
+       a < 0 || b < a || b > 30) {
+      std::cerr << "Error: --pow2 expects a:b with 0 <= a <= b <= 30" << std::endl;
+      return 1;
+    }
+    for(int i = a; i <= b; i++)
+      sizes.push_back(1 << i);
+  }
+
+  if(vm.count("help") || sizes.empty()) {
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  const std::string kind = vm["kind"].as<std::string>();
+  if(kind != "complex" && kind != "real" && kind != "all") {
+    std::cerr << "Error: unknown kind " << kind << std::endl;
+    return 1;
+  }
+
+  const std::string rigor = vm["rigor"].as<std::string>();
+  if(rigor == "measure")
+    gr::fft::planner::set_rigor(gr::fft::planner::MEASURE);
+  else if(rigor == "patient")
+    gr::fft::planner::set_rigor(gr::fft::planner::PATIENT);
+  else if(rigor == "exhaustive")
+    gr::fft::planner::set_rigor(gr::fft::planner::EXHAUSTIVE);
+  else {
+    std::cerr << "Error: unknown rigor " << rigor << std::endl;
+    return 1;
+  }
+
+  std::vector<int> batches(1, 1);
+  if(vm.count("batch")) {
+    BOOST_FOREACH(int b, vm["batch"].as<std::vector<int> >())
+      batches.push_back(b);
+  }
+
+  const int nthreads = vm["threads"].as<int>();
+  const int reps = vm.count("benchmark") ? vm["benchmark"].as<int>() : 0;
+
+  try {
+    BOOST_FOREACH(int size, sizes) {
+      std::cout << "planning size " << size << std::flush;
+      if(kind != "real") {
+        BOOST_FOREACH(int batch, batches) {
+          gr::fft::fft_complex fwd(size, true, nthreads, batch);
+          gr::fft::fft_complex rev(size, false, nthreads, batch);
+        }
+        gr::fft::fft_complex_inplace fwd(size, true, nthreads);
+        gr::fft::fft_complex_inplace rev(size, false, nthreads);
+      }
+      if(kind != "complex") {
+        gr::fft::fft_real_fwd fwd(size, nthreads);
+        gr::fft::fft_real_rev rev(size, nthreads);
+      }
+      std::cout << std::endl;
+
+      if(reps > 0) {
+        // The plans are cached, so these reuse the ones just made.
+        if(kind != "real") {
+          std::vector<gr_complex> item(size, gr_complex(1, 0));
+          gr_complex *buf = gr::fft::malloc_complex(size);
+
+          gr::fft::fft_complex_inplace inplace(size, true, nthreads);
+          inplace_runner run(inplace, &item[0], buf, size);
+          report("complex in-place", size, time_execute(run, reps));
+
+          gr::fft::fft_complex fwd(size, true, nthreads);
+          copy_runner copy(fwd, &item[0], buf, size);
+          report("complex copying", size, time_execute(copy, reps));
+          gr::fft::free(buf);
+
+          std::fill(fwd.get_inbuf(), fwd.get_inbuf() + size, gr_complex(1, 0));
+          report("complex", size, time_execute(fwd, reps));
+        }
+        if(kind != "complex") {
+          gr::fft::fft_real_fwd fwd(size, nthreads);
+          std::fill(fwd.get_inbuf(), fwd.get_inbuf() + size, 1.0f);
+          report("real", size, time_execute(fwd, reps), 2.5);
+        }
+      }
+
+      // Save as we go so an interrupted run keeps what it has planned.
+      gr::fft::planner::export_wisdom();
+    }
+  }
+  catch(std::exception &e) {
+    std::cerr << std::endl << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
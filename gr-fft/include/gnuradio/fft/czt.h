@@ -0,0 +1,107 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_CZT_H
+#define INCLUDED_FFT_CZT_H
+
+#include <gnuradio/fft/api.h>
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+
+    /*!
+     * \brief Chirp-Z transform: DFT bins on an arbitrary frequency
+     * grid, computed with FFTs (zoom FFT)
+     * \ingroup misc
+     *
+     * \details
+     * Computes \p noutputs bins of the DFT of \p ninputs samples,
+     *
+     *   X[k] = sum_n w[n] x[n] exp(-2j pi (start + k step) n),
+     *
+     * where \p start and \p step are in cycles per sample and w is the
+     * window, if one is set. The bins can be spaced much closer than
+     * the 1/ninputs of an FFT, so a narrow span can be inspected at a
+     * fine resolution without transforming the whole band at that
+     * resolution.
+     *
+     * It uses Bluestein's algorithm: with nk = (n^2 + k^2 - (k-n)^2)/2
+     * the sum becomes a convolution with a chirp, done as one forward
+     * and one inverse FFT of fft_size() >= ninputs + noutputs - 1
+     * points. The chirps and the transformed convolution kernel are
+     * computed when the span is set, and vectors are transformed in
+     * batches like fft_complex's.
+     */
+    class FFT_API czt
+    {
+    public:
+      czt(int ninputs, int noutputs, double start, double step,
+          int nthreads=1);
+      ~czt();
+
+      int ninputs() const { return d_ninputs; }
+      int noutputs() const { return d_noutputs; }
+      int fft_size() const { return d_fft_size; }
+      double start() const { return d_start; }
+      double step() const { return d_step; }
+
+      //! Sets the first bin and the bin spacing, in cycles per sample.
+      void set_span(double start, double step);
+
+      //! Sets a window of ninputs() taps, or none if empty.
+      bool set_window(const std::vector<float> &window);
+
+      void set_nthreads(int n);
+      int nthreads() const;
+
+      /*!
+       * \brief Transforms \p nvectors vectors of ninputs() samples at
+       * \p in into as many vectors of noutputs() bins at \p out.
+       */
+      void execute(gr_complex out[], const gr_complex in[], int nvectors=1);
+
+    private:
+      int                d_ninputs;
+      int                d_noutputs;
+      int                d_fft_size;
+      double             d_start;
+      double             d_step;
+      std::vector<float> d_window;
+      fft_complex       *d_fwd;
+      fft_complex       *d_inv;
+      gr_complex        *d_pre;     // window times input chirp
+      gr_complex        *d_post;    // output chirp divided by fft_size
+      gr_complex        *d_kernel;  // FFT of the convolution chirp
+
+      void make_chirps();
+
+      czt(const czt&);
+      czt& operator=(const czt&);
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_CZT_H */
@@ -54,6 +54,16 @@ namespace gr {
     /*!
      * \brief Export reference to planner mutex for those apps that
      * want to use FFTW w/o using the fft_impl_fftw* classes.
+     *
+     * \details
+     * The FFT classes below share one FFTW plan per transform shape
+     * (size, direction, batch, alignment and number of threads),
+     * planned the first time any of them needs it, so constructing
+     * many FFT objects of the same size only plans once. The wisdom
+     * file (~/.gr_fftw_wisdom) is read before the first plan and
+     * written back once at exit, or when export_wisdom() is called,
+     * if any new plans were made. Use the gr_fftw_wisdom program to
+     * generate wisdom for a list of sizes ahead of time.
      */
     class FFT_API planner {
     public:
@@ -62,33 +72,71 @@ namespace gr {
        * Return reference to planner mutex
        */
       static boost::mutex &mutex();
+
+      //! How hard FFTW searches for a fast plan without wisdom.
+      enum rigor_t {
+        MEASURE = 0,
+        PATIENT,
+        EXHAUSTIVE
+      };
+
+      /*!
+       * Sets the rigor of plans made from now on; the default is
+       * MEASURE.
+       */
+      static void set_rigor(rigor_t rigor);
+
+      /*!
+       * Writes the wisdom file now if plans were made since it was
+       * last written.
+       */
+      static void export_wisdom();
     };
 
     /*!
      * \brief FFT: complex in, complex out
      * \ingroup misc
+     *
+     * With \p batch > 1 the buffers hold \p batch vectors of
+     * \p fft_size items back to back and a single FFTW plan
+     * transforms all of them, which is considerably faster than one
+     * execute() per vector for small FFT sizes.
      */
     class FFT_API fft_complex {
       int	      d_fft_size;
+      int         d_batch;
       int         d_nthreads;
+      bool        d_forward;
       gr_complex *d_inbuf;
       gr_complex *d_outbuf;
-      void	     *d_plan;
+      void	     *d_plan;       // all d_batch transforms
+      void	     *d_plan_one;   // a single transform, applied per vector
+
+      void make_plans();
 
     public:
-      fft_complex(int fft_size, bool forward = true, int nthreads=1);
+      fft_complex(int fft_size, bool forward = true, int nthreads=1,
+                  int batch=1);
       virtual ~fft_complex();
 
       /*
        * These return pointers to buffers owned by fft_impl_fft_complex
        * into which input and output take place. It's done this way in
        * order to ensure optimal alignment for SIMD instructions.
+       * Vector i of a batch starts at offset i * fft_size().
        */
       gr_complex *get_inbuf()  const { return d_inbuf; }
       gr_complex *get_outbuf() const { return d_outbuf; }
 
-      int inbuf_length()  const { return d_fft_size; }
-      int outbuf_length() const { return d_fft_size; }
+      int inbuf_length()  const { return d_fft_size * d_batch; }
+      int outbuf_length() const { return d_fft_size * d_batch; }
+
+      int fft_size() const { return d_fft_size; }
+
+      /*!
+       * Number of vectors the buffers hold and execute() transforms.
+       */
+      int batch() const { return d_batch; }
 
       /*!
        *  Set the number of threads to use for caclulation.
@@ -105,33 +153,109 @@ namespace gr {
        * outbuf.
        */
       void execute();
+
+      /*!
+       * Computes the FFT of the first \p nffts vectors of inbuf, at
+       * most batch(). Vectors past those may be overwritten.
+       */
+      void execute(int nffts);
+    };
+
+    /*!
+     * \brief In-place FFT of a caller's buffer: complex in, complex out
+     * \ingroup misc
+     *
+     * For very large transforms. It owns no buffers: execute()
+     * transforms the caller's buffer in place, so a block can copy
+     * (and window) its input straight into its output buffer and
+     * transform it there, instead of going through an input and an
+     * output buffer of its own.
+     *
+     * Measuring plans of LARGE_FFT_SIZE points or more takes minutes,
+     * so at the default MEASURE rigor they come from wisdom if there
+     * is any and are otherwise estimated; run gr_fftw_wisdom on the
+     * sizes in use to get measured plans. This applies to
+     * fft_complex of those sizes as well.
+     */
+    class FFT_API fft_complex_inplace {
+      int	  d_fft_size;
+      int         d_nthreads;
+      bool        d_forward;
+      void	 *d_plan;
+
+    public:
+      static const int LARGE_FFT_SIZE = 1 << 18;
+
+      fft_complex_inplace(int fft_size, bool forward = true, int nthreads=1);
+      virtual ~fft_complex_inplace();
+
+      int fft_size() const { return d_fft_size; }
+
+      /*!
+       *  Set the number of threads to use for caclulation.
+       */
+      void set_nthreads(int n);
+
+      /*!
+       *  Get the number of threads being used by FFTW
+       */
+      int nthreads() const { return d_nthreads; }
+
+      /*!
+       * True if \p buf is aligned the way execute() needs.
+       */
+      bool aligned(const gr_complex *buf) const;
+
+      /*!
+       * Transforms the fft_size() items at \p buf, which must be
+       * aligned(), in place.
+       */
+      void execute(gr_complex *buf);
     };
 
     /*!
      * \brief FFT: real in, complex out
      * \ingroup misc
+     *
+     * Computes the fft_size/2+1 non-negative frequency bins of the
+     * spectrum of a real vector; the others are their complex
+     * conjugates. With \p batch > 1 the input buffer holds \p batch
+     * vectors of \p fft_size floats and the output buffer \p batch
+     * spectra of fft_size/2+1 bins, transformed by one plan as in
+     * fft_complex.
      */
     class FFT_API fft_real_fwd {
       int	  d_fft_size;
+      int         d_batch;
       int         d_nthreads;
       float	 *d_inbuf;
       gr_complex *d_outbuf;
       void	 *d_plan;
+      void	 *d_plan_one;
 
     public:
-      fft_real_fwd (int fft_size, int nthreads=1);
+      fft_real_fwd (int fft_size, int nthreads=1, int batch=1);
       virtual ~fft_real_fwd ();
 
       /*
        * These return pointers to buffers owned by fft_impl_fft_real_fwd
        * into which input and output take place. It's done this way in
        * order to ensure optimal alignment for SIMD instructions.
+       * Vector i of a batch starts at offset i * inbuf_length() /
+       * batch() of inbuf and i * outbuf_length() / batch() of outbuf.
        */
       float *get_inbuf()      const { return d_inbuf; }
       gr_complex *get_outbuf() const { return d_outbuf; }
 
-      int inbuf_length()  const { return d_fft_size; }
-      int outbuf_length() const { return d_fft_size / 2 + 1; }
+      int inbuf_length()  const { return d_fft_size * d_batch; }
+      int outbuf_length() const { return (d_fft_size / 2 + 1) * d_batch; }
+
+      int fft_size() const { return d_fft_size; }
+
+      /*!
+       * Number of vectors the buffers hold and execute() transforms.
+       */
+      int batch() const { return d_batch; }
 
       /*!
        *  Set the number of threads to use for caclulation.
@@ -148,21 +272,34 @@ namespace gr {
        * outbuf.
        */
       void execute();
+
+      /*!
+       * Computes the FFT of the first \p nffts vectors of inbuf, at
+       * most batch(). Vectors past those may be overwritten.
+       */
+      void execute(int nffts);
     };
 
     /*!
      * \brief FFT: complex in, float out
      * \ingroup misc
+     *
+     * The inverse of fft_real_fwd: takes the fft_size/2+1
+     * non-negative frequency bins of a conjugate symmetric spectrum.
+     * Batches are laid out as in fft_real_fwd, with the input and
+     * output sides swapped. execute() overwrites the input.
      */
     class FFT_API fft_real_rev {
       int	      d_fft_size;
+      int         d_batch;
       int         d_nthreads;
       gr_complex *d_inbuf;
       float	     *d_outbuf;
       void	     *d_plan;
+      void	     *d_plan_one;
 
     public:
-      fft_real_rev(int fft_size, int nthreads=1);
+      fft_real_rev(int fft_size, int nthreads=1, int batch=1);
       virtual ~fft_real_rev();
 
       /*
@@ -173,8 +310,15 @@ namespace gr {
       gr_complex *get_inbuf() const { return d_inbuf; }
       float *get_outbuf() const { return d_outbuf; }
 
-      int inbuf_length()  const { return d_fft_size / 2 + 1; }
-      int outbuf_length() const { return d_fft_size; }
+      int inbuf_length()  const { return (d_fft_size / 2 + 1) * d_batch; }
+      int outbuf_length() const { return d_fft_size * d_batch; }
+
+      int fft_size() const { return d_fft_size; }
+
+      /*!
+       * Number of vectors the buffers hold and execute() transforms.
+       */
+      int batch() const { return d_batch; }
 
       /*!
        *  Set the number of threads to use for caclulation.
@@ -191,6 +335,12 @@ namespace gr {
        * outbuf.
        */
       void execute();
+
+      /*!
+       * Computes the FFT of the first \p nffts vectors of inbuf, at
+       * most batch(). Vectors past those may be overwritten.
+       */
+      void execute(int nffts);
     };
 
   } /* namespace fft */
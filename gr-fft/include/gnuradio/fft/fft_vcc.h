@@ -32,6 +32,14 @@ namespace gr {
     /*!
      * \brief Compute forward or reverse FFT. complex vector in / complex vector out.
      * \ingroup fourier_analysis_blk
+     *
+     * \details
+     * Sizes of gr::fft::fft_complex_inplace::LARGE_FFT_SIZE (2^18)
+     * points or more are windowed while they are copied into the
+     * output buffer and transformed there in place, using no buffers
+     * of the block's own. Use \p nthreads to spread such transforms
+     * over several cores, and gr_fftw_wisdom to plan and benchmark
+     * the sizes in use.
      */
     class FFT_API fft_vcc : virtual public sync_block
     {
@@ -0,0 +1,106 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_GOERTZEL_BANK_H
+#define INCLUDED_FFT_GOERTZEL_BANK_H
+
+#include <gnuradio/fft/api.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+
+    /*!
+     * \brief Goertzel DFT calculation of a list of bins at once
+     * \ingroup misc
+     *
+     * \details
+     * Computes for every frequency in the list the same output as a
+     * gr::fft::goertzel of that frequency, in one pass over the
+     * input. The recursions of all the bins are updated together, a
+     * block of bins at a time kept in registers, in loops the
+     * compiler vectorizes.
+     *
+     * sliding() computes overlapping windows: the first window is
+     * computed with the Goertzel recursion and each following one is
+     * updated from the previous one sample by sample (a sliding
+     * DFT), which costs a few operations per sample and bin instead
+     * of \p len per window. The sliding update is recomputed from
+     * scratch every \p len samples so rounding errors cannot build
+     * up.
+     */
+    class FFT_API goertzel_bank
+    {
+    public:
+      goertzel_bank(int rate, int len, const std::vector<float> &freqs);
+
+      void set_params(int rate, int len, const std::vector<float> &freqs);
+
+      unsigned int nbins() const { return d_freqs.size(); }
+      int len() const { return d_len; }
+      std::vector<float> freqs() const { return d_freqs; }
+
+      //! Writes the nbins() outputs of the window \p in[0..len()-1].
+      void batch(gr_complex out[], const float in[]);
+
+      /*!
+       * \brief Writes the nbins() outputs of each of \p n windows
+       * \p step samples apart; window i is \p in[i*step ..
+       * i*step+len()-1].
+       */
+      void sliding(gr_complex out[], const float in[], int n, int step);
+
+      // Process sample by sample
+      void input(const float &in);
+      void output(gr_complex out[]);
+      bool ready() const { return d_processed == d_len; }
+
+    private:
+      int                d_rate;
+      int                d_len;
+      std::vector<float> d_freqs;
+      unsigned int       d_nlanes;   // nbins() padded for the blocked loops
+
+      // Goertzel coefficients and state, one per lane
+      std::vector<float> d_wr;
+      std::vector<float> d_wi;
+      std::vector<float> d_d1;
+      std::vector<float> d_d2;
+      int                d_processed;
+
+      // Sliding DFT rotations e^jw and e^jw*len, and outputs
+      std::vector<float> d_rot_r;
+      std::vector<float> d_rot_i;
+      std::vector<float> d_wrap_r;
+      std::vector<float> d_wrap_i;
+      std::vector<float> d_yr;
+      std::vector<float> d_yi;
+
+      void run(const float in[], int n);
+      void slide(const float in[], int n);
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_GOERTZEL_BANK_H */
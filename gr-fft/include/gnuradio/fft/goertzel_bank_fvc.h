@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_GOERTZEL_BANK_FVC_H
+#define INCLUDED_FFT_GOERTZEL_BANK_FVC_H
+
+#include <gnuradio/fft/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+
+    /*!
+     * \brief Goertzel DFT of a list of frequencies over sliding windows.
+     * \ingroup fourier_analysis_blk
+     *
+     * \details
+     * Every \p step input samples, outputs a vector of the
+     * len(freqs) bins computed over the last \p len input samples,
+     * each the same value goertzel_fc computes for that frequency.
+     * Output i covers the inputs up to (i+1)*step - 1. With \p step
+     * equal to \p len the windows do not overlap and the outputs line
+     * up with those of goertzel_fc; a smaller \p step gives
+     * overlapping windows.
+     *
+     * All the bins are computed together by gr::fft::goertzel_bank,
+     * and heavily overlapping windows are updated with a sliding DFT
+     * instead of being recomputed.
+     */
+    class FFT_API goertzel_bank_fvc : virtual public sync_decimator
+    {
+    public:
+
+      // gr::fft::goertzel_bank_fvc::sptr
+      typedef boost::shared_ptr<goertzel_bank_fvc> sptr;
+
+      /*!
+       * \param rate sample rate of the input
+       * \param len number of samples in each window
+       * \param freqs frequencies of the bins, in Hz
+       * \param step number of input samples between outputs
+       */
+      static sptr make(int rate, int len, const std::vector<float> &freqs,
+                       int step);
+
+      //! Changes the frequencies; the number of bins cannot change.
+      virtual void set_freqs(const std::vector<float> &freqs) = 0;
+
+      virtual void set_rate(int rate) = 0;
+
+      virtual std::vector<float> freqs() = 0;
+
+      virtual int rate() = 0;
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_GOERTZEL_BANK_FVC_H */
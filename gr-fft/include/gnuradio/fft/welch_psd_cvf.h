@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_WELCH_PSD_CVF_H
+#define INCLUDED_FFT_WELCH_PSD_CVF_H
+
+#include <gnuradio/fft/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+
+    /*!
+     * \brief Averaged power spectrum of overlapping windowed FFTs
+     * (Welch's method).
+     * \ingroup fourier_analysis_blk
+     *
+     * \details
+     * Takes an FFT of \p fft_size samples every \p step input
+     * samples, each frame ending on the last sample of its step, and
+     * averages the magnitude squared of \p nframes frames into each
+     * output vector; there is one output every \p step * \p nframes
+     * input samples.
+     *
+     * With \p alpha 0 each output is the mean of its own frames. With
+     * \p alpha in (0, 1] the frames go through a single pole average,
+     *
+     *   avg = alpha * |X|^2 + (1 - alpha) * avg,
+     *
+     * that runs on across outputs, and every \p nframes frame the
+     * current average is output.
+     *
+     * The output is the same as fft_vcc, complex_to_mag_squared and
+     * either an integrate (divided by \p nframes) or a
+     * single_pole_iir_filter_ff kept every \p nframes vectors, but the
+     * frames are transformed in batches, the magnitudes are computed
+     * a whole batch at a time, and only the outputs are shifted and
+     * copied out. Divide by the sum of the squared window taps to get
+     * a power spectral density.
+     */
+    class FFT_API welch_psd_cvf : virtual public sync_decimator
+    {
+    public:
+
+      // gr::fft::welch_psd_cvf::sptr
+      typedef boost::shared_ptr<welch_psd_cvf> sptr;
+
+      /*!
+       * \param fft_size number of samples in each frame
+       * \param window window applied to each frame, or empty
+       * \param step number of input samples between frames
+       * \param nframes number of frames per output
+       * \param alpha 0 for a mean of each output's frames, else the
+       *              single pole averaging constant
+       * \param shift put the DC bin in the middle of the output
+       * \param nthreads number of threads the FFT uses
+       */
+      static sptr make(int fft_size, const std::vector<float> &window,
+                       int step, int nframes, float alpha=0,
+                       bool shift=false, int nthreads=1);
+
+      virtual bool set_window(const std::vector<float> &window) = 0;
+
+      //! Changes the averaging constant, see above.
+      virtual void set_alpha(float alpha) = 0;
+      virtual float alpha() const = 0;
+
+      virtual void set_nthreads(int n) = 0;
+      virtual int nthreads() const = 0;
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_WELCH_PSD_CVF_H */
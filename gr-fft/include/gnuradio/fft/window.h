@@ -299,6 +299,10 @@ namespace gr {
        * \brief Build a window using gr::fft::win_type to index the
        * type of window desired.
        *
+       * The most recently built windows are cached, so rebuilding a
+       * window, e.g. when a GUI sink changes its FFT size back and
+       * forth, is a copy.
+       *
        * \param type a gr::fft::win_type index for the type of window.
        * \param ntaps Number of coefficients in the window.
        * \param beta Used only for building Kaiser windows.
@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_ZOOM_FFT_VCC_H
+#define INCLUDED_FFT_ZOOM_FFT_VCC_H
+
+#include <gnuradio/fft/api.h>
+#include <gnuradio/sync_block.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+
+    /*!
+     * \brief Zoom FFT: a fine resolution spectrum of a narrow band.
+     * complex vector in / complex vector out.
+     * \ingroup fourier_analysis_blk
+     *
+     * \details
+     * Transforms each vector of \p vlen samples into \p nbins bins
+     * evenly spaced over \p bandwidth around \p center_freq, laid out
+     * like the shifted output of fft_vcc: bin k is at
+     *
+     *   center_freq - bandwidth/2 + k * bandwidth/nbins.
+     *
+     * The bins are the exact DFT of the (windowed) vector at those
+     * frequencies, computed with a chirp-Z transform (gr::fft::czt)
+     * in two FFTs of about \p vlen + \p nbins points. Getting the same
+     * resolution from fft_vcc takes an FFT of \p nbins * samp_rate /
+     * \p bandwidth points, or a freq_xlating_fir_filter and a
+     * decimation in front of it.
+     */
+    class FFT_API zoom_fft_vcc : virtual public sync_block
+    {
+    public:
+
+      // gr::fft::zoom_fft_vcc::sptr
+      typedef boost::shared_ptr<zoom_fft_vcc> sptr;
+
+      /*!
+       * \param vlen number of samples in each input vector
+       * \param nbins number of bins in each output vector
+       * \param samp_rate sample rate, in the units of the frequencies
+       * \param center_freq frequency of the middle of the band
+       * \param bandwidth width of the band the bins span
+       * \param window window applied to each vector, or empty
+       * \param nthreads number of threads the FFTs use
+       */
+      static sptr make(int vlen, int nbins, double samp_rate,
+                       double center_freq, double bandwidth,
+                       const std::vector<float> &window,
+                       int nthreads=1);
+
+      virtual void set_center_freq(double center_freq) = 0;
+      virtual double center_freq() const = 0;
+
+      virtual void set_bandwidth(double bandwidth) = 0;
+      virtual double bandwidth() const = 0;
+
+      virtual bool set_window(const std::vector<float> &window) = 0;
+
+      virtual void set_nthreads(int n) = 0;
+      virtual int nthreads() const = 0;
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_ZOOM_FFT_VCC_H */
@@ -0,0 +1,196 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/fft/czt.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+  namespace fft {
+
+    // Items transformed per execute; small FFTs are batched up to this.
+    static const int BATCH_ITEMS = 16384;
+
+    // Smallest size >= n with no prime factor above 7, which FFTW
+    // transforms about as fast as a power of 2.
+    static int
+    fast_size(int n)
+    {
+      for(;; n++) {
+        int m = n;
+        const int primes[] = {2, 3, 5, 7};
+        for(int i = 0; i < 4; i++)
+          while(m % primes[i] == 0)
+            m /= primes[i];
+        if(m == 1)
+          return n;
+      }
+    }
+
+    // exp(-2j pi cycles), with cycles reduced first so large
+    // arguments keep their precision.
+    static gr_complex
+    phasor(double cycles)
+    {
+      double c = 2*M_PI*(cycles - std::floor(cycles));
+      return gr_complex(std::cos(c), -std::sin(c));
+    }
+
+    czt::czt(int ninputs, int noutputs, double start, double step,
+             int nthreads)
+      : d_ninputs(ninputs), d_noutputs(noutputs),
+        d_start(start), d_step(step),
+        d_fwd(NULL), d_inv(NULL),
+        d_pre(NULL), d_post(NULL), d_kernel(NULL)
+    {
+      if(ninputs <= 0 || noutputs <= 0)
+        throw std::out_of_range("czt: ninputs and noutputs must be > 0");
+
+      d_fft_size = fast_size(ninputs + noutputs - 1);
+      int batch = std::max(1, BATCH_ITEMS / d_fft_size);
+      d_fwd = new fft_complex(d_fft_size, true, nthreads, batch);
+      d_inv = new fft_complex(d_fft_size, false, nthreads, batch);
+
+      size_t align = volk_get_alignment();
+      d_pre = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_ninputs, align);
+      d_post = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_noutputs, align);
+      d_kernel = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_fft_size, align);
+
+      make_chirps();
+    }
+
+    czt::~czt()
+    {
+      delete d_fwd;
+      delete d_inv;
+      volk_free(d_pre);
+      volk_free(d_post);
+      volk_free(d_kernel);
+    }
+
+    void
+    czt::set_span(double start, double step)
+    {
+      d_start = start;
+      d_step = step;
+      make_chirps();
+    }
+
+    bool
+    czt::set_window(const std::vector<float> &window)
+    {
+      if(window.size() != 0 && (int)window.size() != d_ninputs)
+        return false;
+
+      d_window = window;
+      make_chirps();
+      return true;
+    }
+
+    void
+    czt::set_nthreads(int n)
+    {
+      d_fwd->set_nthreads(n);
+      d_inv->set_nthreads(n);
+    }
+
+    int
+    czt::nthreads() const
+    {
+      return d_fwd->nthreads();
+    }
+
+    /*
+     * With nk = (n^2 + k^2 - (k-n)^2)/2,
+     *
+     *   X[k] = post[k] sum_n pre[n] x[n] v[k-n]
+     *
+     * for pre[n] = w[n] exp(-2j pi (start n + step n^2/2)),
+     * post[k] = exp(-2j pi step k^2/2) and v[m] = exp(2j pi step m^2/2),
+     * m = -(ninputs-1) .. noutputs-1. The kernel is v wrapped around
+     * fft_size() points, so the circular convolution of the
+     * zero-padded input with it is the linear one at the outputs.
+     */
+    void
+    czt::make_chirps()
+    {
+      for(int n = 0; n < d_ninputs; n++) {
+        double nn = (double)n*n;
+        d_pre[n] = phasor(d_start*n + 0.5*d_step*nn);
+        if(d_window.size())
+          d_pre[n] *= d_window[n];
+      }
+
+      // The inverse FFT is not normalized; take that out here.
+      for(int k = 0; k < d_noutputs; k++)
+        d_post[k] = phasor(0.5*d_step*((double)k*k)) / (float)d_fft_size;
+
+      gr_complex *v = d_fwd->get_inbuf();
+      std::fill(v, v + d_fft_size, gr_complex(0, 0));
+      for(int m = 0; m < d_noutputs; m++)
+        v[m] = phasor(-0.5*d_step*((double)m*m));
+      for(int m = 1; m < d_ninputs; m++)
+        v[d_fft_size - m] = phasor(-0.5*d_step*((double)m*m));
+
+      d_fwd->execute(1);
+      memcpy(d_kernel, d_fwd->get_outbuf(), sizeof(gr_complex)*d_fft_size);
+    }
+
+    void
+    czt::execute(gr_complex out[], const gr_complex in[], int nvectors)
+    {
+      while(nvectors > 0) {
+        int n = std::min(d_fwd->batch(), nvectors);
+
+        for(int i = 0; i < n; i++) {
+          gr_complex *x = d_fwd->get_inbuf() + i*d_fft_size;
+          volk_32fc_x2_multiply_32fc(x, &in[i*d_ninputs], d_pre, d_ninputs);
+          std::fill(x + d_ninputs, x + d_fft_size, gr_complex(0, 0));
+        }
+        d_fwd->execute(n);
+
+        for(int i = 0; i < n; i++)
+          volk_32fc_x2_multiply_32fc(d_inv->get_inbuf() + i*d_fft_size,
+                                     d_fwd->get_outbuf() + i*d_fft_size,
+                                     d_kernel, d_fft_size);
+        d_inv->execute(n);
+
+        for(int i = 0; i < n; i++)
+          volk_32fc_x2_multiply_32fc(&out[i*d_noutputs],
+                                     d_inv->get_outbuf() + i*d_fft_size,
+                                     d_post, d_noutputs);
+
+        in += n*d_ninputs;
+        out += n*d_noutputs;
+        nvectors -= n;
+      }
+    }
+
+  } /* namespace fft */
+} /* namespace gr */
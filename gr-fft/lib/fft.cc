@@ -41,10 +41,15 @@ static int my_fftw_read_char(void *f) { return fgetc((FILE *) f); }
 #include <string.h>
 #include <stdio.h>
 #include <cassert>
+#include <cstdlib>
 #include <stdexcept>
+#include <string>
+#include <map>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 namespace fs = boost::filesystem;
 
 namespace gr {
@@ -82,24 +87,64 @@ namespace gr {
       return s_planning_mutex;
     }
 
-    static const char *
+    static std::string
     wisdom_filename()
     {
-      static fs::path path;
-      path = fs::path(gr::appdata_path()) / ".gr_fftw_wisdom";
-      return path.string().c_str();
+      fs::path path = fs::path(gr::appdata_path()) / ".gr_fftw_wisdom";
+      return path.string();
     }
 
+    // Plans made since the wisdom was last written out.
+    static bool s_wisdom_dirty = false;
+
+    static planner::rigor_t s_rigor = planner::MEASURE;
+
+    // Called with the planner mutex held.
+    static void
+    export_wisdom_locked()
+    {
+      if (!s_wisdom_dirty)
+	return;
+      s_wisdom_dirty = false;
+
+      const std::string filename = wisdom_filename ();
+      FILE *fp = fopen (filename.c_str(), "w");
+      if (fp != 0){
+	fftwf_export_wisdom_to_file (fp);
+	fclose (fp);
+      }
+      else {
+	fprintf (stderr, "fft_impl_fftw: ");
+	perror (filename.c_str());
+      }
+    }
+
+    static void
+    export_wisdom_at_exit()
+    {
+      planner::scoped_lock lock(planner::mutex());
+      export_wisdom_locked();
+    }
+
+    // Called with the planner mutex held. The wisdom file is read
+    // once per process; new wisdom is written once, at exit or on
+    // planner::export_wisdom(), instead of after every plan.
     static void
     import_wisdom()
     {
-      const char *filename = wisdom_filename ();
-      FILE *fp = fopen (filename, "r");
+      static bool imported = false;
+      if (imported)
+	return;
+      imported = true;
+      std::atexit(export_wisdom_at_exit);
+
+      const std::string filename = wisdom_filename ();
+      FILE *fp = fopen (filename.c_str(), "r");
       if (fp != 0){
 	int r = fftwf_import_wisdom_from_file (fp);
 	fclose (fp);
 	if (!r){
-	  fprintf (stderr, "gr::fft: can't import wisdom from %s\n", filename);
+	  fprintf (stderr, "gr::fft: can't import wisdom from %s\n", filename.c_str());
 	}
       }
     }
@@ -120,34 +165,159 @@ namespace gr {
 #endif
     }
 
-    static void
-    export_wisdom()
+    void
+    planner::set_rigor(rigor_t rigor)
     {
-      const char *filename = wisdom_filename ();
-      FILE *fp = fopen (filename, "w");
-      if (fp != 0){
-	fftwf_export_wisdom_to_file (fp);
-	fclose (fp);
+      scoped_lock lock(mutex());
+      s_rigor = rigor;
+    }
+
+    void
+    planner::export_wisdom()
+    {
+      scoped_lock lock(mutex());
+      export_wisdom_locked();
+    }
+
+    enum plan_kind_t {
+      PLAN_C2C_FORWARD = 0,
+      PLAN_C2C_BACKWARD,
+      PLAN_R2C,
+      PLAN_C2R,
+      PLAN_C2C_FORWARD_INPLACE,
+      PLAN_C2C_BACKWARD_INPLACE
+    };
+
+    static fftwf_plan
+    make_plan(plan_kind_t kind, int fft_size, int batch,
+	      fftwf_complex *in, fftwf_complex *out, unsigned flags)
+    {
+      fftwf_plan plan = NULL;
+      switch (kind) {
+      case PLAN_C2C_FORWARD:
+      case PLAN_C2C_BACKWARD:
+	plan = fftwf_plan_many_dft (1, &fft_size, batch,
+				    in, NULL, 1, fft_size,
+				    out, NULL, 1, fft_size,
+				    kind == PLAN_C2C_FORWARD ? FFTW_FORWARD : FFTW_BACKWARD,
+				    flags);
+	break;
+      case PLAN_R2C:
+	plan = fftwf_plan_many_dft_r2c (1, &fft_size, batch,
+					(float *) in, NULL, 1, fft_size,
+					out, NULL, 1, fft_size / 2 + 1,
+					flags);
+	break;
+      case PLAN_C2R:
+	plan = fftwf_plan_many_dft_c2r (1, &fft_size, batch,
+					in, NULL, 1, fft_size / 2 + 1,
+					(float *) out, NULL, 1, fft_size,
+					flags);
+	break;
+      case PLAN_C2C_FORWARD_INPLACE:
+      case PLAN_C2C_BACKWARD_INPLACE:
+	plan = fftwf_plan_dft_1d (fft_size, in, in,
+				  kind == PLAN_C2C_FORWARD_INPLACE ? FFTW_FORWARD : FFTW_BACKWARD,
+				  flags);
+	break;
       }
-      else {
-	fprintf (stderr, "fft_impl_fftw: ");
-	perror (filename);
+      return plan;
+    }
+
+    // (kind, size, batch, unaligned, nthreads)
+    typedef boost::tuple<int, int, int, bool, int> plan_key_t;
+
+    /*
+     * Returns the process-wide plan for a transform, planning it the
+     * first time it is asked for. Plans are made on scratch buffers
+     * and only run with the new-array execute functions, which are
+     * thread-safe, so every FFT object of the same shape shares one
+     * plan and planning never overwrites an object's buffers.
+     * Called with the planner mutex held.
+     */
+    static fftwf_plan
+    cached_plan(plan_kind_t kind, int fft_size, int batch,
+		bool unaligned, int nthreads)
+    {
+      typedef std::map<plan_key_t, fftwf_plan> plan_map_t;
+      static plan_map_t plans;
+
+      plan_key_t key(kind, fft_size, batch, unaligned, nthreads);
+      plan_map_t::const_iterator it = plans.find(key);
+      if (it != plans.end())
+	return it->second;
+
+      // Wisdom made with threads only imports once FFTW's threads are
+      // initialized.
+      config_threading(nthreads);
+      import_wisdom();	// load prior wisdom from disk
+
+      unsigned flags = FFTW_MEASURE;
+      if (s_rigor == planner::PATIENT)
+	flags = FFTW_PATIENT;
+      else if (s_rigor == planner::EXHAUSTIVE)
+	flags = FFTW_EXHAUSTIVE;
+      if (unaligned)
+	flags |= FFTW_UNALIGNED;
+
+      // Measuring a large plan takes minutes; use wisdom if there is
+      // some, else estimate. Explicitly higher rigor still measures.
+      const bool large = fft_size >= fft_complex_inplace::LARGE_FFT_SIZE &&
+	s_rigor == planner::MEASURE;
+
+      // A complex buffer is large enough for the real side of the
+      // real transforms too.
+      const bool inplace =
+	kind == PLAN_C2C_FORWARD_INPLACE || kind == PLAN_C2C_BACKWARD_INPLACE;
+      int length = fft_size * batch;
+      fftwf_complex *in = (fftwf_complex *) fftwf_malloc (sizeof (fftwf_complex) * length);
+      fftwf_complex *out = inplace ? in :
+	(fftwf_complex *) fftwf_malloc (sizeof (fftwf_complex) * length);
+      if (in == 0 || out == 0){
+	fftwf_free (in);
+	if (!inplace)
+	  fftwf_free (out);
+	throw std::runtime_error ("fftwf_malloc");
       }
+
+      fftwf_plan plan;
+      if (large) {
+	plan = make_plan(kind, fft_size, batch, in, out, flags | FFTW_WISDOM_ONLY);
+	if (plan == NULL)
+	  plan = make_plan(kind, fft_size, batch, in, out, flags | FFTW_ESTIMATE);
+      }
+      else
+	plan = make_plan(kind, fft_size, batch, in, out, flags);
+
+      fftwf_free (in);
+      if (!inplace)
+	fftwf_free (out);
+
+      if (plan == NULL) {
+	fprintf(stderr, "gr::fft: error creating plan\n");
+	throw std::runtime_error ("gr::fft: FFTW planning failed");
+      }
+
+      s_wisdom_dirty = true;
+      plans[key] = plan;
+      return plan;
     }
 
 // ----------------------------------------------------------------
 
-    fft_complex::fft_complex(int fft_size, bool forward, int nthreads)
+    fft_complex::fft_complex(int fft_size, bool forward, int nthreads,
+                             int batch)
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
       assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
       if (fft_size <= 0)
 	throw std::out_of_range ("fft_impl_fftw: invalid fft_size");
+      if (batch <= 0)
+	throw std::out_of_range ("fft_impl_fftw: invalid batch");
 
       d_fft_size = fft_size;
+      d_batch = batch;
+      d_forward = forward;
       d_inbuf = (gr_complex *) fftwf_malloc (sizeof (gr_complex) * inbuf_length ());
       if (d_inbuf == 0)
 	throw std::runtime_error ("fftwf_malloc");
@@ -159,28 +329,33 @@ namespace gr {
       }
 
       d_nthreads = nthreads;
-      config_threading(nthreads);
-      import_wisdom();	// load prior wisdom from disk
+      make_plans();
+    }
 
-      d_plan = fftwf_plan_dft_1d (fft_size,
-				  reinterpret_cast<fftwf_complex *>(d_inbuf),
-				  reinterpret_cast<fftwf_complex *>(d_outbuf),
-				  forward ? FFTW_FORWARD : FFTW_BACKWARD,
-				  FFTW_MEASURE);
+    void
+    fft_complex::make_plans()
+    {
+      // Hold global mutex while planning.
+      planner::scoped_lock lock(planner::mutex());
 
-      if (d_plan == NULL) {
-	fprintf(stderr, "gr::fft: error creating plan\n");
-	throw std::runtime_error ("fftwf_plan_dft_1d failed");
+      plan_kind_t kind = d_forward ? PLAN_C2C_FORWARD : PLAN_C2C_BACKWARD;
+      d_plan = cached_plan(kind, d_fft_size, d_batch, false, d_nthreads);
+
+      // Partial batches run a single-vector plan on each vector in
+      // place. Vectors after the first are only as aligned as the
+      // vector size allows, so the plan must not assume more.
+      d_plan_one = d_plan;
+      if (d_batch > 1) {
+	bool unaligned =
+	  fftwf_alignment_of ((float *) (d_inbuf + d_fft_size)) != 0 ||
+	  fftwf_alignment_of ((float *) (d_outbuf + d_fft_size)) != 0;
+	d_plan_one = cached_plan(kind, d_fft_size, 1, unaligned, d_nthreads);
       }
-      export_wisdom();	// store new wisdom to disk
     }
 
     fft_complex::~fft_complex()
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
-      fftwf_destroy_plan ((fftwf_plan) d_plan);
+      // The plans belong to the plan cache.
       fftwf_free (d_inbuf);
       fftwf_free (d_outbuf);
     }
@@ -191,31 +366,94 @@ namespace gr {
       if (n <= 0)
 	throw std::out_of_range ("gr::fft: invalid number of threads");
       d_nthreads = n;
-
-#ifdef FFTW3F_THREADS
-      fftwf_plan_with_nthreads(d_nthreads);
-#endif
+      make_plans();
     }
 
     void
     fft_complex::execute()
     {
-      fftwf_execute((fftwf_plan) d_plan);
+      fftwf_execute_dft ((fftwf_plan) d_plan,
+			 reinterpret_cast<fftwf_complex *>(d_inbuf),
+			 reinterpret_cast<fftwf_complex *>(d_outbuf));
+    }
+
+    void
+    fft_complex::execute(int nffts)
+    {
+      // Past half a batch, transforming the unused vectors as well
+      // is cheaper than running the single-vector plan.
+      if (2 * nffts > d_batch) {
+	execute();
+	return;
+      }
+
+      for (int i = 0; i < nffts; i++) {
+	fftwf_execute_dft ((fftwf_plan) d_plan_one,
+			   reinterpret_cast<fftwf_complex *>(d_inbuf + i * d_fft_size),
+			   reinterpret_cast<fftwf_complex *>(d_outbuf + i * d_fft_size));
+      }
     }
 
 // ----------------------------------------------------------------
 
-    fft_real_fwd::fft_real_fwd (int fft_size, int nthreads)
+    fft_complex_inplace::fft_complex_inplace(int fft_size, bool forward,
+					     int nthreads)
     {
-      // Hold global mutex during plan construction and destruction.
+      assert (sizeof (fftwf_complex) == sizeof (gr_complex));
+
+      if (fft_size <= 0)
+	throw std::out_of_range ("gr::fft::fft_complex_inplace: invalid fft_size");
+
+      d_fft_size = fft_size;
+      d_forward = forward;
+      set_nthreads(nthreads);
+    }
+
+    fft_complex_inplace::~fft_complex_inplace()
+    {
+      // The plan belongs to the plan cache.
+    }
+
+    void
+    fft_complex_inplace::set_nthreads(int n)
+    {
+      if (n <= 0)
+	throw std::out_of_range ("gr::fft::fft_complex_inplace::set_nthreads: invalid number of threads");
+      d_nthreads = n;
+
       planner::scoped_lock lock(planner::mutex());
+      d_plan = cached_plan(d_forward ? PLAN_C2C_FORWARD_INPLACE : PLAN_C2C_BACKWARD_INPLACE,
+			   d_fft_size, 1, false, d_nthreads);
+    }
 
+    bool
+    fft_complex_inplace::aligned(const gr_complex *buf) const
+    {
+      // The plan was made on an fftwf_malloc'ed buffer.
+      return fftwf_alignment_of ((float *) buf) == 0;
+    }
+
+    void
+    fft_complex_inplace::execute(gr_complex *buf)
+    {
+      fftwf_execute_dft ((fftwf_plan) d_plan,
+			 reinterpret_cast<fftwf_complex *>(buf),
+			 reinterpret_cast<fftwf_complex *>(buf));
+    }
+
+// ----------------------------------------------------------------
+
+    fft_real_fwd::fft_real_fwd (int fft_size, int nthreads, int batch)
+    {
       assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
       if (fft_size <= 0)
 	throw std::out_of_range ("gr::fft: invalid fft_size");
+      if (batch <= 0)
+	throw std::out_of_range ("gr::fft: invalid batch");
 
       d_fft_size = fft_size;
+      d_batch = batch;
       d_inbuf = (float *) fftwf_malloc (sizeof (float) * inbuf_length ());
       if (d_inbuf == 0)
 	throw std::runtime_error ("fftwf_malloc");
@@ -226,28 +464,12 @@ namespace gr {
 	throw std::runtime_error ("fftwf_malloc");
       }
 
-      d_nthreads = nthreads;
-      config_threading(nthreads);
-      import_wisdom();	// load prior wisdom from disk
-
-      d_plan = fftwf_plan_dft_r2c_1d (fft_size,
-				      d_inbuf,
-				      reinterpret_cast<fftwf_complex *>(d_outbuf),
-				      FFTW_MEASURE);
-
-      if (d_plan == NULL) {
-	fprintf(stderr, "gr::fft::fft_real_fwd: error creating plan\n");
-	throw std::runtime_error ("fftwf_plan_dft_r2c_1d failed");
-      }
-      export_wisdom();	// store new wisdom to disk
+      set_nthreads(nthreads);
     }
 
     fft_real_fwd::~fft_real_fwd()
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
-      fftwf_destroy_plan ((fftwf_plan) d_plan);
+      // The plans belong to the plan cache.
       fftwf_free (d_inbuf);
       fftwf_free (d_outbuf);
     }
@@ -259,30 +481,54 @@ namespace gr {
 	throw std::out_of_range ("gr::fft::fft_real_fwd::set_nthreads: invalid number of threads");
       d_nthreads = n;
 
-#ifdef FFTW3F_THREADS
-      fftwf_plan_with_nthreads(d_nthreads);
-#endif
+      planner::scoped_lock lock(planner::mutex());
+      d_plan = cached_plan(PLAN_R2C, d_fft_size, d_batch, false, d_nthreads);
+
+      // See fft_complex::make_plans()
+      d_plan_one = d_plan;
+      if (d_batch > 1) {
+	bool unaligned =
+	  fftwf_alignment_of (d_inbuf + d_fft_size) != 0 ||
+	  fftwf_alignment_of ((float *) (d_outbuf + d_fft_size / 2 + 1)) != 0;
+	d_plan_one = cached_plan(PLAN_R2C, d_fft_size, 1, unaligned, d_nthreads);
+      }
     }
 
     void
     fft_real_fwd::execute()
     {
-      fftwf_execute ((fftwf_plan) d_plan);
+      fftwf_execute_dft_r2c ((fftwf_plan) d_plan, d_inbuf,
+			     reinterpret_cast<fftwf_complex *>(d_outbuf));
+    }
+
+    void
+    fft_real_fwd::execute(int nffts)
+    {
+      if (2 * nffts > d_batch) {
+	execute();
+	return;
+      }
+
+      for (int i = 0; i < nffts; i++) {
+	fftwf_execute_dft_r2c ((fftwf_plan) d_plan_one,
+			       d_inbuf + i * d_fft_size,
+			       reinterpret_cast<fftwf_complex *>(d_outbuf + i * (d_fft_size / 2 + 1)));
+      }
     }
 
     // ----------------------------------------------------------------
 
-    fft_real_rev::fft_real_rev(int fft_size, int nthreads)
+    fft_real_rev::fft_real_rev(int fft_size, int nthreads, int batch)
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
       assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
       if (fft_size <= 0)
 	throw std::out_of_range ("gr::fft::fft_real_rev: invalid fft_size");
+      if (batch <= 0)
+	throw std::out_of_range ("gr::fft::fft_real_rev: invalid batch");
 
       d_fft_size = fft_size;
+      d_batch = batch;
       d_inbuf = (gr_complex *) fftwf_malloc (sizeof (gr_complex) * inbuf_length ());
       if (d_inbuf == 0)
 	throw std::runtime_error ("fftwf_malloc");
@@ -293,31 +539,12 @@ namespace gr {
 	throw std::runtime_error ("fftwf_malloc");
       }
 
-      d_nthreads = nthreads;
-      config_threading(nthreads);
-      import_wisdom();	// load prior wisdom from disk
-
-      // FIXME If there's ever a chance that the planning functions
-      // will be called in multiple threads, we've got to ensure single
-      // threaded access.  They are not thread-safe.
-      d_plan = fftwf_plan_dft_c2r_1d (fft_size,
-				      reinterpret_cast<fftwf_complex *>(d_inbuf),
-				      d_outbuf,
-				      FFTW_MEASURE);
-
-      if (d_plan == NULL) {
-	fprintf(stderr, "gr::fft::fft_real_rev: error creating plan\n");
-	throw std::runtime_error ("fftwf_plan_dft_c2r_1d failed");
-      }
-      export_wisdom ();	// store new wisdom to disk
+      set_nthreads(nthreads);
     }
 
     fft_real_rev::~fft_real_rev ()
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
-      fftwf_destroy_plan ((fftwf_plan) d_plan);
+      // The plans belong to the plan cache.
       fftwf_free (d_inbuf);
       fftwf_free (d_outbuf);
     }
@@ -329,15 +556,40 @@ namespace gr {
 	throw std::out_of_range ("gr::fft::fft_real_rev::set_nthreads: invalid number of threads");
       d_nthreads = n;
 
-#ifdef FFTW3F_THREADS
-      fftwf_plan_with_nthreads(d_nthreads);
-#endif
+      planner::scoped_lock lock(planner::mutex());
+      d_plan = cached_plan(PLAN_C2R, d_fft_size, d_batch, false, d_nthreads);
+
+      // See fft_complex::make_plans()
+      d_plan_one = d_plan;
+      if (d_batch > 1) {
+	bool unaligned =
+	  fftwf_alignment_of ((float *) (d_inbuf + d_fft_size / 2 + 1)) != 0 ||
+	  fftwf_alignment_of (d_outbuf + d_fft_size) != 0;
+	d_plan_one = cached_plan(PLAN_C2R, d_fft_size, 1, unaligned, d_nthreads);
+      }
     }
 
     void
     fft_real_rev::execute ()
     {
-      fftwf_execute ((fftwf_plan) d_plan);
+      fftwf_execute_dft_c2r ((fftwf_plan) d_plan,
+			     reinterpret_cast<fftwf_complex *>(d_inbuf),
+			     d_outbuf);
+    }
+
+    void
+    fft_real_rev::execute (int nffts)
+    {
+      if (2 * nffts > d_batch) {
+	execute();
+	return;
+      }
+
+      for (int i = 0; i < nffts; i++) {
+	fftwf_execute_dft_c2r ((fftwf_plan) d_plan_one,
+			       reinterpret_cast<fftwf_complex *>(d_inbuf + i * (d_fft_size / 2 + 1)),
+			       d_outbuf + i * d_fft_size);
+      }
     }
 
   } /* namespace fft */
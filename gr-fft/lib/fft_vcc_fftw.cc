@@ -26,8 +26,10 @@
 
 #include "fft_vcc_fftw.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <math.h>
 #include <string.h>
+#include <algorithm>
 
 namespace gr {
   namespace fft {
@@ -47,9 +49,16 @@ namespace gr {
       : sync_block("fft_vcc_fftw",
 		      io_signature::make(1, 1, fft_size * sizeof(gr_complex)),
 		      io_signature::make(1, 1, fft_size * sizeof(gr_complex))),
+	d_fft(NULL), d_large(NULL), d_scratch(NULL),
 	d_fft_size(fft_size), d_forward(forward), d_shift(shift)
     {
-      d_fft = new fft_complex(d_fft_size, forward, nthreads);
+      // Large transforms are done in place in the output buffer; the
+      // block then needs no buffers of its own the size of an item.
+      if(fft_size >= fft_complex_inplace::LARGE_FFT_SIZE)
+        d_large = new fft_complex_inplace(d_fft_size, forward, nthreads);
+      else
+        d_fft = new fft_complex(d_fft_size, forward, nthreads,
+                                std::max(1, BATCH_ITEMS / fft_size));
       if(!set_window(window))
         throw std::runtime_error("fft_vcc: window not the same length as fft_size\n");
     }
@@ -57,18 +66,24 @@ namespace gr {
     fft_vcc_fftw::~fft_vcc_fftw()
     {
       delete d_fft;
+      delete d_large;
+      if(d_scratch)
+        fft::free(d_scratch);
     }
 
     void
     fft_vcc_fftw::set_nthreads(int n)
     {
-      d_fft->set_nthreads(n);
+      if(d_large)
+        d_large->set_nthreads(n);
+      else
+        d_fft->set_nthreads(n);
     }
 
     int
     fft_vcc_fftw::nthreads() const
     {
-      return d_fft->nthreads();
+      return d_large ? d_large->nthreads() : d_fft->nthreads();
     }
 
     bool
@@ -76,12 +91,58 @@ namespace gr {
     {
       if(window.size()==0 || window.size()==d_fft_size) {
 	d_window=window;
+	d_copy_window=window;
+	d_shift_out = d_forward && d_shift;
+
+	// In large mode, a forward shift of an even size is done by
+	// modulating the input by (-1)^n, folded into the window,
+	// rather than by a pass over the output.
+	if(d_large && d_shift_out && d_fft_size % 2 == 0) {
+	  if(d_copy_window.empty())
+	    d_copy_window.assign(d_fft_size, 1.0f);
+	  for(unsigned int i = 1; i < d_fft_size; i += 2)
+	    d_copy_window[i] = -d_copy_window[i];
+	  d_shift_out = false;
+	}
 	return true;
       }
       else
 	return false;
     }
 
+    void
+    fft_vcc_fftw::copy_input(gr_complex *dst, const gr_complex *in) const
+    {
+      // An ifft shift on the input moves its first half to the end.
+      unsigned int len = (!d_forward && d_shift) ? d_fft_size/2 : 0;
+
+      if(d_copy_window.size()) {
+	volk_32fc_32f_multiply_32fc(&dst[0], &in[len], &d_copy_window[len],
+				    d_fft_size - len);
+	if(len)
+	  volk_32fc_32f_multiply_32fc(&dst[d_fft_size - len], &in[0],
+				      &d_copy_window[0], len);
+      }
+      else {
+	memcpy(&dst[0], &in[len], sizeof(gr_complex)*(d_fft_size - len));
+	if(len)
+	  memcpy(&dst[d_fft_size - len], &in[0], sizeof(gr_complex)*len);
+      }
+    }
+
+    void
+    fft_vcc_fftw::copy_output(gr_complex *dst, const gr_complex *src) const
+    {
+      if(d_shift_out) {  // apply a fft shift on the data
+	unsigned int len = (unsigned int)(ceil(d_fft_size/2.0));
+	memcpy(&dst[0], &src[len], sizeof(gr_complex)*(d_fft_size - len));
+	memcpy(&dst[d_fft_size - len], &src[0], sizeof(gr_complex)*len);
+      }
+      else {
+	memcpy(dst, src, sizeof(gr_complex)*d_fft_size);
+      }
+    }
+
     int
     fft_vcc_fftw::work(int noutput_items,
 		       gr_vector_const_void_star &input_items,
@@ -90,56 +151,52 @@ namespace gr {
       const gr_complex *in = (const gr_complex *) input_items[0];
       gr_complex *out = (gr_complex *) output_items[0];
 
-      unsigned int input_data_size = input_signature()->sizeof_stream_item (0);
-      unsigned int output_data_size = output_signature()->sizeof_stream_item (0);
+      if(d_large) {
+	for(int k = 0; k < noutput_items; k++) {
+	  // Window straight into the output buffer and transform it
+	  // there, unless FFTW cannot use it as it is aligned.
+	  gr_complex *dst = out;
+	  if(!d_large->aligned(out)) {
+	    if(!d_scratch)
+	      d_scratch = malloc_complex(d_fft_size);
+	    dst = d_scratch;
+	  }
+
+	  copy_input(dst, in);
+	  d_large->execute(dst);
+
+	  if(dst != out)
+	    copy_output(out, dst);
+	  else if(d_shift_out)
+	    std::rotate(out, out + (d_fft_size+1)/2, out + d_fft_size);
+
+	  in += d_fft_size;
+	  out += d_fft_size;
+	}
+	return noutput_items;
+      }
 
       int count = 0;
 
-      while(count++ < noutput_items) {
+      while(count < noutput_items) {
+	int nffts = std::min(d_fft->batch(), noutput_items - count);
 
 	// copy input into optimally aligned buffer
-	if(d_window.size()) {
-	  gr_complex *dst = d_fft->get_inbuf();
-	  if(!d_forward && d_shift) {
-	    unsigned int offset = (!d_forward && d_shift)?(d_fft_size/2):0;
-	    int fft_m_offset = d_fft_size - offset;
-	    for(unsigned int i = 0; i < offset; i++)		// apply window
-	      dst[i+fft_m_offset] = in[i] * d_window[i];
-	    for(unsigned int i = offset; i < d_fft_size; i++)	// apply window
-	      dst[i-offset] = in[i] * d_window[i];
-	  }
-	  else {
-	    for(unsigned int i = 0; i < d_fft_size; i++)		// apply window
-	      dst[i] = in[i] * d_window[i];
-	  }
-	}
-	else {
-	  if(!d_forward && d_shift) {  // apply an ifft shift on the data
-	    gr_complex *dst = d_fft->get_inbuf();
-	    unsigned int len = (unsigned int)(floor(d_fft_size/2.0)); // half length of complex array
-	    memcpy(&dst[0], &in[len], sizeof(gr_complex)*(d_fft_size - len));
-	    memcpy(&dst[d_fft_size - len], &in[0], sizeof(gr_complex)*len);
-	  }
-	  else {
-	    memcpy(d_fft->get_inbuf(), in, input_data_size);
-	  }
+	for(int k = 0; k < nffts; k++) {
+	  copy_input(d_fft->get_inbuf() + k*d_fft_size, in);
+	  in += d_fft_size;
 	}
 
-	// compute the fft
-	d_fft->execute();
+	// compute the ffts of the whole batch at once
+	d_fft->execute(nffts);
 
 	// copy result to our output
-	if(d_forward && d_shift) {  // apply a fft shift on the data
-	  unsigned int len = (unsigned int)(ceil(d_fft_size/2.0));
-	  memcpy(&out[0], &d_fft->get_outbuf()[len], sizeof(gr_complex)*(d_fft_size - len));
-	  memcpy(&out[d_fft_size - len], &d_fft->get_outbuf()[0], sizeof(gr_complex)*len);
-	}
-	else {
-	  memcpy (out, d_fft->get_outbuf (), output_data_size);
+	for(int k = 0; k < nffts; k++) {
+	  copy_output(out, d_fft->get_outbuf() + k*d_fft_size);
+	  out += d_fft_size;
 	}
 
-	in  += d_fft_size;
-	out += d_fft_size;
+	count += nffts;
       }
 
       return noutput_items;
@@ -32,11 +32,21 @@ namespace gr {
     class FFT_API fft_vcc_fftw : public fft_vcc
     {
     private:
-      fft_complex          *d_fft;
+      // Items transformed per execute; small FFTs are batched up to this.
+      static const int BATCH_ITEMS = 16384;
+
+      fft_complex          *d_fft;        // NULL in large mode
+      fft_complex_inplace  *d_large;      // NULL below LARGE_FFT_SIZE
+      gr_complex           *d_scratch;    // large mode, unaligned output
       unsigned int          d_fft_size;
       std::vector<float>    d_window;
+      std::vector<float>    d_copy_window; // window applied in the copy
       bool                  d_forward;
       bool                  d_shift;
+      bool                  d_shift_out;  // shift the output after the FFT
+
+      void copy_input(gr_complex *dst, const gr_complex *in) const;
+      void copy_output(gr_complex *dst, const gr_complex *src) const;
 
     public:
       fft_vcc_fftw(int fft_size, bool forward,
@@ -26,8 +26,10 @@
 
 #include "fft_vfc_fftw.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <math.h>
 #include <string.h>
+#include <algorithm>
 
 namespace gr {
   namespace fft {
@@ -49,7 +51,8 @@ namespace gr {
 		      io_signature::make(1, 1, fft_size * sizeof(gr_complex))),
 	d_fft_size(fft_size), d_forward(forward)
     {
-      d_fft = new fft_complex(d_fft_size, forward, nthreads);
+      d_fft = new fft_real_fwd(d_fft_size, nthreads,
+                               std::max(1, BATCH_ITEMS / fft_size));
       if(!set_window(window))
         throw std::runtime_error("fft_vfc: window not the same length as fft_size\n");
     }
@@ -90,32 +93,49 @@ namespace gr {
       const float *in = (const float *)input_items[0];
       gr_complex *out = (gr_complex *)output_items[0];
 
-      unsigned int output_data_size = output_signature()->sizeof_stream_item (0);
+      const unsigned int nbins = d_fft_size/2 + 1;
 
       int count = 0;
 
-      while(count++ < noutput_items) {
+      while(count < noutput_items) {
+	int nffts = std::min(d_fft->batch(), noutput_items - count);
 
 	// copy input into optimally aligned buffer
-	if(d_window.size()) {
-	  gr_complex *dst = d_fft->get_inbuf();
-	  for(unsigned int i = 0; i < d_fft_size; i++)    // apply window
-	    dst[i] = in[i] * d_window[i];
+	for(int k = 0; k < nffts; k++) {
+	  float *dst = d_fft->get_inbuf() + k*d_fft_size;
+	  if(d_window.size()) {
+	    volk_32f_x2_multiply_32f(dst, in, &d_window[0], d_fft_size);
+	  }
+	  else {
+	    memcpy(dst, in, sizeof(float)*d_fft_size);
+	  }
+	  in += d_fft_size;
 	}
-	else {
-	  gr_complex *dst = d_fft->get_inbuf();
-	  for(unsigned int i = 0; i < d_fft_size; i++)    // float to complex conversion
-	    dst[i] = in[i];
-	}
-
-	// compute the fft
-	d_fft->execute();
 
-	// copy result to output stream
-	memcpy(out, d_fft->get_outbuf(), output_data_size);
+	// compute the real ffts of the whole batch at once
+	d_fft->execute(nffts);
+
+	// The spectrum of real input is conjugate symmetric: the real
+	// FFT gives the bins up to fft_size/2 and the others are their
+	// conjugates. The reverse transform of real input is the
+	// conjugate of the forward one.
+	for(int k = 0; k < nffts; k++) {
+	  const gr_complex *src = d_fft->get_outbuf() + k*nbins;
+	  if(d_forward) {
+	    memcpy(out, src, sizeof(gr_complex)*nbins);
+	    for(unsigned int i = nbins; i < d_fft_size; i++)
+	      out[i] = conj(src[d_fft_size - i]);
+	  }
+	  else {
+	    for(unsigned int i = 0; i < nbins; i++)
+	      out[i] = conj(src[i]);
+	    for(unsigned int i = nbins; i < d_fft_size; i++)
+	      out[i] = src[d_fft_size - i];
+	  }
+	  out += d_fft_size;
+	}
 
-	in  += d_fft_size;
-	out += d_fft_size;
+	count += nffts;
       }
 
       return noutput_items;
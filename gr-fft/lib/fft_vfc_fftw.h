@@ -32,7 +32,10 @@ namespace gr {
     class FFT_API fft_vfc_fftw : public fft_vfc
     {
     private:
-      fft_complex          *d_fft;
+      // Items transformed per execute; small FFTs are batched up to this.
+      static const int BATCH_ITEMS = 16384;
+
+      fft_real_fwd         *d_fft;
       unsigned int          d_fft_size;
       std::vector<float>    d_window;
       bool                  d_forward;
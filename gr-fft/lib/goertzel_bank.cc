@@ -0,0 +1,242 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+#include <gnuradio/fft/goertzel_bank.h>
+
+namespace gr {
+  namespace fft {
+
+    // Bins updated together; the state of a block stays in registers
+    // for the whole input. The lanes are padded to a whole number of
+    // TAIL-wide blocks, so a few bins are not padded out to BLOCK.
+    static const int BLOCK = 8;
+    static const int TAIL = 4;
+
+    goertzel_bank::goertzel_bank(int rate, int len, const std::vector<float> &freqs)
+    {
+      set_params(rate, len, freqs);
+    }
+
+    void
+    goertzel_bank::set_params(int rate, int len, const std::vector<float> &freqs)
+    {
+      d_rate = rate;
+      d_len = len;
+      d_freqs = freqs;
+      d_nlanes = (freqs.size() + TAIL - 1) / TAIL * TAIL;
+
+      // Unused lanes have zero coefficients and are never written out
+      d_wr.assign(d_nlanes, 0);
+      d_wi.assign(d_nlanes, 0);
+      d_rot_r.assign(d_nlanes, 0);
+      d_rot_i.assign(d_nlanes, 0);
+      d_wrap_r.assign(d_nlanes, 0);
+      d_wrap_i.assign(d_nlanes, 0);
+      for(unsigned int b = 0; b < freqs.size(); b++) {
+	// Same coefficients as gr::fft::goertzel
+	float w = 2.0*M_PI*freqs[b]/rate;
+	d_wr[b] = 2.0*std::cos(w);
+	d_wi[b] = std::sin(w);
+	d_rot_r[b] = std::cos(w);
+	d_rot_i[b] = std::sin(w);
+	d_wrap_r[b] = std::cos((double)w*len);
+	d_wrap_i[b] = std::sin((double)w*len);
+      }
+
+      d_d1.assign(d_nlanes, 0);
+      d_d2.assign(d_nlanes, 0);
+      d_yr.assign(d_nlanes, 0);
+      d_yi.assign(d_nlanes, 0);
+      d_processed = 0;
+    }
+
+    // Runs the recursions of W lanes over n samples.
+    template<int W>
+    static void
+    run_block(const float wr[], float d1[], float d2[], const float in[], int n)
+    {
+      float c[W], a1[W], a2[W];
+      for(int j = 0; j < W; j++) {
+	c[j] = wr[j];
+	a1[j] = d1[j];
+	a2[j] = d2[j];
+      }
+
+      // Two samples at a time, alternating which array holds the
+      // newest state, so there are no copies between the arrays.
+      int i = 0;
+      for(; i + 1 < n; i += 2) {
+	const float x0 = in[i];
+	const float x1 = in[i+1];
+	for(int j = 0; j < W; j++)
+	  a2[j] = x0 + c[j]*a1[j] - a2[j];
+	for(int j = 0; j < W; j++)
+	  a1[j] = x1 + c[j]*a2[j] - a1[j];
+      }
+      if(i < n) {
+	for(int j = 0; j < W; j++) {
+	  float y = in[i] + c[j]*a1[j] - a2[j];
+	  a2[j] = a1[j];
+	  a1[j] = y;
+	}
+      }
+
+      for(int j = 0; j < W; j++) {
+	d1[j] = a1[j];
+	d2[j] = a2[j];
+      }
+    }
+
+    void
+    goertzel_bank::run(const float in[], int n)
+    {
+      unsigned int l = 0;
+      for(; l + BLOCK <= d_nlanes; l += BLOCK)
+	run_block<BLOCK>(&d_wr[l], &d_d1[l], &d_d2[l], in, n);
+      if(l < d_nlanes)
+	run_block<TAIL>(&d_wr[l], &d_d1[l], &d_d2[l], in, n);
+    }
+
+    /*
+     * The Goertzel output of the window x[n-len+1..n] is
+     *   Y(n) = sum_k x[n-k] e^jw(k+1),  k = 0..len-1
+     * so the next window's is
+     *   Y(n+1) = e^jw (Y(n) + x[n+1] - x[n+1-len] e^jw*len).
+     * Advances d_yr/d_yi by n samples; in[0] is the first sample of
+     * the current window.
+     */
+    template<int W>
+    static void
+    slide_block(const float rot_r[], const float rot_i[],
+		const float wrap_r[], const float wrap_i[],
+		float yr[], float yi[], const float in[], int n, int len)
+    {
+      float cr[W], ci[W], pr[W], pi[W], ar[W], ai[W];
+      for(int j = 0; j < W; j++) {
+	cr[j] = rot_r[j];
+	ci[j] = rot_i[j];
+	pr[j] = wrap_r[j];
+	pi[j] = wrap_i[j];
+	ar[j] = yr[j];
+	ai[j] = yi[j];
+      }
+
+      for(int i = 0; i < n; i++) {
+	const float xo = in[i];
+	const float xn = in[i+len];
+	for(int j = 0; j < W; j++) {
+	  float tr = ar[j] + xn - xo*pr[j];
+	  float ti = ai[j] - xo*pi[j];
+	  ar[j] = cr[j]*tr - ci[j]*ti;
+	  ai[j] = ci[j]*tr + cr[j]*ti;
+	}
+      }
+
+      for(int j = 0; j < W; j++) {
+	yr[j] = ar[j];
+	yi[j] = ai[j];
+      }
+    }
+
+    void
+    goertzel_bank::slide(const float in[], int n)
+    {
+      unsigned int l = 0;
+      for(; l + BLOCK <= d_nlanes; l += BLOCK)
+	slide_block<BLOCK>(&d_rot_r[l], &d_rot_i[l], &d_wrap_r[l], &d_wrap_i[l],
+			   &d_yr[l], &d_yi[l], in, n, d_len);
+      if(l < d_nlanes)
+	slide_block<TAIL>(&d_rot_r[l], &d_rot_i[l], &d_wrap_r[l], &d_wrap_i[l],
+			  &d_yr[l], &d_yi[l], in, n, d_len);
+    }
+
+    void
+    goertzel_bank::batch(gr_complex out[], const float in[])
+    {
+      std::fill(d_d1.begin(), d_d1.end(), 0);
+      std::fill(d_d2.begin(), d_d2.end(), 0);
+
+      run(in, d_len);
+      output(out);
+    }
+
+    void
+    goertzel_bank::sliding(gr_complex out[], const float in[], int n, int step)
+    {
+      const unsigned int nbins = d_freqs.size();
+
+      // A sliding update costs about as much as three Goertzel
+      // updates; with little overlap recompute every window.
+      if(3*step >= d_len) {
+	for(int i = 0; i < n; i++)
+	  batch(&out[i*nbins], &in[i*step]);
+	return;
+      }
+
+      int slid = 0;
+      for(int i = 0; i < n; i++) {
+	if(i == 0 || slid >= d_len) {
+	  std::fill(d_d1.begin(), d_d1.end(), 0);
+	  std::fill(d_d2.begin(), d_d2.end(), 0);
+	  run(&in[i*step], d_len);
+	  for(unsigned int l = 0; l < d_nlanes; l++) {
+	    d_yr[l] = 0.5f*d_wr[l]*d_d1[l] - d_d2[l];
+	    d_yi[l] = d_wi[l]*d_d1[l];
+	  }
+	  slid = 0;
+	}
+	else {
+	  slide(&in[(i-1)*step], step);
+	  slid += step;
+	}
+
+	for(unsigned int b = 0; b < nbins; b++)
+	  out[i*nbins+b] = gr_complex(d_yr[b]/d_len, d_yi[b]/d_len);
+      }
+    }
+
+    void
+    goertzel_bank::input(const float &in)
+    {
+      run(&in, 1);
+      d_processed++;
+    }
+
+    void
+    goertzel_bank::output(gr_complex out[])
+    {
+      for(unsigned int b = 0; b < d_freqs.size(); b++)
+	out[b] = gr_complex((0.5*d_wr[b]*d_d1[b]-d_d2[b])/d_len, (d_wi[b]*d_d1[b])/d_len);
+
+      std::fill(d_d1.begin(), d_d1.end(), 0);
+      std::fill(d_d2.begin(), d_d2.end(), 0);
+      d_processed = 0;
+    }
+
+  } /* namespace fft */
+}/* namespace gr */
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "goertzel_bank_fvc_impl.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+
+namespace gr {
+  namespace fft {
+
+    goertzel_bank_fvc::sptr
+    goertzel_bank_fvc::make(int rate, int len, const std::vector<float> &freqs,
+                            int step)
+    {
+      return gnuradio::get_initial_sptr
+        (new goertzel_bank_fvc_impl(rate, len, freqs, step));
+    }
+
+    goertzel_bank_fvc_impl::goertzel_bank_fvc_impl(int rate, int len,
+                                                   const std::vector<float> &freqs,
+                                                   int step)
+      : sync_decimator("goertzel_bank_fvc",
+			  io_signature::make(1, 1, sizeof(float)),
+			  io_signature::make(1, 1, freqs.size()*sizeof(gr_complex)),
+			  step),
+	d_bank(rate, len, freqs)
+    {
+      if(freqs.empty())
+	throw std::invalid_argument("goertzel_bank_fvc: no frequencies");
+      if(len <= 0 || step <= 0)
+	throw std::invalid_argument("goertzel_bank_fvc: len and step must be > 0");
+
+      d_len = len;
+      d_step = step;
+      d_rate = rate;
+      d_freqs = freqs;
+
+      // Overlapping windows reach back into the previous outputs' input.
+      if(len > step)
+	set_history(len - step + 1);
+    }
+
+    goertzel_bank_fvc_impl::~goertzel_bank_fvc_impl()
+    {
+    }
+
+    void
+    goertzel_bank_fvc_impl::set_freqs(const std::vector<float> &freqs)
+    {
+      if(freqs.size() != d_freqs.size())
+	throw std::invalid_argument("goertzel_bank_fvc: the number of frequencies cannot change");
+
+      d_freqs = freqs;
+      d_bank.set_params(d_rate, d_len, d_freqs);
+    }
+
+    void
+    goertzel_bank_fvc_impl::set_rate(int rate)
+    {
+      d_rate = rate;
+      d_bank.set_params(d_rate, d_len, d_freqs);
+    }
+
+    int
+    goertzel_bank_fvc_impl::work(int noutput_items,
+				 gr_vector_const_void_star &input_items,
+				 gr_vector_void_star &output_items)
+    {
+      const float *in = (const float *)input_items[0];
+      gr_complex *out = (gr_complex *)output_items[0];
+
+      // Each window ends on the last sample of its step.
+      in += history() - 1 + d_step - d_len;
+
+      d_bank.sliding(out, in, noutput_items, d_step);
+
+      return noutput_items;
+    }
+
+  } /* namespace fft */
+} /* namespace gr */
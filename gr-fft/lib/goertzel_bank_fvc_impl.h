@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_GOERTZEL_BANK_FVC_IMPL_H
+#define INCLUDED_FFT_GOERTZEL_BANK_FVC_IMPL_H
+
+#include <gnuradio/fft/goertzel_bank_fvc.h>
+#include <gnuradio/fft/goertzel_bank.h>
+
+namespace gr {
+  namespace fft {
+
+    class FFT_API goertzel_bank_fvc_impl : public goertzel_bank_fvc
+    {
+    private:
+      goertzel_bank      d_bank;
+      int                d_len;
+      int                d_step;
+      std::vector<float> d_freqs;
+      int                d_rate;
+
+    public:
+      goertzel_bank_fvc_impl(int rate, int len,
+                             const std::vector<float> &freqs, int step);
+
+      ~goertzel_bank_fvc_impl();
+
+      void set_freqs(const std::vector<float> &freqs);
+      void set_rate(int rate);
+
+      std::vector<float> freqs() { return d_freqs; }
+      int rate() { return d_rate; }
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_GOERTZEL_BANK_FVC_IMPL_H */
@@ -0,0 +1,199 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "welch_psd_cvf_impl.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace fft {
+
+    welch_psd_cvf::sptr
+    welch_psd_cvf::make(int fft_size, const std::vector<float> &window,
+                        int step, int nframes, float alpha,
+                        bool shift, int nthreads)
+    {
+      return gnuradio::get_initial_sptr
+        (new welch_psd_cvf_impl(fft_size, window, step, nframes,
+                                alpha, shift, nthreads));
+    }
+
+    welch_psd_cvf_impl::welch_psd_cvf_impl(int fft_size, const std::vector<float> &window,
+                                           int step, int nframes, float alpha,
+                                           bool shift, int nthreads)
+      : sync_decimator("welch_psd_cvf",
+			  io_signature::make(1, 1, sizeof(gr_complex)),
+			  io_signature::make(1, 1, fft_size * sizeof(float)),
+			  step * nframes),
+	d_fft_size(fft_size), d_step(step), d_nframes(nframes),
+	d_alpha(0), d_shift(shift), d_frame(0)
+    {
+      if(fft_size <= 0 || step <= 0 || nframes <= 0)
+	throw std::invalid_argument("welch_psd_cvf: fft_size, step and nframes must be > 0");
+      if(!set_window(window))
+        throw std::runtime_error("welch_psd_cvf: window not the same length as fft_size\n");
+      if(alpha < 0 || alpha > 1)
+	throw std::out_of_range("welch_psd_cvf: alpha must be in [0, 1]");
+      d_alpha = alpha;
+
+      d_fft = new fft_complex(d_fft_size, true, nthreads,
+                              std::max(1, BATCH_ITEMS / fft_size));
+
+      const int alignment = volk_get_alignment();
+      d_mag = (float*)volk_malloc(d_fft->batch() * d_fft_size * sizeof(float), alignment);
+      d_avg = (float*)volk_malloc(d_fft_size * sizeof(float), alignment);
+      memset(d_avg, 0, d_fft_size * sizeof(float));
+
+      // Overlapping frames reach back into the previous outputs' input.
+      if(fft_size > step)
+	set_history(fft_size - step + 1);
+    }
+
+    welch_psd_cvf_impl::~welch_psd_cvf_impl()
+    {
+      delete d_fft;
+      volk_free(d_mag);
+      volk_free(d_avg);
+    }
+
+    void
+    welch_psd_cvf_impl::set_nthreads(int n)
+    {
+      d_fft->set_nthreads(n);
+    }
+
+    int
+    welch_psd_cvf_impl::nthreads() const
+    {
+      return d_fft->nthreads();
+    }
+
+    bool
+    welch_psd_cvf_impl::set_window(const std::vector<float> &window)
+    {
+      if(window.size()==0 || window.size()==d_fft_size) {
+	d_window=window;
+	return true;
+      }
+      else
+	return false;
+    }
+
+    void
+    welch_psd_cvf_impl::set_alpha(float alpha)
+    {
+      if(alpha < 0 || alpha > 1)
+	throw std::out_of_range("welch_psd_cvf: alpha must be in [0, 1]");
+
+      // A sum and an average cannot be carried over into each other.
+      if((alpha == 0) != (d_alpha == 0))
+        memset(d_avg, 0, d_fft_size * sizeof(float));
+      d_alpha = alpha;
+    }
+
+    void
+    welch_psd_cvf_impl::accumulate(const float *mag)
+    {
+      if(d_alpha == 0) {
+        volk_32f_x2_add_32f(d_avg, d_avg, mag, d_fft_size);
+      }
+      else {
+        const float a = d_alpha;
+        const float b = 1.0f - d_alpha;
+        for(unsigned int i = 0; i < d_fft_size; i++)
+          d_avg[i] = a*mag[i] + b*d_avg[i];
+      }
+    }
+
+    void
+    welch_psd_cvf_impl::emit(float *out)
+    {
+      const float scale = (d_alpha == 0) ? 1.0f/d_nframes : 1.0f;
+
+      if(d_shift) {  // apply a fft shift on the data
+        unsigned int len = (d_fft_size + 1) / 2;
+        volk_32f_s32f_multiply_32f(&out[0], &d_avg[len], scale, d_fft_size - len);
+        volk_32f_s32f_multiply_32f(&out[d_fft_size - len], &d_avg[0], scale, len);
+      }
+      else {
+        volk_32f_s32f_multiply_32f(out, d_avg, scale, d_fft_size);
+      }
+
+      if(d_alpha == 0)
+        memset(d_avg, 0, d_fft_size * sizeof(float));
+    }
+
+    int
+    welch_psd_cvf_impl::work(int noutput_items,
+			     gr_vector_const_void_star &input_items,
+			     gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      float *out = (float *) output_items[0];
+
+      // Each frame ends on the last sample of its step.
+      in += history() - 1 + d_step - d_fft_size;
+
+      const int nframes = noutput_items * d_nframes;
+      int count = 0;
+
+      while(count < nframes) {
+	int nffts = std::min(d_fft->batch(), nframes - count);
+
+	// copy the windowed frames into the aligned buffer
+	for(int k = 0; k < nffts; k++) {
+	  gr_complex *dst = d_fft->get_inbuf() + k*d_fft_size;
+	  const gr_complex *src = in + (count + k)*d_step;
+	  if(d_window.size())
+	    volk_32fc_32f_multiply_32fc(dst, src, &d_window[0], d_fft_size);
+	  else
+	    memcpy(dst, src, d_fft_size * sizeof(gr_complex));
+	}
+
+	// compute the ffts and their magnitudes of the whole batch at once
+	d_fft->execute(nffts);
+	volk_32fc_magnitude_squared_32f(d_mag, d_fft->get_outbuf(), nffts * d_fft_size);
+
+	for(int k = 0; k < nffts; k++) {
+	  accumulate(d_mag + k*d_fft_size);
+	  if(++d_frame == d_nframes) {
+	    emit(out);
+	    out += d_fft_size;
+	    d_frame = 0;
+	  }
+	}
+
+	count += nffts;
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace fft */
+} /* namespace gr */
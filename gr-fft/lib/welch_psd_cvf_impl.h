@@ -0,0 +1,73 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_WELCH_PSD_CVF_IMPL_H
+#define INCLUDED_FFT_WELCH_PSD_CVF_IMPL_H
+
+#include <gnuradio/fft/welch_psd_cvf.h>
+#include <gnuradio/fft/fft.h>
+
+namespace gr {
+  namespace fft {
+
+    class FFT_API welch_psd_cvf_impl : public welch_psd_cvf
+    {
+    private:
+      // Items transformed per execute; small FFTs are batched up to this.
+      static const int BATCH_ITEMS = 16384;
+
+      fft_complex          *d_fft;
+      unsigned int          d_fft_size;
+      std::vector<float>    d_window;
+      int                   d_step;
+      int                   d_nframes;
+      float                 d_alpha;
+      bool                  d_shift;
+      float                *d_mag;      // |X|^2 of a batch of frames
+      float                *d_avg;      // running sum or average
+      int                   d_frame;    // frames in d_avg since the last output
+
+      void accumulate(const float *mag);
+      void emit(float *out);
+
+    public:
+      welch_psd_cvf_impl(int fft_size, const std::vector<float> &window,
+                         int step, int nframes, float alpha,
+                         bool shift, int nthreads);
+
+      ~welch_psd_cvf_impl();
+
+      bool set_window(const std::vector<float> &window);
+      void set_alpha(float alpha);
+      float alpha() const { return d_alpha; }
+      void set_nthreads(int n);
+      int nthreads() const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_WELCH_PSD_CVF_IMPL_H */
@@ -25,6 +25,12 @@
 #endif
 
 #include <gnuradio/fft/window.h>
+#include <gnuradio/thread/thread.h>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <algorithm>
+#include <deque>
+#include <map>
 #include <stdexcept>
 
 namespace gr {
@@ -91,39 +97,74 @@ namespace gr {
       }
     }
 
-   std::vector<float>
-    window::coswindow(int ntaps, float c0, float c1, float c2)
+    /*
+     * Sum of a[k] cos(2 pi k n/(ntaps-1)) over k < na. cos(k x) is
+     * the Chebyshev polynomial T_k(cos x), so only cos(x) is needed,
+     * and only for the first half of the symmetric window. That is
+     * computed a block at a time as cos(x0 + xj) from cos and sin of
+     * the block start and of the first block's angles, in loops the
+     * compiler vectorizes, rather than with one cos() call per term
+     * and tap.
+     */
+    static std::vector<float>
+    cossum(int ntaps, const float a[], int na)
     {
+      static const int BLOCK = 64;
+
       std::vector<float> taps(ntaps);
-      float M = static_cast<float>(ntaps - 1);
+      double M = ntaps - 1;
+      int half = (ntaps + 1) / 2;
 
-      for(int n = 0; n < ntaps; n++)
-        taps[n] = c0 - c1*cosf((2.0f*M_PI*n)/M) + c2*cosf((4.0f*M_PI*n)/M);
+      double cj[BLOCK], sj[BLOCK];
+      for(int j = 0; j < BLOCK; j++) {
+        cj[j] = cos(2*M_PI*j/M);
+        sj[j] = sin(2*M_PI*j/M);
+      }
+      for(int n0 = 0; n0 < half; n0 += BLOCK) {
+        double c0 = cos(2*M_PI*n0/M);
+        double s0 = sin(2*M_PI*n0/M);
+        int m = std::min(BLOCK, half - n0);
+        for(int j = 0; j < m; j++)
+          taps[n0+j] = c0*cj[j] - s0*sj[j];
+      }
+
+      for(int n = 0; n < half; n++) {
+        float x = taps[n];
+        float t0 = 1, t1 = x;
+        float w = a[0] + a[1]*x;
+        for(int k = 2; k < na; k++) {
+          float t2 = 2*x*t1 - t0;
+          w += a[k]*t2;
+          t0 = t1;
+          t1 = t2;
+        }
+        taps[n] = w;
+      }
+
+      for(int n = half; n < ntaps; n++)
+        taps[n] = taps[ntaps-1-n];
       return taps;
     }
 
     std::vector<float>
-    window::coswindow(int ntaps, float c0, float c1, float c2, float c3)
+    window::coswindow(int ntaps, float c0, float c1, float c2)
     {
-      std::vector<float> taps(ntaps);
-      float M = static_cast<float>(ntaps - 1);
+      const float a[] = {c0, -c1, c2};
+      return cossum(ntaps, a, 3);
+    }
 
-      for(int n = 0; n < ntaps; n++)
-        taps[n] = c0 - c1*cosf((2.0f*M_PI*n)/M) + c2*cosf((4.0f*M_PI*n)/M) \
-          - c3*cosf((6.0f*M_PI*n)/M);
-      return taps;
+    std::vector<float>
+    window::coswindow(int ntaps, float c0, float c1, float c2, float c3)
+    {
+      const float a[] = {c0, -c1, c2, -c3};
+      return cossum(ntaps, a, 4);
     }
 
     std::vector<float>
     window::coswindow(int ntaps, float c0, float c1, float c2, float c3, float c4)
     {
-      std::vector<float> taps(ntaps);
-      float M = static_cast<float>(ntaps - 1);
-
-      for(int n = 0; n < ntaps; n++)
-        taps[n] = c0 - c1*cosf((2.0f*M_PI*n)/M) + c2*cosf((4.0f*M_PI*n)/M) \
-          - c3*cosf((6.0f*M_PI*n)/M) + c4*cosf((8.0f*M_PI*n)/M);
-      return taps;
+      const float a[] = {c0, -c1, c2, -c3, c4};
+      return cossum(ntaps, a, 5);
     }
 
     std::vector<float>
@@ -138,23 +179,15 @@ namespace gr {
     std::vector<float>
     window::hamming(int ntaps)
     {
-      std::vector<float> taps(ntaps);
-      float M = static_cast<float>(ntaps - 1);
-
-      for(int n = 0; n < ntaps; n++)
-        taps[n] = 0.54 - 0.46 * cos((2 * M_PI * n) / M);
-      return taps;
+      const float a[] = {0.54, -0.46};
+      return cossum(ntaps, a, 2);
     }
 
     std::vector<float>
     window::hann(int ntaps)
     {
-      std::vector<float> taps(ntaps);
-      float M = static_cast<float>(ntaps - 1);
-
-      for(int n = 0; n < ntaps; n++)
-        taps[n] = 0.5 - 0.5 * cos((2 * M_PI * n) / M);
-      return taps;
+      const float a[] = {0.5, -0.5};
+      return cossum(ntaps, a, 2);
     }
 
     std::vector<float>
@@ -261,9 +294,11 @@ namespace gr {
       double inm1 = 1.0/((double)(ntaps-1));
       double temp;
 
-      for(int i = 0; i < ntaps; i++) {
+      // Symmetric; the Bessel series is only summed for the first half.
+      for(int i = 0; i < (ntaps+1)/2; i++) {
         temp = 2*i*inm1 - 1;
         taps[i] = Izero(beta*sqrt(1.0-temp*temp)) * IBeta;
+        taps[ntaps-1-i] = taps[i];
       }
       return taps;
     }
@@ -349,22 +384,63 @@ namespace gr {
       return taps;
     }
 
-    std::vector<float>
-    window::build(win_type type, int ntaps, double beta)
+    static std::vector<float>
+    generate(window::win_type type, int ntaps, double beta)
     {
       switch (type) {
-      case WIN_RECTANGULAR: return rectangular(ntaps);
-      case WIN_HAMMING: return hamming(ntaps);
-      case WIN_HANN: return hann(ntaps);
-      case WIN_BLACKMAN: return blackman(ntaps);
-      case WIN_BLACKMAN_hARRIS: return blackman_harris(ntaps);
-      case WIN_KAISER: return kaiser(ntaps, beta);
-      case WIN_BARTLETT: return bartlett(ntaps);
-      case WIN_FLATTOP: return flattop(ntaps);
+      case window::WIN_RECTANGULAR: return window::rectangular(ntaps);
+      case window::WIN_HAMMING: return window::hamming(ntaps);
+      case window::WIN_HANN: return window::hann(ntaps);
+      case window::WIN_BLACKMAN: return window::blackman(ntaps);
+      case window::WIN_BLACKMAN_hARRIS: return window::blackman_harris(ntaps);
+      case window::WIN_KAISER: return window::kaiser(ntaps, beta);
+      case window::WIN_BARTLETT: return window::bartlett(ntaps);
+      case window::WIN_FLATTOP: return window::flattop(ntaps);
       default:
         throw std::out_of_range("window::build: type out of range");
       }
     }
 
+    // Windows kept by build(): at most MAX_CACHED windows of at most
+    // MAX_CACHED_TAPS taps in all, the oldest dropped first.
+    static const unsigned int MAX_CACHED = 16;
+    static const size_t MAX_CACHED_TAPS = 1 << 24;
+
+    // (type, ntaps, beta)
+    typedef boost::tuple<int, int, double> window_key_t;
+
+    static gr::thread::mutex s_cache_mutex;
+    static std::map<window_key_t, std::vector<float> > s_cache;
+    static std::deque<window_key_t> s_cache_order;
+    static size_t s_cache_taps = 0;
+
+    std::vector<float>
+    window::build(win_type type, int ntaps, double beta)
+    {
+      // Only the Kaiser window depends on beta.
+      window_key_t key(type, ntaps, type == WIN_KAISER ? beta : 0);
+
+      gr::thread::scoped_lock lock(s_cache_mutex);
+
+      std::map<window_key_t, std::vector<float> >::const_iterator it = s_cache.find(key);
+      if(it != s_cache.end())
+        return it->second;
+
+      std::vector<float> taps = generate(type, ntaps, beta);
+      if(taps.size() > MAX_CACHED_TAPS)
+        return taps;
+
+      while(s_cache.size() >= MAX_CACHED ||
+            s_cache_taps + taps.size() > MAX_CACHED_TAPS) {
+        s_cache_taps -= s_cache[s_cache_order.front()].size();
+        s_cache.erase(s_cache_order.front());
+        s_cache_order.pop_front();
+      }
+      s_cache[key] = taps;
+      s_cache_order.push_back(key);
+      s_cache_taps += taps.size();
+      return taps;
+    }
+
   } /* namespace fft */
 } /* namespace gr */
@@ -0,0 +1,131 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "zoom_fft_vcc_impl.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+
+namespace gr {
+  namespace fft {
+
+    zoom_fft_vcc::sptr
+    zoom_fft_vcc::make(int vlen, int nbins, double samp_rate,
+                       double center_freq, double bandwidth,
+                       const std::vector<float> &window, int nthreads)
+    {
+      return gnuradio::get_initial_sptr
+        (new zoom_fft_vcc_impl(vlen, nbins, samp_rate, center_freq,
+                               bandwidth, window, nthreads));
+    }
+
+    zoom_fft_vcc_impl::zoom_fft_vcc_impl(int vlen, int nbins, double samp_rate,
+                                         double center_freq, double bandwidth,
+                                         const std::vector<float> &window,
+                                         int nthreads)
+      : sync_block("zoom_fft_vcc",
+		      io_signature::make(1, 1, vlen * sizeof(gr_complex)),
+		      io_signature::make(1, 1, nbins * sizeof(gr_complex))),
+	d_czt(NULL), d_nbins(nbins), d_samp_rate(samp_rate),
+	d_center_freq(center_freq), d_bandwidth(bandwidth)
+    {
+      if(vlen <= 0 || nbins <= 0)
+	throw std::invalid_argument("zoom_fft_vcc: vlen and nbins must be > 0");
+      if(samp_rate <= 0)
+	throw std::invalid_argument("zoom_fft_vcc: samp_rate must be > 0");
+
+      if(window.size() != 0 && (int)window.size() != vlen)
+        throw std::runtime_error("zoom_fft_vcc: window not the same length as vlen\n");
+
+      d_czt = new czt(vlen, nbins, start(), step(), nthreads);
+      if(window.size())
+        d_czt->set_window(window);
+    }
+
+    zoom_fft_vcc_impl::~zoom_fft_vcc_impl()
+    {
+      delete d_czt;
+    }
+
+    void
+    zoom_fft_vcc_impl::set_span()
+    {
+      d_czt->set_span(start(), step());
+    }
+
+    void
+    zoom_fft_vcc_impl::set_center_freq(double center_freq)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+      d_center_freq = center_freq;
+      set_span();
+    }
+
+    void
+    zoom_fft_vcc_impl::set_bandwidth(double bandwidth)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+      d_bandwidth = bandwidth;
+      set_span();
+    }
+
+    bool
+    zoom_fft_vcc_impl::set_window(const std::vector<float> &window)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+      return d_czt->set_window(window);
+    }
+
+    void
+    zoom_fft_vcc_impl::set_nthreads(int n)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+      d_czt->set_nthreads(n);
+    }
+
+    int
+    zoom_fft_vcc_impl::nthreads() const
+    {
+      return d_czt->nthreads();
+    }
+
+    int
+    zoom_fft_vcc_impl::work(int noutput_items,
+			    gr_vector_const_void_star &input_items,
+			    gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+
+      // The chirp-Z transform batches the vectors itself.
+      d_czt->execute(out, in, noutput_items);
+
+      return noutput_items;
+    }
+
+  } /* namespace fft */
+} /* namespace gr */
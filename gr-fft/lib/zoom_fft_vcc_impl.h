@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FFT_ZOOM_FFT_VCC_IMPL_H
+#define INCLUDED_FFT_ZOOM_FFT_VCC_IMPL_H
+
+#include <gnuradio/fft/zoom_fft_vcc.h>
+#include <gnuradio/fft/czt.h>
+
+namespace gr {
+  namespace fft {
+
+    class FFT_API zoom_fft_vcc_impl : public zoom_fft_vcc
+    {
+    private:
+      czt                  *d_czt;
+      int                   d_nbins;
+      double                d_samp_rate;
+      double                d_center_freq;
+      double                d_bandwidth;
+
+      // First bin and bin spacing in cycles per sample
+      double start() const { return (d_center_freq - 0.5*d_bandwidth) / d_samp_rate; }
+      double step() const { return d_bandwidth / d_nbins / d_samp_rate; }
+      void set_span();
+
+    public:
+      zoom_fft_vcc_impl(int vlen, int nbins, double samp_rate,
+                        double center_freq, double bandwidth,
+                        const std::vector<float> &window, int nthreads);
+
+      ~zoom_fft_vcc_impl();
+
+      void set_center_freq(double center_freq);
+      double center_freq() const { return d_center_freq; }
+      void set_bandwidth(double bandwidth);
+      double bandwidth() const { return d_bandwidth; }
+      bool set_window(const std::vector<float> &window);
+      void set_nthreads(int n);
+      int nthreads() const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace fft */
+} /* namespace gr */
+
+#endif /* INCLUDED_FFT_ZOOM_FFT_VCC_IMPL_H */
@@ -21,6 +21,7 @@
 
 import sys
 import random
+import cmath
 
 from gnuradio import gr, gr_unittest, fft, blocks
 
@@ -208,6 +209,95 @@ class test_fft(gr_unittest.TestCase):
         result_data = dst.data()
         self.assert_fft_ok2(expected_result, result_data)
 
+    def test_004(self):
+        # Many small vectors, so the block transforms them in batches
+        # and sees partial batches at the end of each call.
+	tb = gr.top_block()
+        fft_size = 16
+        nvectors = 700
+        random.seed(0)
+        src_data = tuple([complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                          for i in range(fft_size*nvectors)])
+        window = [0.5 + 0.5*i/fft_size for i in range(fft_size)]
+
+        expected_result = []
+        for v in range(nvectors):
+            x = [src_data[v*fft_size + i]*window[i] for i in range(fft_size)]
+            X = [sum([x[n]*cmath.exp(-2j*cmath.pi*k*n/fft_size)
+                      for n in range(fft_size)]) for k in range(fft_size)]
+            expected_result += X[fft_size/2:] + X[:fft_size/2]
+
+        src = blocks.vector_source_c(src_data)
+        s2v = blocks.stream_to_vector(gr.sizeof_gr_complex, fft_size)
+        op  = fft.fft_vcc(fft_size, True, window, True)
+        v2s = blocks.vector_to_stream(gr.sizeof_gr_complex, fft_size)
+        dst = blocks.vector_sink_c()
+        tb.connect(src, s2v, op, v2s, dst)
+        tb.run()
+        result_data = dst.data()
+        self.assertEqual(len(expected_result), len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_005(self):
+        # Real input of odd and even sizes, forward and reverse: the
+        # block fills in the bins a real FFT does not compute.
+        random.seed(0)
+        nvectors = 300
+        for fft_size in (15, 16):
+            for forward in (True, False):
+                tb = gr.top_block()
+                src_data = tuple([random.uniform(-1, 1)
+                                  for i in range(fft_size*nvectors)])
+                window = [0.5 + 0.5*i/fft_size for i in range(fft_size)]
+                sign = -1 if forward else 1
+
+                expected_result = []
+                for v in range(nvectors):
+                    x = [src_data[v*fft_size + i]*window[i] for i in range(fft_size)]
+                    expected_result += [sum([x[n]*cmath.exp(sign*2j*cmath.pi*k*n/fft_size)
+                                             for n in range(fft_size)])
+                                        for k in range(fft_size)]
+
+                src = blocks.vector_source_f(src_data)
+                s2v = blocks.stream_to_vector(gr.sizeof_float, fft_size)
+                op  = fft.fft_vfc(fft_size, forward, window)
+                v2s = blocks.vector_to_stream(gr.sizeof_gr_complex, fft_size)
+                dst = blocks.vector_sink_c()
+                tb.connect(src, s2v, op, v2s, dst)
+                tb.run()
+                result_data = dst.data()
+                self.assertEqual(len(expected_result), len(result_data))
+                self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_006(self):
+        # Sizes from fft_complex_inplace.LARGE_FFT_SIZE up are windowed
+        # and transformed in place in the output buffer. Tones give a
+        # known spectrum without a slow reference transform.
+        tb = gr.top_block()
+        fft_size = 2**18
+        bins = (5, 1000)
+        src_data = []
+        for k in bins:
+            src_data += [cmath.exp(2j*cmath.pi*k*n/fft_size) for n in range(fft_size)]
+        window = [-1.0]*fft_size
+
+        expected_result = []
+        for k in bins:
+            X = [0j]*fft_size
+            X[(k + fft_size/2) % fft_size] = -1
+            expected_result += X
+
+        src = blocks.vector_source_c(src_data)
+        s2v = blocks.stream_to_vector(gr.sizeof_gr_complex, fft_size)
+        op  = fft.fft_vcc(fft_size, True, window, True, 2)
+        v2s = blocks.vector_to_stream(gr.sizeof_gr_complex, fft_size)
+        dst = blocks.vector_sink_c()
+        tb.connect(src, s2v, op, v2s, dst)
+        tb.run()
+        result_data = [x/fft_size for x in dst.data()]
+        self.assertEqual(len(expected_result), len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 3)
+
 if __name__ == '__main__':
     gr_unittest.run(test_fft, "test_fft.xml")
 
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from math import pi, cos
+import cmath
+
+from gnuradio import gr, gr_unittest, fft, blocks
+
+class test_goertzel_bank(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_tone_data(self, rate, freq, n):
+        return [cos(2*pi*x*freq/rate) for x in range(n)]
+
+    def transform(self, src_data, rate, length, freqs, step):
+        src = blocks.vector_source_f(src_data, False)
+        dft = fft.goertzel_bank_fvc(rate, length, freqs, step)
+        dst = blocks.vector_sink_c(len(freqs))
+        self.tb.connect(src, dft, dst)
+        self.tb.run()
+        return dst.data()
+
+    def direct(self, src_data, rate, length, freq, end):
+        # Goertzel output of the window ending on sample end
+        w = 2*pi*freq/rate
+        acc = 0
+        for k in range(length):
+            if end - k >= 0:
+                acc += src_data[end - k] * cmath.exp(1j*w*(k + 1))
+        return acc / length
+
+    def test_001(self): # Same as goertzel_fc with adjacent windows
+        rate = 8000
+        length = 800
+        freqs = [100, 50, 300, 1234.5]
+        src_data = self.make_tone_data(rate, 100, 4*length)
+        actual_result = self.transform(src_data, rate, length, freqs, length)
+        self.assertEqual(4*len(freqs), len(actual_result))
+
+        for b in range(len(freqs)):
+            self.tb = gr.top_block()
+            src = blocks.vector_source_f(src_data, False)
+            dft = fft.goertzel_fc(rate, length, freqs[b])
+            dst = blocks.vector_sink_c()
+            self.tb.connect(src, dft, dst)
+            self.tb.run()
+            expected_result = dst.data()
+            self.assertComplexTuplesAlmostEqual(expected_result,
+                                                actual_result[b::len(freqs)], 5)
+
+        self.assertAlmostEqual(0.5, abs(actual_result[0]), places=4)
+        self.assertAlmostEqual(0.0, abs(actual_result[1]), places=4)
+
+    def test_002(self): # Overlapping windows
+        rate = 8000
+        length = 400
+        step = 25
+        freqs = [100, 175, 2000]
+        src_data = self.make_tone_data(rate, 175, 3000)
+        src_data = [x + 0.1*cos(2*pi*n*2000/rate) for n, x in enumerate(src_data)]
+        actual_result = self.transform(src_data, rate, length, freqs, step)
+        nout = len(src_data) / step
+        self.assertEqual(nout*len(freqs), len(actual_result))
+
+        for i in range(0, nout, 7):
+            for b in range(len(freqs)):
+                expected = self.direct(src_data, rate, length, freqs[b], (i+1)*step - 1)
+                self.assertComplexAlmostEqual(expected, actual_result[i*len(freqs) + b], 4)
+
+    def test_003(self): # Windows with gaps between them
+        rate = 8000
+        length = 100
+        step = 160
+        freqs = [400, 800]
+        src_data = self.make_tone_data(rate, 400, 1600)
+        actual_result = self.transform(src_data, rate, length, freqs, step)
+        self.assertEqual(10*len(freqs), len(actual_result))
+
+        for i in range(10):
+            for b in range(len(freqs)):
+                expected = self.direct(src_data, rate, length, freqs[b], (i+1)*step - 1)
+                self.assertComplexAlmostEqual(expected, actual_result[i*len(freqs) + b], 4)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_goertzel_bank, "test_goertzel_bank.xml")
@@ -0,0 +1,122 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+import cmath
+import random
+
+from gnuradio import gr, gr_unittest, fft, blocks
+
+class test_welch_psd(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_data(self, n):
+        random.seed(0)
+        return [complex(random.uniform(-1, 1), random.uniform(-1, 1)) for x in range(n)]
+
+    def transform(self, src_data, fft_size, win, step, nframes, alpha, shift):
+        src = blocks.vector_source_c(src_data, False)
+        psd = fft.welch_psd_cvf(fft_size, win, step, nframes, alpha, shift)
+        dst = blocks.vector_sink_f(fft_size)
+        self.tb.connect(src, psd, dst)
+        self.tb.run()
+        return dst.data()
+
+    def power(self, src_data, fft_size, win, end):
+        # |X|^2 of the windowed frame ending on sample end
+        frame = src_data[end - fft_size + 1:end + 1]
+        if win:
+            frame = [x*w for x, w in zip(frame, win)]
+        return [abs(sum(x*cmath.exp(-2j*cmath.pi*k*i/fft_size)
+                        for i, x in enumerate(frame)))**2
+                for k in range(fft_size)]
+
+    def test_001(self): # Same as fft_vcc, complex_to_mag_squared, integrate
+        fft_size = 32
+        nframes = 4
+        win = fft.window.hamming(fft_size)
+        src_data = self.make_data(fft_size*nframes*5)
+        actual_result = self.transform(src_data, fft_size, win, fft_size,
+                                       nframes, 0, True)
+
+        self.tb = gr.top_block()
+        src = blocks.vector_source_c(src_data, False)
+        s2v = blocks.stream_to_vector(gr.sizeof_gr_complex, fft_size)
+        dft = fft.fft_vcc(fft_size, True, win, True)
+        mag = blocks.complex_to_mag_squared(fft_size)
+        avg = blocks.integrate_ff(nframes, fft_size)
+        scale = blocks.multiply_const_vff([1.0/nframes]*fft_size)
+        dst = blocks.vector_sink_f(fft_size)
+        self.tb.connect(src, s2v, dft, mag, avg, scale, dst)
+        self.tb.run()
+        expected_result = dst.data()
+
+        self.assertEqual(5*fft_size, len(actual_result))
+        self.assertFloatTuplesAlmostEqual(expected_result, actual_result, 2)
+
+    def test_002(self): # Overlapping frames, mean of each output's frames
+        fft_size = 16
+        step = 4
+        nframes = 3
+        win = fft.window.hanning(fft_size)
+        src_data = self.make_data(step*nframes*6)
+        actual_result = self.transform(src_data, fft_size, win, step,
+                                       nframes, 0, False)
+        self.assertEqual(6*fft_size, len(actual_result))
+
+        # The first frames reach back before the input, into zeros
+        src_data = [0]*(fft_size - step) + src_data
+        for o in range(6):
+            expected = [0]*fft_size
+            for f in range(nframes):
+                end = fft_size - step + (o*nframes + f + 1)*step - 1
+                p = self.power(src_data, fft_size, win, end)
+                expected = [e + x/nframes for e, x in zip(expected, p)]
+            self.assertFloatTuplesAlmostEqual(expected,
+                                              actual_result[o*fft_size:(o+1)*fft_size], 3)
+
+    def test_003(self): # Single pole average across outputs
+        fft_size = 8
+        step = 8
+        nframes = 2
+        alpha = 0.25
+        src_data = self.make_data(step*nframes*5)
+        actual_result = self.transform(src_data, fft_size, [], step,
+                                       nframes, alpha, False)
+        self.assertEqual(5*fft_size, len(actual_result))
+
+        avg = [0]*fft_size
+        for o in range(5):
+            for f in range(nframes):
+                end = (o*nframes + f + 1)*step - 1
+                p = self.power(src_data, fft_size, [], end)
+                avg = [alpha*x + (1 - alpha)*a for a, x in zip(avg, p)]
+            self.assertFloatTuplesAlmostEqual(avg,
+                                              actual_result[o*fft_size:(o+1)*fft_size], 3)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_welch_psd, "test_welch_psd.xml")
@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+import math
+
+from gnuradio import gr_unittest, fft
+
+class test_window(gr_unittest.TestCase):
+
+    def cos_window(self, ntaps, c):
+        M = float(ntaps - 1)
+        return [sum([(-1)**k * c[k] * math.cos(2*math.pi*k*n/M)
+                     for k in range(len(c))]) for n in range(ntaps)]
+
+    def test_001(self):
+        # Cosine-sum windows against their definitions, odd and even
+        # sizes, on both sides of a generation block
+        for ntaps in (2, 7, 64, 129, 1000):
+            self.assertFloatTuplesAlmostEqual(self.cos_window(ntaps, (0.5, 0.5)),
+                                              fft.window.hann(ntaps), 6)
+            self.assertFloatTuplesAlmostEqual(self.cos_window(ntaps, (0.54, 0.46)),
+                                              fft.window.hamming(ntaps), 6)
+            self.assertFloatTuplesAlmostEqual(self.cos_window(ntaps, (0.42, 0.5, 0.08)),
+                                              fft.window.blackman(ntaps), 6)
+            c = (0.35875, 0.48829, 0.14128, 0.01168)
+            self.assertFloatTuplesAlmostEqual(self.cos_window(ntaps, c),
+                                              fft.window.blackman_harris(ntaps), 6)
+            c = (0.084037, 0.29145, 0.375696, 0.20762, 0.041194)
+            self.assertFloatTuplesAlmostEqual(self.cos_window(ntaps, c),
+                                              fft.window.blackman4(ntaps), 6)
+
+    def test_002(self):
+        # build() returns the same window from its cache as when it
+        # generates it, and keeps Kaiser windows of different beta apart
+        for ntaps in (16, 1025):
+            for t in (fft.window.WIN_HAMMING, fft.window.WIN_BLACKMAN_hARRIS,
+                      fft.window.WIN_FLATTOP, fft.window.WIN_KAISER):
+                first = fft.window.build(t, ntaps, 6.76)
+                again = fft.window.build(t, ntaps, 6.76)
+                self.assertEqual(first, again)
+
+            k1 = fft.window.build(fft.window.WIN_KAISER, ntaps, 2.0)
+            k2 = fft.window.build(fft.window.WIN_KAISER, ntaps, 8.0)
+            self.assertFloatTuplesAlmostEqual(fft.window.kaiser(ntaps, 2.0), k1, 6)
+            self.assertFloatTuplesAlmostEqual(fft.window.kaiser(ntaps, 8.0), k2, 6)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_window, "test_window.xml")
@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+import cmath
+import math
+import random
+
+from gnuradio import gr, gr_unittest, fft, blocks
+
+class test_zoom_fft(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_data(self, n):
+        random.seed(0)
+        return [complex(random.uniform(-1, 1), random.uniform(-1, 1)) for x in range(n)]
+
+    def dft(self, x, freqs):
+        return [sum([x[n]*cmath.exp(-2j*cmath.pi*f*n) for n in range(len(x))])
+                for f in freqs]
+
+    def run_zoom(self, vlen, nbins, samp_rate, center_freq, bandwidth,
+                 window, nvectors):
+        src_data = self.make_data(vlen*nvectors)
+        freqs = [(center_freq - bandwidth/2.0 + k*bandwidth/nbins)/samp_rate
+                 for k in range(nbins)]
+        w = window if window else [1.0]*vlen
+
+        expected_result = []
+        for v in range(nvectors):
+            x = [src_data[v*vlen + n]*w[n] for n in range(vlen)]
+            expected_result += self.dft(x, freqs)
+
+        src = blocks.vector_source_c(src_data)
+        s2v = blocks.stream_to_vector(gr.sizeof_gr_complex, vlen)
+        op  = fft.zoom_fft_vcc(vlen, nbins, samp_rate, center_freq,
+                               bandwidth, window)
+        v2s = blocks.vector_to_stream(gr.sizeof_gr_complex, nbins)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, s2v, op, v2s, dst)
+        self.tb.run()
+        return expected_result, dst.data()
+
+    def test_001(self):
+        # The full band in vlen bins is an FFT with its output shifted
+        expected_result, result_data = self.run_zoom(16, 16, 1.0, 0.0, 1.0, [], 20)
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_002(self):
+        # A narrow band at a finer resolution than the vector length
+        window = [0.5 - 0.5*math.cos(2*math.pi*n/64) for n in range(64)]
+        expected_result, result_data = self.run_zoom(64, 40, 32000.0, -2500.0,
+                                                     800.0, window, 10)
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_003(self):
+        # Many small vectors are transformed in batches
+        expected_result, result_data = self.run_zoom(8, 24, 1.0, 0.3, 0.05, [], 500)
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_004(self):
+        op = fft.zoom_fft_vcc(32, 16, 1000.0, 100.0, 50.0, [])
+        op.set_center_freq(-200.0)
+        op.set_bandwidth(10.0)
+        self.assertAlmostEqual(op.center_freq(), -200.0)
+        self.assertAlmostEqual(op.bandwidth(), 10.0)
+        self.assertFalse(op.set_window([1.0]*31))
+        self.assertTrue(op.set_window([1.0]*32))
+
+if __name__ == '__main__':
+    gr_unittest.run(test_zoom_fft, "test_zoom_fft.xml")
@@ -31,17 +31,26 @@
 #include "gnuradio/fft/fft_vcc.h"
 #include "gnuradio/fft/fft_vfc.h"
 #include "gnuradio/fft/goertzel_fc.h"
+#include "gnuradio/fft/goertzel_bank_fvc.h"
+#include "gnuradio/fft/welch_psd_cvf.h"
 #include "gnuradio/fft/window.h"
+#include "gnuradio/fft/zoom_fft_vcc.h"
 %}
 
 %include "gnuradio/fft/fft_vcc.h"
 %include "gnuradio/fft/fft_vfc.h"
 %include "gnuradio/fft/goertzel_fc.h"
+%include "gnuradio/fft/goertzel_bank_fvc.h"
+%include "gnuradio/fft/welch_psd_cvf.h"
 %include "gnuradio/fft/window.h"
+%include "gnuradio/fft/zoom_fft_vcc.h"
 
 GR_SWIG_BLOCK_MAGIC2(fft, fft_vcc);
 GR_SWIG_BLOCK_MAGIC2(fft, fft_vfc);
 GR_SWIG_BLOCK_MAGIC2(fft, goertzel_fc);
+GR_SWIG_BLOCK_MAGIC2(fft, goertzel_bank_fvc);
+GR_SWIG_BLOCK_MAGIC2(fft, welch_psd_cvf);
+GR_SWIG_BLOCK_MAGIC2(fft, zoom_fft_vcc);
 
 #ifdef GR_CTRLPORT
 
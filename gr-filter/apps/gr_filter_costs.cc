@@ -0,0 +1,78 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Measure the filter cost model's costs on this host and save them
+ * to ~/.gr_filter_costs, where gr::filter::kernel::filter_cost_model
+ * reads them when a process first chooses a filter engine. Without
+ * that file the analytic defaults are used. Like gr_fftw_wisdom,
+ * run it once per host (after gr_fftw_wisdom and volk_profile, since
+ * both change the timings); delete the file to go back to the
+ * defaults.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/filter/filter_engine.h>
+#include <boost/program_options.hpp>
+#include <boost/format.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+using boost::format;
+using gr::filter::kernel::filter_cost_model;
+
+int
+main(int argc, char **argv)
+{
+  po::options_description desc((format("Program options: %1% [options]") % argv[0]).str());
+  po::variables_map vm;
+
+  desc.add_options()
+    ("help,h", "print help message")
+    ("quiet,q", "do not print the measured costs")
+    ;
+
+  try {
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  }
+  catch (po::error& error){
+    std::cerr << "Error: " << error.what() << std::endl << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if(vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  if(!filter_cost_model::calibrate(vm.count("quiet") == 0))
+    return 1;
+
+  if(!vm.count("quiet"))
+    std::cout << "Saved to " << filter_cost_model::costs_filename() << std::endl;
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FFT_CHANNELIZER_CCF_H
+#define	INCLUDED_FILTER_FFT_CHANNELIZER_CCF_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief Fast-convolution channelizer: channels of any center
+     * frequency, bandwidth and decimation extracted from one complex
+     * input, with float taps
+     *
+     * \ingroup channelizers_blk
+     *
+     * Channel k behaves like a freq_xlating_fir_filter_ccf with its
+     * own taps, center frequency and decimation, writing to output
+     * port k. Unlike freq_xlating_filterbank_ccf, which filters every
+     * channel in the time domain, the input is transformed once by
+     * overlap-save FFTs of \p fft_size points, shared by all
+     * channels. A channel decimating by D then only takes the
+     * fft_size/D bins around its center frequency, multiplies them by
+     * the transformed taps and goes back to the time domain with an
+     * inverse FFT of fft_size/D points, which directly gives the
+     * decimated output. Compared to fft_filter_ccc, which needs its
+     * own forward FFT for each channel, the cost of adding a channel
+     * is a small inverse FFT; compared to pfb_channelizer_ccf the
+     * channels need not be evenly spaced or of equal bandwidth.
+     *
+     * The FFTs overlap by a quarter of \p fft_size, so the taps of
+     * a channel can be at most fft_size/4+1 long and its decimation
+     * must divide fft_size/4. The center frequency is rounded to the
+     * nearest FFT bin for the bin selection and the remainder is
+     * removed after decimation, so any center frequency can be
+     * used. The part of the taps' response outside the fft_size/D
+     * bins of a channel is dropped rather than aliased: the taps
+     * should reach their stopband within the output bandwidth of the
+     * channel, as they would for freq_xlating_fir_filter_ccf.
+     *
+     * Channels can be added, changed and removed at run time. A
+     * channel only produces output if its output port is connected;
+     * ports without a channel produce zeros at the rate of the
+     * channel with the smallest decimation. As the channels run
+     * at different rates, stream tags are not propagated; a "freq"
+     * tag is added to a channel's output when a new center frequency
+     * or new taps take effect.
+     */
+    class FILTER_API fft_channelizer_ccf : virtual public block
+    {
+    public:
+      // gr::filter::fft_channelizer_ccf::sptr
+      typedef boost::shared_ptr<fft_channelizer_ccf> sptr;
+
+      /*!
+       * \brief Build the channelizer.
+       *
+       * \param fft_size      size of the forward FFT; a multiple of 4
+       * \param decimations   decimation rate of each channel
+       * \param taps          a vector/list of tap vectors, one per channel
+       * \param center_freqs  center frequency of each channel (Hz)
+       * \param sampling_freq sampling rate of the input (Hz)
+       * \param nthreads      number of threads the forward FFT and the
+       *                      channels are split across
+       */
+      static sptr make(int fft_size,
+                       const std::vector<int> &decimations,
+                       const std::vector<std::vector<float> > &taps,
+                       const std::vector<double> &center_freqs,
+                       double sampling_freq,
+                       int nthreads=1);
+
+      /*!
+       * \brief Adds channel \p chan, or replaces it if it exists.
+       */
+      virtual void set_channel(unsigned int chan,
+                               const std::vector<float> &taps,
+                               double center_freq,
+                               int decimation) = 0;
+
+      /*!
+       * \brief Removes channel \p chan; its output port produces zeros.
+       */
+      virtual void remove_channel(unsigned int chan) = 0;
+
+      //! Number of channel slots, including removed ones.
+      virtual unsigned int nchans() const = 0;
+
+      //! True if channel \p chan exists.
+      virtual bool has_channel(unsigned int chan) const = 0;
+
+      virtual void set_center_freq(unsigned int chan, double center_freq) = 0;
+      virtual double center_freq(unsigned int chan) const = 0;
+
+      virtual void set_taps(unsigned int chan, const std::vector<float> &taps) = 0;
+      virtual std::vector<float> taps(unsigned int chan) const = 0;
+
+      virtual int decimation(unsigned int chan) const = 0;
+
+      //! Size of the forward FFT.
+      virtual int fft_size() const = 0;
+
+      virtual void set_nthreads(int nthreads) = 0;
+      virtual int nthreads() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FFT_CHANNELIZER_CCF_H */
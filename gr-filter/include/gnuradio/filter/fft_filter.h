@@ -78,6 +78,9 @@ namespace gr {
 	std::vector<float>       d_taps;            // stores time domain taps
 	gr_complex              *d_xformed_taps;    // Fourier xformed taps
 
+	// Samples transformed per FFT execute; blocks are batched up to this.
+	static const int BATCH_ITEMS = 16384;
+
 	void compute_sizes(int ntaps);
 	int tailsize() const { return d_ntaps - 1; }
 
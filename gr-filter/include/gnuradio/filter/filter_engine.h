@@ -0,0 +1,421 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FILTER_ENGINE_H
+#define INCLUDED_FILTER_FILTER_ENGINE_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+#include <string>
+
+namespace gr {
+  namespace fft {
+    class fft_complex;
+    class fft_real_fwd;
+    class fft_real_rev;
+  }
+
+  namespace filter {
+    namespace kernel {
+
+      /*!
+       * \brief Algorithm used by a FIR filter kernel to compute
+       * filterN/filterNdec.
+       *
+       * ENGINE_DIRECT evaluates one dot product per retained output;
+       * with decimation this only computes the samples that are kept,
+       * which is the same work as a polyphase decomposition. Real
+       * kernels with symmetric or antisymmetric taps fold the direct
+       * form (see gr::filter::kernel::folded_fir), which halves the
+       * multiplies. ENGINE_FFT uses overlap-save fast convolution.
+       * ENGINE_AUTO picks between the two using
+       * gr::filter::kernel::filter_cost_model.
+       */
+      enum filter_engine_t {
+        ENGINE_AUTO = 0,
+        ENGINE_DIRECT,
+        ENGINE_FFT
+      };
+
+      /*!
+       * \brief Symmetry of a set of filter taps about their centre.
+       *
+       * Linear-phase filters, which is most of what firdes designs,
+       * have TAPS_SYMMETRIC (types I and II) or TAPS_ANTISYMMETRIC
+       * (types III and IV, e.g. Hilbert transformers and
+       * differentiators) taps.
+       */
+      enum tap_symmetry_t {
+        TAPS_ASYMMETRIC = 0,
+        TAPS_SYMMETRIC,      //!< taps[k] == taps[ntaps-1-k]
+        TAPS_ANTISYMMETRIC   //!< taps[k] == -taps[ntaps-1-k]
+      };
+
+      /*!
+       * \brief Cost model used to choose between direct-form and FFT
+       * filtering and to size the FFT.
+       * \ingroup filter_blk
+       *
+       * \details
+       * Direct-form cost is modeled as a per-tap cost times the
+       * number of taps for each output; FFT cost as c * N log2(N) for
+       * each transform plus a per-bin spectral multiply, spread over
+       * the outputs produced by one overlap-save block. Costs are in
+       * units of one real multiply-accumulate of a VOLK dot product.
+       *
+       * The default costs are analytic, from operation counts: a
+       * float x float tap is 1, a complex x float tap 2 and a
+       * complex x complex tap 4 real MACs; a complex FFT is
+       * 5 N log2(N) flops at about half the throughput of a dot
+       * product (3 per N log2(N)), a real FFT half of that, and a
+       * spectral multiply 6 flops (3). With these the engine and FFT
+       * size picked for a filter are the same on every run and every
+       * host.
+       *
+       * The costs can be replaced by measured ones, read from
+       * ~/.gr_filter_costs when the model is first used. That file is
+       * written by calibrate(), which the gr_filter_costs program
+       * runs; like gr_fftw_wisdom it is meant to be run once per
+       * host, not from a flowgraph. Each line of the file is a cost
+       * name (mac_real, mac_complex_real, mac_complex, fft_complex,
+       * fft_real, cmul) and its value, so it can also be edited by
+       * hand; missing or invalid entries keep their default.
+       *
+       * Decimating filters with complex output can also decimate in
+       * the frequency domain: the N-bin product is folded onto N/D
+       * bins and only an N/D-point inverse FFT is run. That needs an
+       * FFT size that is a multiple of D, so for those filters sizes
+       * of the form D * 2^k are considered as well as powers of 2.
+       */
+      class FILTER_API filter_cost_model
+      {
+      public:
+        enum mac_t {
+          MAC_REAL = 0,     //!< float input, float taps
+          MAC_COMPLEX_REAL, //!< complex input and float taps, or the reverse
+          MAC_COMPLEX       //!< complex input, complex taps
+        };
+
+        enum fft_t {
+          FFT_COMPLEX = 0,  //!< complex forward and inverse transforms
+          FFT_REAL,         //!< real forward and inverse transforms
+          FFT_REAL_INPUT    //!< real forward, complex inverse transform
+        };
+
+        //! Filters shorter than this always use the direct form.
+        static const unsigned int MIN_FFT_TAPS = 32;
+
+        //! Largest FFT size considered by best_fftsize().
+        static const int MAX_FFT_SIZE = 32768;
+
+        /*!
+         * \brief Returns the process-wide cost model.
+         */
+        static const filter_cost_model &instance();
+
+        /*!
+         * \brief Times VOLK dot products, FFTs and spectral
+         * multiplies on this host and writes the resulting costs to
+         * ~/.gr_filter_costs.
+         *
+         * Takes a few milliseconds. The process-wide model is not
+         * changed; the costs are used by processes started afterwards.
+         *
+         * \param verbose print the measured costs to stdout
+         * \return true if the file was written
+         */
+        static bool calibrate(bool verbose=false);
+
+        /*!
+         * \brief Path of the file the costs are read from.
+         */
+        static std::string costs_filename();
+
+        /*!
+         * \brief Modeled cost of one direct-form output.
+         */
+        double direct_cost(mac_t mac, unsigned int ntaps) const;
+
+        /*!
+         * \brief Modeled cost of one overlap-save output.
+         *
+         * \param type       kind of transforms used
+         * \param fftsize    the forward FFT size
+         * \param ntaps      number of filter taps
+         * \param decimation decimation rate of the filter
+         */
+        double fft_cost(fft_t type, int fftsize,
+                        unsigned int ntaps, unsigned int decimation) const;
+
+        /*!
+         * \brief Returns the FFT size no larger than \p max_fftsize
+         * with the lowest cost per output for the given filter, and
+         * that cost in \p cost if not NULL.
+         *
+         * If no candidate up to \p max_fftsize can hold the filter,
+         * the smallest power of 2 that can is returned.
+         */
+        int best_fftsize(fft_t type, unsigned int ntaps,
+                         unsigned int decimation, double *cost=NULL,
+                         int max_fftsize=MAX_FFT_SIZE) const;
+
+        /*!
+         * \brief Chooses the engine for a filter.
+         *
+         * Resolves ENGINE_AUTO to ENGINE_DIRECT or ENGINE_FFT;
+         * filters shorter than MIN_FFT_TAPS always get the direct
+         * form. When the result is ENGINE_FFT, \p fftsize is set to the FFT size to
+         * use. A \p folded filter's direct form is costed at half its
+         * taps.
+         */
+        static filter_engine_t select(filter_engine_t requested,
+                                      mac_t mac, fft_t type,
+                                      unsigned int ntaps,
+                                      unsigned int decimation,
+                                      int *fftsize,
+                                      bool folded=false);
+
+        /*!
+         * \brief True if an overlap-save filter with these parameters
+         * decimates in the frequency domain.
+         */
+        static bool decimates_in_frequency(fft_t type, int fftsize,
+                                           unsigned int decimation);
+
+      private:
+        filter_cost_model();
+
+        void load_costs(const std::string &filename);
+
+        double d_mac_cost[3];  // per tap for each mac_t
+        double d_fft_cost[2];  // per N log2(N), complex and real
+        double d_cmul_cost;    // per complex multiply of a spectrum bin
+      };
+
+      /*!
+       * \brief Overlap-save convolution of float input with float taps.
+       * \ingroup filter_blk
+       *
+       * \details
+       * Unlike gr::filter::kernel::fft_filter_fff this keeps no state
+       * between calls: like the direct-form kernels it reads
+       * ntaps()-1 samples of history in front of every output, so a
+       * kernel can switch between the two without a discontinuity.
+       */
+      class FILTER_API overlap_save_fff
+      {
+      private:
+        int                  d_ntaps;
+        int                  d_fftsize;
+        unsigned int         d_decimation;
+        fft::fft_real_fwd   *d_fwdfft;
+        fft::fft_real_rev   *d_invfft;
+        gr_complex          *d_xformed_taps;
+
+      public:
+        /*!
+         * \param fftsize    FFT size; must be larger than the number of taps
+         * \param taps       filter taps in their natural (not reversed) order
+         * \param decimation decimation rate filterNdec will be called with
+         */
+        overlap_save_fff(int fftsize, const std::vector<float> &taps,
+                         unsigned int decimation=1);
+        ~overlap_save_fff();
+
+        int fftsize() const { return d_fftsize; }
+
+        /*!
+         * \brief Computes output[i] = sum_k taps[k] * input[i*decimate + ntaps-1-k].
+         *
+         * The last overlap-save block is skipped when it would be
+         * less than half full; returns the number of outputs written,
+         * which may therefore be less than \p n. The caller computes
+         * the remainder with the direct form. Nothing is computed if
+         * \p decimate is not the decimation given to the constructor.
+         */
+        unsigned long filterNdec(float output[], const float input[],
+                                 unsigned long n, unsigned int decimate);
+      };
+
+      /*!
+       * \brief Overlap-save convolution of complex input with complex taps.
+       * \ingroup filter_blk
+       *
+       * \details
+       * See gr::filter::kernel::overlap_save_fff. When
+       * filter_cost_model::decimates_in_frequency() holds, the
+       * decimation is done on the spectrum and the inverse FFT is
+       * only fftsize/decimation points long.
+       */
+      class FILTER_API overlap_save_ccc
+      {
+      private:
+        int                  d_ntaps;
+        int                  d_fftsize;
+        unsigned int         d_decimation;
+        fft::fft_complex    *d_fwdfft;
+        fft::fft_complex    *d_invfft;
+        gr_complex          *d_xformed_taps;
+        gr_complex          *d_product;
+
+      public:
+        overlap_save_ccc(int fftsize, const std::vector<gr_complex> &taps,
+                         unsigned int decimation=1);
+        ~overlap_save_ccc();
+
+        int fftsize() const { return d_fftsize; }
+
+        unsigned long filterNdec(gr_complex output[], const gr_complex input[],
+                                 unsigned long n, unsigned int decimate);
+      };
+
+      /*!
+       * \brief Overlap-save convolution of real input with complex taps.
+       * \ingroup filter_blk
+       *
+       * \details
+       * The input is transformed with a real FFT, about half the
+       * work of a complex one, and its spectrum is completed by
+       * conjugate symmetry before the multiply with the complex
+       * taps. Otherwise the same as
+       * gr::filter::kernel::overlap_save_ccc, including decimation in
+       * the frequency domain.
+       */
+      class FILTER_API overlap_save_fcc
+      {
+      private:
+        int                  d_ntaps;
+        int                  d_fftsize;
+        unsigned int         d_decimation;
+        fft::fft_real_fwd   *d_fwdfft;
+        fft::fft_complex    *d_invfft;
+        gr_complex          *d_xformed_taps;
+        gr_complex          *d_spectrum;
+        gr_complex          *d_product;
+
+        void filter_block(gr_complex output[], unsigned long nout);
+
+      public:
+        overlap_save_fcc(int fftsize, const std::vector<gr_complex> &taps,
+                         unsigned int decimation=1);
+        ~overlap_save_fcc();
+
+        int fftsize() const { return d_fftsize; }
+
+        unsigned long filterNdec(gr_complex output[], const float input[],
+                                 unsigned long n, unsigned int decimate);
+        unsigned long filterNdec(gr_complex output[], const short input[],
+                                 unsigned long n, unsigned int decimate);
+      };
+
+      /*!
+       * \brief Direct-form filtering with folded symmetric or
+       * antisymmetric real taps.
+       * \ingroup filter_blk
+       *
+       * \details
+       * With taps[k] == s*taps[ntaps-1-k], s = +1 or -1, each output
+       * is computed as
+       *
+       *   sum_{k < ntaps/2} taps[k] * (x[k] + s*x[ntaps-1-k])
+       *
+       * plus the centre tap for odd ntaps, so each pair of taps
+       * costs one multiply instead of two. Outputs are computed a
+       * block at a time with the loop over taps outside and a
+       * contiguous loop over outputs inside, which the compiler
+       * vectorizes. When decimating, the input block is first split
+       * into its \p decimate phases so that inner loop stays
+       * contiguous.
+       *
+       * The kernel works on interleaved floats so one implementation
+       * serves float (lanes = 1) and complex (lanes = 2) data with
+       * real taps. It keeps no state between calls: like the other
+       * direct-form kernels it reads ntaps()-1 samples of history in
+       * front of every output.
+       */
+      class FILTER_API folded_fir
+      {
+      private:
+        unsigned int         d_lanes;
+        std::vector<float>   d_taps;
+        mutable tap_symmetry_t d_symmetry;
+        mutable bool         d_symmetry_valid;
+        std::vector<float>   d_phases;
+
+      public:
+        //! Shortest filter worth folding.
+        static const unsigned int MIN_FOLD_TAPS = 8;
+
+        /*!
+         * \param lanes number of floats in one input sample
+         */
+        folded_fir(unsigned int lanes=1);
+
+        /*!
+         * \brief Returns the symmetry of \p taps.
+         *
+         * A single tap, or all taps zero, counts as symmetric.
+         */
+        static tap_symmetry_t symmetry(const std::vector<float> &taps);
+
+        /*!
+         * \brief Sets the taps, in the order the kernel that owns
+         * this one stores them: taps[k] multiplies x[k] of the
+         * ntaps-long input window.
+         */
+        void set_taps(const std::vector<float> &taps);
+
+        //! Changes a single tap; the symmetry is checked again on next use.
+        void update_tap(float t, unsigned int index);
+
+        unsigned int ntaps() const { return d_taps.size(); }
+
+        //! Symmetry of the current taps.
+        tap_symmetry_t symmetry() const;
+
+        /*!
+         * \brief True if filterNdec() should be used for this
+         * decimation: the taps are (anti)symmetric and there are
+         * enough of them for folding to pay off against the
+         * deinterleaving a decimating filter needs.
+         */
+        bool usable(unsigned int decimate) const;
+
+        /*!
+         * \brief Computes n outputs,
+         * output[i] = sum_k taps[k] * input[i*decimate + k],
+         * each output and input sample being lanes() floats.
+         *
+         * Must only be called when usable() is true.
+         */
+        void filterNdec(float output[], const float input[],
+                        unsigned long n, unsigned int decimate);
+
+        unsigned int lanes() const { return d_lanes; }
+      };
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FILTER_ENGINE_H */
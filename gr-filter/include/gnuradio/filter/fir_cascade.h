@@ -0,0 +1,156 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FIR_CASCADE_H
+#define INCLUDED_FILTER_FIR_CASCADE_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/halfband_filter.h>
+#include <gnuradio/gr_complex.h>
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      /*!
+       * \brief A chain of decimating FIR filters run as one filter.
+       * \ingroup filter_blk
+       *
+       * \details
+       * Stage i decimates by rates[i] with taps[i]; the total
+       * decimation is the product of the rates. The output is the
+       * same as that of a cascade of fir_filter_ccf blocks with the
+       * same rates and taps, but the stages are run back to back on
+       * chunks small enough that the intermediate signals stay in
+       * cache. A stage that decimates by 2 with halfband taps, such
+       * as those from firdes::halfband(), runs as a
+       * halfband_decimator.
+       *
+       * Like fir_filter_ccf, filterN() reads history()-1 samples in
+       * front of the first input. The history of the later stages
+       * is kept here between calls and starts at zero.
+       */
+      class FILTER_API fir_decim_cascade_ccf : boost::noncopyable
+      {
+      public:
+        fir_decim_cascade_ccf(const std::vector<unsigned int> &rates,
+                              const std::vector<std::vector<float> > &taps);
+        ~fir_decim_cascade_ccf();
+
+        unsigned int nstages() const { return d_rates.size(); }
+        unsigned int decimation() const { return d_decimation; }
+        std::vector<unsigned int> rates() const { return d_rates; }
+        std::vector<std::vector<float> > taps() const;
+
+        //! Number of input samples the first stage looks at per output.
+        unsigned int history() const;
+
+        //! Clears the history of the stages after the first.
+        void reset();
+
+        /*!
+         * \brief Writes \p n outputs computed from
+         * n * decimation() inputs.
+         */
+        void filterN(gr_complex output[], const gr_complex input[],
+                     unsigned long n);
+
+      private:
+        void run_stage(size_t i, gr_complex output[],
+                       const gr_complex input[], unsigned long n);
+
+        std::vector<unsigned int>          d_rates;
+        std::vector<fir_filter_ccf*>       d_firs;
+        std::vector<halfband_decimator*>   d_halfbands; // NULL unless a halfband stage
+        std::vector<std::vector<gr_complex> > d_bufs; // input of stage i, with history
+        unsigned int                       d_decimation;
+        unsigned long                      d_chunk;   // outputs per pass through the stages
+      };
+
+      /*!
+       * \brief A chain of interpolating FIR filters run as one filter.
+       * \ingroup filter_blk
+       *
+       * \details
+       * Stage i interpolates by rates[i] with taps[i], the same way
+       * interp_fir_filter_ccf does: the taps are split into rates[i]
+       * polyphase branches and the passband gain of the taps should
+       * be rates[i]. A stage that interpolates by 2 with halfband
+       * taps runs as a halfband_interpolator. The total
+       * interpolation is the product of the rates.
+       *
+       * filterN() reads history()-1 samples in front of the first
+       * input; the history of the later stages is kept here.
+       */
+      class FILTER_API fir_interp_cascade_ccf : boost::noncopyable
+      {
+      public:
+        fir_interp_cascade_ccf(const std::vector<unsigned int> &rates,
+                               const std::vector<std::vector<float> > &taps);
+        ~fir_interp_cascade_ccf();
+
+        unsigned int nstages() const { return d_rates.size(); }
+        unsigned int interpolation() const { return d_interpolation; }
+        std::vector<unsigned int> rates() const { return d_rates; }
+        std::vector<std::vector<float> > taps() const { return d_taps; }
+
+        //! Number of input samples the first stage looks at per input.
+        unsigned int history() const;
+
+        //! Clears the history of the stages after the first.
+        void reset();
+
+        /*!
+         * \brief Writes n * interpolation() outputs computed from
+         * \p n inputs.
+         */
+        void filterN(gr_complex output[], const gr_complex input[],
+                     unsigned long n);
+
+      private:
+        struct stage {
+          unsigned int                  rate;
+          unsigned int                  ntaps;  // taps per branch
+          std::vector<fir_filter_ccf*>  branches;
+          halfband_interpolator        *halfband; // used instead of branches if not NULL
+        };
+
+        void run_stage(stage &s, gr_complex output[],
+                       const gr_complex input[], unsigned long n);
+
+        std::vector<unsigned int>          d_rates;
+        std::vector<std::vector<float> >   d_taps;
+        std::vector<stage>                 d_stages;
+        std::vector<std::vector<gr_complex> > d_bufs; // input of stage i, with history
+        std::vector<gr_complex>            d_branch;  // output of one branch
+        unsigned int                       d_interpolation;
+        unsigned long                      d_chunk;   // inputs per pass through the stages
+      };
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FIR_CASCADE_H */
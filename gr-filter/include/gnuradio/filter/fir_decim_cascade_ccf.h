@@ -0,0 +1,73 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FIR_DECIM_CASCADE_CCF_H
+#define	INCLUDED_FIR_DECIM_CASCADE_CCF_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief Multi-stage decimating FIR filter with complex input,
+     * complex output and float taps.
+     * \ingroup filter_blk
+     *
+     * \details
+     * Stage i decimates by rates[i] with the filter taps[i], and the
+     * block decimates by the product of the rates. The result is the
+     * same as a chain of fir_filter_ccf blocks, but all stages run in
+     * this block's thread on small chunks, without the buffers and
+     * scheduling of a chain of blocks.
+     *
+     * Large decimations are much cheaper as a few stages than as one
+     * filter. gr::filter::multistage_decimator_ccf, in Python, picks
+     * the stages and designs the taps for a given decimation.
+     */
+    class FILTER_API fir_decim_cascade_ccf : virtual public sync_decimator
+    {
+    public:
+      // gr::filter::fir_decim_cascade_ccf::sptr
+      typedef boost::shared_ptr<fir_decim_cascade_ccf> sptr;
+
+      /*!
+       * \param rates decimation of each stage, first stage first
+       * \param taps  filter taps of each stage
+       */
+      static sptr make(const std::vector<unsigned int> &rates,
+                       const std::vector<std::vector<float> > &taps);
+
+      /*!
+       * \brief Replaces the taps of all stages; the rates stay the
+       * same. The history of the stages is cleared.
+       */
+      virtual void set_taps(const std::vector<std::vector<float> > &taps) = 0;
+      virtual std::vector<std::vector<float> > taps() const = 0;
+      virtual std::vector<unsigned int> rates() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FIR_DECIM_CASCADE_CCF_H */
@@ -24,7 +24,9 @@
 #define INCLUDED_FILTER_FIR_FILTER_H
 
 #include <gnuradio/filter/api.h>
+#include <gnuradio/filter/filter_engine.h>
 #include <vector>
+#include <stdint.h>
 #include <gnuradio/gr_complex.h>
 
 namespace gr {
@@ -52,6 +54,25 @@ namespace gr {
 			 unsigned long n,
 			 unsigned int decimate);
 
+	/*!
+	 * \brief Selects the algorithm used by filterN and filterNdec.
+	 *
+	 * The default, ENGINE_AUTO, lets
+	 * gr::filter::kernel::filter_cost_model pick direct-form or
+	 * overlap-save convolution from the number of taps and the
+	 * decimation; the choice is redone whenever the taps change.
+	 * The direct form of filterN and filterNdec folds symmetric
+	 * and antisymmetric taps. filter() always uses the unfolded
+	 * direct form.
+	 */
+	void set_engine(filter_engine_t engine);
+
+	/*!
+	 * \brief Returns the engine filterN and filterNdec will use
+	 * (never ENGINE_AUTO).
+	 */
+	filter_engine_t engine() const;
+
       protected:
 	std::vector<float> d_taps;
 	unsigned int  d_ntaps;
@@ -59,6 +80,18 @@ namespace gr {
 	float        *d_output;
 	int           d_align;
 	int           d_naligned;
+
+      private:
+	unsigned long filter_fft(float output[], const float input[],
+				 unsigned long n, unsigned int decimate);
+	void update_engine();
+
+	unsigned int     d_decimation;
+	filter_engine_t  d_engine;       // requested engine
+	filter_engine_t  d_active;       // resolved engine
+	int              d_fftsize;
+	overlap_save_fff *d_fft;
+	folded_fir       d_folded;
       };
 
       /**************************************************************/
@@ -84,6 +117,25 @@ namespace gr {
 			unsigned long n,
 			unsigned int decimate);
 
+	/*!
+	 * \brief Selects the algorithm used by filterN and filterNdec.
+	 *
+	 * The default, ENGINE_AUTO, lets
+	 * gr::filter::kernel::filter_cost_model pick direct-form or
+	 * overlap-save convolution from the number of taps and the
+	 * decimation; the choice is redone whenever the taps change.
+	 * The direct form of filterN and filterNdec folds symmetric
+	 * and antisymmetric taps. filter() always uses the unfolded
+	 * direct form.
+	 */
+	void set_engine(filter_engine_t engine);
+
+	/*!
+	 * \brief Returns the engine filterN and filterNdec will use
+	 * (never ENGINE_AUTO).
+	 */
+	filter_engine_t engine() const;
+
       protected:
 	std::vector<float> d_taps;
 	unsigned int d_ntaps;
@@ -91,6 +143,18 @@ namespace gr {
 	gr_complex  *d_output;
 	int          d_align;
 	int          d_naligned;
+
+      private:
+	unsigned long filter_fft(gr_complex output[], const gr_complex input[],
+				 unsigned long n, unsigned int decimate);
+	void update_engine();
+
+	unsigned int     d_decimation;
+	filter_engine_t  d_engine;       // requested engine
+	filter_engine_t  d_active;       // resolved engine
+	int              d_fftsize;
+	overlap_save_ccc *d_fft;
+	folded_fir       d_folded;
       };
 
       /**************************************************************/
@@ -116,6 +180,23 @@ namespace gr {
 			unsigned long n,
 			unsigned int decimate);
 
+	/*!
+	 * \brief Selects the algorithm used by filterN and filterNdec.
+	 *
+	 * The default, ENGINE_AUTO, lets
+	 * gr::filter::kernel::filter_cost_model pick direct-form or
+	 * overlap-save convolution from the number of taps and the
+	 * decimation; the choice is redone whenever the taps change.
+	 * filter() always uses the direct form.
+	 */
+	void set_engine(filter_engine_t engine);
+
+	/*!
+	 * \brief Returns the engine filterN and filterNdec will use
+	 * (never ENGINE_AUTO).
+	 */
+	filter_engine_t engine() const;
+
       protected:
 	std::vector<gr_complex> d_taps;
 	unsigned int d_ntaps;
@@ -123,6 +204,17 @@ namespace gr {
 	gr_complex  *d_output;
 	int          d_align;
 	int          d_naligned;
+
+      private:
+	unsigned long filter_fft(gr_complex output[], const float input[],
+				 unsigned long n, unsigned int decimate);
+	void update_engine();
+
+	unsigned int     d_decimation;
+	filter_engine_t  d_engine;       // requested engine
+	filter_engine_t  d_active;       // resolved engine
+	int              d_fftsize;
+	overlap_save_fcc *d_fft;
       };
 
       /**************************************************************/
@@ -148,6 +240,23 @@ namespace gr {
 			unsigned long n,
 			unsigned int decimate);
 
+	/*!
+	 * \brief Selects the algorithm used by filterN and filterNdec.
+	 *
+	 * The default, ENGINE_AUTO, lets
+	 * gr::filter::kernel::filter_cost_model pick direct-form or
+	 * overlap-save convolution from the number of taps and the
+	 * decimation; the choice is redone whenever the taps change.
+	 * filter() always uses the direct form.
+	 */
+	void set_engine(filter_engine_t engine);
+
+	/*!
+	 * \brief Returns the engine filterN and filterNdec will use
+	 * (never ENGINE_AUTO).
+	 */
+	filter_engine_t engine() const;
+
       protected:
 	std::vector<gr_complex> d_taps;
 	unsigned int d_ntaps;
@@ -155,6 +264,17 @@ namespace gr {
 	gr_complex  *d_output;
 	int          d_align;
 	int          d_naligned;
+
+      private:
+	unsigned long filter_fft(gr_complex output[], const gr_complex input[],
+				 unsigned long n, unsigned int decimate);
+	void update_engine();
+
+	unsigned int     d_decimation;
+	filter_engine_t  d_engine;       // requested engine
+	filter_engine_t  d_active;       // resolved engine
+	int              d_fftsize;
+	overlap_save_ccc *d_fft;
       };
 
       /**************************************************************/
@@ -180,6 +300,23 @@ namespace gr {
 			unsigned long n,
 			unsigned int decimate);
 
+	/*!
+	 * \brief Selects the algorithm used by filterN and filterNdec.
+	 *
+	 * The default, ENGINE_AUTO, lets
+	 * gr::filter::kernel::filter_cost_model pick direct-form or
+	 * overlap-save convolution from the number of taps and the
+	 * decimation; the choice is redone whenever the taps change.
+	 * filter() always uses the direct form.
+	 */
+	void set_engine(filter_engine_t engine);
+
+	/*!
+	 * \brief Returns the engine filterN and filterNdec will use
+	 * (never ENGINE_AUTO).
+	 */
+	filter_engine_t engine() const;
+
       protected:
 	std::vector<gr_complex> d_taps;
 	unsigned int d_ntaps;
@@ -187,6 +324,17 @@ namespace gr {
 	gr_complex  *d_output;
 	int          d_align;
 	int          d_naligned;
+
+      private:
+	unsigned long filter_fft(gr_complex output[], const short input[],
+				 unsigned long n, unsigned int decimate);
+	void update_engine();
+
+	unsigned int     d_decimation;
+	filter_engine_t  d_engine;       // requested engine
+	filter_engine_t  d_active;       // resolved engine
+	int              d_fftsize;
+	overlap_save_fcc *d_fft;
       };
 
       /**************************************************************/
@@ -221,6 +369,46 @@ namespace gr {
 	int          d_naligned;
       };
 
+      /**************************************************************/
+
+      /*!
+       * \brief FIR filter with 16-bit complex (sc16) input and output
+       *
+       * The complex taps are quantized to Q15 (clamped to +/-32767)
+       * and products are rounded and scaled by 2^-15, so the filter
+       * gain is that of the float taps. Outputs saturate to the
+       * 16-bit range.
+       */
+      class FILTER_API fir_filter_sc16
+      {
+      public:
+	fir_filter_sc16(int decimation,
+			const std::vector<gr_complex> &taps);
+	~fir_filter_sc16();
+
+	void set_taps(const std::vector<gr_complex> &taps);
+	void update_tap(gr_complex t, unsigned int index);
+	std::vector<gr_complex> taps() const;
+	unsigned int ntaps() const;
+
+	std::complex<int16_t> filter(const std::complex<int16_t> input[]);
+	void filterN(std::complex<int16_t> output[],
+		     const std::complex<int16_t> input[],
+		     unsigned long n);
+	void filterNdec(std::complex<int16_t> output[],
+			const std::complex<int16_t> input[],
+			unsigned long n,
+			unsigned int decimate);
+
+      protected:
+	std::vector<gr_complex> d_taps;
+	unsigned int d_ntaps;
+	std::complex<int16_t> **d_aligned_taps;
+	std::complex<int16_t>  *d_output;
+	int          d_align;
+	int          d_naligned;
+      };
+
     } /* namespace kernel */
   } /* namespace filter */
 } /* namespace gr */
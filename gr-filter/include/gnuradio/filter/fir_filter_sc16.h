@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FIR_FILTER_SC16_H
+#define	INCLUDED_FILTER_FIR_FILTER_SC16_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief FIR filter with 16-bit complex (sc16) input and output
+     * and gr_complex taps
+     * \ingroup filter_blk
+     *
+     * \details
+     * Filters interleaved 16-bit I/Q samples without converting them
+     * to float, which halves the memory traffic of a high-rate
+     * front-end compared to fir_filter_ccc. Each item is one
+     * complex sample of two shorts; connect it to streams of shorts
+     * with a vector length of 2.
+     *
+     * The taps are quantized to Q15, so each must lie within
+     * [-1, 1). Products are rounded and scaled by 2^-15 so that the
+     * filter has the gain of the float taps; the output saturates
+     * to the 16-bit range.
+     *
+     * This filter can also act as a down-sampler (or decimator) by
+     * specifying an integer value for \p decimation.
+     */
+    class FILTER_API fir_filter_sc16 : virtual public sync_decimator
+    {
+    public:
+
+      // gr::filter::fir_filter_sc16::sptr
+      typedef boost::shared_ptr<fir_filter_sc16> sptr;
+
+      /*!
+       * \brief FIR filter with sc16 input and output and gr_complex taps
+       *
+       * \param decimation set the integer decimation rate
+       * \param taps a vector/list of complex taps, each within [-1, 1)
+       */
+      static sptr make(int decimation,
+                       const std::vector<gr_complex> &taps);
+
+      virtual void set_taps(const std::vector<gr_complex> &taps) = 0;
+      virtual std::vector<gr_complex> taps() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FIR_FILTER_SC16_H */
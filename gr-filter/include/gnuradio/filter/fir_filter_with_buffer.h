@@ -24,6 +24,7 @@
 #define INCLUDED_FILTER_FIR_FILTER_WITH_BUFFER_H
 
 #include <gnuradio/filter/api.h>
+#include <gnuradio/filter/filter_engine.h>
 #include <vector>
 #include <gnuradio/gr_complex.h>
 
@@ -47,6 +48,11 @@ namespace gr {
 	float        *d_output;
 	int           d_align;
 	int           d_naligned;
+	folded_fir    d_folded;
+	std::vector<float> d_scratch;
+
+	void filter_folded(float output[], const float input[],
+			   unsigned long n, unsigned long decimate);
 
       public:
 
@@ -241,6 +247,11 @@ namespace gr {
 	gr_complex   *d_output;
 	int           d_align;
 	int           d_naligned;
+	folded_fir    d_folded;
+	std::vector<gr_complex> d_scratch;
+
+	void filter_folded(gr_complex output[], const gr_complex input[],
+			   unsigned long n, unsigned long decimate);
 
       public:
 
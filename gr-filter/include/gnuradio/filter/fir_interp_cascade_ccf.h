@@ -0,0 +1,72 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FIR_INTERP_CASCADE_CCF_H
+#define	INCLUDED_FIR_INTERP_CASCADE_CCF_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_interpolator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief Multi-stage interpolating FIR filter with complex input,
+     * complex output and float taps.
+     * \ingroup filter_blk
+     *
+     * \details
+     * Stage i interpolates by rates[i] with the filter taps[i], as
+     * interp_fir_filter_ccf does, and the block interpolates by the
+     * product of the rates. All stages run in this block's thread
+     * on small chunks.
+     *
+     * gr::filter::multistage_interpolator_ccf, in Python, picks the
+     * stages and designs the taps for a given interpolation.
+     */
+    class FILTER_API fir_interp_cascade_ccf : virtual public sync_interpolator
+    {
+    public:
+      // gr::filter::fir_interp_cascade_ccf::sptr
+      typedef boost::shared_ptr<fir_interp_cascade_ccf> sptr;
+
+      /*!
+       * \param rates interpolation of each stage, first stage first
+       * \param taps  filter taps of each stage, with a passband gain
+       *              equal to the stage's interpolation
+       */
+      static sptr make(const std::vector<unsigned int> &rates,
+                       const std::vector<std::vector<float> > &taps);
+
+      /*!
+       * \brief Replaces the taps of all stages; the rates stay the
+       * same. The history of the stages is cleared.
+       */
+      virtual void set_taps(const std::vector<std::vector<float> > &taps) = 0;
+      virtual std::vector<std::vector<float> > taps() const = 0;
+      virtual std::vector<unsigned int> rates() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FIR_INTERP_CASCADE_CCF_H */
@@ -318,6 +318,28 @@ namespace gr {
 		      win_type window = WIN_HAMMING,
 		      double beta = 6.76);	// used only with Kaiser
 
+      /*!
+       * \brief use a Kaiser window to design a halfband low-pass
+       * FIR filter
+       *
+       * The cutoff is at sampling_freq / 4. The filter has 4k+3
+       * taps; every other tap is zero except the centre one, which
+       * is gain / 2. Used by the halfband decimators and
+       * interpolators, which skip the zero taps.
+       *
+       * \p gain:		overall gain of filter (typically 1.0, or 2.0
+       *			for interpolation)
+       * \p sampling_freq:	sampling freq (Hz)
+       * \p transition_width:	width of transition band (Hz), centred
+       *			on sampling_freq / 4
+       * \p attenuation_dB:	required stopband attenuation
+       */
+      static std::vector<float>
+	halfband(double gain,
+		 double sampling_freq,
+		 double transition_width,	// Hz width of transition band
+		 double attenuation_dB = 80);	// out of band attenuation dB
+
       /*!\brief design a Hilbert Transform Filter
        *
        * \p ntaps:              Number of taps, must be odd
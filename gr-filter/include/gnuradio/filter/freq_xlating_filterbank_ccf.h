@@ -0,0 +1,106 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FREQ_XLATING_FILTERBANK_CCF_H
+#define	INCLUDED_FILTER_FREQ_XLATING_FILTERBANK_CCF_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief A bank of frequency translating FIR filters that share
+     * one complex input, with float taps
+     *
+     * \ingroup channelizers_blk
+     *
+     * Channel k behaves like a freq_xlating_fir_filter_ccf with its
+     * own taps and center frequency, writing to output port k; all
+     * channels share the decimation rate and the sampling
+     * rate. Running the channels in one block instead of one
+     * freq_xlating_fir_filter_ccf per channel means the input is
+     * read once: it is processed in cache-sized chunks, and each
+     * chunk is filtered by every channel before moving to the next.
+     * The channels can also be split across several threads.
+     *
+     * The number of channels and the taps of each can change at run
+     * time. A channel only produces output if its output port is
+     * connected; ports without a channel produce zeros. Like
+     * freq_xlating_fir_filter_ccf, a "freq" tag is added to a
+     * channel's output when a new center frequency or new taps take
+     * effect.
+     */
+    class FILTER_API freq_xlating_filterbank_ccf : virtual public sync_decimator
+    {
+    public:
+      // gr::filter::freq_xlating_filterbank_ccf::sptr
+      typedef boost::shared_ptr<freq_xlating_filterbank_ccf> sptr;
+
+      /*!
+       * \brief Build the filter bank.
+       *
+       * \param decimation    set the integer decimation rate of every channel
+       * \param taps          a vector/list of tap vectors, one per channel
+       * \param center_freqs  center frequency of each channel (Hz)
+       * \param sampling_freq sampling rate of the input (Hz)
+       * \param nthreads      number of threads the channels are split across
+       */
+      static sptr make(int decimation,
+                       const std::vector<std::vector<float> > &taps,
+                       const std::vector<double> &center_freqs,
+                       double sampling_freq,
+                       int nthreads=1);
+
+      /*!
+       * \brief Adds channel \p chan, or replaces it if it exists.
+       */
+      virtual void set_channel(unsigned int chan,
+                               const std::vector<float> &taps,
+                               double center_freq) = 0;
+
+      /*!
+       * \brief Removes channel \p chan; its output port produces zeros.
+       */
+      virtual void remove_channel(unsigned int chan) = 0;
+
+      //! Number of channel slots, including removed ones.
+      virtual unsigned int nchans() const = 0;
+
+      //! True if channel \p chan exists.
+      virtual bool has_channel(unsigned int chan) const = 0;
+
+      virtual void set_center_freq(unsigned int chan, double center_freq) = 0;
+      virtual double center_freq(unsigned int chan) const = 0;
+
+      virtual void set_taps(unsigned int chan, const std::vector<float> &taps) = 0;
+      virtual std::vector<float> taps(unsigned int chan) const = 0;
+
+      virtual void set_nthreads(int nthreads) = 0;
+      virtual int nthreads() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FREQ_XLATING_FILTERBANK_CCF_H */
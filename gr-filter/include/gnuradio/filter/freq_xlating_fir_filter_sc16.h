@@ -0,0 +1,85 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FREQ_XLATING_FIR_FILTER_SC16_H
+#define	INCLUDED_FILTER_FREQ_XLATING_FIR_FILTER_SC16_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief FIR filter combined with frequency translation with
+     * 16-bit complex (sc16) input and output and float taps
+     *
+     * \ingroup channelizers_blk
+     *
+     * The fixed-point counterpart of freq_xlating_fir_filter_ccf.
+     * It combines a frequency translation with a FIR filter and
+     * decimation while keeping the samples as interleaved 16-bit I/Q
+     * end to end, for channelizers fed directly by sc16 front-ends.
+     * Each item is one complex sample of two shorts.
+     *
+     * The band-pass taps derived from \p taps are quantized to Q15
+     * and the output is derotated with a 16-bit rotator; see
+     * fir_filter_sc16 for the scaling and saturation rules.
+     *
+     * - freq (input):
+     *        Receives a PMT pair: (intern("freq"), double(frequency).
+     *        The block then sets its frequency translation value to
+     *        the new frequency provided by the message. A tag is then
+     *        produced when the new frequency is applied to let
+     *        downstream blocks know when this has taken affect.
+     */
+    class FILTER_API freq_xlating_fir_filter_sc16 : virtual public sync_decimator
+    {
+    public:
+      // gr::filter::freq_xlating_fir_filter_sc16::sptr
+      typedef boost::shared_ptr<freq_xlating_fir_filter_sc16> sptr;
+
+      /*!
+       * \brief FIR filter with sc16 input and output and float taps
+       * that also frequency translates a signal from \p center_freq.
+       *
+       * \param decimation set the integer decimation rate
+       * \param taps a vector/list of float taps, each within [-1, 1)
+       * \param center_freq Center frequency of signal to down convert from (Hz)
+       * \param sampling_freq Sampling rate of signal (in Hz)
+       */
+      static sptr make(int decimation,
+                       const std::vector<float> &taps,
+                       double center_freq,
+                       double sampling_freq);
+
+      virtual void set_center_freq(double center_freq) = 0;
+      virtual double center_freq() const = 0;
+
+      virtual void set_taps(const std::vector<float> &taps) = 0;
+      virtual std::vector<float> taps() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FREQ_XLATING_FIR_FILTER_SC16_H */
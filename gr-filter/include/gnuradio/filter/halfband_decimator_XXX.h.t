@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* @WARNING@ */
+
+#ifndef @GUARD_NAME@
+#define	@GUARD_NAME@
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief Halfband decimator by 2 with @I_TYPE@ input, @O_TYPE@ output and @TAP_TYPE@ taps
+     * \ingroup filter_blk
+     *
+     * \details
+     * Low-pass filters and decimates by 2 with a halfband filter:
+     * the output is the same as fir_filter_XXX with decimation 2
+     * and the same taps, for about a quarter of the multiplies. The
+     * zero taps are skipped and the symmetric taps are folded, so
+     * each output costs one multiply per pair of non-zero taps plus
+     * one for the centre tap.
+     *
+     * The taps must be a halfband filter with 4k+3 taps, for
+     * example from firdes.halfband(1, fs, transition_width). Taps
+     * that are not symmetric, or whose taps at even offsets from
+     * the centre are not zero, are rejected.
+     */
+    class FILTER_API @BASE_NAME@ : virtual public sync_decimator
+    {
+    public:
+      // gr::filter::@BASE_NAME@::sptr
+      typedef boost::shared_ptr<@BASE_NAME@> sptr;
+
+      /*!
+       * \brief Halfband decimator by 2 with @I_TYPE@ input, @O_TYPE@ output and @TAP_TYPE@ taps
+       *
+       * \param taps halfband filter taps, e.g. from firdes::halfband()
+       */
+      static sptr make(const std::vector<@TAP_TYPE@> &taps);
+
+      virtual void set_taps(const std::vector<@TAP_TYPE@> &taps) = 0;
+      virtual std::vector<@TAP_TYPE@> taps() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* @GUARD_NAME@ */
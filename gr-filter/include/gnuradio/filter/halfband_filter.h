@@ -0,0 +1,131 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_HALFBAND_FILTER_H
+#define INCLUDED_FILTER_HALFBAND_FILTER_H
+
+#include <gnuradio/filter/api.h>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      /*!
+       * \brief Decimate-by-2 halfband FIR filter.
+       * \ingroup filter_blk
+       *
+       * \details
+       * A halfband filter has 4k+3 symmetric taps, and every other
+       * tap is zero except the centre one. Decimating by 2, each
+       * output needs one multiply for the centre tap and k+1 for the
+       * folded pairs of non-zero taps, about a quarter of the
+       * multiplies of fir_filter_ccf. Taps without this structure
+       * (see is_halfband()) throw std::invalid_argument;
+       * firdes::halfband() designs such filters.
+       *
+       * Samples are \p lanes floats wide, so one kernel handles float
+       * (1) and complex (2) streams with real taps. Outputs are
+       * computed in blocks: the input is split into its even and odd
+       * samples, then each pair of taps is applied to the whole
+       * block in a loop over contiguous floats that the compiler
+       * vectorizes.
+       *
+       * The result is the same as fir_filter_XXX with decimation 2:
+       * output m is computed from inputs 2m to 2m + ntaps() - 1.
+       */
+      class FILTER_API halfband_decimator
+      {
+      public:
+        halfband_decimator(const std::vector<float> &taps,
+                           unsigned int lanes=1);
+
+        /*!
+         * \brief True if \p taps has the length and zero taps of a
+         * halfband filter and is symmetric.
+         */
+        static bool is_halfband(const std::vector<float> &taps);
+
+        void set_taps(const std::vector<float> &taps);
+        std::vector<float> taps() const { return d_taps; }
+        unsigned int ntaps() const { return d_taps.size(); }
+
+        /*!
+         * \brief Writes \p n outputs computed from 2n + ntaps() - 2
+         * inputs.
+         */
+        void filterN(float output[], const float input[], unsigned long n);
+
+      private:
+        std::vector<float> d_taps;
+        std::vector<float> d_pairs;   // taps at odd offsets from the centre, nearest first
+        float              d_center;
+        unsigned int       d_lanes;
+        std::vector<float> d_even;    // even input samples of one block
+      };
+
+      /*!
+       * \brief Interpolate-by-2 halfband FIR filter.
+       * \ingroup filter_blk
+       *
+       * \details
+       * Of the two polyphase branches of a halfband filter, one has
+       * only the centre tap and the other has the folded pairs of
+       * non-zero taps; see halfband_decimator. The passband gain of
+       * the taps should be 2.
+       *
+       * The result is the same as interp_fir_filter_XXX with
+       * interpolation 2: outputs 2m and 2m+1 are computed from
+       * inputs m to m + history() - 1.
+       */
+      class FILTER_API halfband_interpolator
+      {
+      public:
+        halfband_interpolator(const std::vector<float> &taps,
+                              unsigned int lanes=1);
+
+        void set_taps(const std::vector<float> &taps);
+        std::vector<float> taps() const { return d_taps; }
+        unsigned int ntaps() const { return d_taps.size(); }
+
+        //! Number of input samples each pair of outputs depends on.
+        unsigned int history() const { return (d_taps.size() + 1) / 2; }
+
+        /*!
+         * \brief Writes 2n outputs computed from n + history() - 1
+         * inputs.
+         */
+        void filterN(float output[], const float input[], unsigned long n);
+
+      private:
+        std::vector<float> d_taps;
+        std::vector<float> d_pairs;   // taps at odd offsets from the centre, nearest first
+        float              d_center;
+        unsigned int       d_lanes;
+        std::vector<float> d_branch;  // even outputs of one block
+      };
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_HALFBAND_FILTER_H */
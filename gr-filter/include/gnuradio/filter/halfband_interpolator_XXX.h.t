@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* @WARNING@ */
+
+#ifndef @GUARD_NAME@
+#define	@GUARD_NAME@
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_interpolator.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief Halfband interpolator by 2 with @I_TYPE@ input, @O_TYPE@ output and @TAP_TYPE@ taps
+     * \ingroup filter_blk
+     *
+     * \details
+     * Interpolates by 2 with a halfband filter: the output is the
+     * same as interp_fir_filter_XXX with interpolation 2 and the
+     * same taps, for about half the multiplies. One output of each
+     * pair is the centre tap times an input sample; the other uses
+     * the folded pairs of non-zero taps.
+     *
+     * The taps must be a halfband filter with 4k+3 taps and a
+     * passband gain of 2, for example from firdes.halfband(2, fs,
+     * transition_width). Taps that are not symmetric, or whose taps
+     * at even offsets from the centre are not zero, are rejected.
+     */
+    class FILTER_API @BASE_NAME@ : virtual public sync_interpolator
+    {
+    public:
+      // gr::filter::@BASE_NAME@::sptr
+      typedef boost::shared_ptr<@BASE_NAME@> sptr;
+
+      /*!
+       * \brief Halfband interpolator by 2 with @I_TYPE@ input, @O_TYPE@ output and @TAP_TYPE@ taps
+       *
+       * \param taps halfband filter taps with a gain of 2, e.g. from firdes::halfband()
+       */
+      static sptr make(const std::vector<@TAP_TYPE@> &taps);
+
+      virtual void set_taps(const std::vector<@TAP_TYPE@> &taps) = 0;
+      virtual std::vector<@TAP_TYPE@> taps() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* @GUARD_NAME@ */
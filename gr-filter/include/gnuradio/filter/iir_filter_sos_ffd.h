@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_IIR_FILTER_SOS_FFD_H
+#define	INCLUDED_IIR_FILTER_SOS_FFD_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief IIR filter with float input, float output and double taps, given as
+     * second-order sections
+     * \ingroup filter_blk
+     *
+     * \details
+     * The filter is a cascade of biquads. Each section is a row of
+     * six coefficients [b0, b1, b2, a0, a1, a2], the layout of the
+     * "sos" output of scipy.signal and Matlab's sosfilt. Use this
+     * instead of iir_filter_ffd for narrow or high-order designs,
+     * which are numerically fragile as a single difference
+     * equation. The filter state is kept in double precision.
+     *
+     * With \p vlen > 1 the block filters vectors of \p vlen
+     * independent channels with the same sections, which is much
+     * faster than \p vlen separate filters.
+     */
+    class FILTER_API iir_filter_sos_ffd : virtual public sync_block
+    {
+    public:
+      // gr::filter::iir_filter_sos_ffd::sptr
+      typedef boost::shared_ptr<iir_filter_sos_ffd> sptr;
+
+      /*!
+       * \param sos  list of sections, each [b0, b1, b2, a0, a1, a2]
+       * \param vlen number of channels in each input and output vector
+       */
+      static sptr make(const std::vector<std::vector<double> > &sos,
+                       unsigned int vlen=1);
+
+      virtual void set_taps(const std::vector<std::vector<double> > &sos) = 0;
+      virtual std::vector<std::vector<double> > taps() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_IIR_FILTER_SOS_FFD_H */
@@ -0,0 +1,102 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_MULTIRES_SPECTRUM_CVF_H
+#define INCLUDED_FILTER_MULTIRES_SPECTRUM_CVF_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+
+    /*!
+     * \brief Multi-resolution (constant-Q) power spectrum: complex
+     * stream in, one spectrum vector of float out.
+     * \ingroup fourier_analysis_blk
+     *
+     * \details
+     * The input is split into \p noctaves bands. Band 0 is the input
+     * itself, and each following band is the previous one filtered
+     * by a halfband filter and decimated by 2, with the
+     * kernel::halfband_decimator the halfband decimator blocks use;
+     * band j is the output of j halfband_decimator_ccf in a row.
+     * Every band is transformed in frames of \p fft_size samples, so
+     * band j has bins fs / (fft_size 2^j) wide: the resolution is
+     * finest at the lowest frequencies and each octave has about as
+     * many bins.
+     *
+     * Band j only contributes the frequencies where band j+1 does
+     * not: |f| from 3/16 to 3/8 of its own sample rate, or from 3/16
+     * up to fs/2 for band 0. The last band contributes everything
+     * below 3/8 of its sample rate. The halfband filters keep
+     * aliases out of that range: their stopband starts at 5/16 of
+     * their input rate.
+     *
+     * One output covers fft_size * 2^(noctaves-1) input samples:
+     * one frame of the last band and 2^(noctaves-1-j) frames of band
+     * j, whose |X|^2 are averaged. The output is
+     * fft_size + 3/8 fft_size (noctaves - 1) bins in order of
+     * frequency from -fs/2 up; bin_freqs() gives the centre of each.
+     * The bins are |X|^2 of the windowed FFTs, so a tone reads the
+     * same in every band while a noise floor drops by 3 dB per
+     * octave, as the bins get narrower.
+     */
+    class FILTER_API multires_spectrum_cvf : virtual public sync_decimator
+    {
+    public:
+
+      // gr::filter::multires_spectrum_cvf::sptr
+      typedef boost::shared_ptr<multires_spectrum_cvf> sptr;
+
+      /*!
+       * \param fft_size FFT size of every band, a multiple of 16
+       * \param noctaves number of bands, at least 1; the decimation
+       *                 fft_size << (noctaves-1) must fit in an int
+       * \param window window of fft_size taps, or empty
+       * \param attenuation_dB stopband attenuation of the halfband filters
+       * \param nthreads number of threads the FFTs use
+       */
+      static sptr make(int fft_size, int noctaves,
+                       const std::vector<float> &window,
+                       double attenuation_dB=80, int nthreads=1);
+
+      //! Number of bins in each output vector.
+      virtual int nbins() const = 0;
+
+      /*!
+       * \brief Centre frequency of each output bin, as a fraction of
+       * the sample rate.
+       */
+      virtual std::vector<float> bin_freqs() const = 0;
+
+      virtual bool set_window(const std::vector<float> &window) = 0;
+
+      virtual void set_nthreads(int n) = 0;
+      virtual int nthreads() const = 0;
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_MULTIRES_SPECTRUM_CVF_H */
@@ -25,6 +25,7 @@
 #define	INCLUDED_PFB_ARB_RESAMPLER_H
 
 #include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/resampler_engine.h>
 
 namespace gr {
   namespace filter {
@@ -94,8 +95,8 @@ namespace gr {
       class FILTER_API pfb_arb_resampler_ccf
       {
       private:
-        std::vector<fir_filter_ccf*> d_filters;
-        std::vector<fir_filter_ccf*> d_diff_filters;
+        resampler_engine_ccf d_engine;     // all arms and derivative arms
+        resampler_schedule d_schedule;    // arm, offset and fraction of each output
         std::vector< std::vector<float> > d_taps;
         std::vector< std::vector<float> > d_dtaps;
         unsigned int d_int_rate;          // the number of filters (interpolation rate)
@@ -122,11 +123,9 @@ namespace gr {
          * \param newtaps    (vector of floats) The prototype filter to populate the filterbank.
          *                   The taps should be generated at the interpolated sampling rate.
          * \param ourtaps    (vector of floats) Reference to our internal member of holding the taps.
-         * \param ourfilter  (vector of filters) Reference to our internal filter to set the taps for.
          */
         void create_taps(const std::vector<float> &newtaps,
-                         std::vector< std::vector<float> > &ourtaps,
-                         std::vector<kernel::fir_filter_ccf*> &ourfilter);
+                         std::vector< std::vector<float> > &ourtaps);
 
       public:
         /*!
@@ -203,6 +202,10 @@ namespace gr {
          * such that the output has \p rate * \p n_to_read amount of
          * space available in the \p output buffer.
          *
+         * The arm and input of every output are scheduled before any
+         * output is computed, and the outputs are then computed
+         * together by resampler_engine_ccf.
+         *
          * \param output The output samples at the new sample rate.
          * \param input An input vector of samples to be resampled
          * \param n_to_read Number of samples to read from \p input.
@@ -407,8 +410,8 @@ namespace gr {
       class FILTER_API pfb_arb_resampler_fff
       {
       private:
-        std::vector<fir_filter_fff*> d_filters;
-        std::vector<fir_filter_fff*> d_diff_filters;
+        resampler_engine_fff d_engine;     // all arms and derivative arms
+        resampler_schedule d_schedule;    // arm, offset and fraction of each output
         std::vector< std::vector<float> > d_taps;
         std::vector< std::vector<float> > d_dtaps;
         unsigned int d_int_rate;          // the number of filters (interpolation rate)
@@ -435,11 +438,9 @@ namespace gr {
          * \param newtaps    (vector of floats) The prototype filter to populate the filterbank.
          *                   The taps should be generated at the interpolated sampling rate.
          * \param ourtaps    (vector of floats) Reference to our internal member of holding the taps.
-         * \param ourfilter  (vector of filters) Reference to our internal filter to set the taps for.
          */
         void create_taps(const std::vector<float> &newtaps,
-                         std::vector< std::vector<float> > &ourtaps,
-                         std::vector<kernel::fir_filter_fff*> &ourfilter);
+                         std::vector< std::vector<float> > &ourtaps);
 
       public:
         /*!
@@ -516,6 +517,10 @@ namespace gr {
          * such that the output has \p rate * \p n_to_read amount of
          * space available in the \p output buffer.
          *
+         * The arm and input of every output are scheduled before any
+         * output is computed, and the outputs are then computed
+         * together by resampler_engine_fff.
+         *
          * \param output The output samples at the new sample rate.
          * \param input An input vector of samples to be resampled
          * \param n_to_read Number of samples to read from \p input.
@@ -142,10 +142,13 @@ namespace gr {
        *				sample rate of a 6/1
        *				oversample ratio is 6000 Hz,
        *				or 6 times the normal 1000 Hz.
+       * \param nthreads (int) Number of threads the filterbank and
+       *                 the FFTs are split across.
        */
       static sptr make(unsigned int numchans,
 				  const std::vector<float> &taps,
-				  float oversample_rate);
+				  float oversample_rate,
+				  int nthreads=1);
 
       /*!
        * Resets the filterbank's filter taps with the new prototype filter
@@ -200,6 +203,17 @@ namespace gr {
        * Gets the current channel map.
        */
       virtual std::vector<int> channel_map() const = 0;
+
+      /*!
+       * Sets the number of threads the filterbank and the FFTs are
+       * split across.
+       */
+      virtual void set_nthreads(int nthreads) = 0;
+
+      /*!
+       * Gets the number of threads used by the channelizer.
+       */
+      virtual int nthreads() const = 0;
     };
 
   } /* namespace filter */
@@ -0,0 +1,181 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_RESAMPLER_ENGINE_H
+#define INCLUDED_FILTER_RESAMPLER_ENGINE_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      /*!
+       * \brief The filter arm, input offset and interpolation
+       * fraction of each output of an arbitrary-ratio resampler.
+       *
+       * \details
+       * The resampler fills a schedule for all the outputs of one
+       * call to work() while it steps its phase accumulator, then
+       * hands it to a resampler_engine_XXX, which computes the
+       * outputs without touching the resampler state again.
+       */
+      struct FILTER_API resampler_schedule
+      {
+        std::vector<unsigned int> arm;
+        std::vector<unsigned int> offset;
+        std::vector<float>        frac;
+
+        void clear() { arm.clear(); offset.clear(); frac.clear(); }
+        unsigned long size() const { return arm.size(); }
+
+        void push(unsigned int a, unsigned int o, float f=0)
+        {
+          arm.push_back(a);
+          offset.push_back(o);
+          frac.push_back(f);
+        }
+      };
+
+      /*!
+       * \brief Bank of polyphase filter arms run over a
+       * resampler_schedule, with gr_complex input, gr_complex output
+       * and float taps.
+       * \ingroup resamplers_blk
+       *
+       * \details
+       * All the arms have the same number of taps and are stored
+       * reversed in one aligned block, each at every alignment of
+       * the input the same way fir_filter_ccf stores its taps, so
+       * every output is a single aligned VOLK dot product with no
+       * per-output setup. Output m of a schedule is
+       *
+       *   taps[arm[m]] . input[offset[m] ...]
+       *     + frac[m] * diff_taps[arm[m]] . input[offset[m] ...]
+       *
+       * where the second term is only computed if diff taps are set.
+       */
+      class FILTER_API resampler_engine_ccf
+      {
+      public:
+        resampler_engine_ccf();
+        ~resampler_engine_ccf();
+
+        /*!
+         * \brief Sets one row of taps per arm, in natural order; all
+         * rows must have the same length.
+         */
+        void set_taps(const std::vector< std::vector<float> > &taps);
+
+        /*!
+         * \brief Sets the arms and the derivative arms that outputs
+         * are linearly interpolated with.
+         */
+        void set_taps(const std::vector< std::vector<float> > &taps,
+                      const std::vector< std::vector<float> > &diff_taps);
+
+        unsigned int narms() const { return d_narms; }
+        unsigned int ntaps() const { return d_ntaps; }
+
+        /*!
+         * \brief Writes one output per schedule entry. The input must
+         * hold the last offset plus ntaps() samples.
+         */
+        void filter(gr_complex output[], const gr_complex input[],
+                    const resampler_schedule &schedule);
+
+      private:
+        unsigned int d_narms;
+        unsigned int d_ntaps;
+        int          d_align;
+        int          d_naligned;
+        unsigned int d_stride;      // floats per copy of an arm
+        float       *d_taps;        // [arm][alignment][d_stride]
+        float       *d_diff_taps;   // same layout, or NULL
+        gr_complex  *d_output;
+
+        void store(float *&bank, const std::vector< std::vector<float> > &taps);
+        const float *row(const float *bank, unsigned int arm, unsigned int al) const
+        {
+          return bank + (arm*d_naligned + al)*d_stride;
+        }
+
+        resampler_engine_ccf(const resampler_engine_ccf&);
+        resampler_engine_ccf& operator=(const resampler_engine_ccf&);
+      };
+
+      /*!
+       * \brief Bank of polyphase filter arms run over a
+       * resampler_schedule, with float input, float output and
+       * float taps.
+       * \ingroup resamplers_blk
+       *
+       * \details
+       * See resampler_engine_ccf. When diff taps are set, each arm
+       * and its derivative arm are interleaved as the real and
+       * imaginary parts of one complex row, so one VOLK dot product
+       * over the input gives both filter outputs.
+       */
+      class FILTER_API resampler_engine_fff
+      {
+      public:
+        resampler_engine_fff();
+        ~resampler_engine_fff();
+
+        void set_taps(const std::vector< std::vector<float> > &taps);
+        void set_taps(const std::vector< std::vector<float> > &taps,
+                      const std::vector< std::vector<float> > &diff_taps);
+
+        unsigned int narms() const { return d_narms; }
+        unsigned int ntaps() const { return d_ntaps; }
+
+        void filter(float output[], const float input[],
+                    const resampler_schedule &schedule);
+
+      private:
+        unsigned int d_narms;
+        unsigned int d_ntaps;
+        int          d_align;
+        int          d_naligned;
+        unsigned int d_stride;      // taps per copy of an arm
+        bool         d_interleaved; // taps are (tap, diff tap) pairs
+        float       *d_taps;        // [arm][alignment][d_stride]
+        float       *d_output;
+
+        void store(const std::vector< std::vector<float> > &taps,
+                   const std::vector< std::vector<float> > *diff_taps);
+        const float *row(unsigned int arm, unsigned int al) const
+        {
+          return d_taps + (arm*d_naligned + al)*d_stride*(d_interleaved ? 2 : 1);
+        }
+
+        resampler_engine_fff(const resampler_engine_fff&);
+        resampler_engine_fff& operator=(const resampler_engine_fff&);
+      };
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_RESAMPLER_ENGINE_H */
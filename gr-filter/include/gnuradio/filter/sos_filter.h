@@ -0,0 +1,193 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_SOS_FILTER_H
+#define INCLUDED_FILTER_SOS_FILTER_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      /*!
+       * \brief IIR filter as a cascade of second-order sections
+       *
+       * \details
+       * Each section is given as a row of six coefficients
+       * [b0, b1, b2, a0, a1, a2], the layout used by scipy.signal
+       * (sosfilt, butter(..., output='sos')) and Matlab's sosfilt,
+       * and implements
+       \f[
+       H_s(z) = \frac{b_0 + b_1 z^{-1} + b_2 z^{-2}}{a_0 + a_1 z^{-1} + a_2 z^{-2}}
+       \f]
+       * The filter is the product of the sections. Unlike a single
+       * high-order Direct Form I filter, narrow high-order designs
+       * stay stable with this structure. Each section is evaluated in
+       * Direct Form II transposed with a state of type \p state_type,
+       * which should be double precision for narrow filters.
+       *
+       * The filter runs \p vlen independent channels with the same
+       * coefficients; input and output are vectors of \p vlen
+       * samples, one per channel. Samples are processed a block at a
+       * time, one section after the other over the whole block, and
+       * the innermost loop runs across the channels, so the compiler
+       * can vectorize it when there are many channels.
+       */
+      template<class i_type, class o_type, class state_type>
+      class sos_filter
+      {
+      public:
+	/*!
+	 * \brief Construct the filter.
+	 *
+	 * \param sos  one row of six coefficients per section
+	 * \param vlen number of channels filtered in parallel
+	 */
+	sos_filter(const std::vector<std::vector<double> > &sos,
+		   unsigned int vlen=1)
+	  throw (std::invalid_argument)
+	  : d_vlen(vlen)
+	{
+	  if(vlen == 0)
+	    throw std::invalid_argument("sos_filter: vlen must be at least 1");
+	  set_taps(sos);
+	}
+
+	~sos_filter() {}
+
+	/*!
+	 * \brief install new sections and clear the filter state.
+	 */
+	void set_taps(const std::vector<std::vector<double> > &sos)
+	  throw (std::invalid_argument)
+	{
+	  std::vector<double> coeffs(5 * sos.size());
+	  for(size_t s = 0; s < sos.size(); s++) {
+	    if(sos[s].size() != 6)
+	      throw std::invalid_argument("sos_filter: each section needs 6 coefficients");
+	    if(sos[s][3] == 0.0)
+	      throw std::invalid_argument("sos_filter: a0 must not be 0");
+
+	    // Normalize so that a0 = 1.
+	    const double a0 = sos[s][3];
+	    coeffs[5*s+0] = sos[s][0] / a0;
+	    coeffs[5*s+1] = sos[s][1] / a0;
+	    coeffs[5*s+2] = sos[s][2] / a0;
+	    coeffs[5*s+3] = sos[s][4] / a0;
+	    coeffs[5*s+4] = sos[s][5] / a0;
+	  }
+
+	  d_sos = sos;
+	  d_coeffs = coeffs;
+	  d_state.assign(2 * sos.size() * d_vlen, state_type(0));
+	}
+
+	/*!
+	 * \brief Return the sections as given to set_taps.
+	 */
+	std::vector<std::vector<double> > taps() const { return d_sos; }
+
+	unsigned int nsections() const { return d_sos.size(); }
+	unsigned int vlen() const { return d_vlen; }
+
+	/*!
+	 * \brief clear the filter state.
+	 */
+	void reset()
+	{
+	  std::fill(d_state.begin(), d_state.end(), state_type(0));
+	}
+
+	/*!
+	 * \brief compute n output vectors.
+	 * \p input must have n vectors of vlen() samples.
+	 */
+	void filter_n(o_type output[], const i_type input[], long n);
+
+      private:
+	// Samples (n * vlen) processed per pass through the sections.
+	static const long BLOCK_ITEMS = 4096;
+
+	unsigned int                          d_vlen;
+	std::vector<std::vector<double> >     d_sos;
+	std::vector<double>                   d_coeffs; // b0 b1 b2 a1 a2 per section
+	std::vector<state_type>               d_state;  // z1 then z2 of each section, per channel
+	std::vector<state_type>               d_work;
+      };
+
+      template<class i_type, class o_type, class state_type>
+      void
+      sos_filter<i_type, o_type, state_type>::filter_n(o_type output[],
+						       const i_type input[],
+						       long n)
+      {
+	const unsigned int vlen = d_vlen;
+	const unsigned int nsections = d_sos.size();
+	const long block = std::max(1L, BLOCK_ITEMS / (long)vlen);
+	d_work.resize(std::min(n, block) * vlen);
+
+	for(long start = 0; start < n; start += block) {
+	  const long nblock = std::min(block, n - start);
+	  const long nitems = nblock * vlen;
+	  state_type *work = &d_work[0];
+
+	  for(long k = 0; k < nitems; k++)
+	    work[k] = state_type(input[start*vlen + k]);
+
+	  // Run each section over the whole block before the next one,
+	  // so its coefficients and state stay in registers.
+	  for(unsigned int s = 0; s < nsections; s++) {
+	    const double b0 = d_coeffs[5*s+0];
+	    const double b1 = d_coeffs[5*s+1];
+	    const double b2 = d_coeffs[5*s+2];
+	    const double a1 = d_coeffs[5*s+3];
+	    const double a2 = d_coeffs[5*s+4];
+	    state_type *z1 = &d_state[2*s*vlen];
+	    state_type *z2 = z1 + vlen;
+
+	    for(long i = 0; i < nblock; i++) {
+	      state_type *x = work + i*vlen;
+	      for(unsigned int c = 0; c < vlen; c++) {
+		const state_type xc = x[c];
+		const state_type y = b0*xc + z1[c];
+		z1[c] = b1*xc - a1*y + z2[c];
+		z2[c] = b2*xc - a2*y;
+		x[c] = y;
+	      }
+	    }
+	  }
+
+	  for(long k = 0; k < nitems; k++)
+	    output[start*vlen + k] = o_type(work[k]);
+	}
+      }
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_SOS_FILTER_H */
@@ -0,0 +1,92 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_WORKER_POOL_H
+#define INCLUDED_FILTER_WORKER_POOL_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/thread/thread.h>
+#include <gnuradio/thread/thread_group.h>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      /*!
+       * \brief A fixed set of threads that a block's work function
+       * can split its computation across.
+       * \ingroup filter_blk
+       *
+       * \details
+       * run(job) calls job(i) once for each i in [0, nthreads()) and
+       * returns when all calls have finished. The calling thread runs
+       * job(0) itself, so a pool of one thread starts no threads and
+       * costs nothing. The other threads are started by the
+       * constructor and sleep between calls, so there is no thread
+       * creation in the work path.
+       *
+       * A job is typically a bound member function that processes
+       * every nthreads()-th item of some list, for example the
+       * channels of a filter bank.
+       */
+      class FILTER_API worker_pool : boost::noncopyable
+      {
+      public:
+        typedef boost::function<void (int)> job_t;
+
+        /*!
+         * \param nthreads number of threads jobs are split across,
+         *        including the caller of run(); values below 1 are
+         *        treated as 1.
+         */
+        worker_pool(int nthreads);
+        ~worker_pool();
+
+        int nthreads() const { return d_nthreads; }
+
+        /*!
+         * \brief Runs job(0) .. job(nthreads()-1) concurrently and
+         * waits for all of them.
+         */
+        void run(const job_t &job);
+
+      private:
+        int                             d_nthreads;
+        gr::thread::thread_group        d_threads;
+        gr::thread::mutex               d_mutex;
+        gr::thread::condition_variable  d_start;
+        gr::thread::condition_variable  d_done;
+        job_t                           d_job;
+        unsigned long                   d_generation;
+        int                             d_pending;
+        bool                            d_shutdown;
+
+        void worker(int index);
+      };
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_WORKER_POOL_H */
@@ -0,0 +1,431 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "fft_channelizer_ccf_impl.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+namespace gr {
+  namespace filter {
+
+    fft_channelizer_ccf::sptr
+    fft_channelizer_ccf::make(int fft_size,
+                              const std::vector<int> &decimations,
+                              const std::vector<std::vector<float> > &taps,
+                              const std::vector<double> &center_freqs,
+                              double sampling_freq,
+                              int nthreads)
+    {
+      return gnuradio::get_initial_sptr
+        (new fft_channelizer_ccf_impl(fft_size, decimations, taps,
+                                      center_freqs, sampling_freq,
+                                      nthreads));
+    }
+
+    fft_channelizer_ccf_impl::fft_channelizer_ccf_impl
+        (int fft_size,
+         const std::vector<int> &decimations,
+         const std::vector<std::vector<float> > &taps,
+         const std::vector<double> &center_freqs,
+         double sampling_freq,
+         int nthreads)
+    : block("fft_channelizer_ccf",
+            io_signature::make(1, 1, sizeof(gr_complex)),
+            io_signature::make(1, -1, sizeof(gr_complex))),
+      d_fft_size(fft_size),
+      d_sampling_freq(sampling_freq),
+      d_fwdfft(NULL), d_pool(NULL)
+    {
+      if(fft_size <= 0 || fft_size % 4 != 0)
+        throw std::invalid_argument("fft_channelizer_ccf: fft_size must be a positive multiple of 4");
+      if(taps.size() != center_freqs.size() || taps.size() != decimations.size())
+        throw std::invalid_argument("fft_channelizer_ccf: decimations, taps and center_freqs must have the same length");
+
+      d_overlap = fft_size / 4;
+      d_step = fft_size - d_overlap;
+      d_out_step = d_step;
+
+      d_fwdfft = new fft::fft_complex(fft_size, true, nthreads,
+                                      std::max(1, BATCH_ITEMS / fft_size));
+      d_pool = new kernel::worker_pool(nthreads);
+
+      for(unsigned int i = 0; i < taps.size(); i++)
+        set_channel(i, taps[i], center_freqs[i], decimations[i]);
+
+      // Each FFT is fed d_overlap samples of the previous one and
+      // produces at most d_step items on a port.
+      set_history(d_overlap + 1);
+      set_output_multiple(d_step);
+
+      // The ports run at different rates, so tag offsets cannot be
+      // mapped with a single relative rate.
+      set_tag_propagation_policy(TPP_DONT);
+    }
+
+    fft_channelizer_ccf_impl::~fft_channelizer_ccf_impl()
+    {
+      for(unsigned int i = 0; i < d_channels.size(); i++) {
+        if(d_channels[i] != NULL)
+          free_channel(d_channels[i]);
+      }
+      delete d_fwdfft;
+      delete d_pool;
+    }
+
+    void
+    fft_channelizer_ccf_impl::free_channel(channel *ch)
+    {
+      delete ch->invfft;
+      if(ch->xformed_taps != NULL)
+        volk_free(ch->xformed_taps);
+      delete ch;
+    }
+
+    /*
+     * Copies \p n bins of a spectrum of \p fft_size bins, starting at
+     * bin \p first (taken modulo fft_size) and wrapping around.
+     */
+    static void
+    copy_bins(gr_complex *dst, const gr_complex *spectrum,
+              int fft_size, int first, int n)
+    {
+      first %= fft_size;
+      if(first < 0)
+        first += fft_size;
+
+      int n1 = std::min(n, fft_size - first);
+      memcpy(dst, spectrum + first, n1 * sizeof(gr_complex));
+      memcpy(dst + n1, spectrum, (n - n1) * sizeof(gr_complex));
+    }
+
+    /*
+     * Bins of a channel in the order of its inverse FFT: the upper
+     * half starts at the channel's bin, the lower half ends just
+     * below it.
+     */
+    static void
+    select_bins(gr_complex *dst, const gr_complex *spectrum,
+                int fft_size, int bin, int nbins)
+    {
+      copy_bins(dst, spectrum, fft_size, bin, nbins/2);
+      copy_bins(dst + nbins/2, spectrum, fft_size, bin - nbins/2, nbins/2);
+    }
+
+    void
+    fft_channelizer_ccf_impl::build_channel(channel *ch)
+    {
+      const int nbins = d_fft_size / ch->decimation;
+
+      if(ch->invfft == NULL || ch->invfft->fft_size() != nbins) {
+        delete ch->invfft;
+        if(ch->xformed_taps != NULL)
+          volk_free(ch->xformed_taps);
+        ch->invfft = new fft::fft_complex(nbins, false, 1, d_fwdfft->batch());
+        ch->xformed_taps = (gr_complex*)volk_malloc(nbins * sizeof(gr_complex),
+                                                    volk_get_alignment());
+      }
+
+      // Same composite taps as freq_xlating_fir_filter_ccf: the
+      // prototype low-pass moved up to the center frequency.
+      const double fwT0 = 2 * M_PI * ch->center_freq / d_sampling_freq;
+      gr_complex *in = d_fwdfft->get_inbuf();
+      memset(in, 0, d_fft_size * sizeof(gr_complex));
+      for(unsigned int i = 0; i < ch->proto_taps.size(); i++)
+        in[i] = ch->proto_taps[i] * gr_complex(std::polar(1.0, i * fwT0));
+      d_fwdfft->execute(1);
+
+      // Scale by 1/fft_size here so the inverse FFT needs no scaling.
+      double bin = floor(ch->center_freq / d_sampling_freq * d_fft_size + 0.5);
+      ch->bin = (int)bin;
+      select_bins(ch->xformed_taps, d_fwdfft->get_outbuf(), d_fft_size, ch->bin, nbins);
+      for(int i = 0; i < nbins; i++)
+        ch->xformed_taps[i] /= (float)d_fft_size;
+
+      // Selecting the bins around ch->bin leaves the output offset by
+      // the distance of the center frequency from that bin.
+      ch->offset = ch->center_freq / d_sampling_freq - bin / d_fft_size;
+      ch->r.set_phase_incr(gr_complex(std::polar(1.0, -2 * M_PI * ch->offset * ch->decimation)));
+
+      // The first output of the next FFT is at time 0
+      ch->phase = -ch->center_freq / d_sampling_freq * d_overlap;
+      ch->phase -= floor(ch->phase);
+    }
+
+    fft_channelizer_ccf_impl::channel *
+    fft_channelizer_ccf_impl::get_channel(unsigned int chan) const
+    {
+      if(chan >= d_channels.size() || d_channels[chan] == NULL)
+        throw std::out_of_range("fft_channelizer_ccf: no such channel");
+      return d_channels[chan];
+    }
+
+    void
+    fft_channelizer_ccf_impl::check_channel(const std::vector<float> &taps,
+                                            int decimation) const
+    {
+      if(taps.empty())
+        throw std::invalid_argument("fft_channelizer_ccf: a channel needs at least one tap");
+      if((int)taps.size() > d_overlap + 1)
+        throw std::invalid_argument("fft_channelizer_ccf: a channel can have at most fft_size/4+1 taps");
+      if(decimation <= 0 || d_overlap % decimation != 0)
+        throw std::invalid_argument("fft_channelizer_ccf: decimation must divide fft_size/4");
+    }
+
+    void
+    fft_channelizer_ccf_impl::update_rates()
+    {
+      int decim = 0;
+      for(unsigned int i = 0; i < d_channels.size(); i++) {
+        if(d_channels[i] != NULL && (decim == 0 || d_channels[i]->decimation < decim))
+          decim = d_channels[i]->decimation;
+      }
+      if(decim == 0)
+        decim = 1;
+
+      d_out_step = d_step / decim;
+      set_relative_rate(1.0 / decim);
+    }
+
+    void
+    fft_channelizer_ccf_impl::set_channel(unsigned int chan,
+                                          const std::vector<float> &taps,
+                                          double center_freq,
+                                          int decimation)
+    {
+      check_channel(taps, decimation);
+
+      gr::thread::scoped_lock guard(d_mutex);
+      if(chan >= d_channels.size())
+        d_channels.resize(chan+1, NULL);
+
+      channel *ch = d_channels[chan];
+      if(ch == NULL) {
+        ch = new channel;
+        ch->invfft = NULL;
+        ch->xformed_taps = NULL;
+        d_channels[chan] = ch;
+      }
+      ch->proto_taps = taps;
+      ch->center_freq = center_freq;
+      ch->decimation = decimation;
+      ch->updated = true;
+      update_rates();
+    }
+
+    void
+    fft_channelizer_ccf_impl::remove_channel(unsigned int chan)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      free_channel(get_channel(chan));
+      d_channels[chan] = NULL;
+      update_rates();
+    }
+
+    unsigned int
+    fft_channelizer_ccf_impl::nchans() const
+    {
+      return d_channels.size();
+    }
+
+    bool
+    fft_channelizer_ccf_impl::has_channel(unsigned int chan) const
+    {
+      return chan < d_channels.size() && d_channels[chan] != NULL;
+    }
+
+    void
+    fft_channelizer_ccf_impl::set_center_freq(unsigned int chan,
+                                              double center_freq)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      channel *ch = get_channel(chan);
+      ch->center_freq = center_freq;
+      ch->updated = true;
+    }
+
+    double
+    fft_channelizer_ccf_impl::center_freq(unsigned int chan) const
+    {
+      return get_channel(chan)->center_freq;
+    }
+
+    void
+    fft_channelizer_ccf_impl::set_taps(unsigned int chan,
+                                       const std::vector<float> &taps)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      channel *ch = get_channel(chan);
+      check_channel(taps, ch->decimation);
+      ch->proto_taps = taps;
+      ch->updated = true;
+    }
+
+    std::vector<float>
+    fft_channelizer_ccf_impl::taps(unsigned int chan) const
+    {
+      return get_channel(chan)->proto_taps;
+    }
+
+    int
+    fft_channelizer_ccf_impl::decimation(unsigned int chan) const
+    {
+      return get_channel(chan)->decimation;
+    }
+
+    void
+    fft_channelizer_ccf_impl::set_nthreads(int nthreads)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      d_fwdfft->set_nthreads(nthreads);
+      delete d_pool;
+      d_pool = new kernel::worker_pool(nthreads);
+    }
+
+    int
+    fft_channelizer_ccf_impl::nthreads() const
+    {
+      return d_pool->nthreads();
+    }
+
+    void
+    fft_channelizer_ccf_impl::forecast(int noutput_items,
+                                       gr_vector_int &ninput_items_required)
+    {
+      unsigned ninputs = ninput_items_required.size();
+      for(unsigned int i = 0; i < ninputs; i++)
+        ninput_items_required[i] = std::max(1, noutput_items / d_out_step) * d_step;
+    }
+
+    void
+    fft_channelizer_ccf_impl::extract_channels(int index, int first, int nblocks,
+                                               gr_vector_void_star *output_items)
+    {
+      const unsigned int nthreads = d_pool->nthreads();
+      const gr_complex *spectra = d_fwdfft->get_outbuf();
+
+      for(unsigned int j = index; j < d_running.size(); j += nthreads) {
+        channel *ch = d_channels[d_running[j]];
+        const int nbins = d_fft_size / ch->decimation;
+        const int skip = d_overlap / ch->decimation;
+        const int nout = d_step / ch->decimation;
+        gr_complex *bins = ch->invfft->get_inbuf();
+        gr_complex *out = (gr_complex *)(*output_items)[d_running[j]] + first * nout;
+
+        for(int i = 0; i < nblocks; i++) {
+          gr_complex *b = bins + i * nbins;
+          select_bins(b, spectra + i * d_fft_size, d_fft_size, ch->bin, nbins);
+          volk_32fc_x2_multiply_32fc(b, b, ch->xformed_taps, nbins);
+        }
+        ch->invfft->execute(nblocks);
+
+        // The first skip outputs of each inverse FFT are the circular
+        // wrap-around of overlap-save; the rest are the channel's
+        // output, still to be moved down from the bin frequency.
+        for(int i = 0; i < nblocks; i++) {
+          double cycles = ch->phase + ch->offset * d_overlap;
+          ch->r.set_phase(gr_complex(std::polar(1.0, -2 * M_PI * cycles)));
+          ch->r.rotateN(out + i * nout,
+                        ch->invfft->get_outbuf() + i * nbins + skip, nout);
+
+          ch->phase += ch->center_freq / d_sampling_freq * d_step;
+          ch->phase -= floor(ch->phase);
+        }
+      }
+    }
+
+    int
+    fft_channelizer_ccf_impl::general_work(int noutput_items,
+                                           gr_vector_int &ninput_items,
+                                           gr_vector_const_void_star &input_items,
+                                           gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      const gr_complex *in = (const gr_complex *)input_items[0];
+      const unsigned int noutputs = output_items.size();
+
+      // rebuild the channels that have changed
+      for(unsigned int i = 0; i < d_channels.size(); i++) {
+        channel *ch = d_channels[i];
+        if(ch == NULL || !ch->updated)
+          continue;
+
+        build_channel(ch);
+        ch->updated = false;
+
+        // Tell downstream items where the change was applied
+        if(i < noutputs) {
+          add_item_tag(i, nitems_written(i),
+                       pmt::intern("freq"), pmt::from_double(ch->center_freq),
+                       alias_pmt());
+        }
+      }
+
+      const int nblocks = std::min(noutput_items / d_out_step,
+                                   ninput_items[0] / d_step);
+
+      // Ports without a channel are zero filled at the rate of the
+      // fastest channel so they keep streaming.
+      d_running.clear();
+      for(unsigned int i = 0; i < noutputs; i++) {
+        if(i < d_channels.size() && d_channels[i] != NULL)
+          d_running.push_back(i);
+        else {
+          memset(output_items[i], 0, nblocks * d_out_step * sizeof(gr_complex));
+          produce(i, nblocks * d_out_step);
+        }
+      }
+      const int batch = d_fwdfft->batch();
+
+      // Each batch of forward FFTs is used by every channel before
+      // the next one overwrites it.
+      for(int first = 0; first < nblocks; first += batch) {
+        int n = std::min(batch, nblocks - first);
+        for(int i = 0; i < n; i++) {
+          memcpy(d_fwdfft->get_inbuf() + i * d_fft_size,
+                 in + (first + i) * d_step,
+                 d_fft_size * sizeof(gr_complex));
+        }
+        d_fwdfft->execute(n);
+
+        d_pool->run(boost::bind(&fft_channelizer_ccf_impl::extract_channels,
+                                this, _1, first, n, &output_items));
+      }
+
+      for(unsigned int j = 0; j < d_running.size(); j++)
+        produce(d_running[j], nblocks * d_step / d_channels[d_running[j]]->decimation);
+      consume_each(nblocks * d_step);
+
+      return WORK_CALLED_PRODUCE;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
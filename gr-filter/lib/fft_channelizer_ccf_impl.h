@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FFT_CHANNELIZER_CCF_IMPL_H
+#define	INCLUDED_FILTER_FFT_CHANNELIZER_CCF_IMPL_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/filter/worker_pool.h>
+#include <gnuradio/filter/fft_channelizer_ccf.h>
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/blocks/rotator.h>
+#include <gnuradio/thread/thread.h>
+
+namespace gr {
+  namespace filter {
+
+    class FILTER_API fft_channelizer_ccf_impl : public fft_channelizer_ccf
+    {
+    private:
+      struct channel {
+        std::vector<float>        proto_taps;
+        double                    center_freq;
+        int                       decimation;
+        bool                      updated;
+
+        int                       bin;           // FFT bin nearest center_freq
+        gr_complex               *xformed_taps;  // taps over the selected bins
+        fft::fft_complex         *invfft;        // fft_size/decimation points
+        double                    phase;         // center_freq*t/fs of the block, in cycles
+        double                    offset;        // center_freq - bin frequency, in cycles/sample
+        blocks::rotator           r;             // removes offset after decimation
+      };
+
+      // Samples transformed per FFT execute; blocks are batched up to this.
+      static const int BATCH_ITEMS = 16384;
+
+      int                         d_fft_size;
+      int                         d_overlap;     // fft_size/4
+      int                         d_step;        // input items per FFT
+      int                         d_out_step;    // largest output per FFT of any channel
+      double                      d_sampling_freq;
+      fft::fft_complex           *d_fwdfft;
+      std::vector<channel*>       d_channels;    // NULL for removed channels
+      std::vector<unsigned int>   d_running;     // channels run by this call to work
+      kernel::worker_pool        *d_pool;
+      gr::thread::mutex           d_mutex;       // protects set/work access
+
+      void check_channel(const std::vector<float> &taps, int decimation) const;
+      void update_rates();
+      void build_channel(channel *ch);
+      channel *get_channel(unsigned int chan) const;
+      void free_channel(channel *ch);
+      void extract_channels(int index, int first, int nblocks,
+                            gr_vector_void_star *output_items);
+
+    public:
+      fft_channelizer_ccf_impl(int fft_size,
+                               const std::vector<int> &decimations,
+                               const std::vector<std::vector<float> > &taps,
+                               const std::vector<double> &center_freqs,
+                               double sampling_freq,
+                               int nthreads);
+      ~fft_channelizer_ccf_impl();
+
+      void set_channel(unsigned int chan,
+                       const std::vector<float> &taps,
+                       double center_freq,
+                       int decimation);
+      void remove_channel(unsigned int chan);
+      unsigned int nchans() const;
+      bool has_channel(unsigned int chan) const;
+
+      void set_center_freq(unsigned int chan, double center_freq);
+      double center_freq(unsigned int chan) const;
+
+      void set_taps(unsigned int chan, const std::vector<float> &taps);
+      std::vector<float> taps(unsigned int chan) const;
+
+      int decimation(unsigned int chan) const;
+      int fft_size() const { return d_fft_size; }
+
+      void set_nthreads(int nthreads);
+      int nthreads() const;
+
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FFT_CHANNELIZER_CCF_IMPL_H */
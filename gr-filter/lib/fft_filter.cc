@@ -25,9 +25,11 @@
 #endif
 
 #include <gnuradio/filter/fft_filter.h>
+#include <gnuradio/filter/filter_engine.h>
 #include <volk/volk.h>
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 
 namespace gr {
   namespace filter {
@@ -79,7 +81,7 @@ namespace gr {
 	for (; i < d_fftsize; i++)
 	  in[i] = 0;
 
-	d_fwdfft->execute();		// do the xform
+	d_fwdfft->execute(1);		// do the xform
 
 	// now copy output to d_xformed_taps
 	for (i = 0; i < d_fftsize/2+1; i++)
@@ -95,6 +97,14 @@ namespace gr {
 	int old_fftsize = d_fftsize;
 	d_ntaps = ntaps;
 	d_fftsize = (int) (2 * pow(2.0, ceil(log(double(ntaps)) / log(2.0))));
+
+	// Longer filters get the size with the lowest modeled cost per
+	// sample, at most 4x the size above so that the output multiple
+	// and the latency stay bounded.
+	if(ntaps >= (int)filter_cost_model::MIN_FFT_TAPS)
+	  d_fftsize = filter_cost_model::instance().best_fftsize(filter_cost_model::FFT_REAL,
+								 ntaps, 1, NULL,
+								 4*d_fftsize);
 	d_nsamples = d_fftsize - d_ntaps + 1;
 
 	if(VERBOSE) {
@@ -109,8 +119,12 @@ namespace gr {
 	  delete d_invfft;
           if(d_xformed_taps != NULL)
             volk_free(d_xformed_taps);
-	  d_fwdfft = new fft::fft_real_fwd(d_fftsize);
-	  d_invfft = new fft::fft_real_rev(d_fftsize);
+	  // Several blocks are transformed per execute; the
+	  // real FFTs only compute the fftsize/2+1 bins that are not
+	  // conjugates of the others.
+	  int batch = std::max(1, BATCH_ITEMS / d_fftsize);
+	  d_fwdfft = new fft::fft_real_fwd(d_fftsize, d_nthreads, batch);
+	  d_invfft = new fft::fft_real_rev(d_fftsize, d_nthreads, batch);
 	  d_xformed_taps = (gr_complex*)volk_malloc(sizeof(gr_complex)*(d_fftsize/2+1),
                                                     volk_get_alignment());
 	}
@@ -150,39 +164,52 @@ namespace gr {
 	int dec_ctr = 0;
 	int j = 0;
 	int ninput_items = nitems * d_decimation;
+	const int nbins = d_fftsize/2 + 1;
 
-	for (int i = 0; i < ninput_items; i += d_nsamples){
+	for (int i = 0; i < ninput_items; ) {
+	  int nblocks = std::min(d_fwdfft->batch(),
+				 (ninput_items - i + d_nsamples - 1) / d_nsamples);
 
-	  memcpy(d_fwdfft->get_inbuf(), &input[i], d_nsamples * sizeof(float));
+	  for (int b = 0; b < nblocks; b++) {
+	    float *in = d_fwdfft->get_inbuf() + b*d_fftsize;
+	    memcpy(in, &input[i + b*d_nsamples], d_nsamples * sizeof(float));
 
-	  for (j = d_nsamples; j < d_fftsize; j++)
-	    d_fwdfft->get_inbuf()[j] = 0;
+	    for (j = d_nsamples; j < d_fftsize; j++)
+	      in[j] = 0;
+	  }
 
-	  d_fwdfft->execute();	// compute fwd xform
+	  d_fwdfft->execute(nblocks);	// compute fwd xforms
 
-	  gr_complex *a = d_fwdfft->get_outbuf();
-	  gr_complex *b = d_xformed_taps;
-	  gr_complex *c = d_invfft->get_inbuf();
+	  for (int b = 0; b < nblocks; b++) {
+	    gr_complex *a = d_fwdfft->get_outbuf() + b*nbins;
+	    gr_complex *c = d_invfft->get_inbuf() + b*nbins;
 
-	  volk_32fc_x2_multiply_32fc_a(c, a, b, d_fftsize/2+1);
+	    volk_32fc_x2_multiply_32fc(c, a, d_xformed_taps, nbins);
+	  }
 
-	  d_invfft->execute();	// compute inv xform
+	  d_invfft->execute(nblocks);	// compute inv xforms
 
-	  // add in the overlapping tail
-	  for (j = 0; j < tailsize(); j++)
-	    d_invfft->get_outbuf()[j] += d_tail[j];
+	  for (int b = 0; b < nblocks; b++) {
+	    float *out = d_invfft->get_outbuf() + b*d_fftsize;
 
-	  // copy nsamples to output
-	  j = dec_ctr;
-	  while (j < d_nsamples) {
-	    *output++ = d_invfft->get_outbuf()[j];
-	    j += d_decimation;
+	    // add in the overlapping tail
+	    for (j = 0; j < tailsize(); j++)
+	      out[j] += d_tail[j];
+
+	    // copy nsamples to output
+	    j = dec_ctr;
+	    while (j < d_nsamples) {
+	      *output++ = out[j];
+	      j += d_decimation;
+	    }
+	    dec_ctr = (j - d_nsamples);
+
+	    // stash the tail
+	    memcpy(&d_tail[0], out + d_nsamples,
+		   tailsize() * sizeof(float));
 	  }
-	  dec_ctr = (j - d_nsamples);
 
-	  // stash the tail
-	  memcpy(&d_tail[0], d_invfft->get_outbuf() + d_nsamples,
-		 tailsize() * sizeof(float));
+	  i += nblocks * d_nsamples;
 	}
 
 	return nitems;
@@ -252,6 +279,14 @@ namespace gr {
 	int old_fftsize = d_fftsize;
 	d_ntaps = ntaps;
 	d_fftsize = (int) (2 * pow(2.0, ceil(log(double(ntaps)) / log(2.0))));
+
+	// Longer filters get the size with the lowest modeled cost per
+	// sample, at most 4x the size above so that the output multiple
+	// and the latency stay bounded.
+	if(ntaps >= (int)filter_cost_model::MIN_FFT_TAPS)
+	  d_fftsize = filter_cost_model::instance().best_fftsize(filter_cost_model::FFT_COMPLEX,
+								 ntaps, 1, NULL,
+								 4*d_fftsize);
 	d_nsamples = d_fftsize - d_ntaps + 1;
 
 	if(VERBOSE) {
@@ -409,6 +444,14 @@ namespace gr {
 	int old_fftsize = d_fftsize;
 	d_ntaps = ntaps;
 	d_fftsize = (int) (2 * pow(2.0, ceil(log(double(ntaps)) / log(2.0))));
+
+	// Longer filters get the size with the lowest modeled cost per
+	// sample, at most 4x the size above so that the output multiple
+	// and the latency stay bounded.
+	if(ntaps >= (int)filter_cost_model::MIN_FFT_TAPS)
+	  d_fftsize = filter_cost_model::instance().best_fftsize(filter_cost_model::FFT_COMPLEX,
+								 ntaps, 1, NULL,
+								 4*d_fftsize);
 	d_nsamples = d_fftsize - d_ntaps + 1;
 
 	if(VERBOSE) {
@@ -0,0 +1,875 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/filter/filter_engine.h>
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/thread/thread.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/sys_paths.h>
+#include <volk/volk.h>
+#include <boost/filesystem/path.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <cstring>
+#include <cmath>
+
+namespace fs = boost::filesystem;
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      #define VERBOSE 0
+
+      // AUTO only switches to the FFT when it is clearly cheaper,
+      // since the model ignores memory traffic and call overhead.
+      static const double       FFT_MARGIN  = 0.9;
+
+      static int
+      next_pow2(unsigned int n)
+      {
+	int p = 1;
+	while(p < (int)n)
+	  p <<= 1;
+	return p;
+      }
+
+      static double
+      nlog2n(int n)
+      {
+	return double(n) * std::log(double(n)) / std::log(2.0);
+      }
+
+      // Names of the costs in the costs file, in the order
+      // mac_real, mac_complex_real, mac_complex, fft_complex,
+      // fft_real, cmul.
+      static const char *const COST_NAMES[] = {
+	"mac_real", "mac_complex_real", "mac_complex",
+	"fft_complex", "fft_real", "cmul"
+      };
+      static const int NCOSTS = 6;
+
+      // Calibration sizes; small enough to finish in a few ms.
+      static const unsigned int CAL_NTAPS   = 256;
+      static const unsigned int CAL_NOUT    = 64;
+      static const int          CAL_FFTSIZE = 1024;
+      static const int          CAL_NFFT    = 32;
+      static const int          CAL_TRIALS  = 5;
+
+      // Costs are in units of one real multiply-accumulate of a VOLK
+      // dot product. A complex FFT of size N is taken as 5 N log2(N)
+      // flops at about half the throughput of a dot product, a real
+      // FFT as half of that, and a spectral multiply as 6 flops.
+      filter_cost_model::filter_cost_model()
+      {
+	d_mac_cost[MAC_REAL] = 1.0;
+	d_mac_cost[MAC_COMPLEX_REAL] = 2.0;
+	d_mac_cost[MAC_COMPLEX] = 4.0;
+	d_fft_cost[0] = 3.0;
+	d_fft_cost[1] = 1.5;
+	d_cmul_cost = 3.0;
+      }
+
+      const filter_cost_model &
+      filter_cost_model::instance()
+      {
+	static gr::thread::mutex s_mutex;
+	static filter_cost_model *s_model = NULL;
+
+	gr::thread::scoped_lock lock(s_mutex);
+	if(s_model == NULL) {
+	  s_model = new filter_cost_model();
+	  s_model->load_costs(costs_filename());
+	}
+	return *s_model;
+      }
+
+      std::string
+      filter_cost_model::costs_filename()
+      {
+	fs::path path = fs::path(gr::appdata_path()) / ".gr_filter_costs";
+	return path.string();
+      }
+
+      // Replaces the defaults with the costs found in \p filename.
+      // A missing file is not an error; it is the common case.
+      void
+      filter_cost_model::load_costs(const std::string &filename)
+      {
+	std::ifstream in(filename.c_str());
+	if(!in)
+	  return;
+
+	double *costs[NCOSTS] = {
+	  &d_mac_cost[MAC_REAL], &d_mac_cost[MAC_COMPLEX_REAL],
+	  &d_mac_cost[MAC_COMPLEX], &d_fft_cost[0], &d_fft_cost[1],
+	  &d_cmul_cost
+	};
+
+	std::string line;
+	while(std::getline(in, line)) {
+	  std::istringstream is(line);
+	  std::string name;
+	  double value;
+	  if(!(is >> name >> value))
+	    continue;
+	  if(!(value > 0.0) || value > 1e6) {
+	    std::cerr << "filter_cost_model: ignoring " << name << " = "
+		      << value << " in " << filename << std::endl;
+	    continue;
+	  }
+	  for(int i = 0; i < NCOSTS; i++) {
+	    if(name == COST_NAMES[i])
+	      *costs[i] = value;
+	  }
+	}
+
+	if(VERBOSE) {
+	  std::cerr << "filter_cost_model: costs from " << filename << ":";
+	  for(int i = 0; i < NCOSTS; i++)
+	    std::cerr << " " << COST_NAMES[i] << "=" << *costs[i];
+	  std::cerr << std::endl;
+	}
+      }
+
+      static double
+      elapsed_ns(high_res_timer_type t0, high_res_timer_type t1)
+      {
+	double ns = double(t1 - t0) * 1e9 / double(high_res_timer_tps());
+	return std::max(ns, 1e-3);
+      }
+
+      bool
+      filter_cost_model::calibrate(bool verbose)
+      {
+	const size_t align = volk_get_alignment();
+	const unsigned int nin = CAL_NTAPS + CAL_NOUT;
+
+	float *fin = (float*)volk_malloc(nin*sizeof(float), align);
+	float *ftaps = (float*)volk_malloc(CAL_NTAPS*sizeof(float), align);
+	float *fout = (float*)volk_malloc(sizeof(float), align);
+	gr_complex *cin = (gr_complex*)volk_malloc(nin*sizeof(gr_complex), align);
+	gr_complex *ctaps = (gr_complex*)volk_malloc(CAL_FFTSIZE*sizeof(gr_complex), align);
+	gr_complex *cres = (gr_complex*)volk_malloc(CAL_FFTSIZE*sizeof(gr_complex), align);
+
+	for(unsigned int i = 0; i < nin; i++) {
+	  fin[i] = float(i % 17) - 8.0f;
+	  cin[i] = gr_complex(fin[i], -fin[i]);
+	}
+	for(int i = 0; i < CAL_FFTSIZE; i++) {
+	  ctaps[i] = gr_complex(0.01f * (i % 7), 0.02f * (i % 5));
+	  if(i < (int)CAL_NTAPS)
+	    ftaps[i] = 0.01f * (i % 7);
+	}
+
+	fft::fft_complex cfft(CAL_FFTSIZE, true, 1);
+	fft::fft_real_fwd rfft(CAL_FFTSIZE, 1);
+	memset(cfft.get_inbuf(), 0, CAL_FFTSIZE*sizeof(gr_complex));
+	memset(rfft.get_inbuf(), 0, CAL_FFTSIZE*sizeof(float));
+	memcpy(cfft.get_inbuf(), cin, nin*sizeof(gr_complex));
+	memcpy(rfft.get_inbuf(), fin, nin*sizeof(float));
+
+	const double macs = double(CAL_NTAPS) * CAL_NOUT;
+	const double nlogn = nlog2n(CAL_FFTSIZE);
+
+	// Nanoseconds per unit of each cost, in COST_NAMES order.
+	double ns[NCOSTS];
+	for(int i = 0; i < NCOSTS; i++)
+	  ns[i] = std::numeric_limits<double>::max();
+
+	// Keep the best of several trials to reject preemption noise.
+	for(int trial = 0; trial < CAL_TRIALS; trial++) {
+	  high_res_timer_type t0, t1;
+
+	  t0 = high_res_timer_now();
+	  for(unsigned int i = 0; i < CAL_NOUT; i++)
+	    volk_32f_x2_dot_prod_32f(fout, fin+i, ftaps, CAL_NTAPS);
+	  t1 = high_res_timer_now();
+	  ns[0] = std::min(ns[0], elapsed_ns(t0, t1) / macs);
+
+	  t0 = high_res_timer_now();
+	  for(unsigned int i = 0; i < CAL_NOUT; i++)
+	    volk_32fc_32f_dot_prod_32fc(cres, cin+i, ftaps, CAL_NTAPS);
+	  t1 = high_res_timer_now();
+	  ns[1] = std::min(ns[1], elapsed_ns(t0, t1) / macs);
+
+	  t0 = high_res_timer_now();
+	  for(unsigned int i = 0; i < CAL_NOUT; i++)
+	    volk_32fc_x2_dot_prod_32fc(cres, cin+i, ctaps, CAL_NTAPS);
+	  t1 = high_res_timer_now();
+	  ns[2] = std::min(ns[2], elapsed_ns(t0, t1) / macs);
+
+	  t0 = high_res_timer_now();
+	  for(int i = 0; i < CAL_NFFT; i++)
+	    cfft.execute();
+	  t1 = high_res_timer_now();
+	  ns[3] = std::min(ns[3], elapsed_ns(t0, t1) / (CAL_NFFT * nlogn));
+
+	  t0 = high_res_timer_now();
+	  for(int i = 0; i < CAL_NFFT; i++)
+	    rfft.execute();
+	  t1 = high_res_timer_now();
+	  ns[4] = std::min(ns[4], elapsed_ns(t0, t1) / (CAL_NFFT * nlogn));
+
+	  t0 = high_res_timer_now();
+	  for(int i = 0; i < CAL_NFFT; i++)
+	    volk_32fc_x2_multiply_32fc_a(cres, cfft.get_outbuf(), ctaps, CAL_FFTSIZE);
+	  t1 = high_res_timer_now();
+	  ns[5] = std::min(ns[5], elapsed_ns(t0, t1) / (double(CAL_NFFT) * CAL_FFTSIZE));
+	}
+
+	volk_free(fin);
+	volk_free(ftaps);
+	volk_free(fout);
+	volk_free(cin);
+	volk_free(ctaps);
+	volk_free(cres);
+
+	// Store the costs relative to a real MAC, like the defaults.
+	const std::string filename = costs_filename();
+	std::ofstream out(filename.c_str());
+	if(!out) {
+	  std::cerr << "filter_cost_model: can't write " << filename << std::endl;
+	  return false;
+	}
+	for(int i = 0; i < NCOSTS; i++) {
+	  out << COST_NAMES[i] << " " << ns[i] / ns[0] << std::endl;
+	  if(verbose)
+	    std::cout << COST_NAMES[i] << " " << ns[i] / ns[0]
+		      << " (" << ns[i] << " ns)" << std::endl;
+	}
+	return bool(out);
+      }
+
+      double
+      filter_cost_model::direct_cost(mac_t mac, unsigned int ntaps) const
+      {
+	return d_mac_cost[mac] * ntaps;
+      }
+
+      // Only decimations FFTW handles with its fast codelets are worth
+      // building an FFT size around.
+      static bool
+      is_smooth(unsigned int n)
+      {
+	const unsigned int primes[] = { 2, 3, 5, 7 };
+	for(int i = 0; i < 4; i++) {
+	  while(n % primes[i] == 0)
+	    n /= primes[i];
+	}
+	return n == 1;
+      }
+
+      bool
+      filter_cost_model::decimates_in_frequency(fft_t type, int fftsize,
+						unsigned int decimation)
+      {
+	return (type != FFT_REAL) && (decimation > 1) &&
+	  (fftsize % decimation == 0) && is_smooth(decimation);
+      }
+
+      // Where the input goes in the FFT buffer. Decimating in
+      // frequency keeps the output samples at multiples of the
+      // decimation, so the first valid output has to land on one.
+      static unsigned int
+      block_offset(bool freq, int ntaps, unsigned int decimation)
+      {
+	if(!freq)
+	  return 0;
+	return (decimation - (ntaps - 1) % decimation) % decimation;
+      }
+
+      // Number of decimated outputs one overlap-save block yields.
+      static unsigned long
+      block_outputs(int fftsize, int ntaps, unsigned int decimation,
+		    unsigned int offset)
+      {
+	if(fftsize < (int)(offset + ntaps))
+	  return 0;
+	return (fftsize - offset - ntaps) / decimation + 1;
+      }
+
+      double
+      filter_cost_model::fft_cost(fft_t type, int fftsize,
+				  unsigned int ntaps, unsigned int decimation) const
+      {
+	decimation = std::max(1u, decimation);
+	bool freq = decimates_in_frequency(type, fftsize, decimation);
+	unsigned long nout = block_outputs(fftsize, ntaps, decimation,
+					   block_offset(freq, ntaps, decimation));
+	if(nout == 0)
+	  return std::numeric_limits<double>::max();
+
+	int ifftsize = freq ? fftsize / decimation : fftsize;
+	int nbins = (type == FFT_REAL) ? fftsize/2+1 : fftsize;
+	double block =
+	  d_fft_cost[type == FFT_COMPLEX ? 0 : 1] * nlog2n(fftsize) +
+	  d_fft_cost[type == FFT_REAL ? 1 : 0] * nlog2n(ifftsize) +
+	  d_cmul_cost * nbins;
+
+	// folding the spectrum costs about half a multiply per bin
+	if(freq)
+	  block += 0.5 * d_cmul_cost * fftsize;
+
+	return block / nout;
+      }
+
+      int
+      filter_cost_model::best_fftsize(fft_t type, unsigned int ntaps,
+				      unsigned int decimation, double *cost,
+				      int max_fftsize) const
+      {
+	decimation = std::max(1u, decimation);
+	int best = next_pow2(ntaps + decimation - 1);
+	double best_cost = fft_cost(type, best, ntaps, decimation);
+
+	for(int n = 2*best; n <= max_fftsize; n *= 2) {
+	  double c = fft_cost(type, n, ntaps, decimation);
+	  if(c < best_cost) {
+	    best = n;
+	    best_cost = c;
+	  }
+	}
+
+	// D * 2^k sizes allow decimating in frequency
+	if(decimates_in_frequency(type, decimation, decimation)) {
+	  for(int n = decimation; n <= max_fftsize; n *= 2) {
+	    double c = fft_cost(type, n, ntaps, decimation);
+	    if(c < best_cost) {
+	      best = n;
+	      best_cost = c;
+	    }
+	  }
+	}
+
+	if(cost)
+	  *cost = best_cost;
+	return best;
+      }
+
+      filter_engine_t
+      filter_cost_model::select(filter_engine_t requested,
+				mac_t mac, fft_t type,
+				unsigned int ntaps,
+				unsigned int decimation,
+				int *fftsize,
+				bool folded)
+      {
+	if(requested == ENGINE_DIRECT || ntaps == 0)
+	  return ENGINE_DIRECT;
+	if(requested == ENGINE_AUTO && ntaps < MIN_FFT_TAPS)
+	  return ENGINE_DIRECT;
+
+	const filter_cost_model &model = instance();
+	double cost;
+	int n = model.best_fftsize(type, ntaps, decimation, &cost);
+
+	// a folded direct form does one multiply per pair of taps
+	unsigned int nmacs = folded ? (ntaps+1)/2 : ntaps;
+	if(requested == ENGINE_AUTO && cost >= FFT_MARGIN * model.direct_cost(mac, nmacs))
+	  return ENGINE_DIRECT;
+
+	if(VERBOSE) {
+	  std::cerr << "filter_cost_model: ntaps = " << ntaps
+		    << " decimation = " << decimation
+		    << " fftsize = " << n << std::endl;
+	}
+
+	*fftsize = n;
+	return ENGINE_FFT;
+      }
+
+      /**************************************************************/
+
+      // Multiplies the spectrum of one input block with the taps and
+      // writes the nout retained outputs. When decimating in
+      // frequency the product is folded onto fftsize/decimation bins
+      // so that the inverse FFT directly yields the decimated samples.
+      static void
+      finish_block(gr_complex output[], unsigned long nout,
+		   const gr_complex *spectrum, const gr_complex *xformed_taps,
+		   gr_complex *product, fft::fft_complex *invfft,
+		   int fftsize, int ntaps, unsigned int decimation, bool freq)
+      {
+	if(freq) {
+	  const int nbins = fftsize / decimation;
+	  const unsigned int offset = block_offset(freq, ntaps, decimation);
+	  gr_complex *folded = invfft->get_inbuf();
+
+	  volk_32fc_x2_multiply_32fc_a(product, spectrum, xformed_taps, fftsize);
+	  memcpy(folded, product, nbins*sizeof(gr_complex));
+	  for(unsigned int l = 1; l < decimation; l++)
+	    volk_32f_x2_add_32f((float*)folded, (const float*)folded,
+				(const float*)(product + l*nbins), 2*nbins);
+	  invfft->execute();
+
+	  memcpy(output, invfft->get_outbuf() + (offset + ntaps - 1) / decimation,
+		 nout*sizeof(gr_complex));
+	}
+	else {
+	  volk_32fc_x2_multiply_32fc_a(invfft->get_inbuf(), spectrum,
+				       xformed_taps, fftsize);
+	  invfft->execute();
+
+	  // the first ntaps-1 samples are circularly aliased
+	  const gr_complex *valid = invfft->get_outbuf() + ntaps - 1;
+	  for(unsigned long i = 0; i < nout; i++)
+	    output[i] = valid[i*decimation];
+	}
+      }
+
+      /**************************************************************/
+
+      overlap_save_fff::overlap_save_fff(int fftsize,
+					 const std::vector<float> &taps,
+					 unsigned int decimation)
+	: d_ntaps((int)taps.size()), d_fftsize(fftsize),
+	  d_decimation(std::max(1u, decimation))
+      {
+	d_fwdfft = new fft::fft_real_fwd(d_fftsize);
+	d_invfft = new fft::fft_real_rev(d_fftsize);
+	d_xformed_taps = (gr_complex*)volk_malloc(sizeof(gr_complex)*(d_fftsize/2+1),
+						  volk_get_alignment());
+
+	// Scale by 1/fftsize here so the inverse needs no scaling.
+	float scale = 1.0 / d_fftsize;
+	float *in = d_fwdfft->get_inbuf();
+	int i;
+	for(i = 0; i < d_ntaps; i++)
+	  in[i] = taps[i] * scale;
+	for(; i < d_fftsize; i++)
+	  in[i] = 0;
+
+	d_fwdfft->execute();
+	memcpy(d_xformed_taps, d_fwdfft->get_outbuf(),
+	       (d_fftsize/2+1)*sizeof(gr_complex));
+      }
+
+      overlap_save_fff::~overlap_save_fff()
+      {
+	delete d_fwdfft;
+	delete d_invfft;
+	volk_free(d_xformed_taps);
+      }
+
+      unsigned long
+      overlap_save_fff::filterNdec(float output[], const float input[],
+				   unsigned long n, unsigned int decimate)
+      {
+	if(decimate != d_decimation)
+	  return 0;
+
+	const unsigned long nblock = block_outputs(d_fftsize, d_ntaps, decimate, 0);
+	unsigned long done = 0;
+
+	while(done < n) {
+	  unsigned long nout = std::min(nblock, n - done);
+	  if(2*nout < nblock || nout == 0)
+	    break;
+
+	  // Only the samples the retained outputs depend on; the zero
+	  // padding behind them never reaches a valid output.
+	  unsigned long ncopy = (nout-1)*decimate + d_ntaps;
+	  float *in = d_fwdfft->get_inbuf();
+	  memcpy(in, &input[done*decimate], ncopy*sizeof(float));
+	  memset(in+ncopy, 0, (d_fftsize-ncopy)*sizeof(float));
+
+	  d_fwdfft->execute();
+	  volk_32fc_x2_multiply_32fc_a(d_invfft->get_inbuf(), d_fwdfft->get_outbuf(),
+				       d_xformed_taps, d_fftsize/2+1);
+	  d_invfft->execute();
+
+	  // the first ntaps-1 samples are circularly aliased
+	  const float *valid = d_invfft->get_outbuf() + d_ntaps - 1;
+	  if(decimate == 1) {
+	    memcpy(&output[done], valid, nout*sizeof(float));
+	  }
+	  else {
+	    for(unsigned long i = 0; i < nout; i++)
+	      output[done+i] = valid[i*decimate];
+	  }
+	  done += nout;
+	}
+
+	return done;
+      }
+
+      /**************************************************************/
+
+      overlap_save_ccc::overlap_save_ccc(int fftsize,
+					 const std::vector<gr_complex> &taps,
+					 unsigned int decimation)
+	: d_ntaps((int)taps.size()), d_fftsize(fftsize),
+	  d_decimation(std::max(1u, decimation))
+      {
+	bool freq = filter_cost_model::decimates_in_frequency
+	  (filter_cost_model::FFT_COMPLEX, d_fftsize, d_decimation);
+
+	d_fwdfft = new fft::fft_complex(d_fftsize, true);
+	d_invfft = new fft::fft_complex(freq ? d_fftsize/d_decimation : d_fftsize, false);
+	d_xformed_taps = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_fftsize,
+						  volk_get_alignment());
+	d_product = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_fftsize,
+					     volk_get_alignment());
+
+	float scale = 1.0 / d_fftsize;
+	gr_complex *in = d_fwdfft->get_inbuf();
+	int i;
+	for(i = 0; i < d_ntaps; i++)
+	  in[i] = taps[i] * scale;
+	for(; i < d_fftsize; i++)
+	  in[i] = 0;
+
+	d_fwdfft->execute();
+	memcpy(d_xformed_taps, d_fwdfft->get_outbuf(),
+	       d_fftsize*sizeof(gr_complex));
+      }
+
+      overlap_save_ccc::~overlap_save_ccc()
+      {
+	delete d_fwdfft;
+	delete d_invfft;
+	volk_free(d_xformed_taps);
+	volk_free(d_product);
+      }
+
+      unsigned long
+      overlap_save_ccc::filterNdec(gr_complex output[], const gr_complex input[],
+				   unsigned long n, unsigned int decimate)
+      {
+	if(decimate != d_decimation)
+	  return 0;
+
+	const bool freq = filter_cost_model::decimates_in_frequency
+	  (filter_cost_model::FFT_COMPLEX, d_fftsize, decimate);
+	const unsigned int offset = block_offset(freq, d_ntaps, decimate);
+	const unsigned long nblock = block_outputs(d_fftsize, d_ntaps, decimate, offset);
+	unsigned long done = 0;
+
+	while(done < n) {
+	  unsigned long nout = std::min(nblock, n - done);
+	  if(2*nout < nblock || nout == 0)
+	    break;
+
+	  unsigned long ncopy = (nout-1)*decimate + d_ntaps;
+	  gr_complex *in = d_fwdfft->get_inbuf();
+	  memset(in, 0, offset*sizeof(gr_complex));
+	  memcpy(in+offset, &input[done*decimate], ncopy*sizeof(gr_complex));
+	  memset(in+offset+ncopy, 0, (d_fftsize-offset-ncopy)*sizeof(gr_complex));
+
+	  d_fwdfft->execute();
+	  finish_block(&output[done], nout, d_fwdfft->get_outbuf(), d_xformed_taps,
+		       d_product, d_invfft, d_fftsize, d_ntaps, decimate, freq);
+	  done += nout;
+	}
+
+	return done;
+      }
+
+      /**************************************************************/
+
+      overlap_save_fcc::overlap_save_fcc(int fftsize,
+					 const std::vector<gr_complex> &taps,
+					 unsigned int decimation)
+	: d_ntaps((int)taps.size()), d_fftsize(fftsize),
+	  d_decimation(std::max(1u, decimation))
+      {
+	bool freq = filter_cost_model::decimates_in_frequency
+	  (filter_cost_model::FFT_REAL_INPUT, d_fftsize, d_decimation);
+
+	d_fwdfft = new fft::fft_real_fwd(d_fftsize);
+	d_invfft = new fft::fft_complex(freq ? d_fftsize/d_decimation : d_fftsize, false);
+	d_xformed_taps = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_fftsize,
+						  volk_get_alignment());
+	d_spectrum = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_fftsize,
+					      volk_get_alignment());
+	d_product = (gr_complex*)volk_malloc(sizeof(gr_complex)*d_fftsize,
+					     volk_get_alignment());
+
+	// The taps are complex, so they need a complex transform; it
+	// is only done once.
+	fft::fft_complex tapfft(d_fftsize, true);
+	float scale = 1.0 / d_fftsize;
+	gr_complex *in = tapfft.get_inbuf();
+	int i;
+	for(i = 0; i < d_ntaps; i++)
+	  in[i] = taps[i] * scale;
+	for(; i < d_fftsize; i++)
+	  in[i] = 0;
+
+	tapfft.execute();
+	memcpy(d_xformed_taps, tapfft.get_outbuf(),
+	       d_fftsize*sizeof(gr_complex));
+      }
+
+      overlap_save_fcc::~overlap_save_fcc()
+      {
+	delete d_fwdfft;
+	delete d_invfft;
+	volk_free(d_xformed_taps);
+	volk_free(d_spectrum);
+	volk_free(d_product);
+      }
+
+      void
+      overlap_save_fcc::filter_block(gr_complex output[], unsigned long nout)
+      {
+	const bool freq = filter_cost_model::decimates_in_frequency
+	  (filter_cost_model::FFT_REAL_INPUT, d_fftsize, d_decimation);
+
+	d_fwdfft->execute();
+
+	// complete the spectrum of the real input: X[N-k] = conj(X[k])
+	const gr_complex *half = d_fwdfft->get_outbuf();
+	memcpy(d_spectrum, half, (d_fftsize/2+1)*sizeof(gr_complex));
+	for(int k = d_fftsize/2+1; k < d_fftsize; k++)
+	  d_spectrum[k] = conj(half[d_fftsize-k]);
+
+	finish_block(output, nout, d_spectrum, d_xformed_taps,
+		     d_product, d_invfft, d_fftsize, d_ntaps, d_decimation, freq);
+      }
+
+      unsigned long
+      overlap_save_fcc::filterNdec(gr_complex output[], const float input[],
+				   unsigned long n, unsigned int decimate)
+      {
+	if(decimate != d_decimation)
+	  return 0;
+
+	const bool freq = filter_cost_model::decimates_in_frequency
+	  (filter_cost_model::FFT_REAL_INPUT, d_fftsize, decimate);
+	const unsigned int offset = block_offset(freq, d_ntaps, decimate);
+	const unsigned long nblock = block_outputs(d_fftsize, d_ntaps, decimate, offset);
+	unsigned long done = 0;
+
+	while(done < n) {
+	  unsigned long nout = std::min(nblock, n - done);
+	  if(2*nout < nblock || nout == 0)
+	    break;
+
+	  unsigned long ncopy = (nout-1)*decimate + d_ntaps;
+	  float *in = d_fwdfft->get_inbuf();
+	  memset(in, 0, offset*sizeof(float));
+	  memcpy(in+offset, &input[done*decimate], ncopy*sizeof(float));
+	  memset(in+offset+ncopy, 0, (d_fftsize-offset-ncopy)*sizeof(float));
+
+	  filter_block(&output[done], nout);
+	  done += nout;
+	}
+
+	return done;
+      }
+
+      unsigned long
+      overlap_save_fcc::filterNdec(gr_complex output[], const short input[],
+				   unsigned long n, unsigned int decimate)
+      {
+	if(decimate != d_decimation)
+	  return 0;
+
+	const bool freq = filter_cost_model::decimates_in_frequency
+	  (filter_cost_model::FFT_REAL_INPUT, d_fftsize, decimate);
+	const unsigned int offset = block_offset(freq, d_ntaps, decimate);
+	const unsigned long nblock = block_outputs(d_fftsize, d_ntaps, decimate, offset);
+	unsigned long done = 0;
+
+	while(done < n) {
+	  unsigned long nout = std::min(nblock, n - done);
+	  if(2*nout < nblock || nout == 0)
+	    break;
+
+	  unsigned long ncopy = (nout-1)*decimate + d_ntaps;
+	  float *in = d_fwdfft->get_inbuf();
+	  memset(in, 0, offset*sizeof(float));
+	  volk_16i_s32f_convert_32f(in+offset, &input[done*decimate], 1.0, ncopy);
+	  memset(in+offset+ncopy, 0, (d_fftsize-offset-ncopy)*sizeof(float));
+
+	  filter_block(&output[done], nout);
+	  done += nout;
+	}
+
+	return done;
+      }
+
+      /**************************************************************/
+
+      // Outputs computed per pass over the taps; keeps the block's
+      // input and output in L1.
+      static const unsigned long FOLD_BLOCK = 256;
+
+      folded_fir::folded_fir(unsigned int lanes)
+	: d_lanes(std::max(1u, lanes)), d_symmetry(TAPS_ASYMMETRIC),
+	  d_symmetry_valid(true)
+      {
+      }
+
+      tap_symmetry_t
+      folded_fir::symmetry(const std::vector<float> &taps)
+      {
+	const size_t n = taps.size();
+	bool sym = true, anti = true;
+	for(size_t k = 0; k < n/2 && (sym || anti); k++) {
+	  sym = sym && (taps[k] == taps[n-1-k]);
+	  anti = anti && (taps[k] == -taps[n-1-k]);
+	}
+	// the centre tap of an odd antisymmetric filter is zero
+	if((n & 1) && taps[n/2] != 0)
+	  anti = false;
+
+	if(sym)
+	  return TAPS_SYMMETRIC;
+	if(anti)
+	  return TAPS_ANTISYMMETRIC;
+	return TAPS_ASYMMETRIC;
+      }
+
+      void
+      folded_fir::set_taps(const std::vector<float> &taps)
+      {
+	d_taps = taps;
+	d_symmetry_valid = false;
+      }
+
+      void
+      folded_fir::update_tap(float t, unsigned int index)
+      {
+	d_taps[index] = t;
+	d_symmetry_valid = false;
+      }
+
+      tap_symmetry_t
+      folded_fir::symmetry() const
+      {
+	if(!d_symmetry_valid) {
+	  d_symmetry = d_taps.empty() ? TAPS_ASYMMETRIC : symmetry(d_taps);
+	  d_symmetry_valid = true;
+	}
+	return d_symmetry;
+      }
+
+      bool
+      folded_fir::usable(unsigned int decimate) const
+      {
+	// Short decimating filters spend more on splitting the input
+	// into phases than folding saves.
+	return (symmetry() != TAPS_ASYMMETRIC) &&
+	  (ntaps() >= MIN_FOLD_TAPS) && (ntaps() >= 4*decimate);
+      }
+
+      void
+      folded_fir::filterNdec(float output[], const float input[],
+			     unsigned long n, unsigned int decimate)
+      {
+	const unsigned int ntaps = d_taps.size();
+	const unsigned int half = ntaps / 2;
+	const unsigned int lanes = d_lanes;
+	const bool sym = (symmetry() == TAPS_SYMMETRIC);
+	const float *t = &d_taps[0];
+
+	decimate = std::max(1u, decimate);
+	const unsigned long step = (unsigned long)decimate * lanes;
+
+	// Phase p of a block holds samples p, p+decimate, ... so that
+	// sample i*decimate+k is element i + k/decimate of phase
+	// k%decimate.
+	const unsigned long span = FOLD_BLOCK + (ntaps-1)/decimate + 1;
+	if(decimate > 1)
+	  d_phases.resize(decimate * span * lanes);
+
+	for(unsigned long done = 0; done < n; done += FOLD_BLOCK) {
+	  const unsigned long nb = std::min(FOLD_BLOCK, n - done);
+	  const unsigned long m = nb * lanes;
+	  const float *x = input + done * step;
+	  float *y = output + done * lanes;
+
+	  // Locates input sample k of the window of the block's
+	  // first output; the following outputs are contiguous.
+	  const float *base = x;
+	  unsigned long pstride = 0;
+	  if(decimate > 1) {
+	    const unsigned long nin = (nb-1)*decimate + ntaps;
+	    for(unsigned int p = 0; p < decimate; p++) {
+	      float *ph = &d_phases[p * span * lanes];
+	      for(unsigned long j = p, i = 0; j < nin; j += decimate, i++)
+		for(unsigned int l = 0; l < lanes; l++)
+		  ph[i*lanes + l] = x[j*lanes + l];
+	    }
+	    base = &d_phases[0];
+	    pstride = span * lanes;
+	  }
+#define FOLD_SAMPLE(k) (base + ((k) % decimate) * pstride + ((k) / decimate) * lanes)
+
+	  if((ntaps & 1) && sym) {
+	    const float c = t[half];
+	    const float *xc = FOLD_SAMPLE(half);
+	    for(unsigned long k = 0; k < m; k++)
+	      y[k] = c * xc[k];
+	  }
+	  else {
+	    std::fill(y, y + m, 0.0f);
+	  }
+
+	  unsigned int j = 0;
+	  if(sym) {
+	    for(; j + 2 <= half; j += 2) {
+	      const float t0 = t[j], t1 = t[j+1];
+	      const float *a0 = FOLD_SAMPLE(j), *a1 = FOLD_SAMPLE(j+1);
+	      const float *b0 = FOLD_SAMPLE(ntaps-1-j), *b1 = FOLD_SAMPLE(ntaps-2-j);
+	      for(unsigned long k = 0; k < m; k++)
+		y[k] += t0 * (a0[k] + b0[k]) + t1 * (a1[k] + b1[k]);
+	    }
+	    for(; j < half; j++) {
+	      const float t0 = t[j];
+	      const float *a0 = FOLD_SAMPLE(j), *b0 = FOLD_SAMPLE(ntaps-1-j);
+	      for(unsigned long k = 0; k < m; k++)
+		y[k] += t0 * (a0[k] + b0[k]);
+	    }
+	  }
+	  else {
+	    for(; j + 2 <= half; j += 2) {
+	      const float t0 = t[j], t1 = t[j+1];
+	      const float *a0 = FOLD_SAMPLE(j), *a1 = FOLD_SAMPLE(j+1);
+	      const float *b0 = FOLD_SAMPLE(ntaps-1-j), *b1 = FOLD_SAMPLE(ntaps-2-j);
+	      for(unsigned long k = 0; k < m; k++)
+		y[k] += t0 * (a0[k] - b0[k]) + t1 * (a1[k] - b1[k]);
+	    }
+	    for(; j < half; j++) {
+	      const float t0 = t[j];
+	      const float *a0 = FOLD_SAMPLE(j), *b0 = FOLD_SAMPLE(ntaps-1-j);
+	      for(unsigned long k = 0; k < m; k++)
+		y[k] += t0 * (a0[k] - b0[k]);
+	    }
+	  }
+#undef FOLD_SAMPLE
+	}
+      }
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,282 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/filter/fir_cascade.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      // Largest intermediate signal, in samples, produced per chunk.
+      static const unsigned long MAX_CHUNK_ITEMS = 8192;
+
+      static void
+      check_stages(const char *name,
+                   const std::vector<unsigned int> &rates,
+                   const std::vector<std::vector<float> > &taps)
+      {
+        if(rates.empty())
+          throw std::invalid_argument(std::string(name) + ": no stages given");
+        if(rates.size() != taps.size())
+          throw std::invalid_argument(std::string(name) + ": need one set of taps per stage");
+        for(size_t i = 0; i < rates.size(); i++) {
+          if(rates[i] == 0)
+            throw std::out_of_range(std::string(name) + ": rates must be > 0");
+          if(taps[i].empty())
+            throw std::invalid_argument(std::string(name) + ": no filter taps provided");
+        }
+      }
+
+      fir_decim_cascade_ccf::fir_decim_cascade_ccf(const std::vector<unsigned int> &rates,
+                                                   const std::vector<std::vector<float> > &taps)
+        : d_rates(rates), d_decimation(1)
+      {
+        check_stages("fir_decim_cascade_ccf", rates, taps);
+
+        for(size_t i = 0; i < rates.size(); i++) {
+          d_firs.push_back(new fir_filter_ccf(rates[i], taps[i]));
+          if(rates[i] == 2 && halfband_decimator::is_halfband(taps[i]))
+            d_halfbands.push_back(new halfband_decimator(taps[i], 2));
+          else
+            d_halfbands.push_back(NULL);
+          d_decimation *= rates[i];
+        }
+
+        // Size the chunk so the output of the first stage, the
+        // longest intermediate signal, stays under MAX_CHUNK_ITEMS.
+        unsigned long per_output = d_decimation / d_rates[0];
+        d_chunk = std::max(1UL, MAX_CHUNK_ITEMS / per_output);
+
+        d_bufs.resize(d_rates.size());
+        for(size_t i = 1; i < d_rates.size(); i++) {
+          d_bufs[i].resize(d_firs[i]->ntaps() - 1 + d_chunk * per_output);
+          per_output /= d_rates[i];
+        }
+      }
+
+      fir_decim_cascade_ccf::~fir_decim_cascade_ccf()
+      {
+        for(size_t i = 0; i < d_firs.size(); i++) {
+          delete d_firs[i];
+          delete d_halfbands[i];
+        }
+      }
+
+      std::vector<std::vector<float> >
+      fir_decim_cascade_ccf::taps() const
+      {
+        std::vector<std::vector<float> > t;
+        for(size_t i = 0; i < d_firs.size(); i++)
+          t.push_back(d_firs[i]->taps());
+        return t;
+      }
+
+      unsigned int
+      fir_decim_cascade_ccf::history() const
+      {
+        return d_firs[0]->ntaps();
+      }
+
+      void
+      fir_decim_cascade_ccf::reset()
+      {
+        for(size_t i = 1; i < d_bufs.size(); i++)
+          std::fill(d_bufs[i].begin(), d_bufs[i].end(), gr_complex(0, 0));
+      }
+
+      void
+      fir_decim_cascade_ccf::run_stage(size_t i, gr_complex output[],
+                                       const gr_complex input[],
+                                       unsigned long n)
+      {
+        if(d_halfbands[i])
+          d_halfbands[i]->filterN((float*)output, (const float*)input, n);
+        else
+          d_firs[i]->filterNdec(output, input, n, d_rates[i]);
+      }
+
+      void
+      fir_decim_cascade_ccf::filterN(gr_complex output[],
+                                     const gr_complex input[],
+                                     unsigned long n)
+      {
+        const size_t nstages = d_firs.size();
+
+        while(n > 0) {
+          unsigned long c = std::min(n, d_chunk);
+          unsigned long m = c * (d_decimation / d_rates[0]);
+
+          gr_complex *dst = (nstages == 1) ? output
+            : &d_bufs[1][d_firs[1]->ntaps() - 1];
+          run_stage(0, dst, input, m);
+
+          for(size_t i = 1; i < nstages; i++) {
+            unsigned long mi = m / d_rates[i];
+            unsigned int h = d_firs[i]->ntaps() - 1;
+            dst = (i == nstages - 1) ? output
+              : &d_bufs[i+1][d_firs[i+1]->ntaps() - 1];
+            run_stage(i, dst, &d_bufs[i][0], mi);
+
+            // the last h inputs are the history of the next chunk
+            std::copy(d_bufs[i].begin() + m, d_bufs[i].begin() + m + h,
+                      d_bufs[i].begin());
+            m = mi;
+          }
+
+          input += c * d_decimation;
+          output += c;
+          n -= c;
+        }
+      }
+
+      /**************************************************************/
+
+      fir_interp_cascade_ccf::fir_interp_cascade_ccf(const std::vector<unsigned int> &rates,
+                                                     const std::vector<std::vector<float> > &taps)
+        : d_rates(rates), d_taps(taps), d_interpolation(1)
+      {
+        check_stages("fir_interp_cascade_ccf", rates, taps);
+
+        d_stages.resize(rates.size());
+        for(size_t i = 0; i < rates.size(); i++) {
+          stage &s = d_stages[i];
+          s.rate = rates[i];
+          s.ntaps = (taps[i].size() + s.rate - 1) / s.rate;
+          s.halfband = NULL;
+
+          if(s.rate == 2 && halfband_decimator::is_halfband(taps[i])) {
+            s.halfband = new halfband_interpolator(taps[i], 2);
+            d_interpolation *= rates[i];
+            continue;
+          }
+
+          // Branch b gets taps b, b+rate, b+2*rate, ...; the last
+          // branches are padded with zeros, as in interp_fir_filter.
+          for(unsigned int b = 0; b < s.rate; b++) {
+            std::vector<float> xtaps(s.ntaps, 0);
+            for(unsigned int k = 0; k < s.ntaps; k++) {
+              if(k * s.rate + b < taps[i].size())
+                xtaps[k] = taps[i][k * s.rate + b];
+            }
+            s.branches.push_back(new fir_filter_ccf(1, xtaps));
+          }
+          d_interpolation *= rates[i];
+        }
+
+        // Size the chunk so the input of the last stage, the longest
+        // intermediate signal, stays under MAX_CHUNK_ITEMS.
+        unsigned long per_input = d_interpolation / d_rates.back();
+        d_chunk = std::max(1UL, MAX_CHUNK_ITEMS / per_input);
+
+        d_bufs.resize(d_stages.size());
+        unsigned long m = d_chunk;
+        for(size_t i = 1; i < d_stages.size(); i++) {
+          m *= d_rates[i-1];
+          d_bufs[i].resize(d_stages[i].ntaps - 1 + m);
+        }
+        d_branch.resize(m);
+      }
+
+      fir_interp_cascade_ccf::~fir_interp_cascade_ccf()
+      {
+        for(size_t i = 0; i < d_stages.size(); i++) {
+          for(size_t b = 0; b < d_stages[i].branches.size(); b++)
+            delete d_stages[i].branches[b];
+          delete d_stages[i].halfband;
+        }
+      }
+
+      unsigned int
+      fir_interp_cascade_ccf::history() const
+      {
+        return d_stages[0].ntaps;
+      }
+
+      void
+      fir_interp_cascade_ccf::reset()
+      {
+        for(size_t i = 1; i < d_bufs.size(); i++)
+          std::fill(d_bufs[i].begin(), d_bufs[i].end(), gr_complex(0, 0));
+      }
+
+      void
+      fir_interp_cascade_ccf::run_stage(stage &s, gr_complex output[],
+                                        const gr_complex input[],
+                                        unsigned long n)
+      {
+        if(s.halfband) {
+          s.halfband->filterN((float*)output, (const float*)input, n);
+          return;
+        }
+
+        for(unsigned int b = 0; b < s.rate; b++) {
+          s.branches[b]->filterN(&d_branch[0], input, n);
+          for(unsigned long i = 0; i < n; i++)
+            output[i * s.rate + b] = d_branch[i];
+        }
+      }
+
+      void
+      fir_interp_cascade_ccf::filterN(gr_complex output[],
+                                      const gr_complex input[],
+                                      unsigned long n)
+      {
+        const size_t nstages = d_stages.size();
+
+        while(n > 0) {
+          unsigned long c = std::min(n, d_chunk);
+          unsigned long m = c;
+          const gr_complex *src = input;
+
+          for(size_t i = 0; i < nstages; i++) {
+            gr_complex *dst = (i == nstages - 1) ? output
+              : &d_bufs[i+1][d_stages[i+1].ntaps - 1];
+            run_stage(d_stages[i], dst, src, m);
+
+            // the last ntaps-1 inputs are the history of the next chunk
+            if(i > 0) {
+              unsigned int h = d_stages[i].ntaps - 1;
+              std::copy(d_bufs[i].begin() + m, d_bufs[i].begin() + m + h,
+                        d_bufs[i].begin());
+            }
+
+            m *= d_stages[i].rate;
+            if(i < nstages - 1)
+              src = &d_bufs[i+1][0];
+          }
+
+          input += c;
+          output += c * d_interpolation;
+          n -= c;
+        }
+      }
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
@@ -21,10 +21,12 @@
  */
 
 #include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/filter_engine.h>
 #include <gnuradio/fft/fft.h>
 #include <volk/volk.h>
 #include <cstdio>
 #include <cstring>
+#include <cmath>
 
 namespace gr {
   namespace filter {
@@ -32,7 +34,13 @@ namespace gr {
 
       fir_filter_fff::fir_filter_fff(int decimation,
 				     const std::vector<float> &taps)
+	: d_folded(1)
       {
+	d_decimation = std::max(1, decimation);
+	d_engine = ENGINE_AUTO;
+	d_fftsize = 0;
+	d_fft = NULL;
+
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(float));
 
@@ -56,6 +64,8 @@ namespace gr {
 
 	// Free output sample
 	volk_free(d_output);
+
+	delete d_fft;
       }
 
       void
@@ -82,6 +92,11 @@ namespace gr {
 	  for(unsigned int j = 0; j < d_ntaps; j++)
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
+
+	d_folded.set_taps(d_taps);
+
+	// The tap count may have changed; choose the engine again.
+	update_engine();
       }
 
       void
@@ -91,6 +106,11 @@ namespace gr {
 	for(int i = 0; i < d_naligned; i++) {
 	  d_aligned_taps[i][i+index] = t;
 	}
+	d_folded.update_tap(t, index);
+
+	// rebuilt with the new taps on next use
+	delete d_fft;
+	d_fft = NULL;
       }
 
       std::vector<float>
@@ -124,7 +144,12 @@ namespace gr {
 			      const float input[],
 			      unsigned long n)
       {
-	for(unsigned long i = 0; i < n; i++) {
+	unsigned long i = filter_fft(output, input, n, 1);
+	if(i < n && d_folded.usable(1)) {
+	  d_folded.filterNdec(&output[i], &input[i], n-i, 1);
+	  return;
+	}
+	for(; i < n; i++) {
 	  output[i] = filter(&input[i]);
 	}
       }
@@ -135,18 +160,74 @@ namespace gr {
 				 unsigned long n,
 				 unsigned int decimate)
       {
-	unsigned long j = 0;
-	for(unsigned long i = 0; i < n; i++) {
+	unsigned long i = filter_fft(output, input, n, decimate);
+	unsigned long j = i * decimate;
+	if(i < n && d_folded.usable(decimate)) {
+	  d_folded.filterNdec(&output[i], &input[j], n-i, decimate);
+	  return;
+	}
+	for(; i < n; i++) {
 	  output[i] = filter(&input[j]);
 	  j += decimate;
 	}
       }
 
+      void
+      fir_filter_fff::set_engine(filter_engine_t engine)
+      {
+	d_engine = engine;
+	update_engine();
+      }
+
+      filter_engine_t
+      fir_filter_fff::engine() const
+      {
+	return d_active;
+      }
+
+      void
+      fir_filter_fff::update_engine()
+      {
+	delete d_fft;
+	d_fft = NULL;
+
+	d_active = filter_cost_model::select(d_engine, filter_cost_model::MAC_REAL,
+					     filter_cost_model::FFT_REAL,
+					     d_ntaps, d_decimation, &d_fftsize,
+					     d_folded.usable(d_decimation));
+
+	// Plan the transforms now rather than in the first filterN,
+	// which usually runs in a block's work().
+	if(d_active == ENGINE_FFT)
+	  d_fft = new overlap_save_fff(d_fftsize, taps(), d_decimation);
+      }
+
+      unsigned long
+      fir_filter_fff::filter_fft(float output[],
+				 const float input[],
+				 unsigned long n,
+				 unsigned int decimate)
+      {
+	if(d_active != ENGINE_FFT)
+	  return 0;
+
+	// rebuilt here after update_tap()
+	if(d_fft == NULL)
+	  update_engine();
+	return d_fft->filterNdec(output, input, n, decimate);
+      }
+
       /**************************************************************/
 
       fir_filter_ccf::fir_filter_ccf(int decimation,
 				     const std::vector<float> &taps)
+	: d_folded(2)
       {
+	d_decimation = std::max(1, decimation);
+	d_engine = ENGINE_AUTO;
+	d_fftsize = 0;
+	d_fft = NULL;
+
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(gr_complex));
 
@@ -170,6 +251,8 @@ namespace gr {
 
 	// Free output sample
 	volk_free(d_output);
+
+	delete d_fft;
       }
 
       void
@@ -196,6 +279,11 @@ namespace gr {
 	  for(unsigned int j = 0; j < d_ntaps; j++)
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
+
+	d_folded.set_taps(d_taps);
+
+	// The tap count may have changed; choose the engine again.
+	update_engine();
       }
 
       void
@@ -205,6 +293,11 @@ namespace gr {
 	for(int i = 0; i < d_naligned; i++) {
 	  d_aligned_taps[i][i+index] = t;
 	}
+	d_folded.update_tap(t, index);
+
+	// rebuilt with the new taps on next use
+	delete d_fft;
+	d_fft = NULL;
       }
 
       std::vector<float>
@@ -238,7 +331,12 @@ namespace gr {
 			      const gr_complex input[],
 			      unsigned long n)
       {
-	for(unsigned long i = 0; i < n; i++)
+	unsigned long i = filter_fft(output, input, n, 1);
+	if(i < n && d_folded.usable(1)) {
+	  d_folded.filterNdec((float*)&output[i], (const float*)&input[i], n-i, 1);
+	  return;
+	}
+	for(; i < n; i++)
 	  output[i] = filter(&input[i]);
       }
 
@@ -249,13 +347,67 @@ namespace gr {
 				 unsigned long n,
 				 unsigned int decimate)
       {
-	unsigned long j = 0;
-	for(unsigned long i = 0; i < n; i++){
+	unsigned long i = filter_fft(output, input, n, decimate);
+	unsigned long j = i * decimate;
+	if(i < n && d_folded.usable(decimate)) {
+	  d_folded.filterNdec((float*)&output[i], (const float*)&input[j],
+			      n-i, decimate);
+	  return;
+	}
+	for(; i < n; i++){
 	  output[i] = filter(&input[j]);
 	  j += decimate;
 	}
       }
 
+      void
+      fir_filter_ccf::set_engine(filter_engine_t engine)
+      {
+	d_engine = engine;
+	update_engine();
+      }
+
+      filter_engine_t
+      fir_filter_ccf::engine() const
+      {
+	return d_active;
+      }
+
+      void
+      fir_filter_ccf::update_engine()
+      {
+	delete d_fft;
+	d_fft = NULL;
+
+	d_active = filter_cost_model::select(d_engine, filter_cost_model::MAC_COMPLEX_REAL,
+					     filter_cost_model::FFT_COMPLEX,
+					     d_ntaps, d_decimation, &d_fftsize,
+					     d_folded.usable(d_decimation));
+
+	// Plan the transforms now rather than in the first filterN,
+	// which usually runs in a block's work().
+	if(d_active == ENGINE_FFT) {
+	  std::vector<float> t = taps();
+	  d_fft = new overlap_save_ccc(d_fftsize,
+				       std::vector<gr_complex>(t.begin(), t.end()),
+				       d_decimation);
+	}
+      }
+
+      unsigned long
+      fir_filter_ccf::filter_fft(gr_complex output[],
+				 const gr_complex input[],
+				 unsigned long n,
+				 unsigned int decimate)
+      {
+	if(d_active != ENGINE_FFT)
+	  return 0;
+
+	// rebuilt here after update_tap()
+	if(d_fft == NULL)
+	  update_engine();
+	return d_fft->filterNdec(output, input, n, decimate);
+      }
 
       /**************************************************************/
 
@@ -263,6 +415,11 @@ namespace gr {
       fir_filter_fcc::fir_filter_fcc(int decimation,
 				     const std::vector<gr_complex> &taps)
       {
+	d_decimation = std::max(1, decimation);
+	d_engine = ENGINE_AUTO;
+	d_fftsize = 0;
+	d_fft = NULL;
+
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(float));
 
@@ -286,6 +443,8 @@ namespace gr {
 
 	// Free output sample
 	volk_free(d_output);
+
+	delete d_fft;
       }
 
       void
@@ -312,6 +471,9 @@ namespace gr {
 	  for(unsigned int j = 0; j < d_ntaps; j++)
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
+
+	// The tap count may have changed; choose the engine again.
+	update_engine();
       }
 
       void
@@ -321,6 +483,10 @@ namespace gr {
 	for(int i = 0; i < d_naligned; i++) {
 	  d_aligned_taps[i][i+index] = t;
 	}
+
+	// rebuilt with the new taps on next use
+	delete d_fft;
+	d_fft = NULL;
       }
 
 
@@ -356,7 +522,8 @@ namespace gr {
 			      const float input[],
 			      unsigned long n)
       {
-	for(unsigned long i = 0; i < n; i++)
+	unsigned long i = filter_fft(output, input, n, 1);
+	for(; i < n; i++)
 	  output[i] = filter(&input[i]);
       }
 
@@ -367,18 +534,68 @@ namespace gr {
 				 unsigned long n,
 				 unsigned int decimate)
       {
-	unsigned long j = 0;
-	for(unsigned long i = 0; i < n; i++){
+	unsigned long i = filter_fft(output, input, n, decimate);
+	unsigned long j = i * decimate;
+	for(; i < n; i++){
 	  output[i] = filter(&input[j]);
 	  j += decimate;
 	}
       }
 
+      void
+      fir_filter_fcc::set_engine(filter_engine_t engine)
+      {
+	d_engine = engine;
+	update_engine();
+      }
+
+      filter_engine_t
+      fir_filter_fcc::engine() const
+      {
+	return d_active;
+      }
+
+      void
+      fir_filter_fcc::update_engine()
+      {
+	delete d_fft;
+	d_fft = NULL;
+
+	d_active = filter_cost_model::select(d_engine, filter_cost_model::MAC_COMPLEX_REAL,
+					     filter_cost_model::FFT_REAL_INPUT,
+					     d_ntaps, d_decimation, &d_fftsize);
+
+	// Plan the transforms now rather than in the first filterN,
+	// which usually runs in a block's work().
+	if(d_active == ENGINE_FFT)
+	  d_fft = new overlap_save_fcc(d_fftsize, taps(), d_decimation);
+      }
+
+      unsigned long
+      fir_filter_fcc::filter_fft(gr_complex output[],
+				 const float input[],
+				 unsigned long n,
+				 unsigned int decimate)
+      {
+	if(d_active != ENGINE_FFT)
+	  return 0;
+
+	// rebuilt here after update_tap()
+	if(d_fft == NULL)
+	  update_engine();
+	return d_fft->filterNdec(output, input, n, decimate);
+      }
+
       /**************************************************************/
 
       fir_filter_ccc::fir_filter_ccc(int decimation,
 				     const std::vector<gr_complex> &taps)
       {
+	d_decimation = std::max(1, decimation);
+	d_engine = ENGINE_AUTO;
+	d_fftsize = 0;
+	d_fft = NULL;
+
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(gr_complex));
 
@@ -402,6 +619,8 @@ namespace gr {
 
 	// Free output sample
 	volk_free(d_output);
+
+	delete d_fft;
       }
 
       void
@@ -428,6 +647,9 @@ namespace gr {
 	  for(unsigned int j = 0; j < d_ntaps; j++)
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
+
+	// The tap count may have changed; choose the engine again.
+	update_engine();
       }
 
       void
@@ -437,6 +659,10 @@ namespace gr {
 	for(int i = 0; i < d_naligned; i++) {
 	  d_aligned_taps[i][i+index] = t;
 	}
+
+	// rebuilt with the new taps on next use
+	delete d_fft;
+	d_fft = NULL;
       }
 
       std::vector<gr_complex>
@@ -470,7 +696,8 @@ namespace gr {
 			      const gr_complex input[],
 			      unsigned long n)
       {
-	for(unsigned long i = 0; i < n; i++)
+	unsigned long i = filter_fft(output, input, n, 1);
+	for(; i < n; i++)
 	  output[i] = filter(&input[i]);
       }
 
@@ -481,18 +708,68 @@ namespace gr {
 				 unsigned long n,
 				 unsigned int decimate)
       {
-	unsigned long j = 0;
-	for(unsigned long i = 0; i < n; i++){
+	unsigned long i = filter_fft(output, input, n, decimate);
+	unsigned long j = i * decimate;
+	for(; i < n; i++){
 	  output[i] = filter(&input[j]);
 	  j += decimate;
 	}
       }
 
+      void
+      fir_filter_ccc::set_engine(filter_engine_t engine)
+      {
+	d_engine = engine;
+	update_engine();
+      }
+
+      filter_engine_t
+      fir_filter_ccc::engine() const
+      {
+	return d_active;
+      }
+
+      void
+      fir_filter_ccc::update_engine()
+      {
+	delete d_fft;
+	d_fft = NULL;
+
+	d_active = filter_cost_model::select(d_engine, filter_cost_model::MAC_COMPLEX,
+					     filter_cost_model::FFT_COMPLEX,
+					     d_ntaps, d_decimation, &d_fftsize);
+
+	// Plan the transforms now rather than in the first filterN,
+	// which usually runs in a block's work().
+	if(d_active == ENGINE_FFT)
+	  d_fft = new overlap_save_ccc(d_fftsize, taps(), d_decimation);
+      }
+
+      unsigned long
+      fir_filter_ccc::filter_fft(gr_complex output[],
+				 const gr_complex input[],
+				 unsigned long n,
+				 unsigned int decimate)
+      {
+	if(d_active != ENGINE_FFT)
+	  return 0;
+
+	// rebuilt here after update_tap()
+	if(d_fft == NULL)
+	  update_engine();
+	return d_fft->filterNdec(output, input, n, decimate);
+      }
+
       /**************************************************************/
 
       fir_filter_scc::fir_filter_scc(int decimation,
 				     const std::vector<gr_complex> &taps)
       {
+	d_decimation = std::max(1, decimation);
+	d_engine = ENGINE_AUTO;
+	d_fftsize = 0;
+	d_fft = NULL;
+
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(short));
 
@@ -516,6 +793,8 @@ namespace gr {
 
 	// Free output sample
 	volk_free(d_output);
+
+	delete d_fft;
       }
 
       void
@@ -542,6 +821,9 @@ namespace gr {
 	  for(unsigned int j = 0; j < d_ntaps; j++)
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
+
+	// The tap count may have changed; choose the engine again.
+	update_engine();
       }
 
       void
@@ -551,6 +833,10 @@ namespace gr {
 	for(int i = 0; i < d_naligned; i++) {
 	  d_aligned_taps[i][i+index] = t;
 	}
+
+	// rebuilt with the new taps on next use
+	delete d_fft;
+	d_fft = NULL;
       }
 
       std::vector<gr_complex>
@@ -585,7 +871,8 @@ namespace gr {
 			      const short input[],
 			      unsigned long n)
       {
-	for(unsigned long i = 0; i < n; i++)
+	unsigned long i = filter_fft(output, input, n, 1);
+	for(; i < n; i++)
 	  output[i] = filter(&input[i]);
       }
 
@@ -596,13 +883,58 @@ namespace gr {
 				 unsigned long n,
 				 unsigned int decimate)
       {
-	unsigned long j = 0;
-	for(unsigned long i = 0; i < n; i++){
+	unsigned long i = filter_fft(output, input, n, decimate);
+	unsigned long j = i * decimate;
+	for(; i < n; i++){
 	  output[i] = filter(&input[j]);
 	  j += decimate;
 	}
       }
 
+      void
+      fir_filter_scc::set_engine(filter_engine_t engine)
+      {
+	d_engine = engine;
+	update_engine();
+      }
+
+      filter_engine_t
+      fir_filter_scc::engine() const
+      {
+	return d_active;
+      }
+
+      void
+      fir_filter_scc::update_engine()
+      {
+	delete d_fft;
+	d_fft = NULL;
+
+	d_active = filter_cost_model::select(d_engine, filter_cost_model::MAC_COMPLEX_REAL,
+					     filter_cost_model::FFT_REAL_INPUT,
+					     d_ntaps, d_decimation, &d_fftsize);
+
+	// Plan the transforms now rather than in the first filterN,
+	// which usually runs in a block's work().
+	if(d_active == ENGINE_FFT)
+	  d_fft = new overlap_save_fcc(d_fftsize, taps(), d_decimation);
+      }
+
+      unsigned long
+      fir_filter_scc::filter_fft(gr_complex output[],
+				 const short input[],
+				 unsigned long n,
+				 unsigned int decimate)
+      {
+	if(d_active != ENGINE_FFT)
+	  return 0;
+
+	// rebuilt here after update_tap()
+	if(d_fft == NULL)
+	  update_engine();
+	return d_fft->filterNdec(output, input, n, decimate);
+      }
+
       /**************************************************************/
 
       fir_filter_fsf::fir_filter_fsf(int decimation,
@@ -717,6 +1049,127 @@ namespace gr {
 	}
       }
 
+      /**************************************************************/
+
+      static std::complex<int16_t>
+      quantize_q15(const gr_complex &t)
+      {
+	float re = std::max(-32767.0f, std::min(32767.0f, rintf(t.real() * 32768.0f)));
+	float im = std::max(-32767.0f, std::min(32767.0f, rintf(t.imag() * 32768.0f)));
+	return std::complex<int16_t>((int16_t)re, (int16_t)im);
+      }
+
+      fir_filter_sc16::fir_filter_sc16(int decimation,
+				       const std::vector<gr_complex> &taps)
+      {
+	d_align = volk_get_alignment();
+	d_naligned = std::max((size_t)1, d_align / sizeof(std::complex<int16_t>));
+
+	d_aligned_taps = NULL;
+	set_taps(taps);
+
+	// Make sure the output sample is always aligned, too.
+	d_output = (std::complex<int16_t>*)volk_malloc(1*sizeof(std::complex<int16_t>), d_align);
+      }
+
+      fir_filter_sc16::~fir_filter_sc16()
+      {
+	// Free all aligned taps
+	if(d_aligned_taps != NULL) {
+	  for(int i = 0; i < d_naligned; i++) {
+	    volk_free(d_aligned_taps[i]);
+	  }
+	  ::free(d_aligned_taps);
+	  d_aligned_taps = NULL;
+	}
+
+	// Free output sample
+	volk_free(d_output);
+      }
+
+      void
+      fir_filter_sc16::set_taps(const std::vector<gr_complex> &taps)
+      {
+	// Free the taps if already allocated
+	if(d_aligned_taps != NULL) {
+	  for(int i = 0; i < d_naligned; i++) {
+	    volk_free(d_aligned_taps[i]);
+	  }
+	  ::free(d_aligned_taps);
+	  d_aligned_taps = NULL;
+	}
+
+	d_ntaps = (int)taps.size();
+	d_taps = taps;
+	std::reverse(d_taps.begin(), d_taps.end());
+
+	// Make a set of Q15 taps at all possible arch alignments
+	d_aligned_taps = (std::complex<int16_t>**)malloc(d_naligned*sizeof(std::complex<int16_t>*));
+	for(int i = 0; i < d_naligned; i++) {
+          d_aligned_taps[i] = (std::complex<int16_t>*)volk_malloc((d_ntaps+d_naligned-1)*sizeof(std::complex<int16_t>), d_align);
+	  memset(d_aligned_taps[i], 0, sizeof(std::complex<int16_t>)*(d_ntaps+d_naligned-1));
+	  for(unsigned int j = 0; j < d_ntaps; j++)
+	    d_aligned_taps[i][i+j] = quantize_q15(d_taps[j]);
+	}
+      }
+
+      void
+      fir_filter_sc16::update_tap(gr_complex t, unsigned int index)
+      {
+	d_taps[index] = t;
+	for(int i = 0; i < d_naligned; i++) {
+	  d_aligned_taps[i][i+index] = quantize_q15(t);
+	}
+      }
+
+      std::vector<gr_complex>
+      fir_filter_sc16::taps() const
+      {
+	std::vector<gr_complex> t = d_taps;
+	std::reverse(t.begin(), t.end());
+	return t;
+      }
+
+      unsigned int
+      fir_filter_sc16::ntaps() const
+      {
+	return d_ntaps;
+      }
+
+      std::complex<int16_t>
+      fir_filter_sc16::filter(const std::complex<int16_t> input[])
+      {
+	const std::complex<int16_t> *ar = (std::complex<int16_t> *)((unsigned long) input & ~(d_align-1));
+	unsigned al = input - ar;
+
+	volk_16ic_x2_dot_prod_16ic_a(d_output, ar,
+				     d_aligned_taps[al],
+				     (d_ntaps+al));
+	return *d_output;
+      }
+
+      void
+      fir_filter_sc16::filterN(std::complex<int16_t> output[],
+			       const std::complex<int16_t> input[],
+			       unsigned long n)
+      {
+	for(unsigned long i = 0; i < n; i++)
+	  output[i] = filter(&input[i]);
+      }
+
+      void
+      fir_filter_sc16::filterNdec(std::complex<int16_t> output[],
+				  const std::complex<int16_t> input[],
+				  unsigned long n,
+				  unsigned int decimate)
+      {
+	unsigned long j = 0;
+	for(unsigned long i = 0; i < n; i++){
+	  output[i] = filter(&input[j]);
+	  j += decimate;
+	}
+      }
+
     } /* namespace kernel */
   } /* namespace filter */
 } /* namespace gr */
@@ -36,6 +36,7 @@ namespace gr {
     namespace kernel {
 
       fir_filter_with_buffer_fff::fir_filter_with_buffer_fff(const std::vector<float> &taps)
+	: d_folded(1)
       {
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(float));
@@ -109,6 +110,8 @@ namespace gr {
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
 
+	d_folded.set_taps(d_taps);
+
 	d_idx = 0;
       }
 
@@ -167,6 +170,11 @@ namespace gr {
 					  const float input[],
 					  unsigned long n)
       {
+	if(n > 0 && d_folded.usable(1)) {
+	  filter_folded(output, input, n, 1);
+	  return;
+	}
+
 	for(unsigned long i = 0; i < n; i++) {
 	  output[i] = filter(input[i]);
 	}
@@ -178,6 +186,11 @@ namespace gr {
 					     unsigned long n,
 					     unsigned long decimate)
       {
+	if(n > 0 && d_folded.usable(decimate)) {
+	  filter_folded(output, input, n, decimate);
+	  return;
+	}
+
 	unsigned long j = 0;
 	for(unsigned long i = 0; i < n; i++) {
 	  output[i] = filter(&input[j], decimate);
@@ -185,6 +198,30 @@ namespace gr {
 	}
       }
 
+      void
+      fir_filter_with_buffer_fff::filter_folded(float output[],
+						const float input[],
+						unsigned long n,
+						unsigned long decimate)
+      {
+	// Lay the history out in front of the new input so the block
+	// can be filtered in one go.
+	const unsigned long nin = n * decimate;
+	d_scratch.resize(d_ntaps - 1 + nin);
+	std::copy(&d_buffer[d_idx+1], &d_buffer[d_idx+d_ntaps], d_scratch.begin());
+	std::copy(input, input + nin, d_scratch.begin() + d_ntaps - 1);
+	d_folded.filterNdec(output, &d_scratch[decimate-1], n, decimate);
+
+	// Leave the circular buffer as filter() would have.
+	for(unsigned long j = nin - std::min(nin, (unsigned long)d_ntaps); j < nin; j++) {
+	  d_buffer[d_idx] = input[j];
+	  d_buffer[d_idx+d_ntaps] = input[j];
+	  d_idx++;
+	  if(d_idx >= d_ntaps)
+	    d_idx = 0;
+	}
+      }
+
 
       /**************************************************************/
 
@@ -343,6 +380,7 @@ namespace gr {
 
 
       fir_filter_with_buffer_ccf::fir_filter_with_buffer_ccf(const std::vector<float> &taps)
+	: d_folded(2)
       {
 	d_align = volk_get_alignment();
 	d_naligned = std::max((size_t)1, d_align / sizeof(gr_complex));
@@ -415,6 +453,8 @@ namespace gr {
 	    d_aligned_taps[i][i+j] = d_taps[j];
 	}
 
+	d_folded.set_taps(d_taps);
+
 	d_idx = 0;
       }
 
@@ -473,6 +513,11 @@ namespace gr {
 					  const gr_complex input[],
 					  unsigned long n)
       {
+	if(n > 0 && d_folded.usable(1)) {
+	  filter_folded(output, input, n, 1);
+	  return;
+	}
+
 	for(unsigned long i = 0; i < n; i++) {
 	  output[i] = filter(input[i]);
 	}
@@ -484,6 +529,11 @@ namespace gr {
 					     unsigned long n,
 					     unsigned long decimate)
       {
+	if(n > 0 && d_folded.usable(decimate)) {
+	  filter_folded(output, input, n, decimate);
+	  return;
+	}
+
 	unsigned long j = 0;
 	for(unsigned long i = 0; i < n; i++) {
 	  output[i] = filter(&input[j], decimate);
@@ -491,6 +541,30 @@ namespace gr {
 	}
       }
 
+      void
+      fir_filter_with_buffer_ccf::filter_folded(gr_complex output[],
+						const gr_complex input[],
+						unsigned long n,
+						unsigned long decimate)
+      {
+	// Lay the history out in front of the new input so the block
+	// can be filtered in one go.
+	const unsigned long nin = n * decimate;
+	d_scratch.resize(d_ntaps - 1 + nin);
+	std::copy(&d_buffer[d_idx+1], &d_buffer[d_idx+d_ntaps], d_scratch.begin());
+	std::copy(input, input + nin, d_scratch.begin() + d_ntaps - 1);
+	d_folded.filterNdec((float*)output, (const float*)&d_scratch[decimate-1], n, decimate);
+
+	// Leave the circular buffer as filter() would have.
+	for(unsigned long j = nin - std::min(nin, (unsigned long)d_ntaps); j < nin; j++) {
+	  d_buffer[d_idx] = input[j];
+	  d_buffer[d_idx+d_ntaps] = input[j];
+	  d_idx++;
+	  if(d_idx >= d_ntaps)
+	    d_idx = 0;
+	}
+      }
+
 
     } /* namespace kernel */
   } /* namespace filter */
@@ -0,0 +1,124 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "fir_interp_cascade_ccf_impl.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace filter {
+
+    fir_interp_cascade_ccf::sptr
+    fir_interp_cascade_ccf::make(const std::vector<unsigned int> &rates,
+                                 const std::vector<std::vector<float> > &taps)
+    {
+      return gnuradio::get_initial_sptr
+	(new fir_interp_cascade_ccf_impl(rates, taps));
+    }
+
+    static unsigned int
+    total_rate(const std::vector<unsigned int> &rates)
+    {
+      unsigned int r = 1;
+      for(size_t i = 0; i < rates.size(); i++)
+        r *= rates[i];
+      return r;
+    }
+
+    fir_interp_cascade_ccf_impl::fir_interp_cascade_ccf_impl(const std::vector<unsigned int> &rates,
+                                                             const std::vector<std::vector<float> > &taps)
+      : sync_interpolator("fir_interp_cascade_ccf",
+                          io_signature::make(1, 1, sizeof(gr_complex)),
+                          io_signature::make(1, 1, sizeof(gr_complex)),
+                          std::max(total_rate(rates), 1U)),
+        d_updated(false)
+    {
+      d_cascade = new kernel::fir_interp_cascade_ccf(rates, taps);
+      set_history(d_cascade->history());
+    }
+
+    fir_interp_cascade_ccf_impl::~fir_interp_cascade_ccf_impl()
+    {
+      delete d_cascade;
+    }
+
+    void
+    fir_interp_cascade_ccf_impl::set_taps(const std::vector<std::vector<float> > &taps)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      if(taps.size() != d_cascade->nstages())
+        throw std::invalid_argument("fir_interp_cascade_ccf: need one set of taps per stage");
+      for(size_t i = 0; i < taps.size(); i++) {
+        if(taps[i].empty())
+          throw std::invalid_argument("fir_interp_cascade_ccf: no filter taps provided");
+      }
+
+      d_new_taps = taps;
+      d_updated = true;
+    }
+
+    std::vector<std::vector<float> >
+    fir_interp_cascade_ccf_impl::taps() const
+    {
+      if(d_updated)
+        return d_new_taps;
+      return d_cascade->taps();
+    }
+
+    std::vector<unsigned int>
+    fir_interp_cascade_ccf_impl::rates() const
+    {
+      return d_cascade->rates();
+    }
+
+    int
+    fir_interp_cascade_ccf_impl::work(int noutput_items,
+                                      gr_vector_const_void_star &input_items,
+                                      gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      const gr_complex *in = (const gr_complex*)input_items[0];
+      gr_complex *out = (gr_complex*)output_items[0];
+
+      if(d_updated) {
+        kernel::fir_interp_cascade_ccf *cascade =
+          new kernel::fir_interp_cascade_ccf(d_cascade->rates(), d_new_taps);
+        delete d_cascade;
+        d_cascade = cascade;
+        set_history(d_cascade->history());
+        d_updated = false;
+        return 0;            // history requirements may have changed.
+      }
+
+      d_cascade->filterN(out, in, noutput_items / interpolation());
+      return noutput_items;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
@@ -25,6 +25,7 @@
 #endif
 
 #include <gnuradio/filter/firdes.h>
+#include <algorithm>
 #include <stdexcept>
 
 using std::vector;
@@ -573,6 +574,54 @@ namespace gr {
       return taps;
     }
 
+    //
+    // Halfband
+    //
+
+    vector<float>
+    firdes::halfband(double gain,
+		     double sampling_freq,
+		     double transition_width,
+		     double attenuation_dB)
+    {
+      sanity_check_1f(sampling_freq, sampling_freq / 4, transition_width);
+      if(transition_width >= sampling_freq / 2)
+	throw std::out_of_range("firdes check failed: transition_width < sampling_freq / 2");
+
+      // Kaiser's estimates of the length and window for the attenuation
+      double dw = 2 * M_PI * transition_width / sampling_freq;
+      int ntaps = (int)ceil((attenuation_dB - 7.95) / (2.285 * dw)) + 1;
+      double beta = 0;
+      if(attenuation_dB > 50)
+	beta = 0.1102 * (attenuation_dB - 8.7);
+      else if(attenuation_dB >= 21)
+	beta = 0.5842 * pow(attenuation_dB - 21, 0.4) + 0.07886 * (attenuation_dB - 21);
+
+      // round up to 4k+3 taps, so the outermost taps are not zero
+      ntaps = std::max(ntaps, 3);
+      ntaps += (7 - ntaps % 4) % 4;
+
+      vector<float> taps(ntaps, 0);
+      vector<float> w = window(WIN_KAISER, ntaps, beta);
+      int M = (ntaps - 1) / 2;
+      double sum = 0;
+      for(int n = 1; n <= M; n += 2) {
+	double t = sin(n * M_PI / 2) / (n * M_PI) * w[M + n];
+	taps[M + n] = taps[M - n] = t;
+	sum += 2 * t;
+      }
+
+      // The non-zero side taps sum to gain/2, as does the centre
+      // tap, so the DC gain is exactly gain.
+      for(int n = 1; n <= M; n += 2) {
+	taps[M + n] *= gain / 2 / sum;
+	taps[M - n] = taps[M + n];
+      }
+      taps[M] = gain / 2;
+
+      return taps;
+    }
+
     //
     // Gaussian
     //
@@ -24,7 +24,7 @@
 #define	INCLUDED_FRACTIONAL_RESAMPLER_CC_IMPL_H
 
 #include <gnuradio/filter/fractional_resampler_cc.h>
-#include <gnuradio/filter/mmse_fir_interpolator_cc.h>
+#include <gnuradio/filter/resampler_engine.h>
 
 namespace gr {
   namespace filter {
@@ -35,7 +35,10 @@ namespace gr {
     private:
       float d_mu;
       float d_mu_inc;
-      mmse_fir_interpolator_cc *d_resamp;
+      kernel::resampler_engine_ccf d_engine;   // one arm per MMSE interpolator step
+      kernel::resampler_schedule d_schedule;
+
+      void schedule(int ii);
 
     public:
       fractional_resampler_cc_impl(float phase_shift,
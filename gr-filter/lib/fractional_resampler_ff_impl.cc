@@ -26,6 +26,7 @@
 
 #include <gnuradio/io_signature.h>
 #include "fractional_resampler_ff_impl.h"
+#include <gnuradio/filter/interpolator_taps.h>
 #include <stdexcept>
 
 namespace gr {
@@ -43,8 +44,7 @@ namespace gr {
       : block("fractional_resampler_ff",
               io_signature::make(1, 2, sizeof(float)),
               io_signature::make(1, 1, sizeof(float))),
-	d_mu (phase_shift), d_mu_inc (resamp_ratio),
-	d_resamp(new mmse_fir_interpolator_ff())
+	d_mu (phase_shift), d_mu_inc (resamp_ratio)
     {
       if(resamp_ratio <=  0)
 	throw std::out_of_range("resampling ratio must be > 0");
@@ -52,11 +52,29 @@ namespace gr {
 	throw std::out_of_range("phase shift ratio must be > 0 and < 1");
 
       set_relative_rate(1.0 / resamp_ratio);
+
+      std::vector< std::vector<float> > arms(NSTEPS + 1);
+      for(int i = 0; i < NSTEPS + 1; i++)
+        arms[i].assign(&taps[i][0], &taps[i][NTAPS]);
+      d_engine.set_taps(arms);
     }
 
     fractional_resampler_ff_impl::~fractional_resampler_ff_impl()
     {
-      delete d_resamp;
+    }
+
+    void
+    fractional_resampler_ff_impl::schedule(int ii)
+    {
+      // Same rounding of mu to the nearest step as
+      // mmse_fir_interpolator_ff::interpolate()
+      int imu = (int)rint(d_mu * NSTEPS);
+
+      if((imu < 0) || (imu > NSTEPS)) {
+	throw std::runtime_error("fractional_resampler_ff: imu out of bounds.\n");
+      }
+
+      d_schedule.push(imu, ii);
     }
 
     void
@@ -66,7 +84,7 @@ namespace gr {
       unsigned ninputs = ninput_items_required.size();
       for(unsigned i=0; i < ninputs; i++) {
 	ninput_items_required[i] =
-	  (int)ceil((noutput_items * d_mu_inc) + d_resamp->ntaps());
+	  (int)ceil((noutput_items * d_mu_inc) + NTAPS);
       }
     }
 
@@ -82,9 +100,13 @@ namespace gr {
       int ii = 0; // input index
       int oo = 0; // output index
 
+      // Step mu through all the outputs first, then compute them in
+      // one pass over the schedule.
+      d_schedule.clear();
       if(ninput_items.size() == 1) {
         while(oo < noutput_items) {
-          out[oo++] = d_resamp->interpolate(&in[ii], d_mu);
+          schedule(ii);
+          oo++;
 
           double s = d_mu + d_mu_inc;
           double f = floor(s);
@@ -93,13 +115,15 @@ namespace gr {
           ii += incr;
         }
 
+        d_engine.filter(out, in, d_schedule);
         consume_each(ii);
         return noutput_items;
       }
       else {
         const float *rr = (const float*)input_items[1];
         while(oo < noutput_items) {
-          out[oo++] = d_resamp->interpolate(&in[ii], d_mu);
+          schedule(ii);
+          oo++;
           d_mu_inc = rr[ii];
 
           double s = d_mu + d_mu_inc;
@@ -110,6 +134,7 @@ namespace gr {
         }
 
         set_relative_rate(1.0 / d_mu_inc);
+        d_engine.filter(out, in, d_schedule);
         consume_each(ii);
         return noutput_items;
       }
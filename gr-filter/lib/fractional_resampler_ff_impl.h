@@ -24,7 +24,7 @@
 #define	INCLUDED_FRACTIONAL_RESAMPLER_FF_IMPL_H
 
 #include <gnuradio/filter/fractional_resampler_ff.h>
-#include <gnuradio/filter/mmse_fir_interpolator_ff.h>
+#include <gnuradio/filter/resampler_engine.h>
 
 namespace gr {
   namespace filter {
@@ -35,7 +35,10 @@ namespace gr {
     private:
       float d_mu;
       float d_mu_inc;
-      mmse_fir_interpolator_ff *d_resamp;
+      kernel::resampler_engine_fff d_engine;   // one arm per MMSE interpolator step
+      kernel::resampler_schedule d_schedule;
+
+      void schedule(int ii);
 
     public:
       fractional_resampler_ff_impl(float phase_shift,
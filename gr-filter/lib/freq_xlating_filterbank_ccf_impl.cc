@@ -0,0 +1,290 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "freq_xlating_filterbank_ccf_impl.h"
+#include <gnuradio/io_signature.h>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+namespace gr {
+  namespace filter {
+
+    freq_xlating_filterbank_ccf::sptr
+    freq_xlating_filterbank_ccf::make(int decimation,
+                                      const std::vector<std::vector<float> > &taps,
+                                      const std::vector<double> &center_freqs,
+                                      double sampling_freq,
+                                      int nthreads)
+    {
+      return gnuradio::get_initial_sptr
+        (new freq_xlating_filterbank_ccf_impl(decimation, taps,
+                                              center_freqs, sampling_freq,
+                                              nthreads));
+    }
+
+    freq_xlating_filterbank_ccf_impl::freq_xlating_filterbank_ccf_impl
+        (int decimation,
+         const std::vector<std::vector<float> > &taps,
+         const std::vector<double> &center_freqs,
+         double sampling_freq,
+         int nthreads)
+    : sync_decimator("freq_xlating_filterbank_ccf",
+                     io_signature::make(1, 1, sizeof(gr_complex)),
+                     io_signature::make(1, -1, sizeof(gr_complex)),
+                     decimation),
+      d_sampling_freq(sampling_freq),
+      d_pool(new kernel::worker_pool(nthreads))
+    {
+      if(taps.size() != center_freqs.size())
+        throw std::invalid_argument("freq_xlating_filterbank_ccf: taps and center_freqs must have the same length");
+
+      for(unsigned int i = 0; i < taps.size(); i++)
+        set_channel(i, taps[i], center_freqs[i]);
+
+      set_history(max_ntaps());
+    }
+
+    freq_xlating_filterbank_ccf_impl::~freq_xlating_filterbank_ccf_impl()
+    {
+      for(unsigned int i = 0; i < d_channels.size(); i++) {
+        if(d_channels[i] != NULL) {
+          delete d_channels[i]->fir;
+          delete d_channels[i];
+        }
+      }
+      delete d_pool;
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::build_composite_fir(channel *ch)
+    {
+      // Same construction as freq_xlating_fir_filter_ccf: the
+      // prototype low-pass is moved up to the center frequency and
+      // the decimated output is derotated back to baseband.
+      std::vector<gr_complex> ctaps(ch->proto_taps.size());
+      float fwT0 = 2 * M_PI * ch->center_freq / d_sampling_freq;
+      for(unsigned int i = 0; i < ch->proto_taps.size(); i++) {
+        ctaps[i] = ch->proto_taps[i] * exp(gr_complex(0, i * fwT0));
+      }
+
+      ch->fir->set_taps(ctaps);
+      ch->r.set_phase_incr(exp(gr_complex(0, -fwT0 * decimation())));
+    }
+
+    unsigned int
+    freq_xlating_filterbank_ccf_impl::max_ntaps() const
+    {
+      unsigned int ntaps = 1;
+      for(unsigned int i = 0; i < d_channels.size(); i++) {
+        if(d_channels[i] != NULL)
+          ntaps = std::max(ntaps, (unsigned int)d_channels[i]->proto_taps.size());
+      }
+      return ntaps;
+    }
+
+    freq_xlating_filterbank_ccf_impl::channel *
+    freq_xlating_filterbank_ccf_impl::get_channel(unsigned int chan) const
+    {
+      if(chan >= d_channels.size() || d_channels[chan] == NULL)
+        throw std::out_of_range("freq_xlating_filterbank_ccf: no such channel");
+      return d_channels[chan];
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::set_channel(unsigned int chan,
+                                                  const std::vector<float> &taps,
+                                                  double center_freq)
+    {
+      if(taps.empty())
+        throw std::invalid_argument("freq_xlating_filterbank_ccf: a channel needs at least one tap");
+
+      gr::thread::scoped_lock guard(d_mutex);
+      if(chan >= d_channels.size())
+        d_channels.resize(chan+1, NULL);
+
+      channel *ch = d_channels[chan];
+      if(ch == NULL) {
+        std::vector<gr_complex> dummy_taps;
+        ch = new channel;
+        ch->fir = new kernel::fir_filter_ccc(decimation(), dummy_taps);
+        d_channels[chan] = ch;
+      }
+      ch->proto_taps = taps;
+      ch->center_freq = center_freq;
+      ch->updated = true;
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::remove_channel(unsigned int chan)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      channel *ch = get_channel(chan);
+      delete ch->fir;
+      delete ch;
+      d_channels[chan] = NULL;
+    }
+
+    unsigned int
+    freq_xlating_filterbank_ccf_impl::nchans() const
+    {
+      return d_channels.size();
+    }
+
+    bool
+    freq_xlating_filterbank_ccf_impl::has_channel(unsigned int chan) const
+    {
+      return chan < d_channels.size() && d_channels[chan] != NULL;
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::set_center_freq(unsigned int chan,
+                                                      double center_freq)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      channel *ch = get_channel(chan);
+      ch->center_freq = center_freq;
+      ch->updated = true;
+    }
+
+    double
+    freq_xlating_filterbank_ccf_impl::center_freq(unsigned int chan) const
+    {
+      return get_channel(chan)->center_freq;
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::set_taps(unsigned int chan,
+                                               const std::vector<float> &taps)
+    {
+      if(taps.empty())
+        throw std::invalid_argument("freq_xlating_filterbank_ccf: a channel needs at least one tap");
+
+      gr::thread::scoped_lock guard(d_mutex);
+      channel *ch = get_channel(chan);
+      ch->proto_taps = taps;
+      ch->updated = true;
+    }
+
+    std::vector<float>
+    freq_xlating_filterbank_ccf_impl::taps(unsigned int chan) const
+    {
+      return get_channel(chan)->proto_taps;
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::set_nthreads(int nthreads)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      delete d_pool;
+      d_pool = new kernel::worker_pool(nthreads);
+    }
+
+    int
+    freq_xlating_filterbank_ccf_impl::nthreads() const
+    {
+      return d_pool->nthreads();
+    }
+
+    void
+    freq_xlating_filterbank_ccf_impl::filter_channels(int index,
+                                                      const gr_complex *in,
+                                                      gr_vector_void_star *output_items,
+                                                      int noutput_items)
+    {
+      const unsigned int decim = decimation();
+      const unsigned int hist = history();
+      const unsigned int nthreads = d_pool->nthreads();
+      const int chunk = std::max(1, CHUNK_ITEMS / (int)decim);
+
+      // Every channel this thread owns filters one chunk of the input
+      // before any of them moves on to the next, so the chunk is read
+      // from memory once and then served from cache.
+      for(int start = 0; start < noutput_items; start += chunk) {
+        int n = std::min(chunk, noutput_items - start);
+        const gr_complex *chunk_in = in + start * decim;
+
+        for(unsigned int j = index; j < d_running.size(); j += nthreads) {
+          channel *ch = d_channels[d_running[j]];
+          gr_complex *out = (gr_complex *)(*output_items)[d_running[j]] + start;
+
+          // Channels with fewer taps than the history skip its start.
+          ch->fir->filterNdec(out, chunk_in + hist - ch->proto_taps.size(),
+                              n, decim);
+          ch->r.rotateN(out, out, n);
+        }
+      }
+    }
+
+    int
+    freq_xlating_filterbank_ccf_impl::work(int noutput_items,
+                                           gr_vector_const_void_star &input_items,
+                                           gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      const gr_complex *in = (const gr_complex *)input_items[0];
+      const unsigned int noutputs = output_items.size();
+
+      // rebuild the composite FIRs of channels that have changed
+      for(unsigned int i = 0; i < d_channels.size(); i++) {
+        channel *ch = d_channels[i];
+        if(ch == NULL || !ch->updated)
+          continue;
+
+        build_composite_fir(ch);
+        ch->updated = false;
+
+        // Tell downstream items where the change was applied
+        if(i < noutputs) {
+          add_item_tag(i, nitems_written(i),
+                       pmt::intern("freq"), pmt::from_double(ch->center_freq),
+                       alias_pmt());
+        }
+      }
+
+      if(max_ntaps() != history()) {
+        set_history(max_ntaps());
+        return 0;                    // history requirements have changed.
+      }
+
+      d_running.clear();
+      for(unsigned int i = 0; i < noutputs; i++) {
+        if(i < d_channels.size() && d_channels[i] != NULL)
+          d_running.push_back(i);
+        else
+          memset(output_items[i], 0, noutput_items * sizeof(gr_complex));
+      }
+
+      d_pool->run(boost::bind(&freq_xlating_filterbank_ccf_impl::filter_channels,
+                              this, _1, in, &output_items, noutput_items));
+
+      return noutput_items;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FREQ_XLATING_FILTERBANK_CCF_IMPL_H
+#define	INCLUDED_FILTER_FREQ_XLATING_FILTERBANK_CCF_IMPL_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/worker_pool.h>
+#include <gnuradio/filter/freq_xlating_filterbank_ccf.h>
+#include <gnuradio/blocks/rotator.h>
+#include <gnuradio/thread/thread.h>
+
+namespace gr {
+  namespace filter {
+
+    class FILTER_API freq_xlating_filterbank_ccf_impl : public freq_xlating_filterbank_ccf
+    {
+    private:
+      struct channel {
+        std::vector<float>        proto_taps;
+        double                    center_freq;
+        kernel::fir_filter_ccc   *fir;
+        blocks::rotator           r;
+        bool                      updated;
+      };
+
+      // Input samples filtered by every channel before moving on.
+      static const int CHUNK_ITEMS = 8192;
+
+      std::vector<channel*>       d_channels;  // NULL for removed channels
+      std::vector<unsigned int>   d_running;   // channels run by this call to work
+      double                      d_sampling_freq;
+      kernel::worker_pool        *d_pool;
+      gr::thread::mutex           d_mutex;     // protects set/work access
+
+      void build_composite_fir(channel *ch);
+      unsigned int max_ntaps() const;
+      channel *get_channel(unsigned int chan) const;
+      void filter_channels(int index, const gr_complex *in,
+                           gr_vector_void_star *output_items,
+                           int noutput_items);
+
+    public:
+      freq_xlating_filterbank_ccf_impl(int decimation,
+                                       const std::vector<std::vector<float> > &taps,
+                                       const std::vector<double> &center_freqs,
+                                       double sampling_freq,
+                                       int nthreads);
+      ~freq_xlating_filterbank_ccf_impl();
+
+      void set_channel(unsigned int chan,
+                       const std::vector<float> &taps,
+                       double center_freq);
+      void remove_channel(unsigned int chan);
+      unsigned int nchans() const;
+      bool has_channel(unsigned int chan) const;
+
+      void set_center_freq(unsigned int chan, double center_freq);
+      double center_freq(unsigned int chan) const;
+
+      void set_taps(unsigned int chan, const std::vector<float> &taps);
+      std::vector<float> taps(unsigned int chan) const;
+
+      void set_nthreads(int nthreads);
+      int nthreads() const;
+
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FREQ_XLATING_FILTERBANK_CCF_IMPL_H */
@@ -158,11 +158,10 @@ namespace gr {
 	return 0;		     // history requirements may have changed.
       }
 
-      unsigned j = 0;
-      for (int i = 0; i < noutput_items; i++){
-        out[i] = d_r.rotate(d_composite_fir->filter(&in[j]));
-        j += decimation();
-      }
+      // Filter the whole buffer first so the composite FIR can use
+      // its fastest engine, then derotate in place.
+      d_composite_fir->filterNdec(out, in, noutput_items, decimation());
+      d_r.rotateN(out, out, noutput_items);
 
       return noutput_items;
     }
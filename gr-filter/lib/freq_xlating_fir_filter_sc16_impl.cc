@@ -0,0 +1,168 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "freq_xlating_fir_filter_sc16_impl.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <math.h>
+
+namespace gr {
+  namespace filter {
+
+    freq_xlating_fir_filter_sc16::sptr
+    freq_xlating_fir_filter_sc16::make(int decimation,
+				       const std::vector<float> &taps,
+				       double center_freq,
+				       double sampling_freq)
+    {
+      return gnuradio::get_initial_sptr(new freq_xlating_fir_filter_sc16_impl
+					(decimation, taps,
+					 center_freq,
+					 sampling_freq));
+    }
+
+    freq_xlating_fir_filter_sc16_impl::freq_xlating_fir_filter_sc16_impl
+    (int decimation,
+     const std::vector<float> &taps,
+     double center_freq,
+     double sampling_freq)
+    : sync_decimator("freq_xlating_fir_filter_sc16",
+			io_signature::make(1, 1, sizeof(std::complex<int16_t>)),
+			io_signature::make(1, 1, sizeof(std::complex<int16_t>)),
+			decimation),
+      d_proto_taps(taps), d_phase(1, 0),
+      d_center_freq(center_freq),
+      d_sampling_freq(sampling_freq),
+      d_updated(false)
+    {
+      std::vector<gr_complex> dummy_taps;
+      d_composite_fir = new kernel::fir_filter_sc16(decimation, dummy_taps);
+
+      set_history(d_proto_taps.size());
+      build_composite_fir();
+
+      const int alignment_multiple =
+	volk_get_alignment() / sizeof(std::complex<int16_t>);
+      set_alignment(std::max(1, alignment_multiple));
+
+      message_port_register_in(pmt::mp("freq"));
+      set_msg_handler(pmt::mp("freq"),
+                      boost::bind(&freq_xlating_fir_filter_sc16_impl::handle_set_center_freq,
+                                  this, _1));
+    }
+
+    freq_xlating_fir_filter_sc16_impl::~freq_xlating_fir_filter_sc16_impl()
+    {
+      delete d_composite_fir;
+    }
+
+    void
+    freq_xlating_fir_filter_sc16_impl::build_composite_fir()
+    {
+      std::vector<gr_complex> ctaps(d_proto_taps.size());
+
+      // Same structure as the float versions:
+      //    x(t) -> BPF -> decim -> (mult by fwT0*decim) -> y(t)
+      // except that the band-pass taps are quantized to Q15 by
+      // the sc16 FIR and the derotation runs on 16-bit samples.
+
+      float fwT0 = 2 * M_PI * d_center_freq / d_sampling_freq;
+      for(unsigned int i = 0; i < d_proto_taps.size(); i++) {
+	ctaps[i] = d_proto_taps[i] * exp(gr_complex(0, i * fwT0));
+      }
+
+      d_composite_fir->set_taps(ctaps);
+      d_phase_inc = exp(gr_complex(0, -fwT0 * decimation()));
+    }
+
+    void
+    freq_xlating_fir_filter_sc16_impl::set_center_freq(double center_freq)
+    {
+      d_center_freq = center_freq;
+      d_updated = true;
+    }
+
+    double
+    freq_xlating_fir_filter_sc16_impl::center_freq() const
+    {
+      return d_center_freq;
+    }
+
+    void
+    freq_xlating_fir_filter_sc16_impl::set_taps(const std::vector<float> &taps)
+    {
+      d_proto_taps = taps;
+      d_updated = true;
+    }
+
+    std::vector<float>
+    freq_xlating_fir_filter_sc16_impl::taps() const
+    {
+      return d_proto_taps;
+    }
+
+    void
+    freq_xlating_fir_filter_sc16_impl::handle_set_center_freq(pmt::pmt_t msg)
+    {
+      if(pmt::is_pair(msg)) {
+        pmt::pmt_t x = pmt::cdr(msg);
+        if(pmt::is_real(x)) {
+          double freq = pmt::to_double(x);
+          set_center_freq(freq);
+        }
+      }
+    }
+
+    int
+    freq_xlating_fir_filter_sc16_impl::work(int noutput_items,
+					    gr_vector_const_void_star &input_items,
+					    gr_vector_void_star &output_items)
+    {
+      const std::complex<int16_t> *in = (const std::complex<int16_t> *)input_items[0];
+      std::complex<int16_t> *out = (std::complex<int16_t> *)output_items[0];
+
+      // rebuild composite FIR if the center freq has changed
+      if(d_updated) {
+	set_history(d_proto_taps.size());
+	build_composite_fir();
+	d_updated = false;
+
+        // Tell downstream items where the frequency change was applied
+        add_item_tag(0, nitems_written(0),
+                     pmt::intern("freq"), pmt::from_double(d_center_freq),
+                     alias_pmt());
+	return 0;		     // history requirements may have changed.
+      }
+
+      d_composite_fir->filterNdec(out, in, noutput_items, decimation());
+      volk_16ic_s32fc_x2_rotator_16ic(out, out, d_phase_inc, &d_phase,
+				      noutput_items);
+
+      return noutput_items;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_FREQ_XLATING_FIR_FILTER_SC16_IMPL_H
+#define	INCLUDED_FILTER_FREQ_XLATING_FIR_FILTER_SC16_IMPL_H
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/freq_xlating_fir_filter_sc16.h>
+
+namespace gr {
+  namespace filter {
+
+    class FILTER_API freq_xlating_fir_filter_sc16_impl : public freq_xlating_fir_filter_sc16
+    {
+    protected:
+      std::vector<float>	d_proto_taps;
+      kernel::fir_filter_sc16  *d_composite_fir;
+      gr_complex		d_phase_inc;
+      gr_complex		d_phase;
+      double			d_center_freq;
+      double			d_sampling_freq;
+      bool			d_updated;
+
+      virtual void build_composite_fir();
+    public:
+
+      freq_xlating_fir_filter_sc16_impl(int decimation,
+					const std::vector<float> &taps,
+					double center_freq,
+					double sampling_freq);
+      virtual ~freq_xlating_fir_filter_sc16_impl();
+
+      void set_center_freq(double center_freq);
+      double center_freq() const;
+
+      void set_taps(const std::vector<float> &taps);
+      std::vector<float> taps() const;
+
+      void handle_set_center_freq(pmt::pmt_t msg);
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_FREQ_XLATING_FIR_FILTER_SC16_IMPL_H */
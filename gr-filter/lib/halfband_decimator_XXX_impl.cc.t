@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* @WARNING@ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "@IMPL_NAME@.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+
+namespace gr {
+  namespace filter {
+
+    // number of floats in one sample
+    static const unsigned int LANES = sizeof(@I_TYPE@) / sizeof(float);
+
+    static void
+    check_taps(const std::vector<@TAP_TYPE@> &taps)
+    {
+      if(!kernel::halfband_decimator::is_halfband(taps))
+        throw std::invalid_argument("@BASE_NAME@: taps must be 4k+3 symmetric taps with zeros at even offsets from the centre");
+    }
+
+    @BASE_NAME@::sptr
+    @BASE_NAME@::make(const std::vector<@TAP_TYPE@> &taps)
+    {
+      return gnuradio::get_initial_sptr(new @IMPL_NAME@(taps));
+    }
+
+    @IMPL_NAME@::@IMPL_NAME@(const std::vector<@TAP_TYPE@> &taps)
+      : sync_decimator("@BASE_NAME@",
+                       io_signature::make(1, 1, sizeof(@I_TYPE@)),
+                       io_signature::make(1, 1, sizeof(@O_TYPE@)),
+                       2),
+        d_updated(false)
+    {
+      check_taps(taps);
+      d_halfband = new kernel::halfband_decimator(taps, LANES);
+      set_history(d_halfband->ntaps());
+    }
+
+    @IMPL_NAME@::~@IMPL_NAME@()
+    {
+      delete d_halfband;
+    }
+
+    void
+    @IMPL_NAME@::set_taps(const std::vector<@TAP_TYPE@> &taps)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      // check the taps now rather than in work
+      check_taps(taps);
+
+      d_new_taps = taps;
+      d_updated = true;
+    }
+
+    std::vector<@TAP_TYPE@>
+    @IMPL_NAME@::taps() const
+    {
+      if(d_updated)
+        return d_new_taps;
+      return d_halfband->taps();
+    }
+
+    int
+    @IMPL_NAME@::work(int noutput_items,
+		      gr_vector_const_void_star &input_items,
+		      gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      const @I_TYPE@ *in = (const @I_TYPE@ *)input_items[0];
+      @O_TYPE@ *out = (@O_TYPE@ *)output_items[0];
+
+      if(d_updated) {
+        d_halfband->set_taps(d_new_taps);
+        set_history(d_halfband->ntaps());
+        d_updated = false;
+        return 0;            // history requirements may have changed.
+      }
+
+      d_halfband->filterN((float*)out, (const float*)in, noutput_items);
+      return noutput_items;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
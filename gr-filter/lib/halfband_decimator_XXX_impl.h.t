@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* @WARNING@ */
+
+#ifndef @GUARD_NAME@
+#define	@GUARD_NAME@
+
+#include <gnuradio/filter/api.h>
+#include <gnuradio/filter/halfband_filter.h>
+#include <gnuradio/filter/@BASE_NAME@.h>
+#include <gnuradio/thread/thread.h>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+
+    class FILTER_API @IMPL_NAME@ : public @BASE_NAME@
+    {
+    private:
+      kernel::halfband_decimator *d_halfband;
+      std::vector<@TAP_TYPE@> d_new_taps;
+      bool d_updated;
+      gr::thread::mutex d_mutex; // mutex to protect set/work access
+
+    public:
+      @IMPL_NAME@(const std::vector<@TAP_TYPE@> &taps);
+      ~@IMPL_NAME@();
+
+      void set_taps(const std::vector<@TAP_TYPE@> &taps);
+      std::vector<@TAP_TYPE@> taps() const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* @GUARD_NAME@ */
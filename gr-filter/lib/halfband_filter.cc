@@ -0,0 +1,182 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/filter/halfband_filter.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      // Outputs (decimator) or inputs (interpolator) per block.
+      static const unsigned long BLOCK_ITEMS = 1024;
+
+      bool
+      halfband_decimator::is_halfband(const std::vector<float> &taps)
+      {
+        if(taps.size() % 4 != 3)
+          return false;
+
+        const int M = (taps.size() - 1) / 2;
+        float tol = 1e-6f * std::fabs(taps[M]);
+        for(int n = 1; n <= M; n++) {
+          if(std::fabs(taps[M+n] - taps[M-n]) > tol)
+            return false;
+          if((n & 1) == 0 && std::fabs(taps[M+n]) > tol)
+            return false;
+        }
+        return true;
+      }
+
+      // Splits halfband taps into the centre tap and the non-zero
+      // taps on one side, nearest the centre first.
+      static void
+      split_taps(const std::vector<float> &taps,
+                 float &center, std::vector<float> &pairs)
+      {
+        if(!halfband_decimator::is_halfband(taps))
+          throw std::invalid_argument("halfband filter: taps must be 4k+3 symmetric taps with zeros at even offsets from the centre");
+
+        const unsigned int M = (taps.size() - 1) / 2;
+        center = taps[M];
+        pairs.clear();
+        for(unsigned int n = 1; n <= M; n += 2)
+          pairs.push_back(taps[M+n]);
+      }
+
+      halfband_decimator::halfband_decimator(const std::vector<float> &taps,
+                                             unsigned int lanes)
+        : d_lanes(lanes)
+      {
+        set_taps(taps);
+      }
+
+      void
+      halfband_decimator::set_taps(const std::vector<float> &taps)
+      {
+        split_taps(taps, d_center, d_pairs);
+        d_taps = taps;
+        d_even.resize((BLOCK_ITEMS + 2*d_pairs.size()) * d_lanes);
+      }
+
+      void
+      halfband_decimator::filterN(float output[], const float input[],
+                                  unsigned long n)
+      {
+        const unsigned int L = d_lanes;
+        const unsigned long k = d_pairs.size() - 1;
+
+        while(n > 0) {
+          const unsigned long b = std::min(n, BLOCK_ITEMS);
+
+          // out[m] = c*x[2m+2k+1] + sum_j p_j*(e[m+k-j] + e[m+k+j+1]),
+          // where e[i] = x[2i] are the even input samples.
+          for(unsigned long i = 0; i < b + 2*k + 1; i++) {
+            for(unsigned int l = 0; l < L; l++)
+              d_even[i*L + l] = input[2*i*L + l];
+          }
+
+          const float *odd = &input[(2*k + 1) * L];
+          for(unsigned long m = 0; m < b; m++) {
+            for(unsigned int l = 0; l < L; l++)
+              output[m*L + l] = d_center * odd[2*m*L + l];
+          }
+
+          const float *even = &d_even[0];
+          const unsigned long nf = b * L;
+          for(unsigned long j = 0; j <= k; j++) {
+            const float p = d_pairs[j];
+            const float *lo = &even[(k - j) * L];
+            const float *hi = &even[(k + j + 1) * L];
+            for(unsigned long i = 0; i < nf; i++)
+              output[i] += p * (lo[i] + hi[i]);
+          }
+
+          input += 2 * b * L;
+          output += b * L;
+          n -= b;
+        }
+      }
+
+      /**************************************************************/
+
+      halfband_interpolator::halfband_interpolator(const std::vector<float> &taps,
+                                                   unsigned int lanes)
+        : d_lanes(lanes)
+      {
+        set_taps(taps);
+      }
+
+      void
+      halfband_interpolator::set_taps(const std::vector<float> &taps)
+      {
+        split_taps(taps, d_center, d_pairs);
+        d_taps = taps;
+        d_branch.resize(BLOCK_ITEMS * d_lanes);
+      }
+
+      void
+      halfband_interpolator::filterN(float output[], const float input[],
+                                     unsigned long n)
+      {
+        const unsigned int L = d_lanes;
+        const unsigned long k = d_pairs.size() - 1;
+
+        while(n > 0) {
+          const unsigned long b = std::min(n, BLOCK_ITEMS);
+          const unsigned long nf = b * L;
+
+          // out[2m] = sum_j p_j*(x[m+k-j] + x[m+k+j+1])
+          float *branch = &d_branch[0];
+          std::fill(branch, branch + nf, 0.0f);
+          for(unsigned long j = 0; j <= k; j++) {
+            const float p = d_pairs[j];
+            const float *lo = &input[(k - j) * L];
+            const float *hi = &input[(k + j + 1) * L];
+            for(unsigned long i = 0; i < nf; i++)
+              branch[i] += p * (lo[i] + hi[i]);
+          }
+
+          // out[2m+1] = c*x[m+k+1]
+          const float *mid = &input[(k + 1) * L];
+          for(unsigned long m = 0; m < b; m++) {
+            for(unsigned int l = 0; l < L; l++) {
+              output[2*m*L + l] = branch[m*L + l];
+              output[(2*m + 1)*L + l] = d_center * mid[m*L + l];
+            }
+          }
+
+          input += b * L;
+          output += 2 * b * L;
+          n -= b;
+        }
+      }
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
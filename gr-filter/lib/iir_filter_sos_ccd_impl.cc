@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "iir_filter_sos_ccd_impl.h"
+#include <gnuradio/io_signature.h>
+
+namespace gr {
+  namespace filter {
+
+    iir_filter_sos_ccd::sptr
+    iir_filter_sos_ccd::make(const std::vector<std::vector<double> > &sos,
+                             unsigned int vlen)
+    {
+      return gnuradio::get_initial_sptr
+	(new iir_filter_sos_ccd_impl(sos, vlen));
+    }
+
+    iir_filter_sos_ccd_impl::iir_filter_sos_ccd_impl(const std::vector<std::vector<double> > &sos,
+                                                     unsigned int vlen)
+      : sync_block("iir_filter_sos_ccd",
+		   io_signature::make(1, 1, vlen * sizeof(gr_complex)),
+		   io_signature::make(1, 1, vlen * sizeof(gr_complex)))
+    {
+      d_sos = new kernel::sos_filter<gr_complex,gr_complex,gr_complexd>(sos, vlen);
+    }
+
+    iir_filter_sos_ccd_impl::~iir_filter_sos_ccd_impl()
+    {
+      delete d_sos;
+    }
+
+    void
+    iir_filter_sos_ccd_impl::set_taps(const std::vector<std::vector<double> > &sos)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      d_sos->set_taps(sos);
+    }
+
+    std::vector<std::vector<double> >
+    iir_filter_sos_ccd_impl::taps() const
+    {
+      return d_sos->taps();
+    }
+
+    int
+    iir_filter_sos_ccd_impl::work(int noutput_items,
+                                  gr_vector_const_void_star &input_items,
+                                  gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      const gr_complex *in = (const gr_complex*)input_items[0];
+      gr_complex *out = (gr_complex*)output_items[0];
+
+      d_sos->filter_n(out, in, noutput_items);
+      return noutput_items;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
@@ -34,6 +34,22 @@
 namespace gr {
   namespace filter {
 
+    // Only the kernels with real taps and float arithmetic fold
+    // symmetric taps, which is what makes pairing branches pay.
+    static bool folds(const kernel::fir_filter_fff *) { return true; }
+    static bool folds(const kernel::fir_filter_ccf *) { return true; }
+    template <class T> static bool folds(const T *) { return false; }
+
+    template <class T> static bool
+    symmetric(const std::vector<T> &taps, size_t ntaps)
+    {
+      for(size_t k = 0; k < ntaps/2; k++) {
+	if(taps[k] != taps[ntaps-1-k])
+	  return false;
+      }
+      return true;
+    }
+
     @BASE_NAME@::sptr
     @BASE_NAME@::make(unsigned interpolation,
 		      const std::vector<@TAP_TYPE@> &taps)
@@ -48,7 +64,7 @@ namespace gr {
 			   io_signature::make(1, 1, sizeof(@I_TYPE@)),
 			   io_signature::make(1, 1, sizeof(@O_TYPE@)),
 			   interpolation),
-      d_updated(false), d_firs(interpolation)
+      d_updated(false), d_firs(interpolation), d_paired(false)
     {
       if(interpolation == 0) {
 	throw std::out_of_range("@IMPL_NAME@: interpolation must be > 0\n");
@@ -79,6 +95,7 @@ namespace gr {
     @IMPL_NAME@::set_taps(const std::vector<@TAP_TYPE@> &taps)
     {
       d_new_taps = taps;
+      d_proto_ntaps = taps.size();
       d_updated = true;
 
       // round up length to a multiple of the interpolation factor
@@ -111,8 +128,49 @@ namespace gr {
 	xtaps[i % nfilters][i / nfilters] = taps[i];
       }
 
-      for(unsigned n = 0; n < nfilters; n++) {
-	d_firs[n]->set_taps (xtaps[n]);
+      // Symmetric taps h[k] == h[N-1-k] make branch b the mirror
+      // image of branch r = (N-1-b) % nfilters: both apply the
+      // first q+1 taps of branch r, q = (N-1-b) / nfilters, to the
+      // same input window, one forwards and one backwards. Filtering
+      // with half the sum and half the difference of the two tap
+      // sets gives y_r = P + Q and y_b = P - Q. The sum is symmetric
+      // and the difference antisymmetric, so both fold and the pair
+      // costs about as much as one branch.
+      const unsigned ntaps = d_proto_ntaps;
+      d_paired = folds(d_firs[0]) && ntaps >= nfilters &&
+	nt >= (int)kernel::folded_fir::MIN_FOLD_TAPS &&
+	symmetric(taps, ntaps);
+
+      if(!d_paired) {
+	for(unsigned n = 0; n < nfilters; n++) {
+	  d_firs[n]->set_taps (xtaps[n]);
+	}
+      }
+      else {
+	d_mirror.resize(nfilters);
+	d_offset.resize(nfilters);
+	for(unsigned b = 0; b < nfilters; b++) {
+	  unsigned r = (ntaps - 1 - b) % nfilters;
+	  unsigned q = (ntaps - 1 - b) / nfilters;
+	  d_mirror[b] = r;
+	  d_offset[b] = nt - 1 - q;
+	  if(r < b)
+	    continue;
+
+	  std::vector<@TAP_TYPE@> fwd(xtaps[r].begin(), xtaps[r].begin() + q + 1);
+	  if(r == b) {
+	    d_firs[b]->set_taps(fwd);
+	    continue;
+	  }
+
+	  std::vector<@TAP_TYPE@> sum(q+1), diff(q+1);
+	  for(unsigned j = 0; j <= q; j++) {
+	    sum[j] = (fwd[j] + fwd[q-j]) * 0.5f;
+	    diff[j] = (fwd[j] - fwd[q-j]) * 0.5f;
+	  }
+	  d_firs[b]->set_taps(sum);
+	  d_firs[r]->set_taps(diff);
+	}
       }
 
       set_history(nt);
@@ -141,6 +199,31 @@ namespace gr {
       int nfilters = interpolation();
       int ni = noutput_items / interpolation();
 
+      if(d_paired) {
+	d_sum.resize(ni);
+	d_diff.resize(ni);
+	for(int b = 0; b < nfilters; b++) {
+	  int r = d_mirror[b];
+	  if(r < b)
+	    continue;
+
+	  const @I_TYPE@ *x = &in[d_offset[b]];
+	  d_firs[b]->filterN(&d_sum[0], x, ni);
+	  if(r == b) {
+	    for(int i = 0; i < ni; i++)
+	      out[i*nfilters + b] = d_sum[i];
+	    continue;
+	  }
+
+	  d_firs[r]->filterN(&d_diff[0], x, ni);
+	  for(int i = 0; i < ni; i++) {
+	    out[i*nfilters + b] = d_sum[i] - d_diff[i];
+	    out[i*nfilters + r] = d_sum[i] + d_diff[i];
+	  }
+	}
+	return noutput_items;
+      }
+
       for(int i = 0; i < ni; i++) {
 	for(int nf = 0; nf < nfilters; nf++) {
 	  out[nf] = d_firs[nf]->filter(&in[i]);
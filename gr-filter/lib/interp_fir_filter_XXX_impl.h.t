@@ -39,6 +39,16 @@ namespace gr {
       bool d_updated;
       std::vector<kernel::@FIR_TYPE@ *> d_firs;
       std::vector<@TAP_TYPE@> d_new_taps;
+      unsigned d_proto_ntaps;           // length of taps before padding
+
+      // With symmetric taps, branch b and its mirror branch are
+      // computed together from the sum and difference of their taps
+      // (see install_taps).
+      bool d_paired;
+      std::vector<unsigned> d_mirror;   // branch paired with each branch
+      std::vector<unsigned> d_offset;   // start of each pair's input window
+      std::vector<@O_TYPE@> d_sum;
+      std::vector<@O_TYPE@> d_diff;
 
       void install_taps(const std::vector<@TAP_TYPE@> &taps);
 
@@ -0,0 +1,261 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "multires_spectrum_cvf_impl.h"
+#include <gnuradio/filter/firdes.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <string.h>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace gr {
+  namespace filter {
+
+    multires_spectrum_cvf::sptr
+    multires_spectrum_cvf::make(int fft_size, int noctaves,
+                                const std::vector<float> &window,
+                                double attenuation_dB, int nthreads)
+    {
+      return gnuradio::get_initial_sptr
+        (new multires_spectrum_cvf_impl(fft_size, noctaves, window,
+                                        attenuation_dB, nthreads));
+    }
+
+    // Checks the arguments before the sync_decimator is built from
+    // them; returns the decimation, fft_size << (noctaves - 1).
+    static int
+    checked_decimation(int fft_size, int noctaves)
+    {
+      if(fft_size <= 0 || fft_size % 16 != 0)
+	throw std::invalid_argument("multires_spectrum_cvf: fft_size must be a positive multiple of 16");
+      if(noctaves < 1)
+	throw std::invalid_argument("multires_spectrum_cvf: noctaves must be at least 1");
+
+      // the output item is fft_size * (1 + 3/8 * (noctaves - 1)) floats
+      const double item_size = sizeof(float) * (fft_size/8) * (8.0 + 3.0*(noctaves - 1));
+      if(noctaves > 31 || fft_size > (INT_MAX >> (noctaves - 1)) || item_size > INT_MAX)
+	throw std::invalid_argument("multires_spectrum_cvf: fft_size << (noctaves - 1) is too large");
+      return fft_size << (noctaves - 1);
+    }
+
+    static int
+    output_bins(int fft_size, int noctaves)
+    {
+      checked_decimation(fft_size, noctaves);
+      return fft_size + fft_size/8*3*(noctaves - 1);
+    }
+
+    multires_spectrum_cvf_impl::multires_spectrum_cvf_impl(int fft_size, int noctaves,
+                                                           const std::vector<float> &window,
+                                                           double attenuation_dB,
+                                                           int nthreads)
+      : sync_decimator("multires_spectrum_cvf",
+			  io_signature::make(1, 1, sizeof(gr_complex)),
+			  io_signature::make(1, 1, output_bins(fft_size, noctaves)*sizeof(float)),
+			  checked_decimation(fft_size, noctaves)),
+	d_fft_size(fft_size), d_noctaves(noctaves),
+	d_edge(fft_size/16*3), d_nbins(output_bins(fft_size, noctaves)),
+	d_halfband(NULL), d_fft(NULL), d_mag(NULL)
+    {
+      if(!set_window(window))
+        throw std::runtime_error("multires_spectrum_cvf: window not the same length as fft_size\n");
+
+      const int N = d_fft_size;
+      const int E = d_edge;
+      const int last = d_noctaves - 1;
+
+      // Lowest frequencies first: the outer bins of the widest bands
+      // on the negative side, all of the last band's, then the outer
+      // bins of the widest bands on the positive side.
+      if(last == 0) {
+        d_segments.push_back(segment(0, -N/2, N/2-1));
+      }
+      else {
+        d_segments.push_back(segment(0, -N/2, -E));
+        for(int j = 1; j < last; j++)
+          d_segments.push_back(segment(j, -(2*E-1), -E));
+        d_segments.push_back(segment(last, -(2*E-1), 2*E-1));
+        for(int j = last-1; j >= 1; j--)
+          d_segments.push_back(segment(j, E, 2*E-1));
+        d_segments.push_back(segment(0, E, N/2-1));
+      }
+
+      // Stopband from 5/16 of the input rate, which folds down onto
+      // 3/8 of the decimated rate.
+      unsigned int hist = 0;
+      if(last > 0) {
+        d_halfband = new kernel::halfband_decimator
+          (firdes::halfband(1.0, 1.0, 0.125, attenuation_dB), 2);
+        hist = d_halfband->ntaps() - 1;
+        set_history(hist + 1);
+      }
+
+      d_band.resize(d_noctaves);
+      d_sum.resize(d_noctaves);
+      for(int j = 0; j < d_noctaves; j++) {
+        if(j > 0)
+          d_band[j].assign(hist + (N << (last - j)), gr_complex(0, 0));
+        d_sum[j].assign(N, 0);
+      }
+
+      d_fft = new fft::fft_complex(N, true, nthreads, std::max(1, BATCH_ITEMS / N));
+      d_mag = (float*)volk_malloc(d_fft->batch() * N * sizeof(float),
+                                  volk_get_alignment());
+    }
+
+    multires_spectrum_cvf_impl::~multires_spectrum_cvf_impl()
+    {
+      delete d_halfband;
+      delete d_fft;
+      volk_free(d_mag);
+    }
+
+    void
+    multires_spectrum_cvf_impl::set_nthreads(int n)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+      d_fft->set_nthreads(n);
+    }
+
+    int
+    multires_spectrum_cvf_impl::nthreads() const
+    {
+      return d_fft->nthreads();
+    }
+
+    bool
+    multires_spectrum_cvf_impl::set_window(const std::vector<float> &window)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+      if(window.size() == 0 || (int)window.size() == d_fft_size) {
+	d_window = window;
+	return true;
+      }
+      else
+	return false;
+    }
+
+    std::vector<float>
+    multires_spectrum_cvf_impl::bin_freqs() const
+    {
+      std::vector<float> freqs;
+      for(unsigned int s = 0; s < d_segments.size(); s++) {
+        const segment &seg = d_segments[s];
+        double width = 1.0 / ((double)d_fft_size * (1 << seg.band));
+        for(int k = seg.first; k <= seg.last; k++)
+          freqs.push_back(k * width);
+      }
+      return freqs;
+    }
+
+    /*
+     * Adds |X|^2 of nframes windowed frames of in to the band's sum,
+     * a batch of frames per FFT execute.
+     */
+    void
+    multires_spectrum_cvf_impl::transform(int band, const gr_complex *in, int nframes)
+    {
+      float *sum = &d_sum[band][0];
+
+      while(nframes > 0) {
+        int n = std::min(d_fft->batch(), nframes);
+
+        for(int i = 0; i < n; i++) {
+          gr_complex *dst = d_fft->get_inbuf() + i*d_fft_size;
+          if(d_window.size())
+            volk_32fc_32f_multiply_32fc(dst, in, &d_window[0], d_fft_size);
+          else
+            memcpy(dst, in, d_fft_size*sizeof(gr_complex));
+          in += d_fft_size;
+        }
+
+        d_fft->execute(n);
+        volk_32fc_magnitude_squared_32f(d_mag, d_fft->get_outbuf(), n*d_fft_size);
+        for(int i = 0; i < n; i++)
+          volk_32f_x2_add_32f(sum, sum, d_mag + i*d_fft_size, d_fft_size);
+
+        nframes -= n;
+      }
+    }
+
+    void
+    multires_spectrum_cvf_impl::merge(float *out) const
+    {
+      for(unsigned int s = 0; s < d_segments.size(); s++) {
+        const segment &seg = d_segments[s];
+        const float *sum = &d_sum[seg.band][0];
+        const float scale = 1.0f / (1 << (d_noctaves - 1 - seg.band));
+        for(int k = seg.first; k <= seg.last; k++)
+          *out++ = sum[(k + d_fft_size) % d_fft_size] * scale;
+      }
+    }
+
+    int
+    multires_spectrum_cvf_impl::work(int noutput_items,
+				     gr_vector_const_void_star &input_items,
+				     gr_vector_void_star &output_items)
+    {
+      gr::thread::scoped_lock l(d_setlock);
+
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      float *out = (float *) output_items[0];
+
+      const int last = d_noctaves - 1;
+      const unsigned int hist = history() - 1;
+
+      for(int o = 0; o < noutput_items; o++) {
+        for(int j = 0; j <= last; j++)
+          std::fill(d_sum[j].begin(), d_sum[j].end(), 0);
+
+        // in[0 .. hist-1] is band 0's halfband history.
+        transform(0, in + hist, 1 << last);
+
+        for(int j = 1; j <= last; j++) {
+          const gr_complex *src = (j == 1) ? in : &d_band[j-1][0];
+          int len = d_fft_size << (last - j);
+          // The same samples as halfband_decimator_ccf would use.
+          d_halfband->filterN((float*)&d_band[j][hist], (const float*)src, len);
+          transform(j, &d_band[j][hist], 1 << (last - j));
+        }
+
+        // Keep the end of each band as the history of its next output.
+        for(int j = 1; j < last; j++) {
+          int len = d_fft_size << (last - j);
+          memmove(&d_band[j][0], &d_band[j][len], hist*sizeof(gr_complex));
+        }
+
+        merge(out);
+        in += d_fft_size << last;
+        out += d_nbins;
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,86 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FILTER_MULTIRES_SPECTRUM_CVF_IMPL_H
+#define INCLUDED_FILTER_MULTIRES_SPECTRUM_CVF_IMPL_H
+
+#include <gnuradio/filter/multires_spectrum_cvf.h>
+#include <gnuradio/filter/halfband_filter.h>
+#include <gnuradio/fft/fft.h>
+
+namespace gr {
+  namespace filter {
+
+    class FILTER_API multires_spectrum_cvf_impl : public multires_spectrum_cvf
+    {
+    private:
+      // Items transformed per execute; small FFTs are batched up to this.
+      static const int BATCH_ITEMS = 16384;
+
+      int                        d_fft_size;
+      int                        d_noctaves;
+      int                        d_edge;     // lowest |bin| a band contributes
+      int                        d_nbins;
+      std::vector<float>         d_window;
+      kernel::halfband_decimator *d_halfband;
+      fft::fft_complex          *d_fft;
+      float                     *d_mag;      // |X|^2 of a batch of frames
+
+      // Per band: halfband history followed by the samples of one
+      // output, and the sum of its frames' |X|^2
+      std::vector< std::vector<gr_complex> > d_band;
+      std::vector< std::vector<float> >      d_sum;
+
+      // Bins first..last of a band, in output order
+      struct segment {
+        int band;
+        int first;
+        int last;
+        segment(int b, int f, int l) : band(b), first(f), last(l) {}
+      };
+      std::vector<segment>       d_segments;
+
+      void transform(int band, const gr_complex *in, int nframes);
+      void merge(float *out) const;
+
+    public:
+      multires_spectrum_cvf_impl(int fft_size, int noctaves,
+                                 const std::vector<float> &window,
+                                 double attenuation_dB, int nthreads);
+
+      ~multires_spectrum_cvf_impl();
+
+      int nbins() const { return d_nbins; }
+      std::vector<float> bin_freqs() const;
+      bool set_window(const std::vector<float> &window);
+      void set_nthreads(int n);
+      int nthreads() const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* INCLUDED_FILTER_MULTIRES_SPECTRUM_CVF_IMPL_H */
@@ -54,17 +54,7 @@ namespace gr {
 
         d_last_filter = (taps.size()/2) % filter_size;
 
-        d_filters = std::vector<fir_filter_ccf*>(d_int_rate);
-        d_diff_filters = std::vector<fir_filter_ccf*>(d_int_rate);
-
-        // Create an FIR filter for each channel and zero out the taps
-        std::vector<float> vtaps(0, d_int_rate);
-        for(unsigned int i = 0; i < d_int_rate; i++) {
-          d_filters[i] = new fir_filter_ccf(1, vtaps);
-          d_diff_filters[i] = new fir_filter_ccf(1, vtaps);
-        }
-
-        // Now, actually set the filters' taps
+        // Set the taps of the filter arms
         set_taps(taps);
 
         // Delay is based on number of taps per filter arm. Round to
@@ -89,16 +79,11 @@ namespace gr {
 
       pfb_arb_resampler_ccf::~pfb_arb_resampler_ccf()
       {
-        for(unsigned int i = 0; i < d_int_rate; i++) {
-          delete d_filters[i];
-          delete d_diff_filters[i];
-        }
       }
 
       void
       pfb_arb_resampler_ccf::create_taps(const std::vector<float> &newtaps,
-                                         std::vector< std::vector<float> > &ourtaps,
-                                         std::vector<fir_filter_ccf*> &ourfilter)
+                                         std::vector< std::vector<float> > &ourtaps)
       {
         unsigned int ntaps = newtaps.size();
         d_taps_per_filter = (unsigned int)ceil((double)ntaps/(double)d_int_rate);
@@ -120,9 +105,6 @@ namespace gr {
           for(unsigned int j = 0; j < d_taps_per_filter; j++) {
             ourtaps[i][j] = tmp_taps[i + j*d_int_rate];
           }
-
-          // Build a filter for each channel and add it's taps to it
-          ourfilter[i]->set_taps(ourtaps[i]);
         }
       }
 
@@ -150,8 +132,9 @@ namespace gr {
       {
         std::vector<float> dtaps;
         create_diff_taps(taps, dtaps);
-        create_taps(taps, d_taps, d_filters);
-        create_taps(dtaps, d_dtaps, d_diff_filters);
+        create_taps(taps, d_taps);
+        create_taps(dtaps, d_dtaps);
+        d_engine.set_taps(d_taps, d_dtaps);
       }
 
       std::vector<std::vector<float> >
@@ -187,14 +170,14 @@ namespace gr {
           throw std::runtime_error("pfb_arb_resampler_ccf: set_phase value out of bounds [0, 2pi).\n");
         }
 
-        float ph_diff = 2.0*M_PI / (float)d_filters.size();
+        float ph_diff = 2.0*M_PI / (float)d_int_rate;
         d_last_filter = static_cast<int>(ph / ph_diff);
       }
 
       float
       pfb_arb_resampler_ccf::phase() const
       {
-        float ph_diff = 2.0*M_PI / static_cast<float>(d_filters.size());
+        float ph_diff = 2.0*M_PI / static_cast<float>(d_int_rate);
         return d_last_filter * ph_diff;
       }
 
@@ -216,17 +199,18 @@ namespace gr {
                                     int n_to_read, int &n_read)
       {
         int i_out = 0, i_in = 0;
-        unsigned int j = d_last_filter;;
-        gr_complex o0, o1;
+        unsigned int j = d_last_filter;
 
+        // Step through the filterbank first, recording which arm and
+        // input each output uses, then compute all the outputs in
+        // one pass over the schedule.
+        d_schedule.clear();
         while(i_in < n_to_read) {
           // start j by wrapping around mod the number of channels
           while(j < d_int_rate) {
-            // Take the current filter and derivative filter output
-            o0 = d_filters[j]->filter(&input[i_in]);
-            o1 = d_diff_filters[j]->filter(&input[i_in]);
-
-            output[i_out] = o0 + o1*d_acc;     // linearly interpolate between samples
+            // The output linearly interpolates between the filter and
+            // derivative filter outputs by d_acc
+            d_schedule.push(j, i_in, d_acc);
             i_out++;
 
             // Adjust accumulator and index into filterbank
@@ -239,6 +223,8 @@ namespace gr {
         }
         d_last_filter = j; // save last filter state for re-entry
 
+        d_engine.filter(output, input, d_schedule);
+
         n_read = i_in;   // return how much we've actually read
         return i_out;    // return how much we've produced
       }
@@ -476,17 +462,7 @@ namespace gr {
 
         d_last_filter = (taps.size()/2) % filter_size;
 
-        d_filters = std::vector<fir_filter_fff*>(d_int_rate);
-        d_diff_filters = std::vector<fir_filter_fff*>(d_int_rate);
-
-        // Create an FIR filter for each channel and zero out the taps
-        std::vector<float> vtaps(0, d_int_rate);
-        for(unsigned int i = 0; i < d_int_rate; i++) {
-          d_filters[i] = new fir_filter_fff(1, vtaps);
-          d_diff_filters[i] = new fir_filter_fff(1, vtaps);
-        }
-
-        // Now, actually set the filters' taps
+        // Set the taps of the filter arms
         set_taps(taps);
 
         // Delay is based on number of taps per filter arm. Round to
@@ -511,16 +487,11 @@ namespace gr {
 
       pfb_arb_resampler_fff::~pfb_arb_resampler_fff()
       {
-        for(unsigned int i = 0; i < d_int_rate; i++) {
-          delete d_filters[i];
-          delete d_diff_filters[i];
-        }
       }
 
       void
       pfb_arb_resampler_fff::create_taps(const std::vector<float> &newtaps,
-                                         std::vector< std::vector<float> > &ourtaps,
-                                         std::vector<fir_filter_fff*> &ourfilter)
+                                         std::vector< std::vector<float> > &ourtaps)
       {
         unsigned int ntaps = newtaps.size();
         d_taps_per_filter = (unsigned int)ceil((double)ntaps/(double)d_int_rate);
@@ -542,9 +513,6 @@ namespace gr {
           for(unsigned int j = 0; j < d_taps_per_filter; j++) {
             ourtaps[i][j] = tmp_taps[i + j*d_int_rate];
           }
-
-          // Build a filter for each channel and add it's taps to it
-          ourfilter[i]->set_taps(ourtaps[i]);
         }
       }
 
@@ -572,8 +540,9 @@ namespace gr {
       {
         std::vector<float> dtaps;
         create_diff_taps(taps, dtaps);
-        create_taps(taps, d_taps, d_filters);
-        create_taps(dtaps, d_dtaps, d_diff_filters);
+        create_taps(taps, d_taps);
+        create_taps(dtaps, d_dtaps);
+        d_engine.set_taps(d_taps, d_dtaps);
       }
 
       std::vector<std::vector<float> >
@@ -609,14 +578,14 @@ namespace gr {
           throw std::runtime_error("pfb_arb_resampler_fff: set_phase value out of bounds [0, 2pi).\n");
         }
 
-        float ph_diff = 2.0*M_PI / (float)d_filters.size();
+        float ph_diff = 2.0*M_PI / (float)d_int_rate;
         d_last_filter = static_cast<int>(ph / ph_diff);
       }
 
       float
       pfb_arb_resampler_fff::phase() const
       {
-        float ph_diff = 2.0*M_PI / static_cast<float>(d_filters.size());
+        float ph_diff = 2.0*M_PI / static_cast<float>(d_int_rate);
         return d_last_filter * ph_diff;
       }
 
@@ -638,17 +607,18 @@ namespace gr {
                                     int n_to_read, int &n_read)
       {
         int i_out = 0, i_in = 0;
-        unsigned int j = d_last_filter;;
-        float o0, o1;
+        unsigned int j = d_last_filter;
 
+        // Step through the filterbank first, recording which arm and
+        // input each output uses, then compute all the outputs in
+        // one pass over the schedule.
+        d_schedule.clear();
         while(i_in < n_to_read) {
           // start j by wrapping around mod the number of channels
           while(j < d_int_rate) {
-            // Take the current filter and derivative filter output
-            o0 = d_filters[j]->filter(&input[i_in]);
-            o1 = d_diff_filters[j]->filter(&input[i_in]);
-
-            output[i_out] = o0 + o1*d_acc;     // linearly interpolate between samples
+            // The output linearly interpolates between the filter and
+            // derivative filter outputs by d_acc
+            d_schedule.push(j, i_in, d_acc);
             i_out++;
 
             // Adjust accumulator and index into filterbank
@@ -661,6 +631,8 @@ namespace gr {
         }
         d_last_filter = j; // save last filter state for re-entry
 
+        d_engine.filter(output, input, d_schedule);
+
         n_read = i_in;   // return how much we've actually read
         return i_out;    // return how much we've produced
       }
@@ -26,6 +26,9 @@
 
 #include "pfb_channelizer_ccf_impl.h"
 #include <gnuradio/io_signature.h>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cstring>
 #include <stdio.h>
 
 #ifdef _MSC_VER
@@ -38,21 +41,25 @@ namespace gr {
     pfb_channelizer_ccf::sptr
     pfb_channelizer_ccf::make(unsigned int nfilts,
                               const std::vector<float> &taps,
-                              float oversample_rate)
+                              float oversample_rate,
+                              int nthreads)
     {
       return gnuradio::get_initial_sptr
         (new pfb_channelizer_ccf_impl(nfilts, taps,
-                                      oversample_rate));
+                                      oversample_rate,
+                                      nthreads));
     }
 
     pfb_channelizer_ccf_impl::pfb_channelizer_ccf_impl(unsigned int nfilts,
 						       const std::vector<float> &taps,
-						       float oversample_rate)
+						       float oversample_rate,
+						       int nthreads)
       : block("pfb_channelizer_ccf",
               io_signature::make(nfilts, nfilts, sizeof(gr_complex)),
               io_signature::make(1, nfilts, sizeof(gr_complex))),
 	polyphase_filterbank(nfilts, taps, false),
-	d_updated(false), d_oversample_rate(oversample_rate)
+	d_updated(false), d_oversample_rate(oversample_rate),
+	d_pool(NULL)
     {
       // The over sampling rate must be rationally related to the number of channels
       // in that it must be N/i for i in [1,N], which gives an outputsample rate
@@ -95,6 +102,24 @@ namespace gr {
 	d_output_multiple++;
       set_output_multiple(d_output_multiple);
 
+      // Every d_output_multiple vectors the same filter reads the
+      // same input stream again, d_input_step samples further on.
+      d_input_step = d_output_multiple * d_rate_ratio / d_nfilts;
+      d_batch = std::max(1, BATCH_ITEMS / (int)d_nfilts / d_output_multiple);
+      d_batch *= d_output_multiple;
+      d_fftin.resize(d_batch * d_nfilts);
+
+      // The branch filters are only ever run with filterNdec at
+      // d_input_step, and their engine is chosen for their own
+      // decimation, so build them with that decimation. The step
+      // depends on nfilts and the oversample rate alone.
+      for(unsigned int i = 0; i < d_nfilts; i++) {
+        delete d_fir_filters[i];
+        d_fir_filters[i] = new kernel::fir_filter_ccf(d_input_step, d_taps[i]);
+      }
+
+      set_nthreads(nthreads);
+
       // Use set_taps to also set the history requirement
       set_taps(taps);
 
@@ -106,6 +131,9 @@ namespace gr {
     pfb_channelizer_ccf_impl::~pfb_channelizer_ccf_impl()
     {
       delete [] d_idxlut;
+      for(unsigned int i = 0; i < d_ffts.size(); i++)
+        delete d_ffts[i];
+      delete d_pool;
     }
 
     void
@@ -150,6 +178,106 @@ namespace gr {
       return d_channel_map;
     }
 
+    void
+    pfb_channelizer_ccf_impl::set_nthreads(int nthreads)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+
+      delete d_pool;
+      d_pool = new kernel::worker_pool(nthreads);
+
+      // Each thread transforms its own vectors, so it needs its own
+      // FFT buffers. Several vectors are transformed per FFTW call.
+      for(unsigned int i = 0; i < d_ffts.size(); i++)
+        delete d_ffts[i];
+      d_ffts.resize(d_pool->nthreads());
+      int fft_batch = std::max(1, FFT_BATCH_ITEMS / (int)d_nfilts);
+      for(unsigned int i = 0; i < d_ffts.size(); i++)
+        d_ffts[i] = new fft::fft_complex(d_nfilts, false, 1, fft_batch);
+
+      d_branch_out.resize(d_pool->nthreads());
+      for(unsigned int i = 0; i < d_branch_out.size(); i++)
+        d_branch_out[i].resize(d_batch / d_output_multiple);
+    }
+
+    int
+    pfb_channelizer_ccf_impl::nthreads() const
+    {
+      return d_pool->nthreads();
+    }
+
+    void
+    pfb_channelizer_ccf_impl::filter_branches(int index,
+                                              gr_vector_const_void_star *input_items,
+                                              int first, int nvectors)
+    {
+      const int nthreads = d_pool->nthreads();
+      gr_complex *branch_out = &d_branch_out[index][0];
+
+      // Output vector v and v + d_output_multiple feed filter i from
+      // the same input stream, d_input_step samples apart, so each
+      // filter computes all of its outputs for a batch with a few
+      // strided filterNdec calls instead of one dot product per
+      // vector. The threads take every nthreads-th filter.
+      for(unsigned int i = index; i < d_nfilts; i += nthreads) {
+        for(int p = 0; p < std::min(d_output_multiple, nvectors); p++) {
+          const int last = d_sched_last[first + p];
+          const int count = (nvectors - p + d_output_multiple - 1) / d_output_multiple;
+
+          // Filters up to last read the current input sample of
+          // streams last..0, the others the previous sample of the
+          // remaining streams; see the schedule in general_work.
+          int j, n;
+          if((int)i <= last) {
+            j = last - i;
+            n = d_sched_n[first + p];
+          }
+          else {
+            j = last + d_nfilts - i;
+            n = d_sched_n[first + p] - 1;
+          }
+
+          const gr_complex *in = (const gr_complex*)(*input_items)[j];
+          d_fir_filters[i]->filterNdec(branch_out, &in[n], count, d_input_step);
+
+          gr_complex *fftin = &d_fftin[p*d_nfilts + d_idxlut[j]];
+          for(int k = 0; k < count; k++)
+            fftin[k*d_output_multiple*d_nfilts] = branch_out[k];
+        }
+      }
+    }
+
+    void
+    pfb_channelizer_ccf_impl::fft_vectors(int index,
+                                          gr_vector_void_star *output_items,
+                                          int first, int nvectors)
+    {
+      const int nthreads = d_pool->nthreads();
+      const size_t noutputs = output_items->size();
+      fft::fft_complex *fft = d_ffts[index];
+
+      // Each thread takes a contiguous range of the batch so its
+      // vectors can be copied and transformed several at a time.
+      const int begin = nvectors * index / nthreads;
+      const int end = nvectors * (index + 1) / nthreads;
+
+      // despin through FFT and send to output channels
+      for(int v = begin; v < end; v += fft->batch()) {
+        int nffts = std::min(fft->batch(), end - v);
+        memcpy(fft->get_inbuf(), &d_fftin[v*d_nfilts],
+               nffts*d_nfilts*sizeof(gr_complex));
+        fft->execute(nffts);
+
+        for(int k = 0; k < nffts; k++) {
+          const gr_complex *spectrum = fft->get_outbuf() + k*d_nfilts;
+          for(unsigned int nn = 0; nn < noutputs; nn++) {
+            gr_complex *out = (gr_complex*)(*output_items)[nn];
+            out[first + v + k] = spectrum[d_channel_map[nn]];
+          }
+        }
+      }
+    }
+
     int
     pfb_channelizer_ccf_impl::general_work(int noutput_items,
 					   gr_vector_int &ninput_items,
@@ -158,16 +286,11 @@ namespace gr {
     {
       gr::thread::scoped_lock guard(d_mutex);
 
-      gr_complex *in = (gr_complex*)input_items[0];
-      gr_complex *out = (gr_complex*)output_items[0];
-
       if(d_updated) {
 	d_updated = false;
 	return 0;		     // history requirements may have changed.
       }
 
-      size_t noutputs = output_items.size();
-
       // The following algorithm looks more complex in order to handle
       // the cases where we want more that 1 sps for each
       // channel. Otherwise, this would boil down into a single loop
@@ -180,38 +303,31 @@ namespace gr {
       // fred harris, Multirate Signal Processing For Communication
       // Systems. Upper Saddle River, NJ: Prentice Hall, 2004.
 
-      int n=1, i=-1, j=0, oo=0, last;
+      // For output vector oo, filters d_sched_last[oo]..0 are fed by
+      // inputs 0.. at sample d_sched_n[oo]; the remaining filters,
+      // from d_nfilts-1 down, by the next inputs at the sample
+      // before.
+      d_sched_last.clear();
+      d_sched_n.clear();
+      int n=1, i=-1;
       int toconsume = (int)rintf(noutput_items/d_oversample_rate);
       while(n <= toconsume) {
-	j = 0;
 	i = (i + d_rate_ratio) % d_nfilts;
-	last = i;
-	while(i >= 0) {
-          in = (gr_complex*)input_items[j];
-	  d_fft->get_inbuf()[d_idxlut[j]] = d_fir_filters[i]->filter(&in[n]);
-	  j++;
-	  i--;
-	}
-
-	i = d_nfilts-1;
-	while(i > last) {
-          in = (gr_complex*)input_items[j];
-	  d_fft->get_inbuf()[d_idxlut[j]] = d_fir_filters[i]->filter(&in[n-1]);
-	  j++;
-	  i--;
-	}
-
+        d_sched_last.push_back(i);
+        d_sched_n.push_back(n);
 	n += (i+d_rate_ratio) >= (int)d_nfilts;
+      }
 
-	// despin through FFT
-	d_fft->execute();
-
-	// Send to output channels
-	for(unsigned int nn = 0; nn < noutputs; nn++) {
-	  out = (gr_complex*)output_items[nn];
-	  out[oo] = d_fft->get_outbuf()[d_channel_map[nn]];
-	}
-	oo++;
+      // Filter a batch of vectors with the filters split across the
+      // threads, then transform it with the vectors split across
+      // the threads.
+      const int nvectors = d_sched_n.size();
+      for(int first = 0; first < nvectors; first += d_batch) {
+        int nb = std::min(d_batch, nvectors - first);
+        d_pool->run(boost::bind(&pfb_channelizer_ccf_impl::filter_branches,
+                                this, _1, &input_items, first, nb));
+        d_pool->run(boost::bind(&pfb_channelizer_ccf_impl::fft_vectors,
+                                this, _1, &output_items, first, nb));
       }
 
       consume_each(toconsume);
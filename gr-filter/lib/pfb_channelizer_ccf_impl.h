@@ -26,6 +26,7 @@
 #include <gnuradio/filter/pfb_channelizer_ccf.h>
 #include <gnuradio/filter/polyphase_filterbank.h>
 #include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/worker_pool.h>
 #include <gnuradio/fft/fft.h>
 #include <gnuradio/thread/thread.h>
 
@@ -43,10 +44,32 @@ namespace gr {
       std::vector<int> d_channel_map;
       gr::thread::mutex     d_mutex; // mutex to protect set/work access
 
+      // Size of the FFT inputs filtered and transformed per batch.
+      static const int BATCH_ITEMS = 65536;
+      // Size of the FFT inputs transformed by one FFTW call.
+      static const int FFT_BATCH_ITEMS = 16384;
+
+      int              d_batch;      // multiple of d_output_multiple
+      int              d_input_step; // input advance of a filter per d_output_multiple vectors
+      std::vector<int> d_sched_last; // filter fed by input 0, per output vector
+      std::vector<int> d_sched_n;    // input offset of that filter, per output vector
+      std::vector<gr_complex> d_fftin; // FFT inputs of a batch, one row per vector
+      std::vector<std::vector<gr_complex> > d_branch_out; // per thread
+      std::vector<fft::fft_complex*> d_ffts; // per thread, batched
+      kernel::worker_pool *d_pool;
+
+      void filter_branches(int index,
+                           gr_vector_const_void_star *input_items,
+                           int first, int nvectors);
+      void fft_vectors(int index,
+                       gr_vector_void_star *output_items,
+                       int first, int nvectors);
+
     public:
       pfb_channelizer_ccf_impl(unsigned int nfilts,
 			       const std::vector<float> &taps,
-			       float oversample_rate);
+			       float oversample_rate,
+			       int nthreads);
 
       ~pfb_channelizer_ccf_impl();
 
@@ -57,6 +80,9 @@ namespace gr {
       void set_channel_map(const std::vector<int> &map);
       std::vector<int> channel_map() const;
 
+      void set_nthreads(int nthreads);
+      int nthreads() const;
+
       int general_work(int noutput_items,
 		       gr_vector_int &ninput_items,
 		       gr_vector_const_void_star &input_items,
@@ -27,9 +27,13 @@
 
 #include <qa_filter.h>
 #include <qa_firdes.h>
+#include <qa_filter_engine.h>
+#include <qa_fir_cascade.h>
 #include <qa_fir_filter_with_buffer.h>
 #include <qa_mmse_fir_interpolator_cc.h>
 #include <qa_mmse_fir_interpolator_ff.h>
+#include <qa_resampler_engine.h>
+#include <qa_worker_pool.h>
 
 CppUnit::TestSuite *
 qa_gr_filter::suite ()
@@ -42,6 +46,10 @@ qa_gr_filter::suite ()
   s->addTest(gr::filter::ccf::qa_fir_filter_with_buffer_ccf::suite());
   s->addTest(gr::filter::qa_mmse_fir_interpolator_cc::suite());
   s->addTest(gr::filter::qa_mmse_fir_interpolator_ff::suite());
+  s->addTest(gr::filter::qa_filter_engine::suite());
+  s->addTest(gr::filter::qa_fir_cascade::suite());
+  s->addTest(gr::filter::qa_resampler_engine::suite());
+  s->addTest(gr::filter::qa_worker_pool::suite());
 
   return s;
 }
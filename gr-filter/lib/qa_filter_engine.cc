@@ -0,0 +1,326 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/types.h>
+#include <qa_filter_engine.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/filter_engine.h>
+#include <gnuradio/random.h>
+#include <cppunit/TestAssert.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+
+    static float
+    uniform()
+    {
+      return 2.0 * ((float)(::random()) / RANDOM_MAX - 0.5); // uniformly (-1, 1)
+    }
+
+    static void
+    random_taps(std::vector<float> &v)
+    {
+      for(unsigned int i = 0; i < v.size(); i++)
+	v[i] = uniform();
+    }
+
+    static void
+    random_taps(std::vector<gr_complex> &v)
+    {
+      for(unsigned int i = 0; i < v.size(); i++)
+	v[i] = gr_complex(uniform(), uniform());
+    }
+
+    static void
+    random_taps(std::vector<short> &v)
+    {
+      for(unsigned int i = 0; i < v.size(); i++)
+	v[i] = (short)rint(uniform() * 1000);
+    }
+
+    template<class T>
+    static double
+    max_abs(const std::vector<T> &v)
+    {
+      double m = 0;
+      for(unsigned int i = 0; i < v.size(); i++)
+	m = std::max(m, (double)std::abs(v[i]));
+      return m;
+    }
+
+    //
+    // Runs the same input through a kernel forced to the direct form
+    // and one forced to overlap-save, before and after changing the
+    // number of taps. The output count is not a multiple of the
+    // overlap-save block so the direct-form remainder is covered too.
+    //
+    template<class fir_type, class i_type, class o_type, class tap_type>
+    static void
+    test_engines(unsigned int decimate)
+    {
+      const unsigned int NOUT = 1001;
+      const unsigned int ntaps_list[] = { 129, 40 };
+
+      std::vector<tap_type> taps(ntaps_list[0]);
+      random_taps(taps);
+
+      fir_type direct(decimate, taps);
+      fir_type fast(decimate, taps);
+      direct.set_engine(kernel::ENGINE_DIRECT);
+      fast.set_engine(kernel::ENGINE_FFT);
+
+      for(int k = 0; k < 2; k++) {
+	if(k > 0) {
+	  taps.resize(ntaps_list[k]);
+	  random_taps(taps);
+	  direct.set_taps(taps);
+	  fast.set_taps(taps);
+	}
+
+	CPPUNIT_ASSERT_EQUAL(kernel::ENGINE_DIRECT, direct.engine());
+	CPPUNIT_ASSERT_EQUAL(kernel::ENGINE_FFT, fast.engine());
+
+	std::vector<i_type> input((NOUT-1)*decimate + taps.size());
+	random_taps(input);
+
+	const double tol = 1e-4 * taps.size() * max_abs(input);
+
+	std::vector<o_type> expected(NOUT), actual(NOUT);
+	direct.filterNdec(&expected[0], &input[0], NOUT, decimate);
+	fast.filterNdec(&actual[0], &input[0], NOUT, decimate);
+
+	for(unsigned int i = 0; i < NOUT; i++) {
+	  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, std::abs(expected[i] - actual[i]), tol);
+	}
+
+	if(decimate == 1) {
+	  fast.filterN(&actual[0], &input[0], NOUT);
+	  for(unsigned int i = 0; i < NOUT; i++) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, std::abs(expected[i] - actual[i]), tol);
+	  }
+	}
+      }
+    }
+
+    void
+    qa_filter_engine::t_fff()
+    {
+      srandom(0);
+      test_engines<kernel::fir_filter_fff, float, float, float>(1);
+      test_engines<kernel::fir_filter_fff, float, float, float>(3);
+    }
+
+    void
+    qa_filter_engine::t_ccf()
+    {
+      srandom(0);
+      test_engines<kernel::fir_filter_ccf, gr_complex, gr_complex, float>(1);
+      test_engines<kernel::fir_filter_ccf, gr_complex, gr_complex, float>(4);
+    }
+
+    void
+    qa_filter_engine::t_ccc()
+    {
+      srandom(0);
+      test_engines<kernel::fir_filter_ccc, gr_complex, gr_complex, gr_complex>(1);
+      test_engines<kernel::fir_filter_ccc, gr_complex, gr_complex, gr_complex>(5);
+    }
+
+    void
+    qa_filter_engine::t_fcc()
+    {
+      srandom(0);
+      test_engines<kernel::fir_filter_fcc, float, gr_complex, gr_complex>(1);
+      test_engines<kernel::fir_filter_fcc, float, gr_complex, gr_complex>(6);
+    }
+
+    void
+    qa_filter_engine::t_scc()
+    {
+      srandom(0);
+      test_engines<kernel::fir_filter_scc, short, gr_complex, gr_complex>(1);
+      test_engines<kernel::fir_filter_scc, short, gr_complex, gr_complex>(12);
+    }
+
+    //
+    // Decimation in the frequency domain needs an FFT size that is a
+    // multiple of the decimation; compare it against the direct form
+    // and against the time-domain path at a power-of-2 size.
+    //
+    void
+    qa_filter_engine::t_freq_decim()
+    {
+      const unsigned int NTAPS = 200;
+      const unsigned int DECIM = 10;
+      const unsigned int NOUT = 500;
+
+      srandom(0);
+      std::vector<gr_complex> taps(NTAPS);
+      random_taps(taps);
+      std::vector<gr_complex> input((NOUT-1)*DECIM + NTAPS);
+      random_taps(input);
+      std::vector<float> rinput(input.size());
+      for(unsigned int i = 0; i < input.size(); i++)
+	rinput[i] = input[i].real();
+
+      CPPUNIT_ASSERT(kernel::filter_cost_model::decimates_in_frequency
+		     (kernel::filter_cost_model::FFT_COMPLEX, 640, DECIM));
+      CPPUNIT_ASSERT(!kernel::filter_cost_model::decimates_in_frequency
+		     (kernel::filter_cost_model::FFT_COMPLEX, 512, DECIM));
+      CPPUNIT_ASSERT(!kernel::filter_cost_model::decimates_in_frequency
+		     (kernel::filter_cost_model::FFT_REAL, 640, DECIM));
+
+      kernel::fir_filter_ccc direct(DECIM, taps);
+      kernel::fir_filter_fcc rdirect(DECIM, taps);
+      direct.set_engine(kernel::ENGINE_DIRECT);
+      rdirect.set_engine(kernel::ENGINE_DIRECT);
+      std::vector<gr_complex> expected(NOUT), rexpected(NOUT), actual(NOUT);
+      direct.filterNdec(&expected[0], &input[0], NOUT, DECIM);
+      rdirect.filterNdec(&rexpected[0], &rinput[0], NOUT, DECIM);
+
+      const int sizes[] = { 640, 512, 2560 };
+      for(int k = 0; k < 3; k++) {
+	kernel::overlap_save_ccc os(sizes[k], taps, DECIM);
+	unsigned long n = os.filterNdec(&actual[0], &input[0], NOUT, DECIM);
+	CPPUNIT_ASSERT(n > 0);
+	for(unsigned int i = 0; i < n; i++) {
+	  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, std::abs(expected[i] - actual[i]), 1e-4 * NTAPS);
+	}
+
+	kernel::overlap_save_fcc ros(sizes[k], taps, DECIM);
+	n = ros.filterNdec(&actual[0], &rinput[0], NOUT, DECIM);
+	CPPUNIT_ASSERT(n > 0);
+	for(unsigned int i = 0; i < n; i++) {
+	  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, std::abs(rexpected[i] - actual[i]), 1e-4 * NTAPS);
+	}
+
+	// a different decimation is left to the caller
+	CPPUNIT_ASSERT_EQUAL(0ul, os.filterNdec(&actual[0], &input[0], NOUT, DECIM/2));
+      }
+    }
+
+    void
+    qa_filter_engine::t_select()
+    {
+      int fftsize = 0;
+
+      // short filters stay on the direct form
+      CPPUNIT_ASSERT_EQUAL(kernel::ENGINE_DIRECT,
+			   kernel::filter_cost_model::select(kernel::ENGINE_AUTO,
+							     kernel::filter_cost_model::MAC_REAL,
+							     kernel::filter_cost_model::FFT_REAL,
+							     8, 1, &fftsize));
+
+      CPPUNIT_ASSERT_EQUAL(kernel::ENGINE_FFT,
+			   kernel::filter_cost_model::select(kernel::ENGINE_FFT,
+							     kernel::filter_cost_model::MAC_COMPLEX,
+							     kernel::filter_cost_model::FFT_COMPLEX,
+							     100, 4, &fftsize));
+      // a power of 2 that holds at least one decimated output
+      CPPUNIT_ASSERT(fftsize >= 100 + 4 - 1);
+      CPPUNIT_ASSERT_EQUAL(0, fftsize & (fftsize - 1));
+
+      // decimation 100 may also use multiples of 100
+      kernel::filter_cost_model::select(kernel::ENGINE_FFT,
+					kernel::filter_cost_model::MAC_COMPLEX_REAL,
+					kernel::filter_cost_model::FFT_REAL_INPUT,
+					1000, 100, &fftsize);
+      CPPUNIT_ASSERT(fftsize >= 1000 + 100 - 1);
+      CPPUNIT_ASSERT((fftsize & (fftsize - 1)) == 0 || fftsize % 100 == 0);
+
+      const kernel::filter_cost_model &model = kernel::filter_cost_model::instance();
+      double cost;
+      int n = model.best_fftsize(kernel::filter_cost_model::FFT_COMPLEX, 100, 4, &cost);
+      CPPUNIT_ASSERT(cost > 0.0);
+      CPPUNIT_ASSERT(cost <= model.fft_cost(kernel::filter_cost_model::FFT_COMPLEX, 2*n, 100, 4));
+      CPPUNIT_ASSERT(model.direct_cost(kernel::filter_cost_model::MAC_COMPLEX, 200) >
+		     model.direct_cost(kernel::filter_cost_model::MAC_COMPLEX, 100));
+    }
+
+    //
+    // Symmetric and antisymmetric taps of odd and even length take
+    // the folded path of filterNdec; compare it with filter(), which
+    // never folds.
+    //
+    template<class fir_type, class i_type>
+    static void
+    test_fold(unsigned int decimate)
+    {
+      const unsigned int NOUT = 601;
+      const unsigned int ntaps_list[] = { 33, 48 };
+
+      for(int k = 0; k < 2; k++) {
+	const unsigned int ntaps = ntaps_list[k];
+	std::vector<float> taps(ntaps), anti(ntaps);
+	random_taps(taps);
+	for(unsigned int j = 0; j < ntaps/2; j++) {
+	  taps[ntaps-1-j] = taps[j];
+	  anti[j] = taps[j];
+	  anti[ntaps-1-j] = -taps[j];
+	}
+
+	CPPUNIT_ASSERT_EQUAL(kernel::TAPS_SYMMETRIC, kernel::folded_fir::symmetry(taps));
+	CPPUNIT_ASSERT_EQUAL(kernel::TAPS_ANTISYMMETRIC, kernel::folded_fir::symmetry(anti));
+
+	std::vector<i_type> input((NOUT-1)*decimate + ntaps);
+	random_taps(input);
+	const double tol = 1e-5 * ntaps * max_abs(input);
+
+	for(int a = 0; a < 2; a++) {
+	  fir_type f(decimate, a ? anti : taps);
+	  f.set_engine(kernel::ENGINE_DIRECT);
+
+	  std::vector<i_type> actual(NOUT);
+	  f.filterNdec(&actual[0], &input[0], NOUT, decimate);
+	  for(unsigned int i = 0; i < NOUT; i++) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, std::abs(f.filter(&input[i*decimate]) - actual[i]), tol);
+	  }
+
+	  // breaking the symmetry falls back to the plain direct form
+	  f.update_tap(taps[0] + 1.0f, 0);
+	  f.filterNdec(&actual[0], &input[0], NOUT, decimate);
+	  for(unsigned int i = 0; i < NOUT; i++) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, std::abs(f.filter(&input[i*decimate]) - actual[i]), tol);
+	  }
+	}
+      }
+    }
+
+    void
+    qa_filter_engine::t_fold()
+    {
+      srandom(0);
+      test_fold<kernel::fir_filter_fff, float>(1);
+      test_fold<kernel::fir_filter_fff, float>(3);
+      test_fold<kernel::fir_filter_ccf, gr_complex>(1);
+      test_fold<kernel::fir_filter_ccf, gr_complex>(4);
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
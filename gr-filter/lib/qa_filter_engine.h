@@ -0,0 +1,58 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef _QA_FILTER_ENGINE_H_
+#define _QA_FILTER_ENGINE_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCase.h>
+
+namespace gr {
+  namespace filter {
+
+    class qa_filter_engine : public CppUnit::TestCase
+    {
+      CPPUNIT_TEST_SUITE(qa_filter_engine);
+      CPPUNIT_TEST(t_fff);
+      CPPUNIT_TEST(t_ccf);
+      CPPUNIT_TEST(t_ccc);
+      CPPUNIT_TEST(t_fcc);
+      CPPUNIT_TEST(t_scc);
+      CPPUNIT_TEST(t_freq_decim);
+      CPPUNIT_TEST(t_select);
+      CPPUNIT_TEST(t_fold);
+      CPPUNIT_TEST_SUITE_END();
+
+    private:
+      void t_fff();
+      void t_ccf();
+      void t_ccc();
+      void t_fcc();
+      void t_scc();
+      void t_freq_decim();
+      void t_select();
+      void t_fold();
+    };
+
+  } /* namespace filter */
+} /* namespace gr */
+
+#endif /* _QA_FILTER_ENGINE_H_ */
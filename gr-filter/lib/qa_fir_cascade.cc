@@ -0,0 +1,201 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <qa_fir_cascade.h>
+#include <gnuradio/filter/fir_cascade.h>
+#include <gnuradio/filter/firdes.h>
+#include <gnuradio/random.h>
+#include <cppunit/TestAssert.h>
+#include <algorithm>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+
+    typedef std::vector<gr_complex> cvec_t;
+
+    static std::vector<float>
+    random_taps(gr::random &rng, int ntaps)
+    {
+      std::vector<float> taps(ntaps);
+      for(int i = 0; i < ntaps; i++)
+        taps[i] = rng.ran1() - 0.5f;
+      return taps;
+    }
+
+    static cvec_t
+    random_signal(gr::random &rng, int n)
+    {
+      cvec_t x(n);
+      for(int i = 0; i < n; i++)
+        x[i] = gr_complex(rng.ran1() - 0.5f, rng.ran1() - 0.5f);
+      return x;
+    }
+
+    // One decimating stage with zero history, the long way.
+    static cvec_t
+    ref_decim(const cvec_t &x, unsigned int decim, const std::vector<float> &taps)
+    {
+      cvec_t y(x.size() / decim);
+      for(size_t i = 0; i < y.size(); i++) {
+        gr_complex acc = 0;
+        for(size_t k = 0; k < taps.size() && k <= i*decim; k++)
+          acc += taps[k] * x[i*decim - k];
+        y[i] = acc;
+      }
+      return y;
+    }
+
+    // One interpolating stage: zero-stuff, then filter.
+    static cvec_t
+    ref_interp(const cvec_t &x, unsigned int interp, const std::vector<float> &taps)
+    {
+      cvec_t y(x.size() * interp);
+      for(size_t i = 0; i < y.size(); i++) {
+        gr_complex acc = 0;
+        for(size_t k = i % interp; k < taps.size() && k <= i; k += interp)
+          acc += taps[k] * x[(i - k) / interp];
+        y[i] = acc;
+      }
+      return y;
+    }
+
+    void
+    qa_fir_cascade::t_decim()
+    {
+      gr::random rng(0);
+      unsigned int r[] = { 5, 4, 2 };
+      int ntaps[] = { 37, 60, 301 };
+      std::vector<unsigned int> rates(r, r + 3);
+      std::vector<std::vector<float> > taps;
+      for(int i = 0; i < 3; i++)
+        taps.push_back(random_taps(rng, ntaps[i]));
+
+      kernel::fir_decim_cascade_ccf cascade(rates, taps);
+      CPPUNIT_ASSERT_EQUAL(40U, cascade.decimation());
+      CPPUNIT_ASSERT_EQUAL(37U, cascade.history());
+
+      const unsigned long nout = 5000;
+      cvec_t x = random_signal(rng, nout * 40);
+      cvec_t expected = x;
+      for(int i = 0; i < 3; i++)
+        expected = ref_decim(expected, rates[i], taps[i]);
+
+      // Call in uneven pieces so the stage histories carry over.
+      cvec_t in(cascade.history() - 1, 0);
+      in.insert(in.end(), x.begin(), x.end());
+      cvec_t out(nout);
+      unsigned long parts[] = { 1, 999, 3000, 1000 }, done = 0;
+      for(int p = 0; p < 4; p++) {
+        cascade.filterN(&out[done], &in[done * 40], parts[p]);
+        done += parts[p];
+      }
+
+      for(unsigned long i = 0; i < nout; i++)
+        CPPUNIT_ASSERT(std::abs(out[i] - expected[i]) < 1e-3);
+    }
+
+    void
+    qa_fir_cascade::t_interp()
+    {
+      gr::random rng(0);
+      unsigned int r[] = { 2, 3, 4 };
+      int ntaps[] = { 31, 20, 9 };
+      std::vector<unsigned int> rates(r, r + 3);
+      std::vector<std::vector<float> > taps;
+      for(int i = 0; i < 3; i++)
+        taps.push_back(random_taps(rng, ntaps[i]));
+
+      kernel::fir_interp_cascade_ccf cascade(rates, taps);
+      CPPUNIT_ASSERT_EQUAL(24U, cascade.interpolation());
+      CPPUNIT_ASSERT_EQUAL(16U, cascade.history());
+
+      const unsigned long nin = 3000;
+      cvec_t x = random_signal(rng, nin);
+      cvec_t expected = x;
+      for(int i = 0; i < 3; i++)
+        expected = ref_interp(expected, rates[i], taps[i]);
+
+      cvec_t in(cascade.history() - 1, 0);
+      in.insert(in.end(), x.begin(), x.end());
+      cvec_t out(nin * 24);
+      unsigned long parts[] = { 7, 993, 2000 }, done = 0;
+      for(int p = 0; p < 3; p++) {
+        cascade.filterN(&out[done * 24], &in[done], parts[p]);
+        done += parts[p];
+      }
+
+      for(unsigned long i = 0; i < out.size(); i++)
+        CPPUNIT_ASSERT(std::abs(out[i] - expected[i]) < 1e-3);
+    }
+
+    void
+    qa_fir_cascade::t_halfband()
+    {
+      // Rate 2 stages with halfband taps take the halfband kernels;
+      // the result must not change.
+      gr::random rng(0);
+      std::vector<float> hb = firdes::halfband(1, 1, 0.1, 60);
+      std::vector<float> hb2 = firdes::halfband(2, 1, 0.2, 60);
+      unsigned int r[] = { 2, 3, 2 };
+      std::vector<unsigned int> rates(r, r + 3);
+      std::vector<std::vector<float> > taps;
+      taps.push_back(hb);
+      taps.push_back(random_taps(rng, 25));
+      taps.push_back(hb2);
+
+      const unsigned long n = 2400;
+      cvec_t x = random_signal(rng, n * 12);
+
+      kernel::fir_decim_cascade_ccf decim(rates, taps);
+      cvec_t expected = x;
+      for(int i = 0; i < 3; i++)
+        expected = ref_decim(expected, rates[i], taps[i]);
+
+      cvec_t in(decim.history() - 1, 0);
+      in.insert(in.end(), x.begin(), x.end());
+      cvec_t out(n);
+      decim.filterN(&out[0], &in[0], 1000);
+      decim.filterN(&out[1000], &in[1000 * 12], n - 1000);
+      for(unsigned long i = 0; i < n; i++)
+        CPPUNIT_ASSERT(std::abs(out[i] - expected[i]) < 1e-3);
+
+      kernel::fir_interp_cascade_ccf interp(rates, taps);
+      expected = cvec_t(x.begin(), x.begin() + n);
+      for(int i = 0; i < 3; i++)
+        expected = ref_interp(expected, rates[i], taps[i]);
+
+      in.assign(interp.history() - 1, 0);
+      in.insert(in.end(), x.begin(), x.begin() + n);
+      out.resize(n * 12);
+      interp.filterN(&out[0], &in[0], 1000);
+      interp.filterN(&out[1000 * 12], &in[1000], n - 1000);
+      for(unsigned long i = 0; i < out.size(); i++)
+        CPPUNIT_ASSERT(std::abs(out[i] - expected[i]) < 1e-3);
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
@@ -0,0 +1,153 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <qa_resampler_engine.h>
+#include <gnuradio/filter/resampler_engine.h>
+#include <gnuradio/random.h>
+#include <cppunit/TestAssert.h>
+#include <stdexcept>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+
+    typedef std::vector<float> fvec_t;
+    typedef std::vector<gr_complex> cvec_t;
+
+    static std::vector<fvec_t>
+    random_arms(gr::random &rng, int narms, int ntaps)
+    {
+      std::vector<fvec_t> arms(narms, fvec_t(ntaps));
+      for(int a = 0; a < narms; a++)
+        for(int i = 0; i < ntaps; i++)
+          arms[a][i] = rng.ran1() - 0.5f;
+      return arms;
+    }
+
+    // Outputs at every input offset, through every arm in turn, so
+    // every alignment of the input is used with every arm.
+    static kernel::resampler_schedule
+    make_schedule(gr::random &rng, int narms, int noffsets)
+    {
+      kernel::resampler_schedule s;
+      for(int o = 0; o < noffsets; o++)
+        for(int a = 0; a < narms; a++)
+          s.push((a + o) % narms, o, rng.ran1());
+      return s;
+    }
+
+    template<class T>
+    static T
+    ref_dot(const fvec_t &taps, const T *x)
+    {
+      // The arm taps are in natural order: the last tap multiplies
+      // the first input of the window, as in fir_filter_XXX.
+      T acc = 0;
+      for(size_t k = 0; k < taps.size(); k++)
+        acc += taps[k] * x[taps.size() - 1 - k];
+      return acc;
+    }
+
+    void
+    qa_resampler_engine::t_ccf()
+    {
+      gr::random rng(0);
+      int ntaps[] = { 1, 8, 13, 32 };
+      for(int t = 0; t < 4; t++) {
+        const int narms = 5, noffsets = 40;
+        std::vector<fvec_t> taps = random_arms(rng, narms, ntaps[t]);
+        std::vector<fvec_t> dtaps = random_arms(rng, narms, ntaps[t]);
+        kernel::resampler_schedule s = make_schedule(rng, narms, noffsets);
+
+        cvec_t x(noffsets + ntaps[t]);
+        for(size_t i = 0; i < x.size(); i++)
+          x[i] = gr_complex(rng.ran1() - 0.5f, rng.ran1() - 0.5f);
+
+        kernel::resampler_engine_ccf engine;
+        cvec_t out(s.size());
+
+        engine.set_taps(taps);
+        CPPUNIT_ASSERT_EQUAL((unsigned int)narms, engine.narms());
+        CPPUNIT_ASSERT_EQUAL((unsigned int)ntaps[t], engine.ntaps());
+        engine.filter(&out[0], &x[0], s);
+        for(unsigned long m = 0; m < s.size(); m++) {
+          gr_complex e = ref_dot(taps[s.arm[m]], &x[s.offset[m]]);
+          CPPUNIT_ASSERT(std::abs(out[m] - e) < 1e-5);
+        }
+
+        engine.set_taps(taps, dtaps);
+        engine.filter(&out[0], &x[0], s);
+        for(unsigned long m = 0; m < s.size(); m++) {
+          gr_complex e = ref_dot(taps[s.arm[m]], &x[s.offset[m]])
+            + ref_dot(dtaps[s.arm[m]], &x[s.offset[m]]) * s.frac[m];
+          CPPUNIT_ASSERT(std::abs(out[m] - e) < 1e-5);
+        }
+      }
+    }
+
+    void
+    qa_resampler_engine::t_fff()
+    {
+      gr::random rng(0);
+      int ntaps[] = { 1, 8, 13, 32 };
+      for(int t = 0; t < 4; t++) {
+        const int narms = 5, noffsets = 40;
+        std::vector<fvec_t> taps = random_arms(rng, narms, ntaps[t]);
+        std::vector<fvec_t> dtaps = random_arms(rng, narms, ntaps[t]);
+        kernel::resampler_schedule s = make_schedule(rng, narms, noffsets);
+
+        fvec_t x(noffsets + ntaps[t]);
+        for(size_t i = 0; i < x.size(); i++)
+          x[i] = rng.ran1() - 0.5f;
+
+        kernel::resampler_engine_fff engine;
+        fvec_t out(s.size());
+
+        engine.set_taps(taps);
+        engine.filter(&out[0], &x[0], s);
+        for(unsigned long m = 0; m < s.size(); m++) {
+          float e = ref_dot(taps[s.arm[m]], &x[s.offset[m]]);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(e, out[m], 1e-5);
+        }
+
+        engine.set_taps(taps, dtaps);
+        engine.filter(&out[0], &x[0], s);
+        for(unsigned long m = 0; m < s.size(); m++) {
+          float e = ref_dot(taps[s.arm[m]], &x[s.offset[m]])
+            + ref_dot(dtaps[s.arm[m]], &x[s.offset[m]]) * s.frac[m];
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(e, out[m], 1e-5);
+        }
+      }
+
+      // Arms of different lengths are rejected.
+      std::vector<fvec_t> bad = random_arms(rng, 3, 4);
+      bad[1].push_back(0);
+      kernel::resampler_engine_fff engine;
+      CPPUNIT_ASSERT_THROW(engine.set_taps(bad), std::invalid_argument);
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
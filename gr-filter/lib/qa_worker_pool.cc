@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <qa_worker_pool.h>
+#include <gnuradio/filter/worker_pool.h>
+#include <cppunit/TestAssert.h>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace gr {
+  namespace filter {
+
+    static void
+    count_calls(int index, std::vector<int> *calls)
+    {
+      (*calls)[index]++;
+    }
+
+    void
+    qa_worker_pool::t_run()
+    {
+      const int nruns = 100;
+
+      for(int nthreads = 0; nthreads <= 4; nthreads++) {
+        kernel::worker_pool pool(nthreads);
+        CPPUNIT_ASSERT_EQUAL(std::max(nthreads, 1), pool.nthreads());
+
+        // Each index runs exactly once per run() and all calls have
+        // finished when run() returns.
+        std::vector<int> calls(pool.nthreads(), 0);
+        for(int i = 0; i < nruns; i++) {
+          pool.run(boost::bind(&count_calls, _1, &calls));
+          for(int j = 0; j < pool.nthreads(); j++)
+            CPPUNIT_ASSERT_EQUAL(i+1, calls[j]);
+        }
+      }
+    }
+
+  } /* namespace filter */
+} /* namespace gr */
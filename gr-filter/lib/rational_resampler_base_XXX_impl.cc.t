@@ -29,6 +29,7 @@
 #include "@IMPL_NAME@.h"
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <boost/math/common_factor_rt.hpp>
 #include <stdexcept>
 
 namespace gr {
@@ -64,10 +65,16 @@ namespace gr {
       set_relative_rate(1.0 * interpolation / decimation);
       set_output_multiple(1);
 
+      // Output i and output i + d_period use the same filter on
+      // inputs d_stride apart, so each filter decimates by d_stride.
+      unsigned g = boost::math::gcd(interpolation, decimation);
+      d_period = interpolation / g;
+      d_stride = decimation / g;
+
       std::vector<@TAP_TYPE@> dummy_taps;
 
       for(unsigned i = 0; i < interpolation; i++) {
-	d_firs[i] = new kernel::@FIR_TYPE@(1, dummy_taps);
+	d_firs[i] = new kernel::@FIR_TYPE@(d_stride, dummy_taps);
       }
 
       set_taps(taps);
@@ -153,21 +160,31 @@ namespace gr {
 	return 0;		// history requirement may have increased.
       }
 
-      unsigned int ctr = d_ctr;
-
-      int i = 0;
-      while(i < noutput_items) {
-	out[i++] = d_firs[ctr]->filter(in);
-	ctr += decimation();
-	while(ctr >= interpolation()) {
-	  ctr -= interpolation();
-	  in++;
+      // Output i uses filter (d_ctr + i*D) % I on the inputs from
+      // (d_ctr + i*D) / I. The outputs r, r + d_period, r +
+      // 2*d_period, ... share a filter, so run each filter over all
+      // of its outputs at once and interleave the results.
+      for(unsigned r = 0; r < d_period && (int)r < noutput_items; r++) {
+	unsigned long ctr = d_ctr + (unsigned long)r * decimation();
+	kernel::@FIR_TYPE@ *fir = d_firs[ctr % interpolation()];
+	const @I_TYPE@ *x = in + ctr / interpolation();
+	unsigned long n = (noutput_items - r + d_period - 1) / d_period;
+
+	if(d_period == 1) {
+	  fir->filterNdec(out, x, n, d_stride);
+	}
+	else {
+	  d_phase_out.resize(n);
+	  fir->filterNdec(&d_phase_out[0], x, n, d_stride);
+	  for(unsigned long k = 0; k < n; k++)
+	    out[r + k*d_period] = d_phase_out[k];
 	}
       }
 
-      d_ctr = ctr;
-      consume_each(in - (@I_TYPE@*)input_items[0]);
-      return i;
+      unsigned long ctr = d_ctr + (unsigned long)noutput_items * decimation();
+      d_ctr = ctr % interpolation();
+      consume_each(ctr / interpolation());
+      return noutput_items;
     }
 
   } /* namespace filter */
@@ -41,6 +41,9 @@ namespace gr {
       std::vector<@TAP_TYPE@> d_new_taps;
       std::vector<kernel::@FIR_TYPE@ *> d_firs;
       bool d_updated;
+      unsigned d_period;                  // outputs before the filter sequence repeats
+      unsigned d_stride;                  // inputs consumed in d_period outputs
+      std::vector<@O_TYPE@> d_phase_out;  // outputs of one filter
 
       void install_taps(const std::vector<@TAP_TYPE@> &taps);
 
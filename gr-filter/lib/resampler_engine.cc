@@ -0,0 +1,243 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/filter/resampler_engine.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      /*
+       * Number of taps in each row: rows are zero-padded at the front
+       * by up to naligned-1 taps and rounded up to keep the next row
+       * aligned to \p align bytes, given rows of \p size bytes a tap.
+       */
+      static unsigned int
+      row_stride(unsigned int ntaps, unsigned int naligned,
+                 unsigned int align, unsigned int size)
+      {
+        unsigned int step = std::max((unsigned int)1, align / size);
+        unsigned int n = ntaps + naligned - 1;
+        return (n + step - 1) / step * step;
+      }
+
+      static unsigned int
+      row_length(const std::vector< std::vector<float> > &taps)
+      {
+        unsigned int ntaps = taps.empty() ? 0 : taps[0].size();
+        for(unsigned int i = 1; i < taps.size(); i++) {
+          if(taps[i].size() != ntaps)
+            throw std::invalid_argument("resampler_engine: all arms must have the same number of taps");
+        }
+        return ntaps;
+      }
+
+      /**************************************************************/
+
+      resampler_engine_ccf::resampler_engine_ccf()
+        : d_narms(0), d_ntaps(0), d_stride(0),
+          d_taps(NULL), d_diff_taps(NULL)
+      {
+        d_align = volk_get_alignment();
+        d_naligned = std::max((size_t)1, d_align / sizeof(gr_complex));
+        d_output = (gr_complex*)volk_malloc(sizeof(gr_complex), d_align);
+      }
+
+      resampler_engine_ccf::~resampler_engine_ccf()
+      {
+        if(d_taps != NULL)
+          volk_free(d_taps);
+        if(d_diff_taps != NULL)
+          volk_free(d_diff_taps);
+        volk_free(d_output);
+      }
+
+      void
+      resampler_engine_ccf::store(float *&bank,
+                                  const std::vector< std::vector<float> > &taps)
+      {
+        if(bank != NULL) {
+          volk_free(bank);
+          bank = NULL;
+        }
+        if(taps.empty())
+          return;
+
+        size_t n = (size_t)d_narms*d_naligned*d_stride;
+        bank = (float*)volk_malloc(n*sizeof(float), d_align);
+        memset(bank, 0, n*sizeof(float));
+
+        for(unsigned int a = 0; a < d_narms; a++) {
+          for(int al = 0; al < d_naligned; al++) {
+            float *r = (float*)row(bank, a, al);
+            for(unsigned int j = 0; j < d_ntaps; j++)
+              r[al+j] = taps[a][d_ntaps-1-j];
+          }
+        }
+      }
+
+      void
+      resampler_engine_ccf::set_taps(const std::vector< std::vector<float> > &taps)
+      {
+        d_narms = taps.size();
+        d_ntaps = row_length(taps);
+        d_stride = row_stride(d_ntaps, d_naligned, d_align, sizeof(float));
+        store(d_taps, taps);
+        store(d_diff_taps, std::vector< std::vector<float> >());
+      }
+
+      void
+      resampler_engine_ccf::set_taps(const std::vector< std::vector<float> > &taps,
+                                     const std::vector< std::vector<float> > &diff_taps)
+      {
+        if(diff_taps.size() != taps.size() || row_length(diff_taps) != row_length(taps))
+          throw std::invalid_argument("resampler_engine_ccf: diff taps must match the taps");
+
+        set_taps(taps);
+        store(d_diff_taps, diff_taps);
+      }
+
+      void
+      resampler_engine_ccf::filter(gr_complex output[], const gr_complex input[],
+                                   const resampler_schedule &schedule)
+      {
+        const unsigned long n = schedule.size();
+        for(unsigned long m = 0; m < n; m++) {
+          const gr_complex *x = &input[schedule.offset[m]];
+          const gr_complex *ar = (gr_complex*)((unsigned long)x & ~(d_align-1));
+          unsigned int al = x - ar;
+          unsigned int a = schedule.arm[m];
+
+          volk_32fc_32f_dot_prod_32fc_a(d_output, ar, row(d_taps, a, al), d_ntaps+al);
+          gr_complex o = *d_output;
+
+          if(d_diff_taps != NULL) {
+            volk_32fc_32f_dot_prod_32fc_a(d_output, ar, row(d_diff_taps, a, al), d_ntaps+al);
+            o += *d_output * schedule.frac[m];
+          }
+          output[m] = o;
+        }
+      }
+
+      /**************************************************************/
+
+      resampler_engine_fff::resampler_engine_fff()
+        : d_narms(0), d_ntaps(0), d_stride(0),
+          d_interleaved(false), d_taps(NULL)
+      {
+        d_align = volk_get_alignment();
+        d_naligned = std::max((size_t)1, d_align / sizeof(float));
+        d_output = (float*)volk_malloc(2*sizeof(float), d_align);
+      }
+
+      resampler_engine_fff::~resampler_engine_fff()
+      {
+        if(d_taps != NULL)
+          volk_free(d_taps);
+        volk_free(d_output);
+      }
+
+      void
+      resampler_engine_fff::store(const std::vector< std::vector<float> > &taps,
+                                  const std::vector< std::vector<float> > *diff_taps)
+      {
+        if(d_taps != NULL) {
+          volk_free(d_taps);
+          d_taps = NULL;
+        }
+
+        d_narms = taps.size();
+        d_ntaps = row_length(taps);
+        d_interleaved = (diff_taps != NULL);
+        unsigned int w = d_interleaved ? 2 : 1;
+        d_stride = row_stride(d_ntaps, d_naligned, d_align, w*sizeof(float));
+        if(d_narms == 0)
+          return;
+
+        size_t n = (size_t)d_narms*d_naligned*d_stride*w;
+        d_taps = (float*)volk_malloc(n*sizeof(float), d_align);
+        memset(d_taps, 0, n*sizeof(float));
+
+        for(unsigned int a = 0; a < d_narms; a++) {
+          for(int al = 0; al < d_naligned; al++) {
+            float *r = (float*)row(a, al);
+            for(unsigned int j = 0; j < d_ntaps; j++) {
+              r[(al+j)*w] = taps[a][d_ntaps-1-j];
+              if(d_interleaved)
+                r[(al+j)*w+1] = (*diff_taps)[a][d_ntaps-1-j];
+            }
+          }
+        }
+      }
+
+      void
+      resampler_engine_fff::set_taps(const std::vector< std::vector<float> > &taps)
+      {
+        store(taps, NULL);
+      }
+
+      void
+      resampler_engine_fff::set_taps(const std::vector< std::vector<float> > &taps,
+                                     const std::vector< std::vector<float> > &diff_taps)
+      {
+        if(diff_taps.size() != taps.size() || row_length(diff_taps) != row_length(taps))
+          throw std::invalid_argument("resampler_engine_fff: diff taps must match the taps");
+
+        store(taps, &diff_taps);
+      }
+
+      void
+      resampler_engine_fff::filter(float output[], const float input[],
+                                   const resampler_schedule &schedule)
+      {
+        const unsigned long n = schedule.size();
+        for(unsigned long m = 0; m < n; m++) {
+          const float *x = &input[schedule.offset[m]];
+          const float *ar = (float*)((unsigned long)x & ~(d_align-1));
+          unsigned int al = x - ar;
+          const float *r = row(schedule.arm[m], al);
+
+          if(d_interleaved) {
+            // Real part is the arm's output, imaginary part the
+            // derivative arm's.
+            volk_32fc_32f_dot_prod_32fc_a((lv_32fc_t*)d_output, (const lv_32fc_t*)r,
+                                          ar, d_ntaps+al);
+            output[m] = d_output[0] + d_output[1]*schedule.frac[m];
+          }
+          else {
+            volk_32f_x2_dot_prod_32f_a(d_output, ar, r, d_ntaps+al);
+            output[m] = d_output[0];
+          }
+        }
+      }
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
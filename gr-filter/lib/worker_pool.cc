@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/filter/worker_pool.h>
+#include <boost/bind.hpp>
+#include <algorithm>
+
+namespace gr {
+  namespace filter {
+    namespace kernel {
+
+      worker_pool::worker_pool(int nthreads)
+        : d_nthreads(std::max(nthreads, 1)),
+          d_generation(0), d_pending(0), d_shutdown(false)
+      {
+        for(int i = 1; i < d_nthreads; i++) {
+          d_threads.create_thread(boost::bind(&worker_pool::worker, this, i));
+        }
+      }
+
+      worker_pool::~worker_pool()
+      {
+        {
+          gr::thread::scoped_lock guard(d_mutex);
+          d_shutdown = true;
+        }
+        d_start.notify_all();
+        d_threads.join_all();
+      }
+
+      void
+      worker_pool::run(const job_t &job)
+      {
+        if(d_nthreads == 1) {
+          job(0);
+          return;
+        }
+
+        {
+          gr::thread::scoped_lock guard(d_mutex);
+          d_job = job;
+          d_pending = d_nthreads - 1;
+          d_generation++;
+        }
+        d_start.notify_all();
+
+        job(0);
+
+        gr::thread::scoped_lock guard(d_mutex);
+        while(d_pending > 0)
+          d_done.wait(guard);
+        d_job.clear();
+      }
+
+      void
+      worker_pool::worker(int index)
+      {
+        unsigned long seen = 0;
+        while(true) {
+          job_t job;
+          {
+            gr::thread::scoped_lock guard(d_mutex);
+            while(!d_shutdown && d_generation == seen)
+              d_start.wait(guard);
+            if(d_shutdown)
+              return;
+            seen = d_generation;
+            job = d_job;
+          }
+
+          job(index);
+
+          gr::thread::scoped_lock guard(d_mutex);
+          if(--d_pending == 0)
+            d_done.notify_one();
+        }
+      }
+
+    } /* namespace kernel */
+  } /* namespace filter */
+} /* namespace gr */
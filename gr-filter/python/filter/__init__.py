@@ -33,8 +33,10 @@ except ImportError:
 from filterbank import *
 from freq_xlating_fft_filter import *
 from rational_resampler import *
+from multistage import *
 import pfb
 import optfir
+import multistage
 
 # Pull this into the filter module
 from gnuradio.fft import window
@@ -0,0 +1,241 @@
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+'''
+Multi-stage decimators and interpolators.
+
+A large rate change is much cheaper as a cascade of smaller ones:
+the first stages only have to keep the band the later stages remove
+from aliasing onto the signal, so they get by with very few taps,
+and the one sharp filter runs at the low rate. Stages that
+decimate by 2 use halfband filters, which skip every other tap.
+'''
+
+import math
+from gnuradio import gr
+import filter_swig as filter
+import optfir
+
+def _factorizations(n, max_stages):
+    '''
+    All ordered ways to write n as a product of at most max_stages
+    factors larger than 1.
+    '''
+    if n == 1:
+        yield []
+        return
+    if max_stages == 0:
+        return
+    for f in xrange(2, n+1):
+        if n % f == 0:
+            for rest in _factorizations(n // f, max_stages - 1):
+                yield [f] + rest
+
+def _stage_bands(rates, fractional_bw):
+    '''
+    Sample rate, passband edge and stopband edge of each decimation
+    stage, with the final output rate normalized to 1.
+    '''
+    fs = float(reduce(lambda a, b: a*b, rates, 1))
+    bands = []
+    for i, r in enumerate(rates):
+        fs_out = fs / r
+        if i == len(rates) - 1:
+            stop = 0.5
+        else:
+            # Only aliases landing in the final passband matter; the
+            # later stages remove everything above 0.5.
+            stop = fs_out - 0.5
+        bands.append((fs, fractional_bw, stop))
+        fs = fs_out
+    return bands
+
+def _estimated_taps(fs, passband, stopband, ripple_db, atten_db):
+    (n, fo, ao, w) = optfir.remezord([passband, stopband], (1, 0),
+                                     [optfir.passband_ripple_to_dev(ripple_db),
+                                      optfir.stopband_atten_to_dev(atten_db)],
+                                     fs)
+    return n + 1
+
+def _halfband_transition(fs, passband, stopband, last):
+    '''
+    Transition width of a halfband filter for a decimate-by-2 stage
+    at rate fs, or None if none fits. The band edges of a halfband
+    filter are symmetric about fs/4.
+    '''
+    if last:
+        # Aliases may land in the transition band of the output.
+        stopband = fs/2.0 - passband
+    edge = max(passband, fs/2.0 - stopband)
+    transition = fs/2.0 - 2*edge
+    if transition <= 0:
+        return None
+    return transition
+
+def _halfband_taps(fs, transition, atten_db):
+    # Kaiser's estimate, as used by firdes.halfband
+    n = int(math.ceil((atten_db - 7.95) / (2.285 * 2*math.pi * transition / fs))) + 1
+    n = max(n, 3)
+    return n + (7 - n % 4) % 4
+
+def _plan_stage(fs, passband, stopband, rate, last, ripple_db, atten_db):
+    '''
+    Cheapest design of one stage: (multiplies per second at rate fs,
+    halfband transition width or None for a general low-pass).
+    '''
+    ntaps = _estimated_taps(fs, passband, stopband, ripple_db, atten_db)
+    best = (ntaps * fs / rate, None)
+    if rate == 2:
+        tw = _halfband_transition(fs, passband, stopband, last)
+        if tw is not None:
+            # one multiply per pair of non-zero taps, one for the centre
+            ntaps = _halfband_taps(fs, tw, atten_db)
+            cost = ((ntaps + 1) // 4 + 1) * fs / rate
+            if cost <= best[0]:
+                best = (cost, tw)
+    return best
+
+def design_stages(decimation, fractional_bw=0.4, atten_db=80.0,
+                  ripple_db=0.1, max_stages=4):
+    """
+    Splits a decimation into stages and designs the filter of each.
+
+    Every ordering of every factorization of the decimation into at
+    most max_stages stages is costed by the multiplies per output
+    sample, and the cheapest is designed. Stages that decimate by 2
+    are halfband filters from firdes.halfband when that is cheaper;
+    the others are designed with optfir.low_pass.
+
+    Args:
+        decimation: total decimation (integer > 0)
+        fractional_bw: passband edge as a fraction of the output rate, in (0, 0.5) (float)
+        atten_db: stopband attenuation in dB (float)
+        ripple_db: total passband ripple in dB, shared by the stages (float)
+        max_stages: largest number of stages considered (integer > 0)
+
+    Returns:
+        (rates, taps): the decimation and filter taps of each stage, first stage first
+    """
+    if not isinstance(decimation, int) or decimation < 1:
+        raise ValueError, "decimation must be an integer >= 1"
+    if fractional_bw >= 0.5 or fractional_bw <= 0:
+        raise ValueError, "Invalid fractional_bw, must be in (0, 0.5)"
+
+    if decimation == 1:
+        candidates = [[1]]
+    else:
+        candidates = _factorizations(decimation, max_stages)
+
+    best = None
+    for rates in candidates:
+        stage_ripple = ripple_db / len(rates)
+        cost = 0.0
+        bands = _stage_bands(rates, fractional_bw)
+        for i, ((fs, passband, stopband), r) in enumerate(zip(bands, rates)):
+            cost += _plan_stage(fs, passband, stopband, r, i == len(rates)-1,
+                                stage_ripple, atten_db)[0]
+        if best is None or cost < best[0]:
+            best = (cost, rates)
+
+    rates = best[1]
+    stage_ripple = ripple_db / len(rates)
+    taps = []
+    bands = _stage_bands(rates, fractional_bw)
+    for i, ((fs, passband, stopband), r) in enumerate(zip(bands, rates)):
+        tw = _plan_stage(fs, passband, stopband, r, i == len(rates)-1,
+                         stage_ripple, atten_db)[1]
+        if tw is not None:
+            taps.append(filter.firdes.halfband(1, fs, tw, atten_db))
+        else:
+            taps.append(optfir.low_pass(1, fs, passband, stopband,
+                                        stage_ripple, atten_db))
+    return (rates, taps)
+
+
+class multistage_decimator_ccf(gr.hier_block2):
+    def __init__(self, decimation, fractional_bw=0.4, atten_db=80.0,
+                 ripple_db=0.1, max_stages=4):
+        """
+        Multi-stage decimating low-pass filter with complex input,
+        complex output and float taps.
+
+        The stages are chosen and designed by design_stages() and run
+        in a single fir_decim_cascade_ccf block.
+
+        Args:
+            decimation: total decimation (integer > 0)
+            fractional_bw: passband edge as a fraction of the output rate, in (0, 0.5) (float)
+            atten_db: stopband attenuation in dB (float)
+            ripple_db: total passband ripple in dB (float)
+            max_stages: largest number of stages considered (integer > 0)
+        """
+        gr.hier_block2.__init__(self, "multistage_decimator_ccf",
+                                gr.io_signature(1, 1, gr.sizeof_gr_complex),
+                                gr.io_signature(1, 1, gr.sizeof_gr_complex))
+
+        (rates, taps) = design_stages(decimation, fractional_bw,
+                                      atten_db, ripple_db, max_stages)
+        self.cascade = filter.fir_decim_cascade_ccf(rates, taps)
+        self.connect(self, self.cascade, self)
+
+    def rates(self):
+        return self.cascade.rates()
+
+    def taps(self):
+        return self.cascade.taps()
+
+
+class multistage_interpolator_ccf(gr.hier_block2):
+    def __init__(self, interpolation, fractional_bw=0.4, atten_db=80.0,
+                 ripple_db=0.1, max_stages=4):
+        """
+        Multi-stage interpolating low-pass filter with complex input,
+        complex output and float taps.
+
+        Uses the stages design_stages() picks for the same decimation
+        in reverse order, so the sharpest filter runs at the input
+        rate, and runs them in a single fir_interp_cascade_ccf block.
+
+        Args:
+            interpolation: total interpolation (integer > 0)
+            fractional_bw: passband edge as a fraction of the input rate, in (0, 0.5) (float)
+            atten_db: stopband attenuation in dB (float)
+            ripple_db: total passband ripple in dB (float)
+            max_stages: largest number of stages considered (integer > 0)
+        """
+        gr.hier_block2.__init__(self, "multistage_interpolator_ccf",
+                                gr.io_signature(1, 1, gr.sizeof_gr_complex),
+                                gr.io_signature(1, 1, gr.sizeof_gr_complex))
+
+        (rates, taps) = design_stages(interpolation, fractional_bw,
+                                      atten_db, ripple_db, max_stages)
+        rates.reverse()
+        taps.reverse()
+        taps = [[r*t for t in stage] for r, stage in zip(rates, taps)]
+        self.cascade = filter.fir_interp_cascade_ccf(rates, taps)
+        self.connect(self, self.cascade, self)
+
+    def rates(self):
+        return self.cascade.rates()
+
+    def taps(self):
+        return self.cascade.taps()
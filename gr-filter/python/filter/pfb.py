@@ -37,7 +37,8 @@ class channelizer_ccf(gr.hier_block2):
     This simplifies the interface by allowing a single input stream to connect to this block.
     It will then output a stream for each channel.
     '''
-    def __init__(self, numchans, taps=None, oversample_rate=1, atten=100):
+    def __init__(self, numchans, taps=None, oversample_rate=1, atten=100,
+                 nthreads=1):
         gr.hier_block2.__init__(self, "pfb_channelizer_ccf",
                                 gr.io_signature(1, 1, gr.sizeof_gr_complex),
                                 gr.io_signature(numchans, numchans, gr.sizeof_gr_complex))
@@ -68,7 +69,8 @@ class channelizer_ccf(gr.hier_block2):
 
         self.s2ss = blocks.stream_to_streams(gr.sizeof_gr_complex, self._nchans)
         self.pfb = filter.pfb_channelizer_ccf(self._nchans, self._taps,
-                                              self._oversample_rate)
+                                              self._oversample_rate,
+                                              nthreads)
         self.connect(self, self.s2ss)
 
         for i in xrange(self._nchans):
@@ -87,6 +89,9 @@ class channelizer_ccf(gr.hier_block2):
     def declare_sample_delay(self, delay):
         self.pfb.declare_sample_delay(delay)
 
+    def set_nthreads(self, nthreads):
+        self.pfb.set_nthreads(nthreads)
+
 
 class interpolator_ccf(gr.hier_block2):
     '''
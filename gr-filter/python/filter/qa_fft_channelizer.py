@@ -0,0 +1,137 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+
+from gnuradio import gr, gr_unittest, filter, blocks
+
+import random
+
+class test_fft_channelizer(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block ()
+        self.fs = 1
+        self.fft_size = 1024
+        random.seed(0)
+        self.src_data = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                         for i in xrange(30000)]
+        # Each channel's taps reach their stopband within its output
+        # bandwidth; the center frequencies are not on FFT bins.
+        win = filter.firdes.WIN_BLACKMAN_hARRIS
+        self.taps = [filter.firdes.low_pass(1, self.fs, 0.05, 0.03, win),
+                     filter.firdes.low_pass(1, self.fs, 0.02, 0.02, win),
+                     filter.firdes.low_pass(1, self.fs, 0.2, 0.1)]
+        self.freqs = [-0.3131, 0.1, 0.0257]
+        self.decims = [4, 8, 1]
+
+    def tearDown(self):
+        self.tb = None
+
+    def reference(self, decim, taps, freq):
+        src = blocks.vector_source_c(self.src_data)
+        op = filter.freq_xlating_fir_filter_ccf(decim, taps, freq, self.fs)
+        dst = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(src, op, dst)
+        tb.run()
+        return dst.data()
+
+    def run_channelizer(self, chan, nports):
+        src = blocks.vector_source_c(self.src_data)
+        self.tb.connect(src, chan)
+        dsts = []
+        for i in xrange(nports):
+            dsts.append(blocks.vector_sink_c())
+            self.tb.connect((chan, i), dsts[i])
+        self.tb.run()
+        return [d.data() for d in dsts]
+
+    def test_001_channels(self):
+        for nthreads in (1, 2):
+            self.tb = gr.top_block()
+            chan = filter.fft_channelizer_ccf(self.fft_size, self.decims,
+                                              self.taps, self.freqs,
+                                              self.fs, nthreads)
+            results = self.run_channelizer(chan, len(self.taps))
+            for decim, taps, freq, result in zip(self.decims, self.taps,
+                                                 self.freqs, results):
+                # Only whole FFTs of the input are processed
+                expected = self.reference(decim, taps, freq)
+                self.assertTrue(len(result) > len(expected) - self.fft_size/decim)
+                self.assertComplexTuplesAlmostEqual(expected[:len(result)],
+                                                    result, 4)
+
+    def test_002_set_channels(self):
+        chan = filter.fft_channelizer_ccf(self.fft_size, self.decims[:2],
+                                          self.taps[:2], self.freqs[:2],
+                                          self.fs)
+        chan.set_channel(3, self.taps[2], self.freqs[2], self.decims[2])
+        chan.set_center_freq(0, 0.2)
+        chan.remove_channel(1)
+        self.assertEqual(4, chan.nchans())
+        self.assertFalse(chan.has_channel(1))
+        self.assertFalse(chan.has_channel(2))
+        self.assertAlmostEqual(0.2, chan.center_freq(0))
+        self.assertEqual(1, chan.decimation(3))
+
+        results = self.run_channelizer(chan, 4)
+        expected = self.reference(self.decims[0], self.taps[0], 0.2)
+        self.assertComplexTuplesAlmostEqual(expected[:len(results[0])],
+                                            results[0], 4)
+        # Ports without a channel stream zeros at the fastest rate
+        self.assertEqual(len(results[3])*(0j,), results[1])
+        self.assertEqual(len(results[3])*(0j,), results[2])
+        expected = self.reference(self.decims[2], self.taps[2], self.freqs[2])
+        self.assertComplexTuplesAlmostEqual(expected[:len(results[3])],
+                                            results[3], 4)
+
+    def test_003_invalid_channels(self):
+        chan = filter.fft_channelizer_ccf(self.fft_size, [], [], [], self.fs)
+        # Too many taps for a 1024 point FFT, and a decimation that
+        # does not divide fft_size/4
+        self.assertRaises(RuntimeError, chan.set_channel, 0, 300*[1,], 0, 1)
+        self.assertRaises(RuntimeError, chan.set_channel, 0, [1,], 0, 3)
+
+    def test_004_remove_channel_running(self):
+        chan = filter.fft_channelizer_ccf(self.fft_size, [4, 4],
+                                          self.taps[:2], self.freqs[:2],
+                                          self.fs)
+        src = blocks.vector_source_c(self.src_data)
+        dsts = [blocks.vector_sink_c(), blocks.vector_sink_c()]
+        self.tb.connect(src, chan)
+        self.tb.connect((chan, 0), dsts[0])
+        self.tb.connect((chan, 1), dsts[1])
+        self.tb.run()
+        n = len(dsts[1].data())
+        self.assertEqual(len(dsts[0].data()), n)
+
+        # Run the same blocks on, without channel 1: its port keeps
+        # up with port 0, with zeros.
+        chan.remove_channel(1)
+        src.rewind()
+        self.tb.run()
+        result0 = dsts[0].data()
+        result1 = dsts[1].data()
+        self.assertTrue(len(result1) > n)
+        self.assertEqual(len(result0), len(result1))
+        self.assertEqual((len(result1) - n)*(0j,), result1[n:])
+
+if __name__ == '__main__':
+    gr_unittest.run(test_fft_channelizer, "test_fft_channelizer.xml")
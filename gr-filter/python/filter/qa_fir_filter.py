@@ -31,6 +31,12 @@ def fir_filter(x, taps, decim=1):
         y.append(yi)
     return y
 
+def interleave_sc16(x):
+    y = []
+    for xi in x:
+        y += [int(xi.real), int(xi.imag)]
+    return y
+
 class test_filter(gr_unittest.TestCase):
 
     def setUp(self):
@@ -168,6 +174,49 @@ class test_filter(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertComplexTuplesAlmostEqual(expected_data, result_data, 5)
 
+    def test_fir_filter_sc16_001(self):
+        decim = 1
+        taps = 20*[0.25+0.125j, 0.25-0.125j]
+        src_data = 40*[8+8j, 16-16j, 24+24j, 32-32j]
+        expected_data = interleave_sc16(fir_filter(src_data, taps, decim))
+
+        src = blocks.vector_source_s(interleave_sc16(src_data), False, 2)
+        op  = filter.fir_filter_sc16(decim, taps)
+        dst = blocks.vector_sink_s(2)
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+        self.assertEqual(tuple(expected_data), result_data)
+
+    def test_fir_filter_sc16_002(self):
+        decim = 4
+        taps = 20*[0.25+0.125j, 0.25-0.125j]
+        src_data = 40*[8+8j, 16-16j, 24+24j, 32-32j]
+        expected_data = interleave_sc16(fir_filter(src_data, taps, decim))
+
+        src = blocks.vector_source_s(interleave_sc16(src_data), False, 2)
+        op  = filter.fir_filter_sc16(decim, taps)
+        dst = blocks.vector_sink_s(2)
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+        self.assertEqual(tuple(expected_data), result_data)
+
+    def test_fir_filter_sc16_003(self):
+        # the output saturates instead of wrapping around
+        decim = 1
+        taps = 4*[0.5+0j,]
+        src_data = 8*[30000-30000j,]
+        expected_data = interleave_sc16([15000-15000j, 30000-30000j] + 6*[32767-32768j,])
+
+        src = blocks.vector_source_s(interleave_sc16(src_data), False, 2)
+        op  = filter.fir_filter_sc16(decim, taps)
+        dst = blocks.vector_sink_s(2)
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+        self.assertEqual(tuple(expected_data), result_data)
+
     def test_fir_filter_fsf_001(self):
         decim = 1
         taps = 20*[0.5, 0.5]
@@ -185,6 +185,18 @@ class test_firdes(gr_unittest.TestCase):
         new_taps = filter.firdes.gaussian(1, 4, 0.35, 13)
         self.assertFloatTuplesAlmostEqual(known_taps, new_taps, 5)
 
+    def test_halfband(self):
+        taps = filter.firdes.halfband(1, 1, 0.1, 60)
+        n = len(taps)
+        m = (n - 1) // 2
+        self.assertEqual(3, n % 4)
+        self.assertAlmostEqual(0.5, taps[m], 6)
+        self.assertAlmostEqual(1.0, sum(taps), 5)
+        for i in xrange(1, m+1):
+            self.assertAlmostEqual(taps[m-i], taps[m+i], 6)
+            if i % 2 == 0:
+                self.assertEqual(0, taps[m+i])
+
 if __name__ == '__main__':
     gr_unittest.run(test_firdes, "test_firdes.xml")
 
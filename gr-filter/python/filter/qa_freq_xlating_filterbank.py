@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+
+from gnuradio import gr, gr_unittest, filter, blocks
+
+import cmath, random
+
+class test_freq_xlating_filterbank(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block ()
+        self.fs = 1
+        self.decim = 4
+        random.seed(0)
+        self.src_data = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                         for i in xrange(20000)]
+        # Channels with different lengths exercise the shared history.
+        self.taps = [filter.firdes.low_pass(1, self.fs, 0.05, 0.02),
+                     filter.firdes.low_pass(1, self.fs, 0.1, 0.05),
+                     filter.firdes.low_pass(1, self.fs, 0.02, 0.01)]
+        self.freqs = [-0.3, 0.1, 0.25]
+
+    def tearDown(self):
+        self.tb = None
+
+    def reference(self, taps, freq):
+        src = blocks.vector_source_c(self.src_data)
+        op = filter.freq_xlating_fir_filter_ccf(self.decim, taps, freq, self.fs)
+        dst = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(src, op, dst)
+        tb.run()
+        return dst.data()
+
+    def run_bank(self, bank, nports):
+        src = blocks.vector_source_c(self.src_data)
+        self.tb.connect(src, bank)
+        dsts = []
+        for i in xrange(nports):
+            dsts.append(blocks.vector_sink_c())
+            self.tb.connect((bank, i), dsts[i])
+        self.tb.run()
+        return [d.data() for d in dsts]
+
+    def test_001_channels(self):
+        for nthreads in (1, 2):
+            self.tb = gr.top_block()
+            bank = filter.freq_xlating_filterbank_ccf(self.decim, self.taps,
+                                                      self.freqs, self.fs,
+                                                      nthreads)
+            results = self.run_bank(bank, len(self.taps))
+            for taps, freq, result in zip(self.taps, self.freqs, results):
+                expected = self.reference(taps, freq)
+                self.assertComplexTuplesAlmostEqual(expected, result, 4)
+
+    def test_002_set_channels(self):
+        bank = filter.freq_xlating_filterbank_ccf(self.decim, self.taps[:2],
+                                                  self.freqs[:2], self.fs)
+        bank.set_channel(3, self.taps[2], self.freqs[2])
+        bank.set_center_freq(0, 0.2)
+        bank.remove_channel(1)
+        self.assertEqual(4, bank.nchans())
+        self.assertFalse(bank.has_channel(1))
+        self.assertFalse(bank.has_channel(2))
+        self.assertAlmostEqual(0.2, bank.center_freq(0))
+
+        results = self.run_bank(bank, 4)
+        n = len(results[0])
+        self.assertComplexTuplesAlmostEqual(self.reference(self.taps[0], 0.2),
+                                            results[0], 4)
+        self.assertEqual(n*(0,), results[1])
+        self.assertEqual(n*(0,), results[2])
+        self.assertComplexTuplesAlmostEqual(self.reference(self.taps[2], self.freqs[2]),
+                                            results[3], 4)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_freq_xlating_filterbank, "test_freq_xlating_filterbank.xml")
@@ -44,6 +44,15 @@ def sig_source_c(samp_rate, freq, amp, N):
                 1j*math.sin(2.*math.pi*freq*x), t)
     return y
 
+def interleave_sc16(x):
+    y = []
+    for xi in x:
+        y += [int(round(xi.real)), int(round(xi.imag))]
+    return y
+
+def deinterleave_sc16(x):
+    return [complex(i, q) for i, q in zip(x[0::2], x[1::2])]
+
 def mix(lo, data):
     y = [lo_i*data_i for lo_i, data_i in zip(lo, data)]
     return y
@@ -104,6 +113,13 @@ class test_freq_xlating_filter(gr_unittest.TestCase):
         times = xrange(100)
         self.src_data = map(lambda t: int(100*math.sin(2*cmath.pi*fc/fs*(t/100.0))), times)
 
+    def generate_sc16_source(self):
+        self.fs = fs = 1
+        self.fc = fc = 0.3
+        self.bw = bw = 0.1
+        self.taps = filter.firdes.low_pass(1, fs, bw, bw/4)
+        times = xrange(100)
+        self.src_data = map(lambda t: 8000*cmath.exp(-2j*cmath.pi*fc/fs*(t/100.0)), times)
 
     def test_fir_filter_ccf_001(self):
         self.generate_ccf_source()
@@ -202,6 +218,27 @@ class test_freq_xlating_filter(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertComplexTuplesAlmostEqual(expected_data, result_data, 5)
 
+    def test_fir_filter_fcf_003(self):
+        # Long input and a large decimation, so the composite filter
+        # can run on its overlap-save engine.
+        self.fs = fs = 1
+        self.fc = fc = 0.3
+        self.taps = filter.firdes.low_pass(1, fs, 0.005, 0.0025)
+        self.src_data = map(lambda t: math.sin(2*cmath.pi*(fc+0.001)*t), xrange(20000))
+
+        decim = 100
+        lo = sig_source_c(self.fs, -self.fc, 1, len(self.src_data))
+        despun = mix(lo, self.src_data)
+        expected_data = fir_filter(despun, self.taps, decim)
+
+        src = blocks.vector_source_f(self.src_data)
+        op  = filter.freq_xlating_fir_filter_fcf(decim, self.taps, self.fc, self.fs)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+        self.assertComplexTuplesAlmostEqual(expected_data, result_data, 4)
+
     def test_fir_filter_fcc_001(self):
         self.generate_fcc_source()
 
@@ -298,6 +335,41 @@ class test_freq_xlating_filter(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertComplexTuplesAlmostEqual(expected_data, result_data, 4)
 
+    def test_fir_filter_sc16_001(self):
+        self.generate_sc16_source()
+
+        decim = 1
+        lo = sig_source_c(self.fs, -self.fc, 1, len(self.src_data))
+        src_data = deinterleave_sc16(interleave_sc16(self.src_data))
+        despun = mix(lo, src_data)
+        expected_data = fir_filter(despun, self.taps, decim)
+
+        src = blocks.vector_source_s(interleave_sc16(src_data), False, 2)
+        op  = filter.freq_xlating_fir_filter_sc16(decim, self.taps, self.fc, self.fs)
+        dst = blocks.vector_sink_s(2)
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = deinterleave_sc16(dst.data())
+        # Q15 taps and per-product rounding: allow a few LSBs of error
+        self.assertComplexTuplesAlmostEqual2(expected_data, result_data, 16, 1e-3)
+
+    def test_fir_filter_sc16_002(self):
+        self.generate_sc16_source()
+
+        decim = 4
+        lo = sig_source_c(self.fs, -self.fc, 1, len(self.src_data))
+        src_data = deinterleave_sc16(interleave_sc16(self.src_data))
+        despun = mix(lo, src_data)
+        expected_data = fir_filter(despun, self.taps, decim)
+
+        src = blocks.vector_source_s(interleave_sc16(src_data), False, 2)
+        op  = filter.freq_xlating_fir_filter_sc16(decim, self.taps, self.fc, self.fs)
+        dst = blocks.vector_sink_s(2)
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = deinterleave_sc16(dst.data())
+        self.assertComplexTuplesAlmostEqual2(expected_data, result_data, 16, 1e-3)
+
 if __name__ == '__main__':
     gr_unittest.run(test_freq_xlating_filter, "test_freq_xlating_filter.xml")
 
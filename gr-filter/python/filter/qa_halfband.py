@@ -0,0 +1,110 @@
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+import random
+from gnuradio import gr, gr_unittest, filter, blocks
+
+class test_halfband(gr_unittest.TestCase):
+
+    def setUp(self):
+        random.seed(0)
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_filter(self, src, op, dst):
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        return dst.data()
+
+    def test_decimator_ccf(self):
+        # Same output as fir_filter_ccf decimating by 2
+        taps = filter.firdes.halfband(1, 1, 0.1, 70)
+        src_data = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                    for i in xrange(10000)]
+
+        expected_result = self.run_filter(blocks.vector_source_c(src_data),
+                                          filter.fir_filter_ccf(2, taps),
+                                          blocks.vector_sink_c())
+        self.tb = gr.top_block()
+        result_data = self.run_filter(blocks.vector_source_c(src_data),
+                                      filter.halfband_decimator_ccf(taps),
+                                      blocks.vector_sink_c())
+        self.assertEqual(5000, len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 5)
+
+    def test_decimator_fff(self):
+        taps = filter.firdes.halfband(1, 1, 0.2, 50)
+        src_data = [random.uniform(-1, 1) for i in xrange(10000)]
+
+        expected_result = self.run_filter(blocks.vector_source_f(src_data),
+                                          filter.fir_filter_fff(2, taps),
+                                          blocks.vector_sink_f())
+        self.tb = gr.top_block()
+        result_data = self.run_filter(blocks.vector_source_f(src_data),
+                                      filter.halfband_decimator_fff(taps),
+                                      blocks.vector_sink_f())
+        self.assertFloatTuplesAlmostEqual(expected_result, result_data, 5)
+
+    def test_interpolator_ccf(self):
+        # Same output as interp_fir_filter_ccf interpolating by 2
+        taps = filter.firdes.halfband(2, 1, 0.1, 70)
+        src_data = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                    for i in xrange(5000)]
+
+        expected_result = self.run_filter(blocks.vector_source_c(src_data),
+                                          filter.interp_fir_filter_ccf(2, taps),
+                                          blocks.vector_sink_c())
+        self.tb = gr.top_block()
+        result_data = self.run_filter(blocks.vector_source_c(src_data),
+                                      filter.halfband_interpolator_ccf(taps),
+                                      blocks.vector_sink_c())
+        self.assertEqual(10000, len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 5)
+
+    def test_interpolator_fff(self):
+        taps = filter.firdes.halfband(2, 1, 0.2, 50)
+        src_data = [random.uniform(-1, 1) for i in xrange(5000)]
+
+        expected_result = self.run_filter(blocks.vector_source_f(src_data),
+                                          filter.interp_fir_filter_fff(2, taps),
+                                          blocks.vector_sink_f())
+        self.tb = gr.top_block()
+        result_data = self.run_filter(blocks.vector_source_f(src_data),
+                                      filter.halfband_interpolator_fff(taps),
+                                      blocks.vector_sink_f())
+        self.assertFloatTuplesAlmostEqual(expected_result, result_data, 5)
+
+    def test_bad_taps(self):
+        # Only 4k+3 taps have the halfband structure
+        self.assertRaises(RuntimeError, filter.halfband_decimator_ccf, [0.5, 1, 0.5, 0])
+        op = filter.halfband_decimator_ccf([0.25, 0.5, 0.25])
+        self.assertRaises(RuntimeError, op.set_taps, [1, 2])
+        # The taps at even offsets from the centre must be zero
+        self.assertRaises(RuntimeError, op.set_taps, [0.1, 0.05, 0.5, 1, 0.5, 0.05, 0.1])
+        # and the taps must be symmetric
+        self.assertRaises(RuntimeError, filter.halfband_interpolator_fff,
+                          [0.1, 0, 0.5, 1, 0.4, 0, 0.1])
+
+if __name__ == '__main__':
+    gr_unittest.run(test_halfband, "test_halfband.xml")
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import random
+from gnuradio import gr, gr_unittest, filter, blocks
+
+# Three stable sections: [b0, b1, b2, a0, a1, a2]
+sos = [[0.2, 0.4, 0.2, 1.0, -0.5, 0.25],
+       [1.0, -1.2, 0.5, 2.0, -0.6, 0.4],
+       [0.5, 0.0, -0.5, 1.0, 0.3, 0.1]]
+
+def cascade_reference(src_data, sections):
+    # Reference result from one iir_filter_ffd per section
+    tb = gr.top_block()
+    src = blocks.vector_source_f(src_data)
+    dst = blocks.vector_sink_f()
+    prev = src
+    for s in sections:
+        op = filter.iir_filter_ffd(s[0:3], s[3:6], False)
+        tb.connect(prev, op)
+        prev = op
+    tb.connect(prev, dst)
+    tb.run()
+    return dst.data()
+
+class test_iir_filter_sos(gr_unittest.TestCase):
+
+    def setUp(self):
+        random.seed(0)
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_sos_ffd_001(self):
+        # Matches a cascade of single-section IIR filters
+        src_data = [random.uniform(-1, 1) for i in xrange(10000)]
+        expected_result = cascade_reference(src_data, sos)
+
+        src = blocks.vector_source_f(src_data)
+        op = filter.iir_filter_sos_ffd(sos)
+        dst = blocks.vector_sink_f()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        self.assertFloatTuplesAlmostEqual(expected_result, dst.data(), 4)
+
+    def test_sos_ffd_002(self):
+        # Each channel of a vector stream is filtered independently
+        vlen = 3
+        nitems = 5000
+        chans = [[random.uniform(-1, 1) for i in xrange(nitems)]
+                 for c in xrange(vlen)]
+        src_data = [chans[c][i] for i in xrange(nitems) for c in xrange(vlen)]
+
+        src = blocks.vector_source_f(src_data, False, vlen)
+        op = filter.iir_filter_sos_ffd(sos, vlen)
+        dst = blocks.vector_sink_f(vlen)
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+
+        for c in xrange(vlen):
+            expected_result = cascade_reference(chans[c], sos)
+            self.assertFloatTuplesAlmostEqual(expected_result,
+                                              result_data[c::vlen], 4)
+
+    def test_sos_ffd_003(self):
+        # set_taps replaces the sections
+        op = filter.iir_filter_sos_ffd(sos)
+        op.set_taps(sos[0:2])
+        self.assertEqual(2, len(op.taps()))
+
+    def test_sos_ccd_001(self):
+        # Real and imaginary parts go through the same real filter
+        re = [random.uniform(-1, 1) for i in xrange(4000)]
+        im = [random.uniform(-1, 1) for i in xrange(4000)]
+        src_data = [complex(r, i) for r, i in zip(re, im)]
+        exp_re = cascade_reference(re, sos)
+        exp_im = cascade_reference(im, sos)
+        expected_result = [complex(r, i) for r, i in zip(exp_re, exp_im)]
+
+        src = blocks.vector_source_c(src_data)
+        op = filter.iir_filter_sos_ccd(sos)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        self.assertComplexTuplesAlmostEqual(expected_result, dst.data(), 4)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_iir_filter_sos, "test_iir_filter_sos.xml")
@@ -55,6 +55,54 @@ class test_interp_fir_filter(gr_unittest.TestCase):
         L = min(len(result_data), len(expected_result))
         self.assertEqual(expected_result[0:L], result_data[0:L])
 
+    def reference(self, taps, src_data, interpolation):
+        # zero-stuff the input and convolve with the taps
+        up = []
+        for x in src_data:
+            up += [x] + (interpolation-1)*[0]
+        y = []
+        for n in range(len(up)):
+            acc = 0
+            for k in range(len(taps)):
+                if n-k >= 0:
+                    acc += taps[k] * up[n-k]
+            y.append(acc)
+        return y
+
+    def test_fff_symmetric(self):
+        # symmetric taps: mirror branches are computed in pairs
+        for ntaps in (40, 41, 43):
+            half = [math.cos(0.1*k) for k in range((ntaps+1)//2)]
+            taps = half + half[::-1][ntaps % 2:]
+            src_data = [math.sin(0.3*n) + 0.1*(n % 7) for n in range(200)]
+            for interpolation in (2, 3, 4):
+                expected_result = self.reference(taps, src_data, interpolation)
+
+                src = blocks.vector_source_f(src_data)
+                op = filter.interp_fir_filter_fff(interpolation, taps)
+                dst = blocks.vector_sink_f()
+                self.tb = gr.top_block()
+                self.tb.connect(src, op, dst)
+                self.tb.run()
+                result_data = dst.data()
+                self.assertFloatTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_ccf_symmetric(self):
+        ntaps = 37
+        half = [1.0/(1+k) for k in range((ntaps+1)//2)]
+        taps = half + half[::-1][1:]
+        src_data = [complex(math.sin(0.3*n), math.cos(0.2*n)) for n in range(200)]
+        interpolation = 3
+        expected_result = self.reference(taps, src_data, interpolation)
+
+        src = blocks.vector_source_c(src_data)
+        op = filter.interp_fir_filter_ccf(interpolation, taps)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
 if __name__ == '__main__':
     gr_unittest.run(test_interp_fir_filter, "test_interp_fir_filter.xml")
 
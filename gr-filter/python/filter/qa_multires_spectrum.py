@@ -0,0 +1,133 @@
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+import math
+import random
+from gnuradio import gr, gr_unittest, filter, fft, blocks
+
+class test_multires_spectrum(gr_unittest.TestCase):
+
+    def setUp(self):
+        random.seed(0)
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def band_spectra(self, src_data, fft_size, noctaves, window, j):
+        # |X|^2 of the frames of band j, through j halfband decimators
+        taps = filter.firdes.halfband(1, 1, 0.125, 80)
+        src = blocks.vector_source_c(src_data)
+        chain = [src]
+        for i in range(j):
+            chain.append(filter.halfband_decimator_ccf(taps))
+        chain += [blocks.stream_to_vector(gr.sizeof_gr_complex, fft_size),
+                  fft.fft_vcc(fft_size, True, window, False),
+                  blocks.complex_to_mag_squared(fft_size)]
+        dst = blocks.vector_sink_f(fft_size)
+        tb = gr.top_block()
+        tb.connect(*(chain + [dst]))
+        tb.run()
+        d = dst.data()
+        return [d[i*fft_size:(i+1)*fft_size] for i in range(len(d)/fft_size)]
+
+    def segments(self, fft_size, noctaves):
+        N = fft_size
+        E = 3*N/16
+        last = noctaves - 1
+        if last == 0:
+            return [(0, -N/2, N/2-1)]
+        segs = [(0, -N/2, -E)]
+        segs += [(j, -(2*E-1), -E) for j in range(1, last)]
+        segs += [(last, -(2*E-1), 2*E-1)]
+        segs += [(j, E, 2*E-1) for j in range(last-1, 0, -1)]
+        segs += [(0, E, N/2-1)]
+        return segs
+
+    def run_check(self, fft_size, noctaves, window, nout):
+        D = fft_size * 2**(noctaves-1)
+        src_data = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                    for i in xrange(D*nout)]
+        spectra = [self.band_spectra(src_data, fft_size, noctaves, window, j)
+                   for j in range(noctaves)]
+
+        expected_result = []
+        for o in range(nout):
+            for (j, first, last) in self.segments(fft_size, noctaves):
+                F = 2**(noctaves-1-j)
+                frames = spectra[j][o*F:(o+1)*F]
+                for k in range(first, last+1):
+                    expected_result.append(sum([f[k % fft_size] for f in frames]) / F)
+
+        src = blocks.vector_source_c(src_data)
+        op = filter.multires_spectrum_cvf(fft_size, noctaves, window)
+        dst = blocks.vector_sink_f(op.nbins())
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        result_data = dst.data()
+
+        self.assertEqual(op.nbins(), fft_size + 3*fft_size/8*(noctaves-1))
+        self.assertEqual(len(expected_result), len(result_data))
+        for e, r in zip(expected_result, result_data):
+            self.assertAlmostEqual(e, r, delta=1e-3*(1+abs(e)))
+
+    def test_001(self):
+        # One octave is a plain shifted power spectrum
+        self.run_check(32, 1, [], 5)
+
+    def test_002(self):
+        # Same bins as halfband decimators, FFTs and averaging
+        window = fft.window.hann(32)
+        self.run_check(32, 4, window, 3)
+
+    def test_003(self):
+        # Tones show up in the bin nearest their frequency, in
+        # whichever octave covers it
+        fft_size = 64
+        op = filter.multires_spectrum_cvf(fft_size, 4, fft.window.blackman_harris(fft_size))
+        freqs = op.bin_freqs()
+        self.assertEqual(len(freqs), op.nbins())
+        for a, b in zip(freqs[:-1], freqs[1:]):
+            self.assertLess(a, b)
+
+        for f in (0.3, -0.2, 0.05, -0.02, 0.007):
+            tb = gr.top_block()
+            src_data = [complex(math.cos(2*math.pi*f*n), math.sin(2*math.pi*f*n))
+                        for n in xrange(fft_size*8*3)]
+            src = blocks.vector_source_c(src_data)
+            op = filter.multires_spectrum_cvf(fft_size, 4, fft.window.blackman_harris(fft_size))
+            dst = blocks.vector_sink_f(op.nbins())
+            tb.connect(src, op, dst)
+            tb.run()
+            spectrum = dst.data()[-op.nbins():]
+            peak = max(range(len(spectrum)), key=lambda i: spectrum[i])
+            nearest = min(range(len(freqs)), key=lambda i: abs(freqs[i] - f))
+            self.assertLessEqual(abs(peak - nearest), 1)
+
+    def test_bad_args(self):
+        self.assertRaises(RuntimeError, filter.multires_spectrum_cvf, 32, 0, [])
+        self.assertRaises(RuntimeError, filter.multires_spectrum_cvf, 40, 2, [])
+        # the decimation, fft_size << (noctaves-1), must fit in an int
+        self.assertRaises(RuntimeError, filter.multires_spectrum_cvf, 1024, 22, [])
+
+if __name__ == '__main__':
+    gr_unittest.run(test_multires_spectrum, "test_multires_spectrum.xml")
@@ -0,0 +1,118 @@
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+import math, cmath, random
+from gnuradio import gr, gr_unittest, filter, blocks
+
+def random_taps(n):
+    return [random.uniform(-0.5, 0.5) for i in xrange(n)]
+
+def random_signal(n):
+    return [complex(random.uniform(-1, 1), random.uniform(-1, 1)) for i in xrange(n)]
+
+def tone(freq, n):
+    return [cmath.exp(2j*math.pi*freq*i) for i in xrange(n)]
+
+class test_multistage(gr_unittest.TestCase):
+
+    def setUp(self):
+        random.seed(0)
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_chain(self, src_data, ops):
+        tb = gr.top_block()
+        src = blocks.vector_source_c(src_data)
+        dst = blocks.vector_sink_c()
+        tb.connect(*([src] + ops + [dst]))
+        tb.run()
+        return dst.data()
+
+    def test_decim_cascade_001(self):
+        # Same output as a chain of decimating FIR filters
+        rates = [5, 4, 2]
+        taps = [random_taps(37), random_taps(60), random_taps(101)]
+        src_data = random_signal(40*500)
+
+        expected_result = self.run_chain(src_data,
+            [filter.fir_filter_ccf(r, t) for r, t in zip(rates, taps)])
+        result_data = self.run_chain(src_data,
+            [filter.fir_decim_cascade_ccf(rates, taps)])
+
+        self.assertEqual(500, len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_interp_cascade_001(self):
+        # Same output as a chain of interpolating FIR filters
+        rates = [2, 3, 4]
+        taps = [random_taps(31), random_taps(20), random_taps(9)]
+        src_data = random_signal(1000)
+
+        expected_result = self.run_chain(src_data,
+            [filter.interp_fir_filter_ccf(r, t) for r, t in zip(rates, taps)])
+        result_data = self.run_chain(src_data,
+            [filter.fir_interp_cascade_ccf(rates, taps)])
+
+        self.assertEqual(24*1000, len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_design_001(self):
+        for decim in (1, 2, 7, 64, 100, 1000):
+            (rates, taps) = filter.multistage.design_stages(decim)
+            self.assertEqual(decim, reduce(lambda a, b: a*b, rates, 1))
+            self.assertEqual(len(rates), len(taps))
+
+        # A large decimation is split up
+        (rates, taps) = filter.multistage.design_stages(1000)
+        self.assertTrue(len(rates) > 1)
+        self.assertTrue(sum([len(t) for t in taps]) < 1000)
+
+    def test_multistage_decimator_001(self):
+        # A tone in the passband comes through at unit gain, one
+        # above the output Nyquist rate is suppressed.
+        decim = 100
+        nout = 400
+        for freq, passes in ((0.2/decim, True), (0.7/decim, False)):
+            op = filter.multistage_decimator_ccf(decim)
+            result_data = self.run_chain(tone(freq, decim*nout), [op])
+            settled = result_data[nout//2:]
+            peak = max([abs(x) for x in settled])
+            if passes:
+                self.assertAlmostEqual(1.0, peak, 1)
+            else:
+                self.assertTrue(peak < 1e-3)
+
+    def test_multistage_interpolator_001(self):
+        # A tone in the passband comes through at unit gain.
+        interp = 20
+        nin = 400
+        op = filter.multistage_interpolator_ccf(interp)
+        result_data = self.run_chain(tone(0.1, nin), [op])
+        self.assertEqual(interp*nin, len(result_data))
+        settled = result_data[interp*nin//2:]
+        for x in settled:
+            self.assertAlmostEqual(1.0, abs(x), 1)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_multistage, "test_multistage.xml")
@@ -75,6 +75,29 @@ class test_pfb_channelizer(gr_unittest.TestCase):
                           filter.pfb.channelizer_ccf,
                           36, taps=self.taps, oversample_rate=10.1334)
 
+    def test_0004(self):
+        """Threaded and oversampled channelizers match a single thread."""
+        data = self.get_input_data()
+        for oversample_rate in (1, self.M/2.0, self.M):
+            results = []
+            for nthreads in (1, 3):
+                tb = gr.top_block()
+                src = blocks.vector_source_c(data)
+                s2ss = blocks.stream_to_streams(gr.sizeof_gr_complex, self.M)
+                pfb = filter.pfb_channelizer_ccf(self.M, self.taps,
+                                                 oversample_rate, nthreads)
+                self.assertEqual(nthreads, pfb.nthreads())
+                tb.connect(src, s2ss)
+                snks = []
+                for i in xrange(self.M):
+                    snks.append(blocks.vector_sink_c())
+                    tb.connect((s2ss,i), (pfb,i))
+                    tb.connect((pfb,i), snks[i])
+                tb.run()
+                results.append([snk.data() for snk in snks])
+            for expected, received in zip(results[0], results[1]):
+                self.assertComplexTuplesAlmostEqual(expected, received, 6)
+
     def get_input_data(self):
         """
         Get the raw data generated by addition of sinusoids.
@@ -40,6 +40,10 @@
 #include "gnuradio/filter/fir_filter_fff.h"
 #include "gnuradio/filter/fir_filter_fsf.h"
 #include "gnuradio/filter/fir_filter_scc.h"
+#include "gnuradio/filter/fir_filter_sc16.h"
+#include "gnuradio/filter/fir_decim_cascade_ccf.h"
+#include "gnuradio/filter/fir_interp_cascade_ccf.h"
+#include "gnuradio/filter/fft_channelizer_ccf.h"
 #include "gnuradio/filter/fft_filter_ccc.h"
 #include "gnuradio/filter/fft_filter_ccf.h"
 #include "gnuradio/filter/fft_filter_fff.h"
@@ -53,18 +57,27 @@
 #include "gnuradio/filter/freq_xlating_fir_filter_fcf.h"
 #include "gnuradio/filter/freq_xlating_fir_filter_scf.h"
 #include "gnuradio/filter/freq_xlating_fir_filter_scc.h"
+#include "gnuradio/filter/freq_xlating_fir_filter_sc16.h"
+#include "gnuradio/filter/freq_xlating_filterbank_ccf.h"
+#include "gnuradio/filter/halfband_decimator_ccf.h"
+#include "gnuradio/filter/halfband_decimator_fff.h"
+#include "gnuradio/filter/halfband_interpolator_ccf.h"
+#include "gnuradio/filter/halfband_interpolator_fff.h"
 #include "gnuradio/filter/hilbert_fc.h"
 #include "gnuradio/filter/iir_filter_ffd.h"
 #include "gnuradio/filter/iir_filter_ccc.h"
 #include "gnuradio/filter/iir_filter_ccf.h"
 #include "gnuradio/filter/iir_filter_ccd.h"
 #include "gnuradio/filter/iir_filter_ccz.h"
+#include "gnuradio/filter/iir_filter_sos_ffd.h"
+#include "gnuradio/filter/iir_filter_sos_ccd.h"
 #include "gnuradio/filter/interp_fir_filter_ccc.h"
 #include "gnuradio/filter/interp_fir_filter_ccf.h"
 #include "gnuradio/filter/interp_fir_filter_fcc.h"
 #include "gnuradio/filter/interp_fir_filter_fff.h"
 #include "gnuradio/filter/interp_fir_filter_fsf.h"
 #include "gnuradio/filter/interp_fir_filter_scc.h"
+#include "gnuradio/filter/multires_spectrum_cvf.h"
 #include "gnuradio/filter/pfb_arb_resampler_ccf.h"
 #include "gnuradio/filter/pfb_arb_resampler_ccc.h"
 #include "gnuradio/filter/pfb_arb_resampler_fff.h"
@@ -94,6 +107,10 @@
 %include "gnuradio/filter/fir_filter_fff.h"
 %include "gnuradio/filter/fir_filter_fsf.h"
 %include "gnuradio/filter/fir_filter_scc.h"
+%include "gnuradio/filter/fir_filter_sc16.h"
+%include "gnuradio/filter/fir_decim_cascade_ccf.h"
+%include "gnuradio/filter/fir_interp_cascade_ccf.h"
+%include "gnuradio/filter/fft_channelizer_ccf.h"
 %include "gnuradio/filter/fft_filter_ccc.h"
 %include "gnuradio/filter/fft_filter_ccf.h"
 %include "gnuradio/filter/fft_filter_fff.h"
@@ -107,18 +124,27 @@
 %include "gnuradio/filter/freq_xlating_fir_filter_fcf.h"
 %include "gnuradio/filter/freq_xlating_fir_filter_scf.h"
 %include "gnuradio/filter/freq_xlating_fir_filter_scc.h"
+%include "gnuradio/filter/freq_xlating_fir_filter_sc16.h"
+%include "gnuradio/filter/freq_xlating_filterbank_ccf.h"
+%include "gnuradio/filter/halfband_decimator_ccf.h"
+%include "gnuradio/filter/halfband_decimator_fff.h"
+%include "gnuradio/filter/halfband_interpolator_ccf.h"
+%include "gnuradio/filter/halfband_interpolator_fff.h"
 %include "gnuradio/filter/hilbert_fc.h"
 %include "gnuradio/filter/iir_filter_ffd.h"
 %include "gnuradio/filter/iir_filter_ccc.h"
 %include "gnuradio/filter/iir_filter_ccf.h"
 %include "gnuradio/filter/iir_filter_ccd.h"
 %include "gnuradio/filter/iir_filter_ccz.h"
+%include "gnuradio/filter/iir_filter_sos_ffd.h"
+%include "gnuradio/filter/iir_filter_sos_ccd.h"
 %include "gnuradio/filter/interp_fir_filter_ccc.h"
 %include "gnuradio/filter/interp_fir_filter_ccf.h"
 %include "gnuradio/filter/interp_fir_filter_fcc.h"
 %include "gnuradio/filter/interp_fir_filter_fff.h"
 %include "gnuradio/filter/interp_fir_filter_fsf.h"
 %include "gnuradio/filter/interp_fir_filter_scc.h"
+%include "gnuradio/filter/multires_spectrum_cvf.h"
 %include "gnuradio/filter/pfb_arb_resampler_ccf.h"
 %include "gnuradio/filter/pfb_arb_resampler_ccc.h"
 %include "gnuradio/filter/pfb_arb_resampler_fff.h"
@@ -145,6 +171,10 @@ GR_SWIG_BLOCK_MAGIC2(filter, fir_filter_fcc);
 GR_SWIG_BLOCK_MAGIC2(filter, fir_filter_fff);
 GR_SWIG_BLOCK_MAGIC2(filter, fir_filter_fsf);
 GR_SWIG_BLOCK_MAGIC2(filter, fir_filter_scc);
+GR_SWIG_BLOCK_MAGIC2(filter, fir_filter_sc16);
+GR_SWIG_BLOCK_MAGIC2(filter, fir_decim_cascade_ccf);
+GR_SWIG_BLOCK_MAGIC2(filter, fir_interp_cascade_ccf);
+GR_SWIG_BLOCK_MAGIC2(filter, fft_channelizer_ccf);
 GR_SWIG_BLOCK_MAGIC2(filter, fft_filter_ccc);
 GR_SWIG_BLOCK_MAGIC2(filter, fft_filter_ccf);
 GR_SWIG_BLOCK_MAGIC2(filter, fft_filter_fff);
@@ -158,18 +188,27 @@ GR_SWIG_BLOCK_MAGIC2(filter, freq_xlating_fir_filter_fcc);
 GR_SWIG_BLOCK_MAGIC2(filter, freq_xlating_fir_filter_fcf);
 GR_SWIG_BLOCK_MAGIC2(filter, freq_xlating_fir_filter_scf);
 GR_SWIG_BLOCK_MAGIC2(filter, freq_xlating_fir_filter_scc);
+GR_SWIG_BLOCK_MAGIC2(filter, freq_xlating_fir_filter_sc16);
+GR_SWIG_BLOCK_MAGIC2(filter, freq_xlating_filterbank_ccf);
+GR_SWIG_BLOCK_MAGIC2(filter, halfband_decimator_ccf);
+GR_SWIG_BLOCK_MAGIC2(filter, halfband_decimator_fff);
+GR_SWIG_BLOCK_MAGIC2(filter, halfband_interpolator_ccf);
+GR_SWIG_BLOCK_MAGIC2(filter, halfband_interpolator_fff);
 GR_SWIG_BLOCK_MAGIC2(filter, hilbert_fc);
 GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_ffd);
 GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_ccc);
 GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_ccf);
 GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_ccd);
 GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_ccz);
+GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_sos_ffd);
+GR_SWIG_BLOCK_MAGIC2(filter, iir_filter_sos_ccd);
 GR_SWIG_BLOCK_MAGIC2(filter, interp_fir_filter_ccc);
 GR_SWIG_BLOCK_MAGIC2(filter, interp_fir_filter_ccf);
 GR_SWIG_BLOCK_MAGIC2(filter, interp_fir_filter_fcc);
 GR_SWIG_BLOCK_MAGIC2(filter, interp_fir_filter_fff);
 GR_SWIG_BLOCK_MAGIC2(filter, interp_fir_filter_fsf);
 GR_SWIG_BLOCK_MAGIC2(filter, interp_fir_filter_scc);
+GR_SWIG_BLOCK_MAGIC2(filter, multires_spectrum_cvf);
 GR_SWIG_BLOCK_MAGIC2(filter, pfb_arb_resampler_ccf);
 GR_SWIG_BLOCK_MAGIC2(filter, pfb_arb_resampler_ccc);
 GR_SWIG_BLOCK_MAGIC2(filter, pfb_arb_resampler_fff);
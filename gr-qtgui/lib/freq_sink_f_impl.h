@@ -48,7 +48,7 @@ namespace gr {
       int d_nconnections;
 
       bool d_shift;
-      fft::fft_complex *d_fft;
+      fft::fft_real_fwd *d_fft;
 
       int d_index;
       std::vector<float*> d_residbufs;
@@ -86,7 +86,7 @@ namespace gr {
       // this is usually desired when plotting
       d_shift = true;
 
-      d_fft = new fft::fft_complex(d_fftsize, true);
+      d_fft = new fft::fft_real_fwd(d_fftsize);
 
       d_index = 0;
       d_residbuf = (float*)volk_malloc(d_fftsize*sizeof(float),
@@ -257,19 +257,21 @@ namespace gr {
     sink_f_impl::fft(float *data_out, const float *data_in, int size)
     {
       if (d_window.size()) {
-	gr_complex *dst = d_fft->get_inbuf();
-	for (int i = 0; i < size; i++)		// apply window
-	  dst[i] = data_in[i] * d_window[i];
+	volk_32f_x2_multiply_32f(d_fft->get_inbuf(), data_in,
+				 &d_window.front(), size);
       }
       else {
-	gr_complex *dst = d_fft->get_inbuf();
-	for (int i = 0; i < size; i++)	        // float to complex conversion
-	  dst[i] = data_in[i];
+	memcpy(d_fft->get_inbuf(), data_in, sizeof(float)*size);
       }
 
-      d_fft->execute ();     // compute the fft
+      d_fft->execute ();     // compute the real fft
       volk_32fc_s32f_x2_power_spectral_density_32f(data_out, d_fft->get_outbuf(),
-                                                   size, 1.0, size);
+                                                   size, 1.0, size/2 + 1);
+
+      // The spectrum of real input is symmetric; the real fft only
+      // computes the bins up to size/2.
+      for(int i = size/2 + 1; i < size; i++)
+        data_out[i] = data_out[size - i];
     }
 
     void
@@ -318,7 +320,7 @@ namespace gr {
 
 	// Reset FFTW plan for new size
 	delete d_fft;
-	d_fft = new fft::fft_complex (d_fftsize, true);
+	d_fft = new fft::fft_real_fwd(d_fftsize);
       }
     }
 
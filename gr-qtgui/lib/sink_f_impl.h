@@ -47,7 +47,7 @@ namespace gr {
       std::string d_name;
 
       bool d_shift;
-      fft::fft_complex *d_fft;
+      fft::fft_real_fwd *d_fft;
 
       int d_index;
       float *d_residbuf;
@@ -0,0 +1,192 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compare two sweep result files written by "volk_profile --sweep --csv".
+ *
+ * Every (kernel, arch, vlen, offset) point present in both files is
+ * checked with a one-sided Mann-Whitney U test on the per-repetition
+ * samples. A point is reported as a regression when the candidate is
+ * slower with p < alpha AND its median is slower by more than the
+ * given relative threshold; the second condition keeps tiny but
+ * statistically significant shifts from failing a build.
+ */
+
+#include "qa_utils.h"
+
+#include <ciso646>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <boost/program_options.hpp>
+
+typedef boost::tuple<std::string, std::string, int, int> sweep_key_t;
+
+static sweep_key_t make_key(const volk_sweep_result_t &r) {
+    return sweep_key_t(r.name, r.arch, r.vlen, r.offset);
+}
+
+// One-sided p-value that samples b are stochastically larger than
+// samples a (normal approximation with tie correction).
+static double mann_whitney_p(const std::vector<double> &a,
+                             const std::vector<double> &b) {
+    const size_t n1 = a.size(), n2 = b.size();
+    if(n1 == 0 || n2 == 0) return 1.0;
+
+    std::vector<std::pair<double, int> > all;
+    BOOST_FOREACH(double v, a) all.push_back(std::make_pair(v, 0));
+    BOOST_FOREACH(double v, b) all.push_back(std::make_pair(v, 1));
+    std::sort(all.begin(), all.end());
+
+    const double n = double(n1 + n2);
+    double rank_sum_b = 0.0;
+    double tie_term = 0.0;
+    size_t i = 0;
+    while(i < all.size()) {
+        size_t j = i;
+        while(j + 1 < all.size() && all[j+1].first == all[i].first) j++;
+        double avg_rank = 0.5 * double(i + j) + 1.0;
+        double t = double(j - i + 1);
+        tie_term += t*t*t - t;
+        for(size_t k = i; k <= j; k++) {
+            if(all[k].second == 1) rank_sum_b += avg_rank;
+        }
+        i = j + 1;
+    }
+
+    double u_b = rank_sum_b - double(n2) * double(n2 + 1) / 2.0;
+    double mean_u = double(n1) * double(n2) / 2.0;
+    double var_u = double(n1) * double(n2) / 12.0 *
+        ((n + 1.0) - tie_term / (n * (n - 1.0)));
+    if(var_u <= 0.0) return 1.0;
+
+    // continuity correction
+    double z = (u_b - mean_u - 0.5) / std::sqrt(var_u);
+    return 0.5 * erfc(z / std::sqrt(2.0));
+}
+
+int main(int argc, char *argv[]) {
+    boost::program_options::options_description desc("Options");
+    desc.add_options()
+      ("help,h", "Print help messages")
+      ("baseline,b",
+            boost::program_options::value<std::string>(),
+            "Baseline sweep CSV file")
+      ("candidate,c",
+            boost::program_options::value<std::string>(),
+            "Candidate sweep CSV file")
+      ("alpha,a",
+            boost::program_options::value<double>()->default_value(0.01),
+            "Significance level of the one-sided test")
+      ("threshold,t",
+            boost::program_options::value<double>()->default_value(0.05),
+            "Minimum relative slowdown of the median to report")
+      ("verbose,v", "Print every compared point, not just regressions")
+      ;
+
+    boost::program_options::positional_options_description pos;
+    pos.add("baseline", 1).add("candidate", 1);
+
+    boost::program_options::variables_map vm;
+    try {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv).
+                                      options(desc).positional(pos).run(), vm);
+        boost::program_options::notify(vm);
+    } catch (boost::program_options::error& error) {
+        std::cerr << "Error: " << error.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 2;
+    }
+
+    if(vm.count("help") or not vm.count("baseline") or not vm.count("candidate")) {
+        std::cout << "Compare two volk_profile sweep results." << std::endl
+                  << "Usage: volk_profile_compare [options] baseline.csv candidate.csv" << std::endl
+                  << desc << std::endl;
+        return vm.count("help") ? 0 : 2;
+    }
+
+    const double alpha = vm["alpha"].as<double>();
+    const double threshold = vm["threshold"].as<double>();
+    const bool verbose = vm.count("verbose") > 0;
+
+    std::vector<volk_sweep_result_t> base_results, cand_results;
+    std::ifstream base_file(vm["baseline"].as<std::string>().c_str());
+    std::ifstream cand_file(vm["candidate"].as<std::string>().c_str());
+    if(!base_file.is_open() or !read_sweep_csv(base_file, base_results)) {
+        std::cerr << "Error reading " << vm["baseline"].as<std::string>() << std::endl;
+        return 2;
+    }
+    if(!cand_file.is_open() or !read_sweep_csv(cand_file, cand_results)) {
+        std::cerr << "Error reading " << vm["candidate"].as<std::string>() << std::endl;
+        return 2;
+    }
+
+    std::map<sweep_key_t, volk_sweep_result_t> base_map;
+    BOOST_FOREACH(const volk_sweep_result_t &r, base_results) {
+        base_map[make_key(r)] = r;
+    }
+
+    size_t compared = 0, regressions = 0, improvements = 0;
+    std::cout << std::fixed << std::setprecision(4);
+    BOOST_FOREACH(const volk_sweep_result_t &cand, cand_results) {
+        std::map<sweep_key_t, volk_sweep_result_t>::const_iterator it =
+            base_map.find(make_key(cand));
+        if(it == base_map.end()) continue;
+        const volk_sweep_result_t &base = it->second;
+        compared++;
+
+        double ratio = base.median > 0.0 ? cand.median / base.median : 1.0;
+        double p_slower = mann_whitney_p(base.samples, cand.samples);
+        double p_faster = mann_whitney_p(cand.samples, base.samples);
+
+        std::string verdict;
+        if(p_slower < alpha && ratio > 1.0 + threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        }
+        else if(p_faster < alpha && ratio < 1.0 - threshold) {
+            verdict = "improved";
+            improvements++;
+        }
+
+        if(verbose || !verdict.empty()) {
+            std::cout << cand.name << " " << cand.arch
+                      << " vlen=" << cand.vlen << " offset=" << cand.offset
+                      << ": " << base.median << " -> " << cand.median << " ns/item ("
+                      << std::showpos << 100.0 * (ratio - 1.0) << std::noshowpos
+                      << "%, p=" << std::min(p_slower, p_faster) << ") "
+                      << verdict << std::endl;
+        }
+    }
+
+    std::cout << compared << " points compared, " << regressions
+              << " regressions, " << improvements << " improvements" << std::endl;
+
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_BIND_H
+#define INCLUDED_VOLK_BIND_H
+
+#ifndef __cplusplus
+#error "volk_bind.h is C++ only; C code can use volk_init() from volk.h"
+#endif
+
+#include <volk/volk.h>
+#include <cstddef>
+
+/*!
+ * Header-only C++ helpers to bind kernel implementations once, for
+ * example in a block constructor, and call them directly from work().
+ *
+ * A call through the public kernel pointer goes through the
+ * dispatcher, which tests the alignment of every buffer; the first
+ * call also ranks the implementations. A binding resolves both
+ * implementations up front and stores the plain function pointers:
+ *
+ * \code
+ *   // constructor
+ *   d_mult = VOLK_BIND(volk_32fc_x2_multiply_32fc);
+ *
+ *   // work(), with set_alignment() making aligned buffers the rule
+ *   d_mult(VOLK_OR_PTR(VOLK_OR_PTR(out, a), b))(out, a, b, n);
+ *
+ *   // or, when the buffers are known to be aligned
+ *   d_mult.aligned(out, a, b, n);
+ * \endcode
+ */
+namespace volk {
+
+  template <typename fcn_t>
+  struct binding
+  {
+    //! The implementation to use for aligned buffers
+    fcn_t aligned;
+    //! The implementation to use for any buffers
+    fcn_t unaligned;
+
+    binding() : aligned(NULL), unaligned(NULL) {}
+    binding(fcn_t a, fcn_t u) : aligned(a), unaligned(u) {}
+
+    /*!
+     * Select the implementation for a set of buffers.
+     * \param ptrs the buffer addresses OR'ed together with VOLK_OR_PTR
+     */
+    fcn_t operator()(const void *ptrs) const
+    {
+      return volk_is_aligned(ptrs) ? aligned : unaligned;
+    }
+  };
+
+  /*!
+   * Bind the implementations the dispatcher would choose. The kernel
+   * pointers are passed by reference so they are read after
+   * volk_init() has resolved them.
+   */
+  template <typename fcn_t>
+  inline binding<fcn_t> bind(const fcn_t &a, const fcn_t &u)
+  {
+    volk_init();
+    return binding<fcn_t>(a, u);
+  }
+
+  //! Bind one named implementation for both aligned and unaligned use
+  template <typename fcn_t>
+  inline binding<fcn_t> bind_impl(fcn_t impl)
+  {
+    volk_init();
+    return binding<fcn_t>(impl, impl);
+  }
+
+} /* namespace volk */
+
+//! Bind the best implementations of a kernel, e.g. VOLK_BIND(volk_32f_x2_add_32f)
+#define VOLK_BIND(kern) ::volk::bind(kern ## _a, kern ## _u)
+
+//! Bind a named implementation of a kernel, e.g. VOLK_BIND_IMPL(volk_32f_x2_add_32f, "a_sse")
+#define VOLK_BIND_IMPL(kern, impl_name) ::volk::bind_impl(kern ## _get_impl(impl_name))
+
+#endif /* INCLUDED_VOLK_BIND_H */
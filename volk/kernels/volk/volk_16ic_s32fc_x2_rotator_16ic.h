@@ -0,0 +1,262 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_16ic_s32fc_x2_rotator_16ic_a_H
+#define INCLUDED_volk_16ic_s32fc_x2_rotator_16ic_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#ifndef ROTATOR_RELOAD
+#define ROTATOR_RELOAD 512
+#endif
+
+/*
+ * Rotates interleaved 16 bit complex samples by a float phasor that
+ * advances by phase_inc per sample. The product is rounded to nearest
+ * and saturated; shared by the generic kernel and the SIMD tails.
+ */
+static inline void volk_16ic_s32fc_x2_rotator_16ic_block(int16_t* outPtr, const int16_t* inPtr, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+  unsigned int number;
+  float pr = lv_creal(*phase), pi = lv_cimag(*phase);
+  const float ir = lv_creal(phase_inc), ii = lv_cimag(phase_inc);
+  float re, im, tmp;
+  for(number = 0; number < num_points; number++){
+    re = rintf((float)inPtr[0] * pr - (float)inPtr[1] * pi);
+    im = rintf((float)inPtr[0] * pi + (float)inPtr[1] * pr);
+    *outPtr++ = (int16_t)(re > 32767.0f ? 32767.0f : (re < -32768.0f ? -32768.0f : re));
+    *outPtr++ = (int16_t)(im > 32767.0f ? 32767.0f : (im < -32768.0f ? -32768.0f : im));
+    inPtr += 2;
+
+    tmp = pr * ir - pi * ii;
+    pi = pr * ii + pi * ir;
+    pr = tmp;
+  }
+  *phase = lv_cmake(pr, pi);
+}
+
+static inline void volk_16ic_s32fc_x2_rotator_16ic_normalize(lv_32fc_t* phase){
+  const float mag = sqrtf(lv_creal(*phase) * lv_creal(*phase) + lv_cimag(*phase) * lv_cimag(*phase));
+  *phase = lv_cmake(lv_creal(*phase) / mag, lv_cimag(*phase) / mag);
+}
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Rotates a 16 bit complex vector at a fixed rate per sample from an initial phase offset
+  \param outVector The vector where the rounded and saturated results will be stored
+  \param inVector Vector to be rotated
+  \param phase_inc rotational velocity
+  \param phase initial phase offset; updated to the phase of the next sample
+  \param num_points The number of values in inVector to be rotated and stored into outVector
+*/
+static inline void volk_16ic_s32fc_x2_rotator_16ic_generic(lv_16sc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+  int16_t* outPtr = (int16_t*)outVector;
+  const int16_t* inPtr = (const int16_t*)inVector;
+  unsigned int i;
+
+  for(i = 0; i < num_points / ROTATOR_RELOAD; ++i){
+    volk_16ic_s32fc_x2_rotator_16ic_block(outPtr, inPtr, phase_inc, phase, ROTATOR_RELOAD);
+    volk_16ic_s32fc_x2_rotator_16ic_normalize(phase);
+    outPtr += 2 * ROTATOR_RELOAD;
+    inPtr += 2 * ROTATOR_RELOAD;
+  }
+  volk_16ic_s32fc_x2_rotator_16ic_block(outPtr, inPtr, phase_inc, phase, num_points % ROTATOR_RELOAD);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+/*!
+  \brief Rotates a 16 bit complex vector at a fixed rate per sample from an initial phase offset
+  \param outVector The vector where the rounded and saturated results will be stored
+  \param inVector Vector to be rotated
+  \param phase_inc rotational velocity
+  \param phase initial phase offset; updated to the phase of the next sample
+  \param num_points The number of values in inVector to be rotated and stored into outVector
+*/
+static inline void volk_16ic_s32fc_x2_rotator_16ic_a_sse4_1(lv_16sc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+  int16_t* cPtr = (int16_t*)outVector;
+  const int16_t* aPtr = (const int16_t*)inVector;
+  __VOLK_ATTR_ALIGNED(16) lv_32fc_t phase_Ptr[4];
+  lv_32fc_t incr = lv_cmake(1.0f, 0.0f);
+  unsigned int i, j;
+
+  for(i = 0; i < 4; ++i){
+    phase_Ptr[i] = (*phase) * incr;
+    incr *= phase_inc;
+  }
+
+  __m128i aVal, cVal;
+  __m128 lowVal, highVal, phaseLow, phaseHigh, incl, inch, yl, yh, tmp1, tmp2;
+
+  phaseLow = _mm_load_ps((float*)phase_Ptr);
+  phaseHigh = _mm_load_ps((float*)(phase_Ptr + 2));
+  incl = _mm_set1_ps(lv_creal(incr));
+  inch = _mm_set1_ps(lv_cimag(incr));
+
+  const unsigned int quarterPoints = num_points / 4;
+
+  for(i = 0; i < quarterPoints; i += j){
+    for(j = 0; j < ROTATOR_RELOAD && i + j < quarterPoints; ++j){
+      aVal = _mm_load_si128((__m128i*)aPtr);
+
+      lowVal = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(aVal));
+      highVal = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(aVal, 8)));
+
+      yl = _mm_moveldup_ps(phaseLow);
+      yh = _mm_movehdup_ps(phaseLow);
+      tmp1 = _mm_mul_ps(lowVal, yl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(lowVal, lowVal, 0xB1), yh);
+      lowVal = _mm_addsub_ps(tmp1, tmp2);
+
+      yl = _mm_moveldup_ps(phaseHigh);
+      yh = _mm_movehdup_ps(phaseHigh);
+      tmp1 = _mm_mul_ps(highVal, yl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(highVal, highVal, 0xB1), yh);
+      highVal = _mm_addsub_ps(tmp1, tmp2);
+
+      // advance both phasor pairs by phase_inc^4
+      tmp1 = _mm_mul_ps(phaseLow, incl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(phaseLow, phaseLow, 0xB1), inch);
+      phaseLow = _mm_addsub_ps(tmp1, tmp2);
+
+      tmp1 = _mm_mul_ps(phaseHigh, incl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(phaseHigh, phaseHigh, 0xB1), inch);
+      phaseHigh = _mm_addsub_ps(tmp1, tmp2);
+
+      cVal = _mm_packs_epi32(_mm_cvtps_epi32(lowVal), _mm_cvtps_epi32(highVal));
+      _mm_store_si128((__m128i*)cPtr, cVal);
+
+      aPtr += 8;
+      cPtr += 8;
+    }
+    // keep the phasors on the unit circle
+    tmp1 = _mm_mul_ps(phaseLow, phaseLow);
+    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+    phaseLow = _mm_div_ps(phaseLow, _mm_sqrt_ps(tmp1));
+    tmp1 = _mm_mul_ps(phaseHigh, phaseHigh);
+    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+    phaseHigh = _mm_div_ps(phaseHigh, _mm_sqrt_ps(tmp1));
+  }
+
+  _mm_store_ps((float*)phase_Ptr, phaseLow);
+  (*phase) = phase_Ptr[0];
+  volk_16ic_s32fc_x2_rotator_16ic_block(cPtr, aPtr, phase_inc, phase, num_points % 4);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_16ic_s32fc_x2_rotator_16ic_a_H */
+
+
+#ifndef INCLUDED_volk_16ic_s32fc_x2_rotator_16ic_u_H
+#define INCLUDED_volk_16ic_s32fc_x2_rotator_16ic_u_H
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+/*!
+  \brief Rotates a 16 bit complex vector at a fixed rate per sample from an initial phase offset
+  \param outVector The vector where the rounded and saturated results will be stored
+  \param inVector Vector to be rotated
+  \param phase_inc rotational velocity
+  \param phase initial phase offset; updated to the phase of the next sample
+  \param num_points The number of values in inVector to be rotated and stored into outVector
+*/
+static inline void volk_16ic_s32fc_x2_rotator_16ic_u_sse4_1(lv_16sc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+  int16_t* cPtr = (int16_t*)outVector;
+  const int16_t* aPtr = (const int16_t*)inVector;
+  __VOLK_ATTR_ALIGNED(16) lv_32fc_t phase_Ptr[4];
+  lv_32fc_t incr = lv_cmake(1.0f, 0.0f);
+  unsigned int i, j;
+
+  for(i = 0; i < 4; ++i){
+    phase_Ptr[i] = (*phase) * incr;
+    incr *= phase_inc;
+  }
+
+  __m128i aVal, cVal;
+  __m128 lowVal, highVal, phaseLow, phaseHigh, incl, inch, yl, yh, tmp1, tmp2;
+
+  phaseLow = _mm_load_ps((float*)phase_Ptr);
+  phaseHigh = _mm_load_ps((float*)(phase_Ptr + 2));
+  incl = _mm_set1_ps(lv_creal(incr));
+  inch = _mm_set1_ps(lv_cimag(incr));
+
+  const unsigned int quarterPoints = num_points / 4;
+
+  for(i = 0; i < quarterPoints; i += j){
+    for(j = 0; j < ROTATOR_RELOAD && i + j < quarterPoints; ++j){
+      aVal = _mm_loadu_si128((__m128i*)aPtr);
+
+      lowVal = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(aVal));
+      highVal = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(aVal, 8)));
+
+      yl = _mm_moveldup_ps(phaseLow);
+      yh = _mm_movehdup_ps(phaseLow);
+      tmp1 = _mm_mul_ps(lowVal, yl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(lowVal, lowVal, 0xB1), yh);
+      lowVal = _mm_addsub_ps(tmp1, tmp2);
+
+      yl = _mm_moveldup_ps(phaseHigh);
+      yh = _mm_movehdup_ps(phaseHigh);
+      tmp1 = _mm_mul_ps(highVal, yl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(highVal, highVal, 0xB1), yh);
+      highVal = _mm_addsub_ps(tmp1, tmp2);
+
+      // advance both phasor pairs by phase_inc^4
+      tmp1 = _mm_mul_ps(phaseLow, incl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(phaseLow, phaseLow, 0xB1), inch);
+      phaseLow = _mm_addsub_ps(tmp1, tmp2);
+
+      tmp1 = _mm_mul_ps(phaseHigh, incl);
+      tmp2 = _mm_mul_ps(_mm_shuffle_ps(phaseHigh, phaseHigh, 0xB1), inch);
+      phaseHigh = _mm_addsub_ps(tmp1, tmp2);
+
+      cVal = _mm_packs_epi32(_mm_cvtps_epi32(lowVal), _mm_cvtps_epi32(highVal));
+      _mm_storeu_si128((__m128i*)cPtr, cVal);
+
+      aPtr += 8;
+      cPtr += 8;
+    }
+    // keep the phasors on the unit circle
+    tmp1 = _mm_mul_ps(phaseLow, phaseLow);
+    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+    phaseLow = _mm_div_ps(phaseLow, _mm_sqrt_ps(tmp1));
+    tmp1 = _mm_mul_ps(phaseHigh, phaseHigh);
+    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+    phaseHigh = _mm_div_ps(phaseHigh, _mm_sqrt_ps(tmp1));
+  }
+
+  _mm_store_ps((float*)phase_Ptr, phaseLow);
+  (*phase) = phase_Ptr[0];
+  volk_16ic_s32fc_x2_rotator_16ic_block(cPtr, aPtr, phase_inc, phase, num_points % 4);
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_16ic_s32fc_x2_rotator_16ic_u_H */
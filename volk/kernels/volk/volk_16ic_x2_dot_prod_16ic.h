@@ -0,0 +1,182 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_16ic_x2_dot_prod_16ic_a_H
+#define INCLUDED_volk_16ic_x2_dot_prod_16ic_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+
+/*
+ * Q15 complex multiply-accumulate shared by the generic kernel and the
+ * SIMD tails. taps is clamped to [-32767, 32767]; every product is
+ * rounded and scaled by 2^-15 before it is added to the 32 bit
+ * accumulators, so up to 32768 points can be summed without overflow.
+ */
+static inline void volk_16ic_x2_dot_prod_16ic_block(int32_t* realAcc, int32_t* imagAcc, const int16_t* aPtr, const int16_t* bPtr, unsigned int num_points){
+  unsigned int number;
+  int32_t re = *realAcc, im = *imagAcc;
+  for(number = 0; number < num_points; number++){
+    const int32_t ar = aPtr[0], ai = aPtr[1];
+    const int32_t br = (bPtr[0] < -32767) ? -32767 : bPtr[0];
+    const int32_t bi = (bPtr[1] < -32767) ? -32767 : bPtr[1];
+    re += (ar*br - ai*bi + 16384) >> 15;
+    im += (ar*bi + ai*br + 16384) >> 15;
+    aPtr += 2;
+    bPtr += 2;
+  }
+  *realAcc = re;
+  *imagAcc = im;
+}
+
+static inline lv_16sc_t volk_16ic_x2_dot_prod_16ic_saturate(int32_t re, int32_t im){
+  re = re > 32767 ? 32767 : (re < -32768 ? -32768 : re);
+  im = im > 32767 ? 32767 : (im < -32768 ? -32768 : im);
+  return lv_cmake((int16_t)re, (int16_t)im);
+}
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+/*!
+  \brief Computes the Q15 dot product of two complex vectors with rounding and saturation
+  \param result The saturated 16 bit complex dot product
+  \param input One of the complex vectors to be multiplied and accumulated
+  \param taps The other complex vector to be multiplied and accumulated (clamped to [-32767, 32767])
+  \param num_points The number of complex values in input and taps
+*/
+static inline void volk_16ic_x2_dot_prod_16ic_a_sse4_1(lv_16sc_t* result, const lv_16sc_t* input, const lv_16sc_t* taps, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m128i x, y, yconj, yswap, realacc, imagacc;
+  const int16_t* a = (const int16_t*)input;
+  const int16_t* b = (const int16_t*)taps;
+  const __m128i minVal = _mm_set1_epi16(-32767);
+  const __m128i conjugateSign = _mm_set_epi16(-1, 1, -1, 1, -1, 1, -1, 1);
+  const __m128i rounding = _mm_set1_epi32(16384);
+  __VOLK_ATTR_ALIGNED(16) int32_t realStore[4];
+  __VOLK_ATTR_ALIGNED(16) int32_t imagStore[4];
+  int32_t re, im;
+
+  realacc = _mm_setzero_si128();
+  imagacc = _mm_setzero_si128();
+
+  for(;number < quarterPoints; number++){
+    x = _mm_load_si128((__m128i*)a);
+    y = _mm_max_epi16(_mm_load_si128((__m128i*)b), minVal);
+
+    yconj = _mm_sign_epi16(y, conjugateSign);
+    yswap = _mm_shufflehi_epi16(_mm_shufflelo_epi16(y, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+
+    realacc = _mm_add_epi32(realacc, _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(x, yconj), rounding), 15));
+    imagacc = _mm_add_epi32(imagacc, _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(x, yswap), rounding), 15));
+
+    a += 8;
+    b += 8;
+  }
+
+  _mm_store_si128((__m128i*)realStore, realacc);
+  _mm_store_si128((__m128i*)imagStore, imagacc);
+  re = realStore[0] + realStore[1] + realStore[2] + realStore[3];
+  im = imagStore[0] + imagStore[1] + imagStore[2] + imagStore[3];
+
+  number = quarterPoints * 4;
+  volk_16ic_x2_dot_prod_16ic_block(&re, &im, a, b, num_points - number);
+  *result = volk_16ic_x2_dot_prod_16ic_saturate(re, im);
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Computes the Q15 dot product of two complex vectors with rounding and saturation
+  \param result The saturated 16 bit complex dot product
+  \param input One of the complex vectors to be multiplied and accumulated
+  \param taps The other complex vector to be multiplied and accumulated (clamped to [-32767, 32767])
+  \param num_points The number of complex values in input and taps
+*/
+static inline void volk_16ic_x2_dot_prod_16ic_generic(lv_16sc_t* result, const lv_16sc_t* input, const lv_16sc_t* taps, unsigned int num_points){
+  int32_t re = 0, im = 0;
+  volk_16ic_x2_dot_prod_16ic_block(&re, &im, (const int16_t*)input, (const int16_t*)taps, num_points);
+  *result = volk_16ic_x2_dot_prod_16ic_saturate(re, im);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_16ic_x2_dot_prod_16ic_a_H */
+
+
+#ifndef INCLUDED_volk_16ic_x2_dot_prod_16ic_u_H
+#define INCLUDED_volk_16ic_x2_dot_prod_16ic_u_H
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+/*!
+  \brief Computes the Q15 dot product of two complex vectors with rounding and saturation
+  \param result The saturated 16 bit complex dot product
+  \param input One of the complex vectors to be multiplied and accumulated
+  \param taps The other complex vector to be multiplied and accumulated (clamped to [-32767, 32767])
+  \param num_points The number of complex values in input and taps
+*/
+static inline void volk_16ic_x2_dot_prod_16ic_u_sse4_1(lv_16sc_t* result, const lv_16sc_t* input, const lv_16sc_t* taps, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m128i x, y, yconj, yswap, realacc, imagacc;
+  const int16_t* a = (const int16_t*)input;
+  const int16_t* b = (const int16_t*)taps;
+  const __m128i minVal = _mm_set1_epi16(-32767);
+  const __m128i conjugateSign = _mm_set_epi16(-1, 1, -1, 1, -1, 1, -1, 1);
+  const __m128i rounding = _mm_set1_epi32(16384);
+  __VOLK_ATTR_ALIGNED(16) int32_t realStore[4];
+  __VOLK_ATTR_ALIGNED(16) int32_t imagStore[4];
+  int32_t re, im;
+
+  realacc = _mm_setzero_si128();
+  imagacc = _mm_setzero_si128();
+
+  for(;number < quarterPoints; number++){
+    x = _mm_loadu_si128((__m128i*)a);
+    y = _mm_max_epi16(_mm_loadu_si128((__m128i*)b), minVal);
+
+    yconj = _mm_sign_epi16(y, conjugateSign);
+    yswap = _mm_shufflehi_epi16(_mm_shufflelo_epi16(y, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+
+    realacc = _mm_add_epi32(realacc, _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(x, yconj), rounding), 15));
+    imagacc = _mm_add_epi32(imagacc, _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(x, yswap), rounding), 15));
+
+    a += 8;
+    b += 8;
+  }
+
+  _mm_store_si128((__m128i*)realStore, realacc);
+  _mm_store_si128((__m128i*)imagStore, imagacc);
+  re = realStore[0] + realStore[1] + realStore[2] + realStore[3];
+  im = imagStore[0] + imagStore[1] + imagStore[2] + imagStore[3];
+
+  number = quarterPoints * 4;
+  volk_16ic_x2_dot_prod_16ic_block(&re, &im, a, b, num_points - number);
+  *result = volk_16ic_x2_dot_prod_16ic_saturate(re, im);
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_16ic_x2_dot_prod_16ic_u_H */
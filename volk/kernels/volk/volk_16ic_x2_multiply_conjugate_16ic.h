@@ -0,0 +1,166 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_16ic_x2_multiply_conjugate_16ic_a_H
+#define INCLUDED_volk_16ic_x2_multiply_conjugate_16ic_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_complex.h>
+
+/*
+ * Q15 complex multiply by the conjugate of bVector, shared by the generic kernel and the SIMD tails.
+ * bVector is clamped to the symmetric range [-32767, 32767] so that the
+ * 32 bit sums of products can not overflow; each result is rounded,
+ * scaled by 2^-15 and saturated to 16 bits.
+ */
+static inline void volk_16ic_x2_multiply_conjugate_16ic_block(int16_t* cPtr, const int16_t* aPtr, const int16_t* bPtr, unsigned int num_points){
+  unsigned int number;
+  for(number = 0; number < num_points; number++){
+    const int32_t ar = aPtr[0], ai = aPtr[1];
+    const int32_t br = (bPtr[0] < -32767) ? -32767 : bPtr[0];
+    const int32_t bi = (bPtr[1] < -32767) ? -32767 : bPtr[1];
+    int32_t re = (ar*br + ai*bi + 16384) >> 15;
+    int32_t im = (ai*br - ar*bi + 16384) >> 15;
+    *cPtr++ = (int16_t)(re > 32767 ? 32767 : (re < -32768 ? -32768 : re));
+    *cPtr++ = (int16_t)(im > 32767 ? 32767 : (im < -32768 ? -32768 : im));
+    aPtr += 2;
+    bPtr += 2;
+  }
+}
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+/*!
+  \brief Multiplies a Q15 complex vector by the complex conjugate of a second one, with rounding and saturation
+  \param cVector The complex vector where the results will be stored
+  \param aVector One of the complex vectors to be multiplied
+  \param bVector The complex vector which will be conjugated and multiplied (clamped to [-32767, 32767])
+  \param num_points The number of complex values in aVector and bVector to be multiplied together and stored into cVector
+*/
+static inline void volk_16ic_x2_multiply_conjugate_16ic_a_sse4_1(lv_16sc_t* cVector, const lv_16sc_t* aVector, const lv_16sc_t* bVector, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m128i x, y, yswap, realz, imagz;
+  int16_t* c = (int16_t*)cVector;
+  const int16_t* a = (const int16_t*)aVector;
+  const int16_t* b = (const int16_t*)bVector;
+  const __m128i minVal = _mm_set1_epi16(-32767);
+  const __m128i conjugateSign = _mm_set_epi16(1, -1, 1, -1, 1, -1, 1, -1);
+  const __m128i rounding = _mm_set1_epi32(16384);
+
+  for(;number < quarterPoints; number++){
+    x = _mm_load_si128((__m128i*)a);
+    y = _mm_max_epi16(_mm_load_si128((__m128i*)b), minVal);
+
+    // ar*br + ai*bi
+    realz = _mm_madd_epi16(x, y);
+
+    // ai*br - ar*bi
+    yswap = _mm_shufflehi_epi16(_mm_shufflelo_epi16(y, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+    yswap = _mm_sign_epi16(yswap, conjugateSign);
+    imagz = _mm_madd_epi16(x, yswap);
+
+    realz = _mm_srai_epi32(_mm_add_epi32(realz, rounding), 15);
+    imagz = _mm_srai_epi32(_mm_add_epi32(imagz, rounding), 15);
+
+    _mm_store_si128((__m128i*)c, _mm_packs_epi32(_mm_unpacklo_epi32(realz, imagz), _mm_unpackhi_epi32(realz, imagz)));
+
+    a += 8;
+    b += 8;
+    c += 8;
+  }
+
+  number = quarterPoints * 4;
+  volk_16ic_x2_multiply_conjugate_16ic_block(c, a, b, num_points - number);
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Multiplies a Q15 complex vector by the complex conjugate of a second one, with rounding and saturation
+  \param cVector The complex vector where the results will be stored
+  \param aVector One of the complex vectors to be multiplied
+  \param bVector The complex vector which will be conjugated and multiplied (clamped to [-32767, 32767])
+  \param num_points The number of complex values in aVector and bVector to be multiplied together and stored into cVector
+*/
+static inline void volk_16ic_x2_multiply_conjugate_16ic_generic(lv_16sc_t* cVector, const lv_16sc_t* aVector, const lv_16sc_t* bVector, unsigned int num_points){
+  volk_16ic_x2_multiply_conjugate_16ic_block((int16_t*)cVector, (const int16_t*)aVector, (const int16_t*)bVector, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_16ic_x2_multiply_conjugate_16ic_a_H */
+
+
+#ifndef INCLUDED_volk_16ic_x2_multiply_conjugate_16ic_u_H
+#define INCLUDED_volk_16ic_x2_multiply_conjugate_16ic_u_H
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+/*!
+  \brief Multiplies a Q15 complex vector by the complex conjugate of a second one, with rounding and saturation
+  \param cVector The complex vector where the results will be stored
+  \param aVector One of the complex vectors to be multiplied
+  \param bVector The complex vector which will be conjugated and multiplied (clamped to [-32767, 32767])
+  \param num_points The number of complex values in aVector and bVector to be multiplied together and stored into cVector
+*/
+static inline void volk_16ic_x2_multiply_conjugate_16ic_u_sse4_1(lv_16sc_t* cVector, const lv_16sc_t* aVector, const lv_16sc_t* bVector, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m128i x, y, yswap, realz, imagz;
+  int16_t* c = (int16_t*)cVector;
+  const int16_t* a = (const int16_t*)aVector;
+  const int16_t* b = (const int16_t*)bVector;
+  const __m128i minVal = _mm_set1_epi16(-32767);
+  const __m128i conjugateSign = _mm_set_epi16(1, -1, 1, -1, 1, -1, 1, -1);
+  const __m128i rounding = _mm_set1_epi32(16384);
+
+  for(;number < quarterPoints; number++){
+    x = _mm_loadu_si128((__m128i*)a);
+    y = _mm_max_epi16(_mm_loadu_si128((__m128i*)b), minVal);
+
+    // ar*br + ai*bi
+    realz = _mm_madd_epi16(x, y);
+
+    // ai*br - ar*bi
+    yswap = _mm_shufflehi_epi16(_mm_shufflelo_epi16(y, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+    yswap = _mm_sign_epi16(yswap, conjugateSign);
+    imagz = _mm_madd_epi16(x, yswap);
+
+    realz = _mm_srai_epi32(_mm_add_epi32(realz, rounding), 15);
+    imagz = _mm_srai_epi32(_mm_add_epi32(imagz, rounding), 15);
+
+    _mm_storeu_si128((__m128i*)c, _mm_packs_epi32(_mm_unpacklo_epi32(realz, imagz), _mm_unpackhi_epi32(realz, imagz)));
+
+    a += 8;
+    b += 8;
+    c += 8;
+  }
+
+  number = quarterPoints * 4;
+  volk_16ic_x2_multiply_conjugate_16ic_block(c, a, b, num_points - number);
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_16ic_x2_multiply_conjugate_16ic_u_H */
@@ -0,0 +1,234 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <inttypes.h>
+
+#ifndef INCLUDED_volk_32f_sincos_32fc_a_H
+#define INCLUDED_volk_32f_sincos_32fc_a_H
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+/*!
+  \brief Computes the unit phasor exp(j*phase) of each input phase
+  \param outVector The vector where the complex results (cos + j*sin) will be stored
+  \param inVector The input vector of phases in radians
+  \param num_points Number of points for which the phasor is to be computed
+*/
+static inline void volk_32f_sincos_32fc_a_sse2(lv_32fc_t* outVector, const float* inVector, unsigned int num_points){
+  float* outPtr = (float*)outVector;
+  const float* inPtr = inVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+  const __m128 fourOverPi = _mm_set1_ps(1.27323954473516f);
+  const __m128 dp1 = _mm_set1_ps(-0.78515625f);
+  const __m128 dp2 = _mm_set1_ps(-2.4187564849853515625e-4f);
+  const __m128 dp3 = _mm_set1_ps(-3.77489497744594108e-8f);
+  const __m128 sp0 = _mm_set1_ps(-1.9515295891e-4f);
+  const __m128 sp1 = _mm_set1_ps(8.3321608736e-3f);
+  const __m128 sp2 = _mm_set1_ps(-1.6666654611e-1f);
+  const __m128 cp0 = _mm_set1_ps(2.443315711809948e-5f);
+  const __m128 cp1 = _mm_set1_ps(-1.388731625493765e-3f);
+  const __m128 cp2 = _mm_set1_ps(4.166664568298827e-2f);
+  const __m128 fhalf = _mm_set1_ps(0.5f);
+  const __m128 fones = _mm_set1_ps(1.0f);
+  const __m128i ones = _mm_set1_epi32(1);
+  const __m128i twos = _mm_set1_epi32(2);
+  const __m128i fours = _mm_set1_epi32(4);
+  const __m128i notOnes = _mm_set1_epi32(~1);
+
+  __m128 x, y, z, signSin, signCos, polyMask, ySin, yCos, sine, cosine;
+  __m128i j, jCos;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_load_ps(inPtr);
+
+    // Work on |x| and remember the sign for the sine
+    signSin = _mm_and_ps(x, signMask);
+    x = _mm_andnot_ps(signMask, x);
+
+    // Octant index, rounded up to an even value
+    j = _mm_cvttps_epi32(_mm_mul_ps(x, fourOverPi));
+    j = _mm_and_si128(_mm_add_epi32(j, ones), notOnes);
+    y = _mm_cvtepi32_ps(j);
+
+    // Extended precision modular arithmetic: x = |x| - j*pi/4
+    x = _mm_add_ps(x, _mm_mul_ps(y, dp1));
+    x = _mm_add_ps(x, _mm_mul_ps(y, dp2));
+    x = _mm_add_ps(x, _mm_mul_ps(y, dp3));
+
+    // Quadrant dependent sign flips and polynomial selection
+    signSin = _mm_xor_ps(signSin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, fours), 29)));
+    jCos = _mm_andnot_si128(_mm_sub_epi32(j, twos), fours);
+    signCos = _mm_castsi128_ps(_mm_slli_epi32(jCos, 29));
+    polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, twos), _mm_setzero_si128()));
+
+    // Minimax polynomials on [-pi/4, pi/4]
+    z = _mm_mul_ps(x, x);
+    yCos = _mm_add_ps(_mm_mul_ps(cp0, z), cp1);
+    yCos = _mm_add_ps(_mm_mul_ps(yCos, z), cp2);
+    yCos = _mm_mul_ps(_mm_mul_ps(yCos, z), z);
+    yCos = _mm_add_ps(_mm_sub_ps(yCos, _mm_mul_ps(z, fhalf)), fones);
+
+    ySin = _mm_add_ps(_mm_mul_ps(sp0, z), sp1);
+    ySin = _mm_add_ps(_mm_mul_ps(ySin, z), sp2);
+    ySin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ySin, z), x), x);
+
+    sine = _mm_or_ps(_mm_and_ps(polyMask, ySin), _mm_andnot_ps(polyMask, yCos));
+    cosine = _mm_or_ps(_mm_and_ps(polyMask, yCos), _mm_andnot_ps(polyMask, ySin));
+    sine = _mm_xor_ps(sine, signSin);
+    cosine = _mm_xor_ps(cosine, signCos);
+
+    _mm_store_ps(outPtr, _mm_unpacklo_ps(cosine, sine));
+    _mm_store_ps(outPtr + 4, _mm_unpackhi_ps(cosine, sine));
+
+    inPtr += 4;
+    outPtr += 8;
+  }
+
+  number = quarterPoints * 4;
+  for(;number < num_points; number++){
+    *outPtr++ = cosf(*inPtr);
+    *outPtr++ = sinf(*inPtr++);
+  }
+}
+#endif /* LV_HAVE_SSE2 for aligned */
+
+#endif /* INCLUDED_volk_32f_sincos_32fc_a_H */
+
+#ifndef INCLUDED_volk_32f_sincos_32fc_u_H
+#define INCLUDED_volk_32f_sincos_32fc_u_H
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+/*!
+  \brief Computes the unit phasor exp(j*phase) of each input phase
+  \param outVector The vector where the complex results (cos + j*sin) will be stored
+  \param inVector The input vector of phases in radians
+  \param num_points Number of points for which the phasor is to be computed
+*/
+static inline void volk_32f_sincos_32fc_u_sse2(lv_32fc_t* outVector, const float* inVector, unsigned int num_points){
+  float* outPtr = (float*)outVector;
+  const float* inPtr = inVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+  const __m128 fourOverPi = _mm_set1_ps(1.27323954473516f);
+  const __m128 dp1 = _mm_set1_ps(-0.78515625f);
+  const __m128 dp2 = _mm_set1_ps(-2.4187564849853515625e-4f);
+  const __m128 dp3 = _mm_set1_ps(-3.77489497744594108e-8f);
+  const __m128 sp0 = _mm_set1_ps(-1.9515295891e-4f);
+  const __m128 sp1 = _mm_set1_ps(8.3321608736e-3f);
+  const __m128 sp2 = _mm_set1_ps(-1.6666654611e-1f);
+  const __m128 cp0 = _mm_set1_ps(2.443315711809948e-5f);
+  const __m128 cp1 = _mm_set1_ps(-1.388731625493765e-3f);
+  const __m128 cp2 = _mm_set1_ps(4.166664568298827e-2f);
+  const __m128 fhalf = _mm_set1_ps(0.5f);
+  const __m128 fones = _mm_set1_ps(1.0f);
+  const __m128i ones = _mm_set1_epi32(1);
+  const __m128i twos = _mm_set1_epi32(2);
+  const __m128i fours = _mm_set1_epi32(4);
+  const __m128i notOnes = _mm_set1_epi32(~1);
+
+  __m128 x, y, z, signSin, signCos, polyMask, ySin, yCos, sine, cosine;
+  __m128i j, jCos;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_loadu_ps(inPtr);
+
+    // Work on |x| and remember the sign for the sine
+    signSin = _mm_and_ps(x, signMask);
+    x = _mm_andnot_ps(signMask, x);
+
+    // Octant index, rounded up to an even value
+    j = _mm_cvttps_epi32(_mm_mul_ps(x, fourOverPi));
+    j = _mm_and_si128(_mm_add_epi32(j, ones), notOnes);
+    y = _mm_cvtepi32_ps(j);
+
+    // Extended precision modular arithmetic: x = |x| - j*pi/4
+    x = _mm_add_ps(x, _mm_mul_ps(y, dp1));
+    x = _mm_add_ps(x, _mm_mul_ps(y, dp2));
+    x = _mm_add_ps(x, _mm_mul_ps(y, dp3));
+
+    // Quadrant dependent sign flips and polynomial selection
+    signSin = _mm_xor_ps(signSin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, fours), 29)));
+    jCos = _mm_andnot_si128(_mm_sub_epi32(j, twos), fours);
+    signCos = _mm_castsi128_ps(_mm_slli_epi32(jCos, 29));
+    polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, twos), _mm_setzero_si128()));
+
+    // Minimax polynomials on [-pi/4, pi/4]
+    z = _mm_mul_ps(x, x);
+    yCos = _mm_add_ps(_mm_mul_ps(cp0, z), cp1);
+    yCos = _mm_add_ps(_mm_mul_ps(yCos, z), cp2);
+    yCos = _mm_mul_ps(_mm_mul_ps(yCos, z), z);
+    yCos = _mm_add_ps(_mm_sub_ps(yCos, _mm_mul_ps(z, fhalf)), fones);
+
+    ySin = _mm_add_ps(_mm_mul_ps(sp0, z), sp1);
+    ySin = _mm_add_ps(_mm_mul_ps(ySin, z), sp2);
+    ySin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ySin, z), x), x);
+
+    sine = _mm_or_ps(_mm_and_ps(polyMask, ySin), _mm_andnot_ps(polyMask, yCos));
+    cosine = _mm_or_ps(_mm_and_ps(polyMask, yCos), _mm_andnot_ps(polyMask, ySin));
+    sine = _mm_xor_ps(sine, signSin);
+    cosine = _mm_xor_ps(cosine, signCos);
+
+    _mm_storeu_ps(outPtr, _mm_unpacklo_ps(cosine, sine));
+    _mm_storeu_ps(outPtr + 4, _mm_unpackhi_ps(cosine, sine));
+
+    inPtr += 4;
+    outPtr += 8;
+  }
+
+  number = quarterPoints * 4;
+  for(;number < num_points; number++){
+    *outPtr++ = cosf(*inPtr);
+    *outPtr++ = sinf(*inPtr++);
+  }
+}
+#endif /* LV_HAVE_SSE2 for unaligned */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Computes the unit phasor exp(j*phase) of each input phase
+  \param outVector The vector where the complex results (cos + j*sin) will be stored
+  \param inVector The input vector of phases in radians
+  \param num_points Number of points for which the phasor is to be computed
+*/
+static inline void volk_32f_sincos_32fc_generic(lv_32fc_t* outVector, const float* inVector, unsigned int num_points){
+  float* outPtr = (float*)outVector;
+  const float* inPtr = inVector;
+  unsigned int number = 0;
+
+  for(number = 0; number < num_points; number++){
+    *outPtr++ = cosf(*inPtr);
+    *outPtr++ = sinf(*inPtr++);
+  }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32f_sincos_32fc_u_H */
@@ -0,0 +1,152 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_32f_x2_s32f_chebyshev_32f_a_H
+#define INCLUDED_volk_32f_x2_s32f_chebyshev_32f_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+
+/*
+ * Clenshaw recurrence for sum(c[k] * T_k(x)), shared by the generic
+ * kernel and the SIMD tails.
+ */
+static inline void volk_32f_x2_s32f_chebyshev_32f_block(float* outPtr, const float* inPtr, const float* coeffs, const int n, unsigned int num_points){
+  unsigned int number;
+  int k;
+  for(number = 0; number < num_points; number++){
+    const float x = *inPtr++;
+    const float x2 = x + x;
+    float b1 = 0.0f, b2 = 0.0f, b0;
+    for(k = n; k >= 1; k--){
+      b0 = coeffs[k] + x2 * b1 - b2;
+      b2 = b1;
+      b1 = b0;
+    }
+    *outPtr++ = coeffs[0] + x * b1 - b2;
+  }
+}
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Evaluates a Chebyshev series at every point of the input vector
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector of evaluation points, mapped to [-1, 1]
+  \param coeffs The Chebyshev series coefficients c[0]..c[order]
+  \param order The order of the series
+  \param num_points The number of points to evaluate
+*/
+static inline void volk_32f_x2_s32f_chebyshev_32f_a_sse(float* outputVector, const float* inputVector, const float* coeffs, const float order, unsigned int num_points){
+  float* outPtr = outputVector;
+  const float* inPtr = inputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  const int n = (int)order;
+  int k;
+  __m128 x, x2, y, b0, b1, b2;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_load_ps(inPtr);
+    x2 = _mm_add_ps(x, x);
+    b1 = _mm_setzero_ps();
+    b2 = _mm_setzero_ps();
+    for(k = n; k >= 1; k--){
+      b0 = _mm_sub_ps(_mm_add_ps(_mm_set_ps1(coeffs[k]), _mm_mul_ps(x2, b1)), b2);
+      b2 = b1;
+      b1 = b0;
+    }
+    y = _mm_sub_ps(_mm_add_ps(_mm_set_ps1(coeffs[0]), _mm_mul_ps(x, b1)), b2);
+    _mm_store_ps(outPtr, y);
+    inPtr += 4;
+    outPtr += 4;
+  }
+
+  number = quarterPoints * 4;
+  volk_32f_x2_s32f_chebyshev_32f_block(outPtr, inPtr, coeffs, n, num_points - number);
+}
+#endif /* LV_HAVE_SSE for aligned */
+
+#endif /* INCLUDED_volk_32f_x2_s32f_chebyshev_32f_a_H */
+
+#ifndef INCLUDED_volk_32f_x2_s32f_chebyshev_32f_u_H
+#define INCLUDED_volk_32f_x2_s32f_chebyshev_32f_u_H
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Evaluates a Chebyshev series at every point of the input vector
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector of evaluation points, mapped to [-1, 1]
+  \param coeffs The Chebyshev series coefficients c[0]..c[order]
+  \param order The order of the series
+  \param num_points The number of points to evaluate
+*/
+static inline void volk_32f_x2_s32f_chebyshev_32f_u_sse(float* outputVector, const float* inputVector, const float* coeffs, const float order, unsigned int num_points){
+  float* outPtr = outputVector;
+  const float* inPtr = inputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  const int n = (int)order;
+  int k;
+  __m128 x, x2, y, b0, b1, b2;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_loadu_ps(inPtr);
+    x2 = _mm_add_ps(x, x);
+    b1 = _mm_setzero_ps();
+    b2 = _mm_setzero_ps();
+    for(k = n; k >= 1; k--){
+      b0 = _mm_sub_ps(_mm_add_ps(_mm_set_ps1(coeffs[k]), _mm_mul_ps(x2, b1)), b2);
+      b2 = b1;
+      b1 = b0;
+    }
+    y = _mm_sub_ps(_mm_add_ps(_mm_set_ps1(coeffs[0]), _mm_mul_ps(x, b1)), b2);
+    _mm_storeu_ps(outPtr, y);
+    inPtr += 4;
+    outPtr += 4;
+  }
+
+  number = quarterPoints * 4;
+  volk_32f_x2_s32f_chebyshev_32f_block(outPtr, inPtr, coeffs, n, num_points - number);
+}
+#endif /* LV_HAVE_SSE for unaligned */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Evaluates a Chebyshev series at every point of the input vector
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector of evaluation points, mapped to [-1, 1]
+  \param coeffs The Chebyshev series coefficients c[0]..c[order]
+  \param order The order of the series
+  \param num_points The number of points to evaluate
+*/
+static inline void volk_32f_x2_s32f_chebyshev_32f_generic(float* outputVector, const float* inputVector, const float* coeffs, const float order, unsigned int num_points){
+  const int n = (int)order;
+  volk_32f_x2_s32f_chebyshev_32f_block(outputVector, inputVector, coeffs, n, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32f_x2_s32f_chebyshev_32f_u_H */
@@ -0,0 +1,179 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_32f_x2_s32f_lut_interp_32f_a_H
+#define INCLUDED_volk_32f_x2_s32f_lut_interp_32f_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+
+/*
+ * Scalar lookup shared by the generic kernel and the SIMD tails. Inputs
+ * outside [0, 1] are clamped to the ends of the table, and NaN maps to
+ * table[0] like it does in the SSE max/min clamp. The index is clamped
+ * again after the conversion so that no input can read outside the table.
+ */
+static inline void volk_32f_x2_s32f_lut_interp_32f_block(float* outPtr, const float* inPtr, const float* table, const float tableLength, unsigned int num_points){
+  const float maxPos = tableLength - 1.0f;
+  const int maxIndex = (int)tableLength - 2;
+  unsigned int number;
+  for(number = 0; number < num_points; number++){
+    float pos = *inPtr++ * maxPos;
+    int index;
+    pos = pos > 0.0f ? pos : 0.0f;
+    pos = pos < maxPos ? pos : maxPos;
+    index = (int)pos;
+    index = index < 0 ? 0 : (index > maxIndex ? maxIndex : index);
+    pos -= (float)index;
+    *outPtr++ = table[index] + pos * (table[index + 1] - table[index]);
+  }
+}
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+/*!
+  \brief Looks up every input in a table with linear interpolation
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector; 0 maps to table[0] and 1 to table[tableLength - 1]
+  \param table The lookup table
+  \param tableLength The number of entries in the table (at least 2)
+  \param num_points The number of points to look up
+*/
+static inline void volk_32f_x2_s32f_lut_interp_32f_a_sse2(float* outputVector, const float* inputVector, const float* table, const float tableLength, unsigned int num_points){
+  float* outPtr = outputVector;
+  const float* inPtr = inputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 maxPos = _mm_set_ps1(tableLength - 1.0f);
+  const __m128i maxIndex = _mm_set1_epi32((int)tableLength - 2);
+  const __m128i izeros = _mm_setzero_si128();
+  __m128 x, y, frac, lo, hi;
+  __m128i index, over;
+  __VOLK_ATTR_ALIGNED(16) int idx[4];
+  __VOLK_ATTR_ALIGNED(16) float t0[4];
+  __VOLK_ATTR_ALIGNED(16) float t1[4];
+  int k;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_load_ps(inPtr);
+    x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(x, maxPos), zeros), maxPos);
+    index = _mm_cvttps_epi32(x);
+    index = _mm_andnot_si128(_mm_cmpgt_epi32(izeros, index), index);
+    over = _mm_cmpgt_epi32(index, maxIndex);
+    index = _mm_or_si128(_mm_and_si128(over, maxIndex), _mm_andnot_si128(over, index));
+    frac = _mm_sub_ps(x, _mm_cvtepi32_ps(index));
+    _mm_store_si128((__m128i*)idx, index);
+    // SSE has no gather; fetch both neighbours per lane
+    for(k = 0; k < 4; k++){
+      t0[k] = table[idx[k]];
+      t1[k] = table[idx[k] + 1];
+    }
+    lo = _mm_load_ps(t0);
+    hi = _mm_load_ps(t1);
+    y = _mm_add_ps(lo, _mm_mul_ps(frac, _mm_sub_ps(hi, lo)));
+    _mm_store_ps(outPtr, y);
+    inPtr += 4;
+    outPtr += 4;
+  }
+
+  number = quarterPoints * 4;
+  volk_32f_x2_s32f_lut_interp_32f_block(outPtr, inPtr, table, tableLength, num_points - number);
+}
+#endif /* LV_HAVE_SSE2 for aligned */
+
+#endif /* INCLUDED_volk_32f_x2_s32f_lut_interp_32f_a_H */
+
+#ifndef INCLUDED_volk_32f_x2_s32f_lut_interp_32f_u_H
+#define INCLUDED_volk_32f_x2_s32f_lut_interp_32f_u_H
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+/*!
+  \brief Looks up every input in a table with linear interpolation
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector; 0 maps to table[0] and 1 to table[tableLength - 1]
+  \param table The lookup table
+  \param tableLength The number of entries in the table (at least 2)
+  \param num_points The number of points to look up
+*/
+static inline void volk_32f_x2_s32f_lut_interp_32f_u_sse2(float* outputVector, const float* inputVector, const float* table, const float tableLength, unsigned int num_points){
+  float* outPtr = outputVector;
+  const float* inPtr = inputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 maxPos = _mm_set_ps1(tableLength - 1.0f);
+  const __m128i maxIndex = _mm_set1_epi32((int)tableLength - 2);
+  const __m128i izeros = _mm_setzero_si128();
+  __m128 x, y, frac, lo, hi;
+  __m128i index, over;
+  __VOLK_ATTR_ALIGNED(16) int idx[4];
+  __VOLK_ATTR_ALIGNED(16) float t0[4];
+  __VOLK_ATTR_ALIGNED(16) float t1[4];
+  int k;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_loadu_ps(inPtr);
+    x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(x, maxPos), zeros), maxPos);
+    index = _mm_cvttps_epi32(x);
+    index = _mm_andnot_si128(_mm_cmpgt_epi32(izeros, index), index);
+    over = _mm_cmpgt_epi32(index, maxIndex);
+    index = _mm_or_si128(_mm_and_si128(over, maxIndex), _mm_andnot_si128(over, index));
+    frac = _mm_sub_ps(x, _mm_cvtepi32_ps(index));
+    _mm_store_si128((__m128i*)idx, index);
+    // SSE has no gather; fetch both neighbours per lane
+    for(k = 0; k < 4; k++){
+      t0[k] = table[idx[k]];
+      t1[k] = table[idx[k] + 1];
+    }
+    lo = _mm_load_ps(t0);
+    hi = _mm_load_ps(t1);
+    y = _mm_add_ps(lo, _mm_mul_ps(frac, _mm_sub_ps(hi, lo)));
+    _mm_storeu_ps(outPtr, y);
+    inPtr += 4;
+    outPtr += 4;
+  }
+
+  number = quarterPoints * 4;
+  volk_32f_x2_s32f_lut_interp_32f_block(outPtr, inPtr, table, tableLength, num_points - number);
+}
+#endif /* LV_HAVE_SSE2 for unaligned */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Looks up every input in a table with linear interpolation
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector; 0 maps to table[0] and 1 to table[tableLength - 1]
+  \param table The lookup table
+  \param tableLength The number of entries in the table (at least 2)
+  \param num_points The number of points to look up
+*/
+static inline void volk_32f_x2_s32f_lut_interp_32f_generic(float* outputVector, const float* inputVector, const float* table, const float tableLength, unsigned int num_points){
+  volk_32f_x2_s32f_lut_interp_32f_block(outputVector, inputVector, table, tableLength, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32f_x2_s32f_lut_interp_32f_u_H */
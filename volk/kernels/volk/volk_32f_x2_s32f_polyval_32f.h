@@ -0,0 +1,139 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_32f_x2_s32f_polyval_32f_a_H
+#define INCLUDED_volk_32f_x2_s32f_polyval_32f_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+
+/*
+ * Horner evaluation shared by the generic kernel and the SIMD tails, so
+ * that every proto-kernel performs the same sequence of operations.
+ */
+static inline void volk_32f_x2_s32f_polyval_32f_block(float* outPtr, const float* inPtr, const float* coeffs, const int n, unsigned int num_points){
+  unsigned int number;
+  int k;
+  for(number = 0; number < num_points; number++){
+    const float x = *inPtr++;
+    float y = coeffs[n];
+    for(k = n - 1; k >= 0; k--){
+      y = y * x + coeffs[k];
+    }
+    *outPtr++ = y;
+  }
+}
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Evaluates a polynomial at every point of the input vector
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector of evaluation points
+  \param coeffs The polynomial coefficients, lowest order first (order + 1 values)
+  \param order The order of the polynomial
+  \param num_points The number of points to evaluate
+*/
+static inline void volk_32f_x2_s32f_polyval_32f_a_sse(float* outputVector, const float* inputVector, const float* coeffs, const float order, unsigned int num_points){
+  float* outPtr = outputVector;
+  const float* inPtr = inputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  const int n = (int)order;
+  int k;
+  __m128 x, y;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_load_ps(inPtr);
+    y = _mm_set_ps1(coeffs[n]);
+    for(k = n - 1; k >= 0; k--){
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set_ps1(coeffs[k]));
+    }
+    _mm_store_ps(outPtr, y);
+    inPtr += 4;
+    outPtr += 4;
+  }
+
+  number = quarterPoints * 4;
+  volk_32f_x2_s32f_polyval_32f_block(outPtr, inPtr, coeffs, n, num_points - number);
+}
+#endif /* LV_HAVE_SSE for aligned */
+
+#endif /* INCLUDED_volk_32f_x2_s32f_polyval_32f_a_H */
+
+#ifndef INCLUDED_volk_32f_x2_s32f_polyval_32f_u_H
+#define INCLUDED_volk_32f_x2_s32f_polyval_32f_u_H
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Evaluates a polynomial at every point of the input vector
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector of evaluation points
+  \param coeffs The polynomial coefficients, lowest order first (order + 1 values)
+  \param order The order of the polynomial
+  \param num_points The number of points to evaluate
+*/
+static inline void volk_32f_x2_s32f_polyval_32f_u_sse(float* outputVector, const float* inputVector, const float* coeffs, const float order, unsigned int num_points){
+  float* outPtr = outputVector;
+  const float* inPtr = inputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  const int n = (int)order;
+  int k;
+  __m128 x, y;
+
+  for(;number < quarterPoints; number++){
+    x = _mm_loadu_ps(inPtr);
+    y = _mm_set_ps1(coeffs[n]);
+    for(k = n - 1; k >= 0; k--){
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set_ps1(coeffs[k]));
+    }
+    _mm_storeu_ps(outPtr, y);
+    inPtr += 4;
+    outPtr += 4;
+  }
+
+  number = quarterPoints * 4;
+  volk_32f_x2_s32f_polyval_32f_block(outPtr, inPtr, coeffs, n, num_points - number);
+}
+#endif /* LV_HAVE_SSE for unaligned */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Evaluates a polynomial at every point of the input vector
+  \param outputVector The vector where the results will be stored
+  \param inputVector The input vector of evaluation points
+  \param coeffs The polynomial coefficients, lowest order first (order + 1 values)
+  \param order The order of the polynomial
+  \param num_points The number of points to evaluate
+*/
+static inline void volk_32f_x2_s32f_polyval_32f_generic(float* outputVector, const float* inputVector, const float* coeffs, const float order, unsigned int num_points){
+  const int n = (int)order;
+  volk_32f_x2_s32f_polyval_32f_block(outputVector, inputVector, coeffs, n, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32f_x2_s32f_polyval_32f_u_H */
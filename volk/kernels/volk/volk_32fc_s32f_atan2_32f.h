@@ -78,6 +78,59 @@ static inline void volk_32fc_s32f_atan2_32f_a_sse4_1(float* outputVector,  const
     outPtr += 4;
   }
   number = quarterPoints * 4;
+#else
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 signMask = _mm_set_ps1(-0.0f);
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 piOver2 = _mm_set_ps1(1.5707963267948966f);
+  const __m128 pi = _mm_set_ps1(3.1415926535897932f);
+  const __m128 ones = _mm_set_ps1(1.0f);
+  const __m128 piOver4 = _mm_set_ps1(0.78539816339744831f);
+  const __m128 tanPiOver8 = _mm_set_ps1(0.4142135623730950f);
+  const __m128 p0 = _mm_set_ps1(8.05374449538e-2f);
+  const __m128 p1 = _mm_set_ps1(-1.38776856032e-1f);
+  const __m128 p2 = _mm_set_ps1(1.99777106478e-1f);
+  const __m128 p3 = _mm_set_ps1(-3.33329491539e-1f);
+  const __m128 vNormalizeFactor = _mm_set_ps1(invNormalizeFactor);
+  __m128 complex1, complex2, iValue, qValue, absI, absQ, maxV, minV;
+  __m128 ratio, z, phase, mask, offset;
+
+  for (; number < quarterPoints; number++) {
+    // Load IQ data:
+    complex1 = _mm_load_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    complex2 = _mm_load_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    // Deinterleave IQ data:
+    iValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+    // Reduce to a ratio in [0, 1]; 0/0 gives 0:
+    absI = _mm_andnot_ps(signMask, iValue);
+    absQ = _mm_andnot_ps(signMask, qValue);
+    maxV = _mm_max_ps(absI, absQ);
+    minV = _mm_min_ps(absI, absQ);
+    ratio = _mm_and_ps(_mm_div_ps(minV, maxV), _mm_cmpneq_ps(maxV, zeros));
+    // Above tan(pi/8) use atan(r) = pi/4 + atan((r-1)/(r+1)):
+    mask = _mm_cmpgt_ps(ratio, tanPiOver8);
+    ratio = _mm_blendv_ps(ratio, _mm_div_ps(_mm_sub_ps(ratio, ones), _mm_add_ps(ratio, ones)), mask);
+    offset = _mm_and_ps(mask, piOver4);
+    z = _mm_mul_ps(ratio, ratio);
+    phase = _mm_add_ps(_mm_mul_ps(p0, z), p1);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), p2);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), p3);
+    phase = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(phase, z), ratio), ratio);
+    phase = _mm_add_ps(phase, offset);
+    // Map back to the full circle:
+    mask = _mm_cmpgt_ps(absQ, absI);
+    phase = _mm_blendv_ps(phase, _mm_sub_ps(piOver2, phase), mask);
+    mask = _mm_cmplt_ps(iValue, zeros);
+    phase = _mm_blendv_ps(phase, _mm_sub_ps(pi, phase), mask);
+    phase = _mm_or_ps(phase, _mm_and_ps(qValue, signMask));
+    phase = _mm_mul_ps(phase, vNormalizeFactor);
+    _mm_store_ps((float*)outPtr, phase);
+    outPtr += 4;
+  }
+  number = quarterPoints * 4;
 #endif /* LV_HAVE_SIMDMATH_H */
 
   for (; number < num_points; number++) {
@@ -143,6 +196,59 @@ static inline void volk_32fc_s32f_atan2_32f_a_sse(float* outputVector,  const lv
     outPtr += 4;
   }
   number = quarterPoints * 4;
+#else
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 signMask = _mm_set_ps1(-0.0f);
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 piOver2 = _mm_set_ps1(1.5707963267948966f);
+  const __m128 pi = _mm_set_ps1(3.1415926535897932f);
+  const __m128 ones = _mm_set_ps1(1.0f);
+  const __m128 piOver4 = _mm_set_ps1(0.78539816339744831f);
+  const __m128 tanPiOver8 = _mm_set_ps1(0.4142135623730950f);
+  const __m128 p0 = _mm_set_ps1(8.05374449538e-2f);
+  const __m128 p1 = _mm_set_ps1(-1.38776856032e-1f);
+  const __m128 p2 = _mm_set_ps1(1.99777106478e-1f);
+  const __m128 p3 = _mm_set_ps1(-3.33329491539e-1f);
+  const __m128 vNormalizeFactor = _mm_set_ps1(invNormalizeFactor);
+  __m128 complex1, complex2, iValue, qValue, absI, absQ, maxV, minV;
+  __m128 ratio, z, phase, mask, offset;
+
+  for (; number < quarterPoints; number++) {
+    // Load IQ data:
+    complex1 = _mm_load_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    complex2 = _mm_load_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    // Deinterleave IQ data:
+    iValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+    // Reduce to a ratio in [0, 1]; 0/0 gives 0:
+    absI = _mm_andnot_ps(signMask, iValue);
+    absQ = _mm_andnot_ps(signMask, qValue);
+    maxV = _mm_max_ps(absI, absQ);
+    minV = _mm_min_ps(absI, absQ);
+    ratio = _mm_and_ps(_mm_div_ps(minV, maxV), _mm_cmpneq_ps(maxV, zeros));
+    // Above tan(pi/8) use atan(r) = pi/4 + atan((r-1)/(r+1)):
+    mask = _mm_cmpgt_ps(ratio, tanPiOver8);
+    ratio = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(_mm_sub_ps(ratio, ones), _mm_add_ps(ratio, ones))), _mm_andnot_ps(mask, ratio));
+    offset = _mm_and_ps(mask, piOver4);
+    z = _mm_mul_ps(ratio, ratio);
+    phase = _mm_add_ps(_mm_mul_ps(p0, z), p1);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), p2);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), p3);
+    phase = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(phase, z), ratio), ratio);
+    phase = _mm_add_ps(phase, offset);
+    // Map back to the full circle:
+    mask = _mm_cmpgt_ps(absQ, absI);
+    phase = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(piOver2, phase)), _mm_andnot_ps(mask, phase));
+    mask = _mm_cmplt_ps(iValue, zeros);
+    phase = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(pi, phase)), _mm_andnot_ps(mask, phase));
+    phase = _mm_or_ps(phase, _mm_and_ps(qValue, signMask));
+    phase = _mm_mul_ps(phase, vNormalizeFactor);
+    _mm_store_ps((float*)outPtr, phase);
+    outPtr += 4;
+  }
+  number = quarterPoints * 4;
 #endif /* LV_HAVE_SIMDMATH_H */
 
   for (; number < num_points; number++) {
@@ -153,6 +259,92 @@ static inline void volk_32fc_s32f_atan2_32f_a_sse(float* outputVector,  const lv
 }
 #endif /* LV_HAVE_SSE */
 
+#endif /* INCLUDED_volk_32fc_s32f_atan2_32f_a_H */
+
+#ifndef INCLUDED_volk_32fc_s32f_atan2_32f_u_H
+#define INCLUDED_volk_32fc_s32f_atan2_32f_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+/*!
+  \brief performs the atan2 on the input vector and stores the results in the output vector.
+  \param outputVector The vector where the results will be stored.
+  \param inputVector The input vector containing interleaved IQ data (I = cos, Q = sin).
+  \param normalizeFactor The atan2 results will be divided by this normalization factor.
+  \param num_points The number of complex values in the input vector.
+*/
+static inline void volk_32fc_s32f_atan2_32f_u_sse4_1(float* outputVector,  const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points){
+  const float* complexVectorPtr = (float*)complexVector;
+  float* outPtr = outputVector;
+
+  unsigned int number = 0;
+  const float invNormalizeFactor = 1.0 / normalizeFactor;
+
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 signMask = _mm_set_ps1(-0.0f);
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 piOver2 = _mm_set_ps1(1.5707963267948966f);
+  const __m128 pi = _mm_set_ps1(3.1415926535897932f);
+  const __m128 ones = _mm_set_ps1(1.0f);
+  const __m128 piOver4 = _mm_set_ps1(0.78539816339744831f);
+  const __m128 tanPiOver8 = _mm_set_ps1(0.4142135623730950f);
+  const __m128 p0 = _mm_set_ps1(8.05374449538e-2f);
+  const __m128 p1 = _mm_set_ps1(-1.38776856032e-1f);
+  const __m128 p2 = _mm_set_ps1(1.99777106478e-1f);
+  const __m128 p3 = _mm_set_ps1(-3.33329491539e-1f);
+  const __m128 vNormalizeFactor = _mm_set_ps1(invNormalizeFactor);
+  __m128 complex1, complex2, iValue, qValue, absI, absQ, maxV, minV;
+  __m128 ratio, z, phase, mask, offset;
+
+  for (; number < quarterPoints; number++) {
+    // Load IQ data:
+    complex1 = _mm_loadu_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    complex2 = _mm_loadu_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    // Deinterleave IQ data:
+    iValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+    // Reduce to a ratio in [0, 1]; 0/0 gives 0:
+    absI = _mm_andnot_ps(signMask, iValue);
+    absQ = _mm_andnot_ps(signMask, qValue);
+    maxV = _mm_max_ps(absI, absQ);
+    minV = _mm_min_ps(absI, absQ);
+    ratio = _mm_and_ps(_mm_div_ps(minV, maxV), _mm_cmpneq_ps(maxV, zeros));
+    // Above tan(pi/8) use atan(r) = pi/4 + atan((r-1)/(r+1)):
+    mask = _mm_cmpgt_ps(ratio, tanPiOver8);
+    ratio = _mm_blendv_ps(ratio, _mm_div_ps(_mm_sub_ps(ratio, ones), _mm_add_ps(ratio, ones)), mask);
+    offset = _mm_and_ps(mask, piOver4);
+    z = _mm_mul_ps(ratio, ratio);
+    phase = _mm_add_ps(_mm_mul_ps(p0, z), p1);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), p2);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), p3);
+    phase = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(phase, z), ratio), ratio);
+    phase = _mm_add_ps(phase, offset);
+    // Map back to the full circle:
+    mask = _mm_cmpgt_ps(absQ, absI);
+    phase = _mm_blendv_ps(phase, _mm_sub_ps(piOver2, phase), mask);
+    mask = _mm_cmplt_ps(iValue, zeros);
+    phase = _mm_blendv_ps(phase, _mm_sub_ps(pi, phase), mask);
+    phase = _mm_or_ps(phase, _mm_and_ps(qValue, signMask));
+    phase = _mm_mul_ps(phase, vNormalizeFactor);
+    _mm_storeu_ps((float*)outPtr, phase);
+    outPtr += 4;
+  }
+  number = quarterPoints * 4;
+
+  for (; number < num_points; number++) {
+    const float real = *complexVectorPtr++;
+    const float imag = *complexVectorPtr++;
+    *outPtr++ = atan2f(imag, real) * invNormalizeFactor;
+  }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
 #ifdef LV_HAVE_GENERIC
 /*!
   \brief performs the atan2 on the input vector and stores the results in the output vector.
@@ -174,7 +366,4 @@ static inline void volk_32fc_s32f_atan2_32f_generic(float* outputVector, const l
 }
 #endif /* LV_HAVE_GENERIC */
 
-
-
-
-#endif /* INCLUDED_volk_32fc_s32f_atan2_32f_a_H */
+#endif /* INCLUDED_volk_32fc_s32f_atan2_32f_u_H */
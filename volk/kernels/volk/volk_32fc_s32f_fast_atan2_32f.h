@@ -0,0 +1,211 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_volk_32fc_s32f_fast_atan2_32f_a_H
+#define INCLUDED_volk_32fc_s32f_fast_atan2_32f_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+
+/*
+ * Scalar form of the approximation, shared by the generic kernel and
+ * the tails of the SIMD kernels so every arch returns the same values.
+ */
+static inline void volk_32fc_s32f_fast_atan2_32f_tail(float* outPtr, const float* inPtr, const float invNormalizeFactor, unsigned int num_points){
+  unsigned int number;
+  for(number = 0; number < num_points; number++){
+    const float real = *inPtr++;
+    const float imag = *inPtr++;
+    const float absI = fabsf(real);
+    const float absQ = fabsf(imag);
+    const float maxV = absI > absQ ? absI : absQ;
+    const float minV = absI > absQ ? absQ : absI;
+    const float ratio = maxV != 0.0f ? minV / maxV : 0.0f;
+    const float z = ratio * ratio;
+    float phase = ratio * (0.9998660f + z * (-0.3302995f + z * (0.1801410f + z * (-0.0851330f + z * 0.0208351f))));
+    if(absQ > absI) phase = 1.5707963267948966f - phase;
+    if(real < 0.0f) phase = 3.1415926535897932f - phase;
+    if(signbit(imag)) phase = -phase;
+    *outPtr++ = phase * invNormalizeFactor;
+  }
+}
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Computes an approximate atan2 of each complex input value.
+  The polynomial approximation has an absolute error below 1.2e-5 rad.
+  \param outputVector The vector where the results will be stored.
+  \param complexVector The input vector containing interleaved IQ data (I = cos, Q = sin).
+  \param normalizeFactor The atan2 results will be divided by this normalization factor.
+  \param num_points The number of complex values in the input vector.
+*/
+static inline void volk_32fc_s32f_fast_atan2_32f_a_sse(float* outputVector, const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points){
+  const float* complexVectorPtr = (float*)complexVector;
+  float* outPtr = outputVector;
+
+  unsigned int number = 0;
+  const float invNormalizeFactor = 1.0 / normalizeFactor;
+
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 signMask = _mm_set_ps1(-0.0f);
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 piOver2 = _mm_set_ps1(1.5707963267948966f);
+  const __m128 pi = _mm_set_ps1(3.1415926535897932f);
+  const __m128 c1 = _mm_set_ps1(0.9998660f);
+  const __m128 c3 = _mm_set_ps1(-0.3302995f);
+  const __m128 c5 = _mm_set_ps1(0.1801410f);
+  const __m128 c7 = _mm_set_ps1(-0.0851330f);
+  const __m128 c9 = _mm_set_ps1(0.0208351f);
+  const __m128 vNormalizeFactor = _mm_set_ps1(invNormalizeFactor);
+  __m128 complex1, complex2, iValue, qValue, absI, absQ, maxV, minV;
+  __m128 ratio, z, phase, mask;
+
+  for (; number < quarterPoints; number++) {
+    // Load IQ data:
+    complex1 = _mm_load_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    complex2 = _mm_load_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    // Deinterleave IQ data:
+    iValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+    // Reduce to a ratio in [0, 1]; 0/0 gives 0:
+    absI = _mm_andnot_ps(signMask, iValue);
+    absQ = _mm_andnot_ps(signMask, qValue);
+    maxV = _mm_max_ps(absI, absQ);
+    minV = _mm_min_ps(absI, absQ);
+    ratio = _mm_and_ps(_mm_div_ps(minV, maxV), _mm_cmpneq_ps(maxV, zeros));
+    // atan on [0, 1], |error| < 1.2e-5 rad:
+    z = _mm_mul_ps(ratio, ratio);
+    phase = _mm_add_ps(_mm_mul_ps(c9, z), c7);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), c5);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), c3);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), c1);
+    phase = _mm_mul_ps(phase, ratio);
+    // Map back to the full circle:
+    mask = _mm_cmpgt_ps(absQ, absI);
+    phase = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(piOver2, phase)), _mm_andnot_ps(mask, phase));
+    mask = _mm_cmplt_ps(iValue, zeros);
+    phase = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(pi, phase)), _mm_andnot_ps(mask, phase));
+    phase = _mm_or_ps(phase, _mm_and_ps(qValue, signMask));
+    phase = _mm_mul_ps(phase, vNormalizeFactor);
+    _mm_store_ps((float*)outPtr, phase);
+    outPtr += 4;
+  }
+  number = quarterPoints * 4;
+
+  volk_32fc_s32f_fast_atan2_32f_tail(outPtr, complexVectorPtr, invNormalizeFactor, num_points - number);
+}
+#endif /* LV_HAVE_SSE for aligned */
+
+#endif /* INCLUDED_volk_32fc_s32f_fast_atan2_32f_a_H */
+
+#ifndef INCLUDED_volk_32fc_s32f_fast_atan2_32f_u_H
+#define INCLUDED_volk_32fc_s32f_fast_atan2_32f_u_H
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Computes an approximate atan2 of each complex input value.
+  The polynomial approximation has an absolute error below 1.2e-5 rad.
+  \param outputVector The vector where the results will be stored.
+  \param complexVector The input vector containing interleaved IQ data (I = cos, Q = sin).
+  \param normalizeFactor The atan2 results will be divided by this normalization factor.
+  \param num_points The number of complex values in the input vector.
+*/
+static inline void volk_32fc_s32f_fast_atan2_32f_u_sse(float* outputVector, const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points){
+  const float* complexVectorPtr = (float*)complexVector;
+  float* outPtr = outputVector;
+
+  unsigned int number = 0;
+  const float invNormalizeFactor = 1.0 / normalizeFactor;
+
+  const unsigned int quarterPoints = num_points / 4;
+  const __m128 signMask = _mm_set_ps1(-0.0f);
+  const __m128 zeros = _mm_setzero_ps();
+  const __m128 piOver2 = _mm_set_ps1(1.5707963267948966f);
+  const __m128 pi = _mm_set_ps1(3.1415926535897932f);
+  const __m128 c1 = _mm_set_ps1(0.9998660f);
+  const __m128 c3 = _mm_set_ps1(-0.3302995f);
+  const __m128 c5 = _mm_set_ps1(0.1801410f);
+  const __m128 c7 = _mm_set_ps1(-0.0851330f);
+  const __m128 c9 = _mm_set_ps1(0.0208351f);
+  const __m128 vNormalizeFactor = _mm_set_ps1(invNormalizeFactor);
+  __m128 complex1, complex2, iValue, qValue, absI, absQ, maxV, minV;
+  __m128 ratio, z, phase, mask;
+
+  for (; number < quarterPoints; number++) {
+    // Load IQ data:
+    complex1 = _mm_loadu_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    complex2 = _mm_loadu_ps(complexVectorPtr);
+    complexVectorPtr += 4;
+    // Deinterleave IQ data:
+    iValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+    // Reduce to a ratio in [0, 1]; 0/0 gives 0:
+    absI = _mm_andnot_ps(signMask, iValue);
+    absQ = _mm_andnot_ps(signMask, qValue);
+    maxV = _mm_max_ps(absI, absQ);
+    minV = _mm_min_ps(absI, absQ);
+    ratio = _mm_and_ps(_mm_div_ps(minV, maxV), _mm_cmpneq_ps(maxV, zeros));
+    // atan on [0, 1], |error| < 1.2e-5 rad:
+    z = _mm_mul_ps(ratio, ratio);
+    phase = _mm_add_ps(_mm_mul_ps(c9, z), c7);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), c5);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), c3);
+    phase = _mm_add_ps(_mm_mul_ps(phase, z), c1);
+    phase = _mm_mul_ps(phase, ratio);
+    // Map back to the full circle:
+    mask = _mm_cmpgt_ps(absQ, absI);
+    phase = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(piOver2, phase)), _mm_andnot_ps(mask, phase));
+    mask = _mm_cmplt_ps(iValue, zeros);
+    phase = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(pi, phase)), _mm_andnot_ps(mask, phase));
+    phase = _mm_or_ps(phase, _mm_and_ps(qValue, signMask));
+    phase = _mm_mul_ps(phase, vNormalizeFactor);
+    _mm_storeu_ps((float*)outPtr, phase);
+    outPtr += 4;
+  }
+  number = quarterPoints * 4;
+
+  volk_32fc_s32f_fast_atan2_32f_tail(outPtr, complexVectorPtr, invNormalizeFactor, num_points - number);
+}
+#endif /* LV_HAVE_SSE for unaligned */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Computes an approximate atan2 of each complex input value.
+  The polynomial approximation has an absolute error below 1.2e-5 rad.
+  \param outputVector The vector where the results will be stored.
+  \param complexVector The input vector containing interleaved IQ data (I = cos, Q = sin).
+  \param normalizeFactor The atan2 results will be divided by this normalization factor.
+  \param num_points The number of complex values in the input vector.
+*/
+static inline void volk_32fc_s32f_fast_atan2_32f_generic(float* outputVector, const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points){
+  const float invNormalizeFactor = 1.0 / normalizeFactor;
+  volk_32fc_s32f_fast_atan2_32f_tail(outputVector, (const float*)complexVector, invNormalizeFactor, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32fc_s32f_fast_atan2_32f_u_H */
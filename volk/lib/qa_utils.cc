@@ -12,6 +12,7 @@
 #include <ctime>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <volk/volk.h>
 #include <volk/volk_cpu.h>
@@ -20,6 +21,9 @@
 #include <boost/typeof/typeof.hpp>
 #include <boost/type_traits.hpp>
 #include <stdio.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
 
 float uniform() {
   return 2.0 * ((float) rand() / RAND_MAX - 0.5);	// uniformly (-1, 1)
@@ -217,6 +221,59 @@ inline void run_cast_test3_s32fc(volk_fn_3arg_s32fc func, std::vector<void *> &b
     while(iter--) func(buffs[0], buffs[1], buffs[2], scalar, vlen, arch.c_str());
 }
 
+// Call manual_func with the argument list implied by the kernel
+// signature: nbuffs vector arguments plus any scalar inputs.
+static void run_volk_func(void (*manual_func)(),
+                          size_t nbuffs,
+                          const std::vector<volk_type_t> &inputsc,
+                          std::vector<void *> &buffs,
+                          lv_32fc_t scalar,
+                          unsigned int vlen,
+                          unsigned int iter,
+                          std::string arch) {
+    switch(nbuffs) {
+        case 1:
+            if(inputsc.size() == 0) {
+                run_cast_test1((volk_fn_1arg)(manual_func), buffs, vlen, iter, arch);
+            } else if(inputsc.size() == 1 && inputsc[0].is_float) {
+                if(inputsc[0].is_complex) {
+                    run_cast_test1_s32fc((volk_fn_1arg_s32fc)(manual_func), buffs, scalar, vlen, iter, arch);
+                } else {
+                    run_cast_test1_s32f((volk_fn_1arg_s32f)(manual_func), buffs, scalar.real(), vlen, iter, arch);
+                }
+            } else throw "unsupported 1 arg function >1 scalars";
+            break;
+        case 2:
+            if(inputsc.size() == 0) {
+                run_cast_test2((volk_fn_2arg)(manual_func), buffs, vlen, iter, arch);
+            } else if(inputsc.size() == 1 && inputsc[0].is_float) {
+                if(inputsc[0].is_complex) {
+                    run_cast_test2_s32fc((volk_fn_2arg_s32fc)(manual_func), buffs, scalar, vlen, iter, arch);
+                } else {
+                    run_cast_test2_s32f((volk_fn_2arg_s32f)(manual_func), buffs, scalar.real(), vlen, iter, arch);
+                }
+            } else throw "unsupported 2 arg function >1 scalars";
+            break;
+        case 3:
+            if(inputsc.size() == 0) {
+                run_cast_test3((volk_fn_3arg)(manual_func), buffs, vlen, iter, arch);
+            } else if(inputsc.size() == 1 && inputsc[0].is_float) {
+                if(inputsc[0].is_complex) {
+                    run_cast_test3_s32fc((volk_fn_3arg_s32fc)(manual_func), buffs, scalar, vlen, iter, arch);
+                } else {
+                    run_cast_test3_s32f((volk_fn_3arg_s32f)(manual_func), buffs, scalar.real(), vlen, iter, arch);
+                }
+            } else throw "unsupported 3 arg function >1 scalars";
+            break;
+        case 4:
+            run_cast_test4((volk_fn_4arg)(manual_func), buffs, vlen, iter, arch);
+            break;
+        default:
+            throw "no function handler for this signature";
+            break;
+    }
+}
+
 // This function is a nop that helps resolve GNU Radio bugs 582 and 583.
 // Without this the cast in run_volk_tests for tol_i = static_cast<int>(float tol)
 // won't happen on armhf (reported on cortex A9 and A15).
@@ -333,13 +390,17 @@ bool run_volk_tests(volk_func_desc_t desc,
                     std::vector<volk_test_results_t> *results,
                     std::string puppet_master_name,
                     bool benchmark_mode, 
-                    std::string kernel_regex
+                    std::string kernel_regex,
+                    volk_sweep_params_t *sweep
                    ) {
     boost::xpressive::sregex kernel_expression = boost::xpressive::sregex::compile(kernel_regex);
     if( !boost::xpressive::regex_search(name, kernel_expression) ) {
         // in this case we have a regex and are only looking to test one kernel
         return false;
     }
+    if(sweep && sweep->enabled) {
+        return run_volk_sweep(desc, manual_func, name, scalar, *sweep);
+    }
     if(results) {
         results->push_back(volk_test_results_t()); 
         results->back().name = name;
@@ -416,47 +477,7 @@ bool run_volk_tests(volk_func_desc_t desc,
     for(size_t i = 0; i < arch_list.size(); i++) {
         start = clock();
 
-        switch(both_sigs.size()) {
-            case 1:
-                if(inputsc.size() == 0) {
-                    run_cast_test1((volk_fn_1arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                } else if(inputsc.size() == 1 && inputsc[0].is_float) {
-                    if(inputsc[0].is_complex) {
-                        run_cast_test1_s32fc((volk_fn_1arg_s32fc)(manual_func), test_data[i], scalar, vlen, iter, arch_list[i]);
-                    } else {
-                        run_cast_test1_s32f((volk_fn_1arg_s32f)(manual_func), test_data[i], scalar.real(), vlen, iter, arch_list[i]);
-                    }
-                } else throw "unsupported 1 arg function >1 scalars";
-                break;
-            case 2:
-                if(inputsc.size() == 0) {
-                    run_cast_test2((volk_fn_2arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                } else if(inputsc.size() == 1 && inputsc[0].is_float) {
-                    if(inputsc[0].is_complex) {
-                        run_cast_test2_s32fc((volk_fn_2arg_s32fc)(manual_func), test_data[i], scalar, vlen, iter, arch_list[i]);
-                    } else {
-                        run_cast_test2_s32f((volk_fn_2arg_s32f)(manual_func), test_data[i], scalar.real(), vlen, iter, arch_list[i]);
-                    }
-                } else throw "unsupported 2 arg function >1 scalars";
-                break;
-            case 3:
-                if(inputsc.size() == 0) {
-                    run_cast_test3((volk_fn_3arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                } else if(inputsc.size() == 1 && inputsc[0].is_float) {
-                    if(inputsc[0].is_complex) {
-                        run_cast_test3_s32fc((volk_fn_3arg_s32fc)(manual_func), test_data[i], scalar, vlen, iter, arch_list[i]);
-                    } else {
-                        run_cast_test3_s32f((volk_fn_3arg_s32f)(manual_func), test_data[i], scalar.real(), vlen, iter, arch_list[i]);
-                    }
-                } else throw "unsupported 3 arg function >1 scalars";
-                break;
-            case 4:
-                run_cast_test4((volk_fn_4arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                break;
-            default:
-                throw "no function handler for this signature";
-                break;
-        }
+        run_volk_func(manual_func, both_sigs.size(), inputsc, test_data[i], scalar, vlen, iter, arch_list[i]);
 
         end = clock();
         double arch_time = 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
@@ -582,3 +603,208 @@ bool run_volk_tests(volk_func_desc_t desc,
 }
 
 
+
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0) && defined(CLOCK_MONOTONIC)
+static double sweep_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1e9 * double(ts.tv_sec) + double(ts.tv_nsec);
+}
+#else
+static double sweep_now_ns() {
+    return 1e9 * double(clock()) / double(CLOCKS_PER_SEC);
+}
+#endif
+
+// Linear-interpolated percentile of an already sorted vector.
+static double sweep_percentile(const std::vector<double> &sorted, double pct) {
+    if(sorted.empty()) return 0.0;
+    double pos = pct / 100.0 * double(sorted.size() - 1);
+    size_t lo = size_t(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double frac = pos - double(lo);
+    return sorted[lo] + frac * (sorted[hi] - sorted[lo]);
+}
+
+bool run_volk_sweep(volk_func_desc_t desc,
+                    void (*manual_func)(),
+                    std::string name,
+                    lv_32fc_t scalar,
+                    volk_sweep_params_t &sweep
+                   ) {
+    std::vector<std::string> arch_list = get_arch_list(desc);
+
+    std::vector<volk_type_t> inputsig, outputsig;
+    get_signatures_from_name(inputsig, outputsig, name);
+
+    std::vector<volk_type_t> inputsc;
+    for(size_t i=0; i<inputsig.size(); i++) {
+        if(inputsig[i].is_scalar) {
+            inputsc.push_back(inputsig[i]);
+            inputsig.erase(inputsig.begin() + i);
+            i -= 1;
+        }
+    }
+
+    std::vector<volk_type_t> both_sigs;
+    both_sigs.insert(both_sigs.end(), outputsig.begin(), outputsig.end());
+    both_sigs.insert(both_sigs.end(), inputsig.begin(), inputsig.end());
+
+    int max_len = 0, max_offset = 0;
+    BOOST_FOREACH(int len, sweep.lengths) max_len = std::max(max_len, len);
+    BOOST_FOREACH(int offset, sweep.offsets) max_offset = std::max(max_offset, offset);
+    const int buff_len = max_len + max_offset;
+
+    // One set of buffers big enough for the largest length and offset;
+    // every (length, offset) point uses a shifted view into it.
+    volk_qa_aligned_mem_pool mem_pool;
+    std::vector<void *> base_buffs;
+    for(size_t j=0; j<both_sigs.size(); j++) {
+        base_buffs.push_back(mem_pool.get_new(buff_len*both_sigs[j].size*(both_sigs[j].is_complex ? 2 : 1)));
+        load_random_data(base_buffs[j], both_sigs[j], buff_len);
+    }
+
+    std::cout << "RUN_VOLK_SWEEP: " << name << std::endl;
+
+    BOOST_FOREACH(int offset, sweep.offsets) {
+        std::vector<void *> buffs;
+        for(size_t j=0; j<both_sigs.size(); j++) {
+            size_t item_size = both_sigs[j].size*(both_sigs[j].is_complex ? 2 : 1);
+            buffs.push_back((char *)base_buffs[j] + offset*item_size);
+        }
+
+        BOOST_FOREACH(int vlen, sweep.lengths) {
+            for(size_t i=0; i<arch_list.size(); i++) {
+                // an aligned proto-kernel would fault on a shifted buffer
+                if(offset != 0 && desc.impl_alignment[i] != 0) continue;
+
+                // warmup, and use its timing to size the inner loop so
+                // each repetition is long enough to measure reliably.
+                const int warmup = std::max(sweep.warmup, 1);
+                double t0 = sweep_now_ns();
+                run_volk_func(manual_func, both_sigs.size(), inputsc, buffs, scalar, vlen, warmup, arch_list[i]);
+                double single = std::max((sweep_now_ns() - t0) / warmup, 1.0);
+                int inner = std::max(1, int(std::ceil(sweep.min_rep_time_ms * 1e6 / single)));
+
+                volk_sweep_result_t result;
+                result.name = name;
+                result.arch = arch_list[i];
+                result.vlen = vlen;
+                result.offset = offset;
+                result.reps = sweep.reps;
+                result.inner_iter = inner;
+                for(int r=0; r<sweep.reps; r++) {
+                    t0 = sweep_now_ns();
+                    run_volk_func(manual_func, both_sigs.size(), inputsc, buffs, scalar, vlen, inner, arch_list[i]);
+                    double elapsed = sweep_now_ns() - t0;
+                    result.samples.push_back(elapsed / (double(inner) * double(vlen)));
+                }
+
+                std::vector<double> sorted(result.samples);
+                std::sort(sorted.begin(), sorted.end());
+                result.median = sweep_percentile(sorted, 50.0);
+                result.p10 = sweep_percentile(sorted, 10.0);
+                result.p90 = sweep_percentile(sorted, 90.0);
+
+                double sum = 0.0, sqsum = 0.0;
+                BOOST_FOREACH(double v, sorted) { sum += v; sqsum += v*v; }
+                result.mean = sum / sorted.size();
+                double var = sorted.size() > 1 ?
+                    (sqsum - sum*sum/sorted.size()) / (sorted.size() - 1) : 0.0;
+                result.stddev = std::sqrt(std::max(var, 0.0));
+
+                std::cout << "  " << arch_list[i] << " vlen=" << vlen
+                          << " offset=" << offset << ": median " << result.median
+                          << " ns/item (p10 " << result.p10 << ", p90 "
+                          << result.p90 << ")" << std::endl;
+                sweep.results.push_back(result);
+            }
+        }
+    }
+
+    return false;
+}
+
+void write_sweep_csv(std::ostream &out, const std::vector<volk_sweep_result_t> &results) {
+    out << "kernel,arch,vlen,offset,reps,inner_iter,median_ns,p10_ns,p90_ns,mean_ns,stddev_ns,samples" << std::endl;
+    BOOST_FOREACH(const volk_sweep_result_t &r, results) {
+        out << r.name << "," << r.arch << "," << r.vlen << "," << r.offset << ","
+            << r.reps << "," << r.inner_iter << "," << r.median << "," << r.p10 << ","
+            << r.p90 << "," << r.mean << "," << r.stddev << ",";
+        for(size_t i=0; i<r.samples.size(); i++) {
+            if(i) out << ";";
+            out << r.samples[i];
+        }
+        out << std::endl;
+    }
+}
+
+void write_sweep_json(std::ostream &out, const std::vector<volk_sweep_result_t> &results) {
+    out << "{" << std::endl;
+    out << " \"volk_sweep\": [" << std::endl;
+    for(size_t i=0; i<results.size(); i++) {
+        const volk_sweep_result_t &r = results[i];
+        out << "  {" << std::endl;
+        out << "   \"name\": \"" << r.name << "\"," << std::endl;
+        out << "   \"arch\": \"" << r.arch << "\"," << std::endl;
+        out << "   \"vlen\": " << r.vlen << "," << std::endl;
+        out << "   \"offset\": " << r.offset << "," << std::endl;
+        out << "   \"reps\": " << r.reps << "," << std::endl;
+        out << "   \"inner_iter\": " << r.inner_iter << "," << std::endl;
+        out << "   \"median\": " << r.median << "," << std::endl;
+        out << "   \"p10\": " << r.p10 << "," << std::endl;
+        out << "   \"p90\": " << r.p90 << "," << std::endl;
+        out << "   \"mean\": " << r.mean << "," << std::endl;
+        out << "   \"stddev\": " << r.stddev << "," << std::endl;
+        out << "   \"units\": \"ns/item\"," << std::endl;
+        out << "   \"samples\": [";
+        for(size_t j=0; j<r.samples.size(); j++) {
+            if(j) out << ", ";
+            out << r.samples[j];
+        }
+        out << "]" << std::endl;
+        out << "  }";
+        if(i+1 != results.size()) {
+            out << ",";
+        }
+        out << std::endl;
+    }
+    out << " ]" << std::endl;
+    out << "}" << std::endl;
+}
+
+bool read_sweep_csv(std::istream &in, std::vector<volk_sweep_result_t> &results) {
+    std::string line;
+    if(!std::getline(in, line)) return false; // header
+
+    boost::char_separator<char> comma(",", "", boost::keep_empty_tokens);
+    boost::char_separator<char> semi(";");
+    while(std::getline(in, line)) {
+        if(line.empty()) continue;
+        boost::tokenizer<boost::char_separator<char> > tok(line, comma);
+        std::vector<std::string> f(tok.begin(), tok.end());
+        if(f.size() != 12) return false;
+        try {
+            volk_sweep_result_t r;
+            r.name = f[0];
+            r.arch = f[1];
+            r.vlen = boost::lexical_cast<int>(f[2]);
+            r.offset = boost::lexical_cast<int>(f[3]);
+            r.reps = boost::lexical_cast<int>(f[4]);
+            r.inner_iter = boost::lexical_cast<int>(f[5]);
+            r.median = boost::lexical_cast<double>(f[6]);
+            r.p10 = boost::lexical_cast<double>(f[7]);
+            r.p90 = boost::lexical_cast<double>(f[8]);
+            r.mean = boost::lexical_cast<double>(f[9]);
+            r.stddev = boost::lexical_cast<double>(f[10]);
+            boost::tokenizer<boost::char_separator<char> > stok(f[11], semi);
+            for(BOOST_AUTO(it, stok.begin()); it != stok.end(); ++it) {
+                r.samples.push_back(boost::lexical_cast<double>(*it));
+            }
+            results.push_back(r);
+        } catch(boost::bad_lexical_cast &) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -42,6 +42,46 @@ class volk_test_results_t {
         std::string best_arch_u;
 };
 
+/*!
+ * Timing statistics of one kernel/arch pair at a single vector
+ * length and buffer offset. All times are in nanoseconds per item.
+ */
+class volk_sweep_result_t {
+    public:
+        std::string name;
+        std::string arch;
+        int vlen;
+        int offset;
+        int reps;
+        int inner_iter;
+        double median;
+        double p10;
+        double p90;
+        double mean;
+        double stddev;
+        std::vector<double> samples;
+};
+
+/*!
+ * Parameters for the regression sweep. When \p enabled is set,
+ * run_volk_tests() times every arch over all combinations of
+ * \p lengths and \p offsets instead of doing a single-shot profile.
+ * Offsets are given in items; non-zero offsets only run the
+ * unaligned implementations.
+ */
+class volk_sweep_params_t {
+    public:
+        volk_sweep_params_t() :
+            enabled(false), warmup(10), reps(25), min_rep_time_ms(1.0) {}
+        bool enabled;
+        std::vector<int> lengths;
+        std::vector<int> offsets;
+        int warmup;
+        int reps;
+        double min_rep_time_ms;
+        std::vector<volk_sweep_result_t> results;
+};
+
 bool run_volk_tests(
     volk_func_desc_t, 
     void(*)(), 
@@ -53,9 +93,22 @@ bool run_volk_tests(
     std::vector<volk_test_results_t> *results = NULL, 
     std::string puppet_master_name = "NULL",
     bool benchmark_mode=false, 
-    std::string kernel_regex=""
+    std::string kernel_regex="",
+    volk_sweep_params_t *sweep = NULL
     );
 
+bool run_volk_sweep(
+    volk_func_desc_t,
+    void(*)(),
+    std::string,
+    lv_32fc_t,
+    volk_sweep_params_t &sweep
+    );
+
+void write_sweep_csv(std::ostream &out, const std::vector<volk_sweep_result_t> &results);
+void write_sweep_json(std::ostream &out, const std::vector<volk_sweep_result_t> &results);
+bool read_sweep_csv(std::istream &in, std::vector<volk_sweep_result_t> &results);
+
 
 #define VOLK_RUN_TESTS(func, tol, scalar, len, iter) \
     BOOST_AUTO_TEST_CASE(func##_test) { \
@@ -64,8 +117,8 @@ bool run_volk_tests(
             std::string(#func), tol, scalar, len, iter, 0, "NULL"), \
           0); \
     }
-#define VOLK_PROFILE(func, tol, scalar, len, iter, results, bnmode, kernel_regex) run_volk_tests(func##_get_func_desc(), (void (*)())func##_manual, std::string(#func), tol, scalar, len, iter, results, "NULL", bnmode, kernel_regex)
-#define VOLK_PUPPET_PROFILE(func, puppet_master_func, tol, scalar, len, iter, results, bnmode, kernel_regex) run_volk_tests(func##_get_func_desc(), (void (*)())func##_manual, std::string(#func), tol, scalar, len, iter, results, std::string(#puppet_master_func), bnmode, kernel_regex)
+#define VOLK_PROFILE(func, tol, scalar, len, iter, results, bnmode, kernel_regex, sweep) run_volk_tests(func##_get_func_desc(), (void (*)())func##_manual, std::string(#func), tol, scalar, len, iter, results, "NULL", bnmode, kernel_regex, sweep)
+#define VOLK_PUPPET_PROFILE(func, puppet_master_func, tol, scalar, len, iter, results, bnmode, kernel_regex, sweep) run_volk_tests(func##_get_func_desc(), (void (*)())func##_manual, std::string(#func), tol, scalar, len, iter, results, std::string(#puppet_master_func), bnmode, kernel_regex, sweep)
 typedef void (*volk_fn_1arg)(void *, unsigned int, const char*); //one input, operate in place
 typedef void (*volk_fn_2arg)(void *, void *, unsigned int, const char*);
 typedef void (*volk_fn_3arg)(void *, void *, void *, unsigned int, const char*);
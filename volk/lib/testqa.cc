@@ -22,6 +22,7 @@
 
 #include "qa_utils.h"
 #include <volk/volk.h>
+#include <volk/volk_bind.h>
 #include <boost/test/unit_test.hpp>
 
 //VOLK_RUN_TESTS(volk_16i_x5_add_quad_16i_x4, 1e-4, 2046, 10000);
@@ -33,6 +34,9 @@ VOLK_RUN_TESTS(volk_16ic_s32f_deinterleave_32f_x2, 1e-4, 32768.0, 20462, 1);
 VOLK_RUN_TESTS(volk_16ic_deinterleave_real_16i, 0, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_16ic_magnitude_16i, 1, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_16ic_s32f_magnitude_32f, 1e-5, 32768.0, 20462, 1);
+VOLK_RUN_TESTS(volk_16ic_x2_multiply_16ic, 0, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_16ic_x2_multiply_conjugate_16ic, 0, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_16ic_x2_dot_prod_16ic, 0, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_16i_s32f_convert_32f, 1e-4, 32768.0, 20462, 1);
 VOLK_RUN_TESTS(volk_16i_convert_8i, 0, 0, 20462, 1);
 //VOLK_RUN_TESTS(volk_16i_max_star_16i, 0, 0, 20462, 10000);
@@ -49,6 +53,7 @@ VOLK_RUN_TESTS(volk_32f_expfast_32f, 1e-1, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_x2_pow_32f, 1e-2, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_sin_32f, 1e-6, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_cos_32f, 1e-6, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32f_sincos_32fc, 1e-5, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_tan_32f, 1e-6, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_atan_32f, 1e-3, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_asin_32f, 1e-3, 0, 20462, 1);
@@ -56,6 +61,7 @@ VOLK_RUN_TESTS(volk_32f_acos_32f, 1e-3, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_s32f_power_32fc, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_s32f_calc_spectral_noise_floor_32f, 1e-4, 20.0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_s32f_atan2_32f, 1e-4, 10.0, 20462, 1);
+VOLK_RUN_TESTS(volk_32fc_s32f_fast_atan2_32f, 1e-4, 10.0, 20462, 1);
 //VOLK_RUN_TESTS(volk_32fc_x2_conjugate_dot_prod_32fc, 1e-4, 0, 2046, 10000);
 VOLK_RUN_TESTS(volk_32fc_x2_conjugate_dot_prod_32fc, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_deinterleave_32f_x2, 1e-4, 0, 20462, 1);
@@ -93,6 +99,9 @@ VOLK_RUN_TESTS(volk_32f_s32f_stddev_32f, 1e-4, 100, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_stddev_and_mean_32f_x2, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_x2_subtract_32f, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_x3_sum_of_poly_32f, 1e-2, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32f_x2_s32f_polyval_32f, 1e-4, 6, 20462, 1);
+VOLK_RUN_TESTS(volk_32f_x2_s32f_chebyshev_32f, 1e-4, 9, 20462, 1);
+VOLK_RUN_TESTS(volk_32f_x2_s32f_lut_interp_32f, 1e-4, 1024, 20462, 1);
 VOLK_RUN_TESTS(volk_32i_x2_and_32i, 0, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32i_s32f_convert_32f, 1e-4, 100, 20462, 1);
 VOLK_RUN_TESTS(volk_32i_x2_or_32i, 0, 0, 20462, 1);
@@ -119,8 +128,41 @@ VOLK_RUN_TESTS(volk_32f_x2_multiply_32f, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_s32fc_multiply_32fc, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_s32f_multiply_32f, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_s32fc_rotatorpuppet_32fc, 1e-3, (lv_32fc_t)lv_cmake(0.953939201, 0.3), 20462, 1);
+//the float phasor drifts differently per arch; allow ~1e-3 of full scale
+VOLK_RUN_TESTS(volk_16ic_s32fc_rotatorpuppet_16ic, 32, (lv_32fc_t)lv_cmake(0.953939201, 0.3), 20462, 1);
 VOLK_RUN_TESTS(volk_8u_conv_k7_r2puppet_8u, 0, 0, 2060, 1);
 VOLK_RUN_TESTS(volk_32f_invsqrt_32f, 1e-2, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_binary_slicer_32i, 0, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_binary_slicer_8i, 0, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_tanh_32f, 1e-6, 0, 20462, 1);
+
+BOOST_AUTO_TEST_CASE(volk_bind_test) {
+    const unsigned int N = 1027;
+    float *a = (float*)volk_malloc(N*sizeof(float), volk_get_alignment());
+    float *b = (float*)volk_malloc(N*sizeof(float), volk_get_alignment());
+    float *out = (float*)volk_malloc(N*sizeof(float), volk_get_alignment());
+    float *ref = (float*)volk_malloc(N*sizeof(float), volk_get_alignment());
+    for(unsigned int i = 0; i < N; i++) {
+        a[i] = float(i);
+        b[i] = 0.5f * float(i);
+    }
+
+    volk::binding<p_32f_x2_add_32f> add = VOLK_BIND(volk_32f_x2_add_32f);
+    BOOST_REQUIRE(add.aligned != NULL);
+    BOOST_REQUIRE(add.unaligned != NULL);
+    BOOST_CHECK(add.aligned == volk_32f_x2_add_32f_a);
+    BOOST_CHECK(add.unaligned == volk_32f_x2_add_32f_u);
+
+    volk_32f_x2_add_32f_manual(ref, a, b, N, "generic");
+    add(VOLK_OR_PTR(VOLK_OR_PTR(out, a), b))(out, a, b, N);
+    for(unsigned int i = 0; i < N; i++) BOOST_CHECK_EQUAL(ref[i], out[i]);
+
+    volk::binding<p_32f_x2_add_32f> generic = VOLK_BIND_IMPL(volk_32f_x2_add_32f, "generic");
+    generic.unaligned(out+1, a+1, b+1, N-1);
+    for(unsigned int i = 1; i < N; i++) BOOST_CHECK_EQUAL(ref[i], out[i]);
+
+    volk_free(a);
+    volk_free(b);
+    volk_free(out);
+    volk_free(ref);
+}
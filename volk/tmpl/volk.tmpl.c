@@ -195,6 +195,16 @@ void $(kern.name)_manual($kern.arglist_full, const char* impl_name)
     );
 }
 
+$kern.pname $(kern.name)_get_impl(const char* impl_name)
+{
+    const int index = volk_get_index(
+        get_machine()->$(kern.name)_impl_names,
+        get_machine()->$(kern.name)_n_impls,
+        impl_name
+    );
+    return get_machine()->$(kern.name)_impls[index];
+}
+
 volk_func_desc_t $(kern.name)_get_func_desc(void) {
     const char **impl_names = get_machine()->$(kern.name)_impl_names;
     const int *impl_deps = get_machine()->$(kern.name)_impl_deps;
@@ -210,3 +220,15 @@ volk_func_desc_t $(kern.name)_get_func_desc(void) {
 }
 
 #end for
+
+void volk_init(void)
+{
+    static bool initialized = false;
+    if(initialized) return;
+
+    #for $kern in $kernels
+    __init_$(kern.name)();
+    #end for
+
+    initialized = true;
+}
@@ -50,6 +50,16 @@ VOLK_API const char* volk_get_machine(void);
 //! Get the machine alignment in bytes
 VOLK_API size_t volk_get_alignment(void);
 
+/*!
+ * Resolve the implementation of every kernel now.
+ *
+ * Without this, each kernel ranks its implementations and loads the
+ * preferences file on its first call, so the first work() call of a
+ * block sees a latency spike. Call it once, from a single thread,
+ * before any worker thread uses VOLK; later calls return immediately.
+ */
+VOLK_API void volk_init(void);
+
 /*!
  * The VOLK_OR_PTR macro is a convenience macro
  * for checking the alignment of a set of pointers.
@@ -85,6 +95,9 @@ extern VOLK_API $kern.pname $(kern.name)_u;
 //! Call into a specific implementation given by name
 extern VOLK_API void $(kern.name)_manual($kern.arglist_full, const char* impl_name);
 
+//! Get a specific implementation given by name
+extern VOLK_API $kern.pname $(kern.name)_get_impl(const char* impl_name);
+
 //! Get description paramaters for this kernel
 extern VOLK_API volk_func_desc_t $(kern.name)_get_func_desc(void);
 #end for